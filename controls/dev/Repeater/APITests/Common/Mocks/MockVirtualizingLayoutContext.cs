@@ -0,0 +1,88 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+using System;
+using System.Collections.Generic;
+using Windows.Foundation;
+using Microsoft.UI.Xaml.Controls;
+
+namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks
+{
+    // Standalone VirtualizingLayoutContext which lets a layout be measured and arranged without an ItemsRepeater.
+    // Elements are plain fixed-size Borders handed out through a simple recycle stack.
+    partial class MockVirtualizingLayoutContext : VirtualizingLayoutContext
+    {
+        private readonly Stack<Border> _recycledElements = new Stack<Border>();
+        private readonly Dictionary<int, Border> _realizedElements = new Dictionary<int, Border>();
+
+        public int TotalItemCount { get; set; }
+        public Func<int, Size> ItemSizeFunc { get; set; }
+        public Rect RealizationWindow { get; set; }
+        public Rect VisibleWindow { get; set; }
+        public int AnchorIndex { get; set; } = -1;
+
+        public int CreatedElementCount { get; private set; }
+        public int RealizedElementCount { get { return _realizedElements.Count; } }
+
+        protected override int ItemCountCore()
+        {
+            return TotalItemCount;
+        }
+
+        protected override object GetItemAtCore(int index)
+        {
+            return index;
+        }
+
+        protected override Rect RealizationRectCore()
+        {
+            return RealizationWindow;
+        }
+
+        protected override Rect VisibleRectCore()
+        {
+            return VisibleWindow;
+        }
+
+        protected override int RecommendedAnchorIndexCore
+        {
+            get { return AnchorIndex; }
+        }
+
+        protected override Point LayoutOriginCore { get; set; }
+
+        protected override object LayoutStateCore { get; set; }
+
+        protected override UIElement GetOrCreateElementAtCore(int index, ElementRealizationOptions options)
+        {
+            Border element;
+            if (!_realizedElements.TryGetValue(index, out element))
+            {
+                if (_recycledElements.Count > 0)
+                {
+                    element = _recycledElements.Pop();
+                }
+                else
+                {
+                    element = new Border();
+                    CreatedElementCount++;
+                }
+
+                var size = ItemSizeFunc != null ? ItemSizeFunc(index) : new Size(100, 100);
+                element.Width = size.Width;
+                element.Height = size.Height;
+                element.Tag = index;
+                _realizedElements[index] = element;
+            }
+
+            return element;
+        }
+
+        protected override void RecycleElementCore(UIElement element)
+        {
+            var border = (Border)element;
+            _realizedElements.Remove((int)border.Tag);
+            _recycledElements.Push(border);
+        }
+    }
+}
@@ -11,6 +11,7 @@ using Microsoft.UI.Xaml.Input;
 using Microsoft.UI.Xaml.Markup;
 using System.Threading;
 using Common;
+using Microsoft.UI.Private.Controls;
 
 using WEX.TestExecution;
 using WEX.TestExecution.Markup;
@@ -92,6 +93,50 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateMultipleChangesBeforeLayout()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                bool wasCoalescingEnabled = RepeaterTestHooks.GetIsCollectionChangeCoalescingEnabled();
+
+                try
+                {
+                    foreach (bool isCoalescingEnabled in new[] { false, true })
+                    {
+                        Log.Comment("Collection change coalescing enabled: " + isCoalescingEnabled);
+                        RepeaterTestHooks.SetIsCollectionChangeCoalescingEnabled(isCoalescingEnabled);
+
+                        var dataSource = new CustomItemsSource(Enumerable.Range(0, 20).ToList());
+                        var repeater = SetupRepeater(dataSource);
+
+                        // None of these are followed by a layout pass, so the layout sees all of them
+                        // before it gets to update its realized range.
+                        dataSource.Insert(index: 2, count: 3, reset: false);
+                        dataSource.Remove(index: 6, count: 2, reset: false);
+                        dataSource.Replace(index: 1, oldCount: 1, newCount: 1, reset: false);
+                        dataSource.Replace(index: 3, oldCount: 2, newCount: 4, reset: false);
+                        dataSource.Move(oldIndex: 4, newIndex: 0, count: 1, reset: false);
+                        dataSource.Insert(index: 0, count: 2, reset: false);
+                        dataSource.Remove(index: 0, count: 1, reset: false);
+                        for (int i = 0; i < 3; i++)
+                        {
+                            dataSource.Insert(index: 5 + i, count: 1, reset: false);
+                            dataSource.Remove(index: 9, count: 1, reset: false);
+                        }
+                        repeater.UpdateLayout();
+
+                        var realized = VerifyRealizedRange(repeater, dataSource);
+                        Verify.IsGreaterThan(realized, 0);
+                    }
+                }
+                finally
+                {
+                    RepeaterTestHooks.SetIsCollectionChangeCoalescingEnabled(wasCoalescingEnabled);
+                }
+            });
+        }
+
         [TestMethod]
         public void CanRemoveItemsStartingBeforeRealizedRange()
         {
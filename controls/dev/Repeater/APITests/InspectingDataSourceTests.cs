@@ -12,6 +12,7 @@ using Windows.Foundation.Collections;
 using Common;
 using System;
 using Microsoft.UI.Xaml.Controls;
+using Microsoft.UI.Private.Controls;
 using MUXControlsTestApp.Utils;
 
 using WEX.TestExecution;
@@ -145,6 +146,119 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void VerifyIndexOfCacheMatchesLinearIndexOf()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                bool wasIndexOfCacheEnabled = RepeaterTestHooks.GetIsIndexOfCacheEnabled();
+
+                try
+                {
+                    // Items equal by value, by a custom Equals, duplicated or null, in an IEnumerable that is
+                    // snapshotted and so answered from the identity index.
+                    var items = Enumerable.Range(0, 200).Select(i =>
+                        i % 5 == 0 ? (object)(i % 10) :
+                        i % 5 == 1 ? (object)new AlwaysEqual() :
+                        i % 5 == 2 ? null :
+                        (object)new object()).ToList();
+                    items.Add(items[3]);
+
+                    var lookups = items.Concat(new object[] { 0, new AlwaysEqual(), new object() }).ToList();
+                    var results = new List<int>[2];
+
+                    foreach (bool isIndexOfCacheEnabled in new[] { false, true })
+                    {
+                        RepeaterTestHooks.SetIsIndexOfCacheEnabled(isIndexOfCacheEnabled);
+                        var dataSource = new ItemsSourceView(Iterate(items));
+                        results[isIndexOfCacheEnabled ? 1 : 0] = lookups.Select(item => dataSource.IndexOf(item)).ToList();
+                    }
+
+                    for (int i = 0; i < lookups.Count; i++)
+                    {
+                        Verify.AreEqual(results[0][i], results[1][i]);
+                    }
+
+                    // The snapshot compares identities, so only the first occurrence of the very same object is found.
+                    Verify.AreEqual(1, results[1][1]);
+                    Verify.AreEqual(2, results[1][2]);
+                    Verify.AreEqual(3, results[1][items.Count - 1]);
+                    Verify.AreEqual(-1, results[1][lookups.Count - 2]);
+                }
+                finally
+                {
+                    RepeaterTestHooks.SetIsIndexOfCacheEnabled(wasIndexOfCacheEnabled);
+                }
+            });
+        }
+
+        [TestMethod]
+        public void VerifyIndexOfUsesVectorEquality()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                // Vectors are asked directly, so their own equality decides which item is found first.
+                var data = new ObservableCollection<object>(Enumerable.Range(0, 200).Select(i => (object)new AlwaysEqual()));
+                var dataSource = new ItemsSourceView(data);
+
+                Verify.AreEqual(0, dataSource.IndexOf(data[100]));
+                Verify.AreEqual(0, dataSource.IndexOf(new AlwaysEqual()));
+            });
+        }
+
+        private static IEnumerable<object> Iterate(IEnumerable<object> items)
+        {
+            foreach (var item in items)
+            {
+                yield return item;
+            }
+        }
+
+        private class AlwaysEqual
+        {
+            public override bool Equals(object obj) { return obj is AlwaysEqual; }
+            public override int GetHashCode() { return 0; }
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Compares IndexOf throughput with and without the identity index.")]
+        public void IndexOfCacheBenchmark()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int itemCount = 20000;
+                const int lookupCount = 2000;
+                bool wasIndexOfCacheEnabled = RepeaterTestHooks.GetIsIndexOfCacheEnabled();
+
+                try
+                {
+                    var data = Enumerable.Range(0, itemCount).Select(i => new object()).ToList();
+                    var random = new Random(42);
+                    var lookups = Enumerable.Range(0, lookupCount).Select(i => random.Next(itemCount)).ToArray();
+
+                    foreach (bool isIndexOfCacheEnabled in new[] { false, true })
+                    {
+                        RepeaterTestHooks.SetIsIndexOfCacheEnabled(isIndexOfCacheEnabled);
+                        var dataSource = new ItemsSourceView(Iterate(data));
+
+                        var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+                        foreach (int index in lookups)
+                        {
+                            Verify.AreEqual(index, dataSource.IndexOf(data[index]));
+                        }
+                        stopwatch.Stop();
+
+                        Log.Comment(string.Format("IndexOf cache enabled: {0}, {1} lookups over {2} items: {3} ms",
+                            isIndexOfCacheEnabled, lookupCount, itemCount, stopwatch.ElapsedMilliseconds));
+                    }
+                }
+                finally
+                {
+                    RepeaterTestHooks.SetIsIndexOfCacheEnabled(wasIndexOfCacheEnabled);
+                }
+            });
+        }
+
         // Calling Reset multiple times before layout runs causes a crash
         // in unique ids. We end up thinking we have multiple elements with the same id.
         #if MUX_PRERELEASE // 35797846
@@ -0,0 +1,187 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+using MUXControlsTestApp.Utilities;
+using System;
+using System.Diagnostics;
+using System.Linq;
+using Windows.Foundation;
+using Microsoft.UI.Xaml.Controls;
+using Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks;
+using Common;
+
+using WEX.TestExecution;
+using WEX.TestExecution.Markup;
+using WEX.Logging.Interop;
+
+namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
+{
+    // Headless layout benchmarks. Each layout is driven through a MockVirtualizingLayoutContext, without an
+    // ItemsRepeater or ScrollViewer, and the cost of measure, arrange and a scroll jump per realized item is
+    // logged so that layout performance can be compared from one build to the next.
+    // They take minutes, so they are classified as performance tests and only run when selected explicitly,
+    // e.g. te.exe MUXControlsTestApp.dll /select:"@Classification='Performance'".
+    [TestClass]
+    public class LayoutBenchmarkTests : ApiTestBase
+    {
+        private static readonly int[] s_itemCounts = { 1000, 10000, 100000, 1000000 };
+        private const double c_viewportWidth = 800.0;
+        private const double c_viewportHeight = 600.0;
+        private const int c_iterations = 10;
+        private const int c_warmupSamples = 2;
+        private const int c_samples = 5;
+
+        private class BenchmarkSample
+        {
+            public double MeasureNanosecondsPerRealizedItem;
+            public double ArrangeNanosecondsPerRealizedItem;
+            public double ScrollJumpNanosecondsPerRealizedItem;
+            public int RealizedElementCount;
+            public int CreatedElementCount;
+        }
+
+        [ClassInitialize]
+        [TestProperty("Classification", "Performance")]
+        public static void ClassInitialize(TestContext testContext)
+        {
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Benchmarks StackLayout (FlowLayoutAlgorithm) with variable item heights.")]
+        public void StackLayoutBenchmark()
+        {
+            RunBenchmark("StackLayout", () => new StackLayout(), index => new Size(c_viewportWidth, 20 + (index * 7919) % 80));
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Benchmarks FlowLayout (FlowLayoutAlgorithm) with variable item sizes.")]
+        public void FlowLayoutBenchmark()
+        {
+            RunBenchmark("FlowLayout", () => new FlowLayout(), index => new Size(40 + (index * 7919) % 120, 20 + (index * 104729) % 80));
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Benchmarks UniformGridLayout with uniform item sizes.")]
+        public void UniformGridLayoutBenchmark()
+        {
+            RunBenchmark("UniformGridLayout", () => new UniformGridLayout(), index => new Size(100, 100));
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Benchmarks LinedFlowLayout with variable item aspect ratios.")]
+        public void LinedFlowLayoutBenchmark()
+        {
+            RunBenchmark("LinedFlowLayout", () => new LinedFlowLayout() { LineHeight = 100 }, index => new Size(50 + (index * 7919) % 150, 100));
+        }
+
+        private void RunBenchmark(string layoutName, Func<VirtualizingLayout> layoutFactory, Func<int, Size> itemSizeFunc)
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                foreach (int itemCount in s_itemCounts)
+                {
+                    // Warm up the code paths and allocators, then keep the median of the timed samples.
+                    for (int i = 0; i < c_warmupSamples; i++)
+                    {
+                        RunSample(layoutFactory, itemSizeFunc, itemCount);
+                    }
+
+                    var samples = new BenchmarkSample[c_samples];
+                    for (int i = 0; i < c_samples; i++)
+                    {
+                        samples[i] = RunSample(layoutFactory, itemSizeFunc, itemCount);
+                    }
+
+                    Log.Comment(string.Format(
+                        "{0} items={1} measure={2:F3}ns/realized item arrange={3:F3}ns/realized item scrollJump={4:F3}ns/realized item realized={5} created={6} (median of {7} samples)",
+                        layoutName,
+                        itemCount,
+                        Median(samples, sample => sample.MeasureNanosecondsPerRealizedItem),
+                        Median(samples, sample => sample.ArrangeNanosecondsPerRealizedItem),
+                        Median(samples, sample => sample.ScrollJumpNanosecondsPerRealizedItem),
+                        samples[c_samples - 1].RealizedElementCount,
+                        samples[c_samples - 1].CreatedElementCount,
+                        c_samples));
+                }
+            });
+        }
+
+        // Runs a full measure, arrange and scroll jump sequence on a new layout and context. Each cost is
+        // divided by the number of elements realized by that operation, which is what the layout touches,
+        // rather than by the total item count.
+        private BenchmarkSample RunSample(Func<VirtualizingLayout> layoutFactory, Func<int, Size> itemSizeFunc, int itemCount)
+        {
+            var sample = new BenchmarkSample();
+            var layout = layoutFactory();
+            var context = new MockVirtualizingLayoutContext() {
+                TotalItemCount = itemCount,
+                ItemSizeFunc = itemSizeFunc,
+                VisibleWindow = new Rect(0, 0, c_viewportWidth, c_viewportHeight),
+                RealizationWindow = new Rect(0, -c_viewportHeight, c_viewportWidth, 3 * c_viewportHeight)
+            };
+            var availableSize = new Size(c_viewportWidth, double.PositiveInfinity);
+
+            layout.InitializeForContext(context);
+
+            var stopwatch = Stopwatch.StartNew();
+            var desiredSize = layout.Measure(context, availableSize);
+            stopwatch.Stop();
+            sample.MeasureNanosecondsPerRealizedItem = PerRealizedItem(stopwatch.ElapsedTicks, context);
+
+            stopwatch.Restart();
+            for (int i = 0; i < c_iterations; i++)
+            {
+                layout.Arrange(context, desiredSize);
+            }
+            stopwatch.Stop();
+            sample.ArrangeNanosecondsPerRealizedItem = PerRealizedItem(stopwatch.ElapsedTicks / c_iterations, context);
+
+            // Scroll jumps alternate between the middle and the end of the extent.
+            double scrollJumpNanoseconds = 0.0;
+            for (int i = 0; i < c_iterations; i++)
+            {
+                double offset = (i % 2 == 0 ? 0.5 : 0.95) * Math.Max(0.0, desiredSize.Height - c_viewportHeight);
+                context.VisibleWindow = new Rect(0, offset, c_viewportWidth, c_viewportHeight);
+                context.RealizationWindow = new Rect(0, offset - c_viewportHeight, c_viewportWidth, 3 * c_viewportHeight);
+
+                stopwatch.Restart();
+                desiredSize = layout.Measure(context, availableSize);
+                layout.Arrange(context, desiredSize);
+                stopwatch.Stop();
+                scrollJumpNanoseconds += PerRealizedItem(stopwatch.ElapsedTicks, context);
+            }
+            sample.ScrollJumpNanosecondsPerRealizedItem = scrollJumpNanoseconds / c_iterations;
+
+            layout.UninitializeForContext(context);
+
+            Verify.IsGreaterThan(context.CreatedElementCount, 0);
+
+            // The timings are only comparable if the layout virtualizes, so a large collection must not be fully realized.
+            if (itemCount >= 100000)
+            {
+                Verify.IsLessThan(context.RealizedElementCount, itemCount);
+            }
+
+            sample.RealizedElementCount = context.RealizedElementCount;
+            sample.CreatedElementCount = context.CreatedElementCount;
+            return sample;
+        }
+
+        private static double PerRealizedItem(long ticks, MockVirtualizingLayoutContext context)
+        {
+            return TicksToNanoseconds(ticks) / Math.Max(1, context.RealizedElementCount);
+        }
+
+        private static double Median(BenchmarkSample[] samples, Func<BenchmarkSample, double> selector)
+        {
+            var values = samples.Select(selector).OrderBy(value => value).ToArray();
+            int middle = values.Length / 2;
+            return values.Length % 2 == 0 ? (values[middle - 1] + values[middle]) / 2 : values[middle];
+        }
+
+        private static double TicksToNanoseconds(long ticks)
+        {
+            return ticks * (1e9 / Stopwatch.Frequency);
+        }
+    }
+}
@@ -7,6 +7,7 @@ using System;
 using System.Collections.Generic;
 using System.Linq;
 using System.Threading;
+using Windows.Foundation;
 using Microsoft.UI.Xaml;
 using Microsoft.UI.Xaml.Controls;
 using Microsoft.UI.Xaml.Markup;
@@ -98,6 +99,202 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             }
         }
 
+        [TestMethod]
+        public void ValidateBuildTreeSchedulerCounters()
+        {
+            int numPhases = 6; // 0 to 5
+            ManualResetEvent buildTreeCompleted = new ManualResetEvent(false);
+            TypedEventHandler<object, object> buildTreeCompletedHandler = (sender, args) =>
+            {
+                buildTreeCompleted.Set();
+            };
+
+            try
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.ResetBuildTreeSchedulerCounters();
+                    RepeaterTestHooks.BuildTreeCompleted += buildTreeCompletedHandler;
+
+                    var repeater = new ItemsRepeater()
+                    {
+                        ItemsSource = Enumerable.Range(0, 10),
+                        ItemTemplate = new CustomElementFactory(numPhases),
+                        Layout = new StackLayout(),
+                    };
+
+                    Content = new ItemsRepeaterScrollHost()
+                    {
+                        Width = 400,
+                        Height = 400,
+                        ScrollViewer = new ScrollViewer
+                        {
+                            Content = repeater
+                        }
+                    };
+                });
+
+                if (buildTreeCompleted.WaitOne(TimeSpan.FromMilliseconds(2000)))
+                {
+                    RunOnUIThread.Execute(() =>
+                    {
+                        Log.Comment(string.Format("Executed: {0}, Deferred: {1}, Dropped: {2}",
+                            RepeaterTestHooks.GetBuildTreeSchedulerExecutedWorkCount(),
+                            RepeaterTestHooks.GetBuildTreeSchedulerDeferredWorkCount(),
+                            RepeaterTestHooks.GetBuildTreeSchedulerDroppedWorkCount()));
+
+                        Verify.IsGreaterThan(RepeaterTestHooks.GetBuildTreeSchedulerExecutedWorkCount(), 0UL);
+                        Verify.AreEqual(0UL, RepeaterTestHooks.GetBuildTreeSchedulerDroppedWorkCount());
+                    });
+                }
+                else
+                {
+                    Verify.Fail("Failed on waiting on build tree.");
+                }
+            }
+            finally
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.BuildTreeCompleted -= buildTreeCompletedHandler;
+                    ElementPhasingManager.ProcessedCalls?.Clear();
+                });
+            }
+        }
+
+        [TestMethod]
+        public void ValidateBuildTreeSchedulerCancelAndUpdatePriority()
+        {
+            ManualResetEvent buildTreeCompleted = new ManualResetEvent(false);
+            TypedEventHandler<object, object> buildTreeCompletedHandler = (sender, args) =>
+            {
+                buildTreeCompleted.Set();
+            };
+            ulong lateWorkId = 0;
+
+            try
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.ResetBuildTreeSchedulerCounters();
+                    RepeaterTestHooks.BuildTreeCompleted += buildTreeCompletedHandler;
+
+                    // Nothing runs before the next rendering tick, so all of this is applied to queued work.
+                    lateWorkId = RepeaterTestHooks.RegisterBuildTreeSchedulerWork(2 /* priority */, 1 /* tag */);
+                    RepeaterTestHooks.RegisterBuildTreeSchedulerWork(1 /* priority */, 2 /* tag */);
+                    ulong promotedWorkId = RepeaterTestHooks.RegisterBuildTreeSchedulerWork(3 /* priority */, 3 /* tag */);
+                    ulong cancelledWorkId = RepeaterTestHooks.RegisterBuildTreeSchedulerWork(0 /* priority */, 4 /* tag */);
+
+                    Verify.IsTrue(RepeaterTestHooks.CancelBuildTreeSchedulerWork(cancelledWorkId));
+                    Verify.IsFalse(RepeaterTestHooks.CancelBuildTreeSchedulerWork(cancelledWorkId), "Work can only be cancelled once.");
+                    Verify.IsFalse(RepeaterTestHooks.UpdateBuildTreeSchedulerWorkPriority(cancelledWorkId, 1), "Cancelled work cannot be reprioritized.");
+
+                    Verify.IsTrue(RepeaterTestHooks.UpdateBuildTreeSchedulerWorkPriority(promotedWorkId, 0));
+                });
+
+                if (buildTreeCompleted.WaitOne(TimeSpan.FromMilliseconds(2000)))
+                {
+                    RunOnUIThread.Execute(() =>
+                    {
+                        var tags = RepeaterTestHooks.GetExecutedBuildTreeSchedulerWorkTags().ToList();
+                        Log.Comment("Executed tags: " + string.Join(", ", tags));
+
+                        // The promoted work runs first, the cancelled work never runs.
+                        Verify.AreEqual(3, tags.Count);
+                        Verify.AreEqual(3, tags[0]);
+                        Verify.AreEqual(2, tags[1]);
+                        Verify.AreEqual(1, tags[2]);
+
+                        Verify.AreEqual(1UL, RepeaterTestHooks.GetBuildTreeSchedulerDroppedWorkCount());
+                        Verify.IsFalse(RepeaterTestHooks.CancelBuildTreeSchedulerWork(lateWorkId), "Work that already ran cannot be cancelled.");
+                        Verify.IsFalse(RepeaterTestHooks.UpdateBuildTreeSchedulerWorkPriority(lateWorkId, 0), "Work that already ran cannot be reprioritized.");
+                    });
+                }
+                else
+                {
+                    Verify.Fail("Failed on waiting on build tree.");
+                }
+            }
+            finally
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.BuildTreeCompleted -= buildTreeCompletedHandler;
+                });
+            }
+        }
+
+        [TestMethod]
+        public void ValidatePhaserCancelsCallbackWhenElementsAreCleared()
+        {
+            int numPhases = 6; // 0 to 5
+            ManualResetEvent buildTreeCompleted = new ManualResetEvent(false);
+            TypedEventHandler<object, object> buildTreeCompletedHandler = (sender, args) =>
+            {
+                buildTreeCompleted.Set();
+            };
+
+            try
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.ResetBuildTreeSchedulerCounters();
+                    RepeaterTestHooks.BuildTreeCompleted += buildTreeCompletedHandler;
+
+                    var repeater = new ItemsRepeater()
+                    {
+                        ItemsSource = Enumerable.Range(0, 10),
+                        ItemTemplate = new CustomElementFactory(numPhases),
+                        Layout = new StackLayout(),
+                    };
+
+                    Content = new ItemsRepeaterScrollHost()
+                    {
+                        Width = 400,
+                        Height = 400,
+                        ScrollViewer = new ScrollViewer
+                        {
+                            Content = repeater
+                        }
+                    };
+
+                    // Realize the elements, which runs phase 0 and queues the Phaser callback for the next phases.
+                    Content.UpdateLayout();
+                    Verify.IsGreaterThan(ElementPhasingManager.ProcessedCalls.Count, 0);
+
+                    // Clearing every element before the callback runs leaves the Phaser with nothing to do, so
+                    // it cancels its queued callback.
+                    repeater.ItemsSource = new List<int>();
+                    Content.UpdateLayout();
+                    Verify.AreEqual(1UL, RepeaterTestHooks.GetBuildTreeSchedulerDroppedWorkCount());
+                });
+
+                if (buildTreeCompleted.WaitOne(TimeSpan.FromMilliseconds(2000)))
+                {
+                    RunOnUIThread.Execute(() =>
+                    {
+                        Verify.AreEqual(0UL, RepeaterTestHooks.GetBuildTreeSchedulerExecutedWorkCount());
+                        foreach (var phases in ElementPhasingManager.ProcessedCalls.Values)
+                        {
+                            Verify.IsTrue(phases.All(phase => phase == 0), "Only phase 0 should have run.");
+                        }
+                    });
+                }
+                else
+                {
+                    Verify.Fail("Failed on waiting on build tree.");
+                }
+            }
+            finally
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.BuildTreeCompleted -= buildTreeCompletedHandler;
+                    ElementPhasingManager.ProcessedCalls?.Clear();
+                });
+            }
+        }
+
         [TestMethod]
         public void ValidateXBindWithoutPhasing()
         {
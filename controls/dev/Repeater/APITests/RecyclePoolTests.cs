@@ -12,6 +12,7 @@ using Microsoft.UI.Xaml.Controls;
 using Microsoft.UI.Xaml.Markup;
 using Microsoft.UI.Xaml.Media;
 using Common;
+using Microsoft.UI.Private.Controls;
 
 using WEX.TestExecution;
 using WEX.TestExecution.Markup;
@@ -199,5 +200,96 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
                 Verify.IsNull(recycled2.Parent);
             });
         }
+
+        [TestMethod]
+        public void ValidateLimitsEvictLeastRecentlyRecycledElements()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const string key1 = "Key1";
+                const string key2 = "Key2";
+
+                RecyclePool pool = new RecyclePool();
+                RepeaterTestHooks.SetRecyclePoolLimits(pool, 2 /* maxElementsPerKey */, 3 /* maxElements */);
+
+                var parent = new StackPanel();
+                Content = parent;
+                Content.UpdateLayout();
+
+                var buttons = Enumerable.Range(0, 3).Select(i => new Button()).ToList();
+                foreach (var button in buttons)
+                {
+                    parent.Children.Add(button);
+                    pool.PutElement(button, key1, parent);
+                }
+
+                // The per-key limit evicts the oldest element. Its removal from the owner is deferred
+                // until the owner's layout has completed, since eviction can happen mid-layout.
+                Verify.AreEqual(2, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+                Verify.AreEqual(1UL, RepeaterTestHooks.GetRecyclePoolEvictionCount(pool));
+                Verify.AreSame(parent, buttons[0].Parent);
+                Verify.AreEqual(3, parent.Children.Count);
+
+                Content.UpdateLayout();
+                Verify.IsNull(buttons[0].Parent);
+                Verify.AreEqual(2, parent.Children.Count);
+
+                var textBlocks = Enumerable.Range(0, 2).Select(i => new TextBlock()).ToList();
+                foreach (var textBlock in textBlocks)
+                {
+                    pool.PutElement(textBlock, key2);
+                }
+
+                // The global limit evicts the least recently recycled element across keys.
+                Verify.AreEqual(3, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+                Verify.AreEqual(2UL, RepeaterTestHooks.GetRecyclePoolEvictionCount(pool));
+                Content.UpdateLayout();
+                Verify.IsNull(buttons[1].Parent);
+
+                Verify.AreSame(buttons[2], pool.TryGetElement(key1, parent));
+                Verify.IsNull(pool.TryGetElement(key1, parent));
+                Verify.IsNotNull(pool.TryGetElement(key2));
+                Verify.IsNotNull(pool.TryGetElement(key2));
+
+                Verify.AreEqual(3UL, RepeaterTestHooks.GetRecyclePoolHitCount(pool));
+                Verify.AreEqual(1UL, RepeaterTestHooks.GetRecyclePoolMissCount(pool));
+                Verify.AreEqual(0, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+            });
+        }
+
+        [TestMethod]
+        public void ValidatePreWarmFillsPoolUsedByRepeater()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var itemTemplate = (DataTemplate)XamlReader.Load(
+                    @"<DataTemplate  xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'>
+                         <TextBlock Text='{Binding}' />
+                    </DataTemplate>");
+
+                RepeaterTestHooks.PreWarmRecyclePool(itemTemplate, 10);
+                var pool = RecyclePool.GetPoolInstance(itemTemplate);
+                Verify.IsNotNull(pool);
+                Verify.AreEqual(10, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+
+                // Pre-warming tops up to the target rather than adding more elements.
+                RepeaterTestHooks.PreWarmRecyclePool(itemTemplate, 5);
+                Verify.AreEqual(10, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+
+                var repeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, 5),
+                    ItemTemplate = itemTemplate,
+                };
+
+                Content = repeater;
+                Content.UpdateLayout();
+
+                // The first layout is served entirely from the pre-warmed pool.
+                Verify.AreEqual(5UL, RepeaterTestHooks.GetRecyclePoolHitCount(pool));
+                Verify.AreEqual(0UL, RepeaterTestHooks.GetRecyclePoolMissCount(pool));
+                Verify.AreEqual(5, RepeaterTestHooks.GetRecyclePoolElementCount(pool));
+            });
+        }
     }
 }
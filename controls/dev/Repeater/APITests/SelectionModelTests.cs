@@ -1199,6 +1199,84 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateOverlappingAndAdjacentRangesAreMergedAndSplit()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                SelectionModel selectionModel = new SelectionModel();
+                selectionModel.Source = Enumerable.Range(0, 100).ToList();
+
+                // Overlapping and adjacent ranges must not count indices twice.
+                selectionModel.SelectRange(Path(10), Path(19));
+                selectionModel.SelectRange(Path(15), Path(29));
+                selectionModel.SelectRange(Path(30), Path(39));
+                selectionModel.Select(12);
+                ValidateSelection(selectionModel, Enumerable.Range(10, 30).Select(i => Path(i)).ToList());
+
+                // Deselecting in the middle splits the range.
+                selectionModel.DeselectRange(Path(20), Path(24));
+                ValidateSelection(selectionModel,
+                    Enumerable.Range(10, 10).Concat(Enumerable.Range(25, 15)).Select(i => Path(i)).ToList());
+
+                // Deselecting across a gap trims both sides.
+                selectionModel.DeselectRange(Path(18), Path(26));
+                ValidateSelection(selectionModel,
+                    Enumerable.Range(10, 8).Concat(Enumerable.Range(27, 13)).Select(i => Path(i)).ToList());
+
+                // Filling the gap merges the ranges back together.
+                selectionModel.SelectRange(Path(18), Path(26));
+                ValidateSelection(selectionModel, Enumerable.Range(10, 30).Select(i => Path(i)).ToList());
+            });
+        }
+
+        [TestMethod]
+        [TestProperty("Description", "Measures SelectAll, shift-range select and deselecting in the middle on a 1M item source.")]
+        public void LargeSelectionBenchmark()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int itemCount = 1000000;
+                SelectionModel selectionModel = new SelectionModel();
+                selectionModel.Source = Enumerable.Range(0, itemCount).ToList();
+
+                var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+                selectionModel.SelectAllFlat();
+                stopwatch.Stop();
+                Log.Comment(string.Format("SelectAllFlat over {0} items: {1} ms", itemCount, stopwatch.ElapsedMilliseconds));
+                Verify.AreEqual(itemCount, selectionModel.SelectedIndices.Count);
+
+                stopwatch.Restart();
+                for (int i = 1; i < 1000; i++)
+                {
+                    selectionModel.Deselect(i * 1000);
+                }
+                stopwatch.Stop();
+                Log.Comment(string.Format("Deselect 999 items in the middle: {0} ms", stopwatch.ElapsedMilliseconds));
+                Verify.AreEqual(itemCount - 999, selectionModel.SelectedIndices.Count);
+                Verify.IsFalse(selectionModel.IsSelected(500000).Value);
+                Verify.IsTrue(selectionModel.IsSelected(500001).Value);
+                Verify.AreEqual(1001, selectionModel.SelectedIndices[1000].GetAt(0));
+
+                selectionModel.ClearSelection();
+                selectionModel.Select(0);
+
+                stopwatch.Restart();
+                selectionModel.SelectRangeFromAnchor(itemCount - 1);
+                stopwatch.Stop();
+                Log.Comment(string.Format("SelectRangeFromAnchor over {0} items: {1} ms", itemCount, stopwatch.ElapsedMilliseconds));
+                Verify.AreEqual(itemCount, selectionModel.SelectedIndices.Count);
+
+                stopwatch.Restart();
+                for (int i = 0; i < 1000; i++)
+                {
+                    Verify.IsTrue(selectionModel.IsSelected(i * 997).Value);
+                }
+                stopwatch.Stop();
+                Log.Comment(string.Format("1000 IsSelected lookups: {0} ms", stopwatch.ElapsedMilliseconds));
+            });
+        }
+
         private void Select(SelectionModel manager, int index, bool select)
         {
             Log.Comment((select ? "Selecting " : "DeSelecting ") + index);
@@ -528,6 +528,103 @@ namespace Microsoft.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        [TestProperty("Description", "Validates that the cache buffer is shifted towards the scrolling direction during inertia and split evenly again once the view is idle.")]
+        public void ValidateVelocityAwareCacheBuffer()
+        {
+            var scrollPresenter = (ScrollPresenter)null;
+            var repeater = (ItemsRepeater)null;
+            var visibleRects = new List<Rect>();
+            var realizationRects = new List<Rect>();
+            var fullCacheEvent = new ManualResetEvent(initialState: false);
+            var scrollCompletedEvent = new AutoResetEvent(false);
+            bool isVelocityAwareCacheEnabled = RepeaterTestHooks.GetIsVelocityAwareCacheEnabled();
+
+            try
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.SetIsVelocityAwareCacheEnabled(true);
+
+                    scrollPresenter = new ScrollPresenter {
+                        Width = 400,
+                        Height = 400
+                    };
+
+                    var layout = new MockVirtualizingLayout {
+                        MeasureLayoutFunc = (availableSize, context) =>
+                        {
+                            visibleRects.Add(context.VisibleRect);
+                            realizationRects.Add(context.RealizationRect);
+
+                            if (context.RealizationRect.Height == scrollPresenter.Height * (repeater.VerticalCacheLength + 1))
+                            {
+                                fullCacheEvent.Set();
+                            }
+
+                            return new Size(400, 40000);
+                        }
+                    };
+
+                    repeater = new ItemsRepeater() {
+                        Layout = layout
+                    };
+
+                    scrollPresenter.Content = repeater;
+                    scrollPresenter.ScrollCompleted += (ScrollPresenter sender, ScrollingScrollCompletedEventArgs args) =>
+                    {
+                        scrollCompletedEvent.Set();
+                    };
+                    Content = scrollPresenter;
+                });
+
+                if (!fullCacheEvent.WaitOne(DefaultWaitTimeInMS)) Verify.Fail("Cache full size never reached.");
+                IdleSynchronizer.Wait();
+
+                RunOnUIThread.Execute(() =>
+                {
+                    visibleRects.Clear();
+                    realizationRects.Clear();
+
+                    Log.Comment("Flinging downwards.");
+                    scrollPresenter.AddScrollVelocity(new Vector2(0.0f, 4000.0f), null);
+                });
+
+                Verify.IsTrue(scrollCompletedEvent.WaitOne(DefaultWaitTimeInMS));
+                IdleSynchronizer.Wait();
+
+                RunOnUIThread.Execute(() =>
+                {
+                    bool sawBiasedWindow = false;
+
+                    for (int i = 0; i < realizationRects.Count - 1; ++i)
+                    {
+                        double topBuffer = visibleRects[i].Y - realizationRects[i].Y;
+                        double bottomBuffer = realizationRects[i].Bottom - visibleRects[i].Bottom;
+
+                        Log.Comment("VisibleRect: {0}, RealizationRect: {1}, top buffer: {2}, bottom buffer: {3}", visibleRects[i], realizationRects[i], topBuffer, bottomBuffer);
+
+                        Verify.IsLessThanOrEqual(topBuffer, bottomBuffer + 0.001);
+                        sawBiasedWindow |= bottomBuffer > topBuffer;
+                    }
+
+                    Verify.IsTrue(sawBiasedWindow, "Expected the cache buffer to favor the scrolling direction during inertia.");
+
+                    Log.Comment("Validate that the cache buffer is split evenly once the view is idle.");
+                    Rect lastVisibleRect = visibleRects.Last();
+                    Rect lastRealizationRect = realizationRects.Last();
+                    Verify.IsLessThan(Math.Abs((lastVisibleRect.Y - lastRealizationRect.Y) - (lastRealizationRect.Bottom - lastVisibleRect.Bottom)), 0.001);
+                });
+            }
+            finally
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    RepeaterTestHooks.SetIsVelocityAwareCacheEnabled(isVelocityAwareCacheEnabled);
+                });
+            }
+        }
+
         [TestMethod]
         [TestProperty("Ignore", "True")] // Disabled as per tracking issue #3125 and internal issue 18866003
         public void ValidateLoadUnload()
@@ -8,18 +8,74 @@
 #include "RepeaterTestHooks.h"
 #include "MuxcTraceLogging.h"
 
-double BuildTreeScheduler::m_budgetInMs = 40.0;
+thread_local double BuildTreeScheduler::m_budgetInMs = BuildTreeScheduler::c_maxBudgetInMs;
 thread_local QPCTimer BuildTreeScheduler::m_timer{};
-thread_local std::vector<WorkInfo> BuildTreeScheduler::m_pendingWork{};
+thread_local QPCTimer BuildTreeScheduler::m_frameTimer{};
+thread_local std::vector<BuildTreeScheduler::HeapEntry> BuildTreeScheduler::m_pendingHeap{};
+thread_local std::unordered_map<BuildTreeScheduler::WorkId, WorkInfo> BuildTreeScheduler::m_pendingWork{};
+thread_local BuildTreeScheduler::WorkId BuildTreeScheduler::m_nextWorkId{ BuildTreeScheduler::InvalidWorkId + 1 };
 thread_local winrt::event_token BuildTreeScheduler::m_renderingToken{};
+thread_local uint64_t BuildTreeScheduler::m_executedWorkCount{};
+thread_local uint64_t BuildTreeScheduler::m_deferredWorkCount{};
+thread_local uint64_t BuildTreeScheduler::m_droppedWorkCount{};
 
-void BuildTreeScheduler::RegisterWork(int priority, const std::function<void()>& workFunc)
+namespace
+{
+    // std heap functions build a max-heap, so order by descending priority value and then by
+    // descending id to pop the lowest priority value first, in registration order.
+    struct HeapEntryComparer
+    {
+        template <typename T>
+        bool operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs.m_priority != rhs.m_priority ? lhs.m_priority > rhs.m_priority : lhs.m_workId > rhs.m_workId;
+        }
+    };
+}
+
+BuildTreeScheduler::WorkId BuildTreeScheduler::RegisterWork(int priority, const std::function<void()>& workFunc)
 {
     MUX_ASSERT(priority >= 0);
     MUX_ASSERT(workFunc != nullptr);
 
     QueueTick();
-    m_pendingWork.push_back(WorkInfo(priority, workFunc));
+
+    const WorkId workId = m_nextWorkId++;
+    m_pendingWork.emplace(workId, WorkInfo(priority, workFunc));
+    PushHeapEntry(priority, workId);
+    return workId;
+}
+
+// Removes queued work that has not run yet. Returns false if the work already ran or was cancelled.
+bool BuildTreeScheduler::CancelWork(WorkId workId)
+{
+    if (m_pendingWork.erase(workId) > 0)
+    {
+        // The heap entry is discarded lazily when it reaches the top.
+        m_droppedWorkCount++;
+        return true;
+    }
+    return false;
+}
+
+// Moves queued work to a new priority. Returns false if the work already ran or was cancelled.
+bool BuildTreeScheduler::UpdateWorkPriority(WorkId workId, int priority)
+{
+    MUX_ASSERT(priority >= 0);
+
+    const auto it = m_pendingWork.find(workId);
+    if (it == m_pendingWork.end())
+    {
+        return false;
+    }
+
+    if (it->second.Priority() != priority)
+    {
+        it->second.Priority(priority);
+        // The entry with the old priority becomes stale.
+        PushHeapEntry(priority, workId);
+    }
+    return true;
 }
 
 bool BuildTreeScheduler::ShouldYield()
@@ -27,26 +83,76 @@ bool BuildTreeScheduler::ShouldYield()
     return m_timer.DurationInMilliSeconds() > m_budgetInMs;
 }
 
+void BuildTreeScheduler::ResetCounters()
+{
+    m_executedWorkCount = 0;
+    m_deferredWorkCount = 0;
+    m_droppedWorkCount = 0;
+}
+
+void BuildTreeScheduler::PushHeapEntry(int priority, WorkId workId)
+{
+    m_pendingHeap.push_back(HeapEntry{ priority, workId });
+    std::push_heap(m_pendingHeap.begin(), m_pendingHeap.end(), HeapEntryComparer());
+}
+
+void BuildTreeScheduler::AdaptBudget(int frameDurationInMs)
+{
+    if (frameDurationInMs > c_targetFrameDurationInMs * c_longFrameFactor)
+    {
+        // We are dropping frames, give more of the next frame back to rendering and input.
+        m_budgetInMs = std::max(c_minBudgetInMs, m_budgetInMs / 2.0);
+    }
+    else
+    {
+        m_budgetInMs = std::min(c_maxBudgetInMs, m_budgetInMs + c_budgetGrowthInMs);
+    }
+}
+
 void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::IInspectable&)
 {
+    AdaptBudget(m_frameTimer.DurationInMilliSeconds());
+    m_frameTimer.Reset();
+
     const bool budgetReached = ShouldYield();
-    if (!budgetReached && m_pendingWork.size() > 0)
+    if (!budgetReached)
     {
-        // Sort in descending order of priority and work from the end of the list to avoid moving around during erase.
-        std::sort(m_pendingWork.begin(), m_pendingWork.end(), [](const auto& lhs, const auto& rhs) { return lhs.Priority() > rhs.Priority(); });
-        int currentIndex = static_cast<int>(m_pendingWork.size()) - 1;
-
-        do
+        while (!m_pendingHeap.empty())
         {
-            m_pendingWork[currentIndex].InvokeWorkFunc();
-            m_pendingWork.erase(m_pendingWork.begin() + currentIndex);
-        } while (--currentIndex >= 0 && !ShouldYield());
+            std::pop_heap(m_pendingHeap.begin(), m_pendingHeap.end(), HeapEntryComparer());
+            const HeapEntry entry = m_pendingHeap.back();
+            m_pendingHeap.pop_back();
+
+            const auto it = m_pendingWork.find(entry.m_workId);
+            if (it == m_pendingWork.end() || it->second.Priority() != entry.m_priority)
+            {
+                // Cancelled or reprioritized.
+                continue;
+            }
+
+            // Remove the work before invoking it since the callback commonly registers new work.
+            const WorkInfo workInfo = it->second;
+            m_pendingWork.erase(it);
+            workInfo.InvokeWorkFunc();
+            m_executedWorkCount++;
+
+            if (ShouldYield())
+            {
+                break;
+            }
+        }
     }
 
     if (m_pendingWork.empty())
     {
+        m_pendingHeap.clear();
+
         TraceLoggingProviderWrite(
             XamlTelemetryLogging, "BuildTreeScheduler_OutOfWork",
+            TraceLoggingUInt64(m_executedWorkCount, "ExecutedWorkCount"),
+            TraceLoggingUInt64(m_deferredWorkCount, "DeferredWorkCount"),
+            TraceLoggingUInt64(m_droppedWorkCount, "DroppedWorkCount"),
+            TraceLoggingFloat64(m_budgetInMs, "BudgetInMs"),
             TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
 
         // No more pending work, unhook from rendering event since being hooked up will case wux to try to
@@ -55,6 +161,10 @@ void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::II
         m_renderingToken.value = 0;
         RepeaterTestHooks::NotifyBuildTreeCompleted();
     }
+    else
+    {
+        m_deferredWorkCount += m_pendingWork.size();
+    }
 
     // Reset the timer so it snaps the time just before rendering
     m_timer.Reset();
@@ -65,5 +175,7 @@ void  BuildTreeScheduler::QueueTick()
     if (m_renderingToken.value == 0)
     {
         m_renderingToken = winrt::Microsoft::UI::Xaml::Media::CompositionTarget::Rendering(OnRendering);
+        // The first tick after being idle must not be mistaken for a long frame.
+        m_frameTimer.Reset();
     }
 }
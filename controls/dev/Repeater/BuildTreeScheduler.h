@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include "QPCTimer.h"
+
 struct WorkInfo
 {
     WorkInfo(int priority, const std::function<void()>& workFunc) :
@@ -11,6 +14,7 @@ struct WorkInfo
     {}
 
     int Priority() const { return m_priority; }
+    void Priority(int priority) { m_priority = priority; }
     void InvokeWorkFunc() const { m_workFunc(); }
 
 private:
@@ -18,20 +22,58 @@ private:
     std::function<void()> m_workFunc;
 };
 
-// High performance time management using QueryPerformanceCounter
+// Frame-budgeted scheduler for deferred ItemsRepeater work such as x:Phase bindings.
+// Pending work is kept in a min-heap keyed on (priority, registration order) and drained on
+// CompositionTarget.Rendering until the per-frame budget is exhausted. The budget shrinks when
+// frames run long and grows back while frames are on time. Work can be cancelled or
+// reprioritized through the id returned by RegisterWork.
 class BuildTreeScheduler final
 {
 public:
-    static void RegisterWork(int priority, const std::function<void()>& workFunc);
+    using WorkId = uint64_t;
+    static constexpr WorkId InvalidWorkId{ 0 };
+
+    static WorkId RegisterWork(int priority, const std::function<void()>& workFunc);
+    static bool CancelWork(WorkId workId);
+    static bool UpdateWorkPriority(WorkId workId, int priority);
     static bool ShouldYield();
 
+    static double BudgetInMs() { return m_budgetInMs; }
+    static uint64_t ExecutedWorkCount() { return m_executedWorkCount; }
+    static uint64_t DeferredWorkCount() { return m_deferredWorkCount; }
+    static uint64_t DroppedWorkCount() { return m_droppedWorkCount; }
+    static void ResetCounters();
+
 private:
+    struct HeapEntry
+    {
+        int m_priority;
+        WorkId m_workId;
+    };
+
     static void OnRendering(const winrt::IInspectable& sender, const winrt::IInspectable& args);
     static void QueueTick();
+    static void PushHeapEntry(int priority, WorkId workId);
+    static void AdaptBudget(int frameDurationInMs);
+
+    // Frames longer than c_targetFrameDurationInMs * c_longFrameFactor shrink the budget.
+    static constexpr double c_targetFrameDurationInMs{ 1000.0 / 60.0 };
+    static constexpr double c_longFrameFactor{ 1.5 };
+    static constexpr double c_minBudgetInMs{ 4.0 };
+    static constexpr double c_maxBudgetInMs{ 40.0 };
+    static constexpr double c_budgetGrowthInMs{ 2.0 };
 
-    static double m_budgetInMs;
+    static thread_local double m_budgetInMs;
 
     static thread_local QPCTimer m_timer;
-    static thread_local std::vector<WorkInfo> m_pendingWork;
+    static thread_local QPCTimer m_frameTimer;
+    // Entries whose id is no longer in m_pendingWork, or whose priority no longer matches, are stale and skipped when popped.
+    static thread_local std::vector<HeapEntry> m_pendingHeap;
+    static thread_local std::unordered_map<WorkId, WorkInfo> m_pendingWork;
+    static thread_local WorkId m_nextWorkId;
     static thread_local winrt::event_token m_renderingToken;
+
+    static thread_local uint64_t m_executedWorkCount;
+    static thread_local uint64_t m_deferredWorkCount;
+    static thread_local uint64_t m_droppedWorkCount;
 };
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "ItemsRepeater.common.h"
 #include "ElementManager.h"
 
+/* static */
+bool ElementManager::s_isCollectionChangeCoalescingEnabled{ true };
+
 void ElementManager::SetContext(const winrt::VirtualizingLayoutContext& virtualContext)
 {
     m_context = virtualContext;
@@ -15,6 +18,8 @@ void ElementManager::OnBeginMeasure(const ScrollOrientation& orientation)
 {
     MUX_ASSERT(m_useLayoutBounds);
 
+    ApplyPendingChanges();
+
     if (m_context)
     {
         if (IsVirtualizingContext())
@@ -51,7 +56,7 @@ int ElementManager::GetFirstRealizedDataIndex() const
 int ElementManager::GetRealizedElementCount() const
 {
     return IsVirtualizingContext() ?
-        static_cast<int>(m_realizedElements.size()) : m_context.ItemCount();
+        GetRealizedSlotCount() : m_context.ItemCount();
 }
 
 winrt::UIElement ElementManager::GetAt(int realizedIndex)
@@ -59,6 +64,8 @@ winrt::UIElement ElementManager::GetAt(int realizedIndex)
     winrt::UIElement element{ nullptr };
     if (IsVirtualizingContext())
     {
+        ApplyPendingChanges();
+
         if (!m_realizedElements[realizedIndex])
         {
             // Sentinel. Create the element now since we need it.
@@ -85,6 +92,8 @@ void ElementManager::Add(const winrt::UIElement& element, int dataIndex)
 {
     MUX_ASSERT(IsVirtualizingContext());
 
+    ApplyPendingChanges();
+
     if (m_realizedElements.size() == 0)
     {
         m_firstRealizedDataIndex = dataIndex;
@@ -94,13 +103,16 @@ void ElementManager::Add(const winrt::UIElement& element, int dataIndex)
 
     if (m_useLayoutBounds)
     {
-        m_realizedElementLayoutBounds.emplace_back(winrt::Rect());
+        m_realizedElementLayoutBounds.push_back(winrt::Rect());
     }
 }
 
 void ElementManager::Insert(int realizedIndex, int dataIndex, const winrt::UIElement& element)
 {
     MUX_ASSERT(IsVirtualizingContext());
+
+    ApplyPendingChanges();
+
     if (realizedIndex == 0)
     {
         m_firstRealizedDataIndex = dataIndex;
@@ -111,7 +123,7 @@ void ElementManager::Insert(int realizedIndex, int dataIndex, const winrt::UIEle
     if (m_useLayoutBounds)
     {
         // Set bounds to an invalid rect since we do not know it yet.
-        m_realizedElementLayoutBounds.insert(m_realizedElementLayoutBounds.begin() + realizedIndex, InvalidBounds);
+        m_realizedElementLayoutBounds.insert(realizedIndex, InvalidBounds);
     }
 }
 
@@ -123,24 +135,28 @@ void ElementManager::ClearRealizedRange(int realizedIndex, int count)
         // Clear from the edges so that ItemsRepeater can optimize on maintaining 
         // realized indices without walking through all the children every time.
         const int index = realizedIndex == 0 ? realizedIndex + i : (realizedIndex + count - 1) - i;
-        if (auto elementRef = m_realizedElements[index])
-        {
-            m_context.RecycleElement(elementRef.get());
-        }
+        RecycleRealizedElement(index);
     }
 
-    const int endIndex = realizedIndex + count;
-    m_realizedElements.erase(m_realizedElements.begin() + realizedIndex, m_realizedElements.begin() + endIndex);
-
-    if (m_useLayoutBounds)
+    if (m_hasPendingChanges)
     {
-        m_realizedElementLayoutBounds.erase(m_realizedElementLayoutBounds.begin() + realizedIndex, m_realizedElementLayoutBounds.begin() + endIndex);
+        RecordPendingChange(realizedIndex, count, 0 /* insertedCount */);
+    }
+    else
+    {
+        const int endIndex = realizedIndex + count;
+        m_realizedElements.erase(m_realizedElements.begin() + realizedIndex, m_realizedElements.begin() + endIndex);
+
+        if (m_useLayoutBounds)
+        {
+            m_realizedElementLayoutBounds.erase(realizedIndex, endIndex);
+        }
     }
 
     if (realizedIndex == 0)
     {
         m_firstRealizedDataIndex =
-            m_realizedElements.size() == 0 ?
+            GetRealizedSlotCount() == 0 ?
             -1 :
             m_firstRealizedDataIndex + count;
     }
@@ -148,6 +164,8 @@ void ElementManager::ClearRealizedRange(int realizedIndex, int count)
 
 void ElementManager::DiscardElementsOutsideWindow(bool forward, int startIndex)
 {
+    ApplyPendingChanges();
+
     // Remove layout elements that are outside the realized range.
     if (IsDataIndexRealized(startIndex))
     {
@@ -193,6 +211,12 @@ winrt::Rect ElementManager::GetLayoutBoundsForRealizedIndex(int realizedIndex) c
 {
     MUX_ASSERT(m_useLayoutBounds);
 
+    if (m_hasPendingChanges)
+    {
+        const int slot = GetPendingSlot(realizedIndex);
+        return slot >= 0 ? m_realizedElementLayoutBounds[slot] : InvalidBounds;
+    }
+
     return m_realizedElementLayoutBounds[realizedIndex];
 }
 
@@ -200,14 +224,22 @@ void ElementManager::SetLayoutBoundsForRealizedIndex(int realizedIndex, const wi
 {
     MUX_ASSERT(m_useLayoutBounds);
 
-    m_realizedElementLayoutBounds[realizedIndex] = bounds;
+    ApplyPendingChanges();
+
+    m_realizedElementLayoutBounds.Set(realizedIndex, bounds);
 }
 
 bool ElementManager::IsLayoutBoundsForRealizedIndexSet(int realizedIndex) const
 {
     MUX_ASSERT(realizedIndex >= 0 && realizedIndex < GetRealizedElementCount());
 
-    return m_realizedElementLayoutBounds[realizedIndex] != InvalidBounds;
+    if (m_hasPendingChanges)
+    {
+        const int slot = GetPendingSlot(realizedIndex);
+        return slot >= 0 && m_realizedElementLayoutBounds.IsSet(slot);
+    }
+
+    return m_realizedElementLayoutBounds.IsSet(realizedIndex);
 }
 
 bool ElementManager::IsDataIndexRealized(int index) const
@@ -266,7 +298,7 @@ bool ElementManager::IsWindowConnected(const winrt::Rect& window, const ScrollOr
     MUX_ASSERT(m_useLayoutBounds);
 
     bool intersects = false;
-    if (m_realizedElementLayoutBounds.size() > 0)
+    if (GetRealizedSlotCount() > 0)
     {
         const auto firstElementBounds = GetLayoutBoundsForRealizedIndex(0);
         const auto lastElementBounds = GetLayoutBoundsForRealizedIndex(GetRealizedElementCount() - 1);
@@ -291,8 +323,10 @@ bool ElementManager::IsWindowConnected(const winrt::Rect& window, const ScrollOr
 void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, winrt::NotifyCollectionChangedEventArgs const& args)
 {
     MUX_ASSERT(IsVirtualizingContext());
-    if (m_realizedElements.size() > 0)
+    if (GetRealizedSlotCount() > 0)
     {
+        BeginPendingChanges();
+
         switch (args.Action())
         {
         case winrt::NotifyCollectionChangedAction::Add:
@@ -321,11 +355,7 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
                 const auto startRealizedIndex = GetRealizedRangeIndexFromDataIndex(oldStartIndex);
                 for (int realizedIndex = startRealizedIndex; realizedIndex < startRealizedIndex + oldSize; realizedIndex++)
                 {
-                    if (auto elementRef = m_realizedElements[realizedIndex])
-                    {
-                        m_context.RecycleElement(elementRef.get());
-                        m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, nullptr };
-                    }
+                    RecycleRealizedElement(realizedIndex);
                 }
             }
             else
@@ -352,6 +382,11 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
             OnItemsAdded(args.NewStartingIndex(), size);
             break;
         }
+
+        if (!s_isCollectionChangeCoalescingEnabled)
+        {
+            ApplyPendingChanges();
+        }
     }
 }
 
@@ -359,10 +394,30 @@ int ElementManager::GetElementDataIndex(const winrt::UIElement& suggestedAnchor)
 {
     MUX_ASSERT(suggestedAnchor);
     auto it = std::find(m_realizedElements.cbegin(), m_realizedElements.cend(), suggestedAnchor);
-    return
-        it != m_realizedElements.cend() ?
-        GetDataIndexFromRealizedRangeIndex(static_cast<int>(std::distance(m_realizedElements.cbegin(), it))) :
-        -1;
+    if (it == m_realizedElements.cend())
+    {
+        return -1;
+    }
+
+    int realizedIndex = static_cast<int>(std::distance(m_realizedElements.cbegin(), it));
+    if (m_hasPendingChanges)
+    {
+        // Walk the slot forward through the recorded changes.
+        for (const auto& change : m_pendingChanges)
+        {
+            if (realizedIndex >= change.realizedIndex)
+            {
+                if (realizedIndex < change.realizedIndex + change.removedCount)
+                {
+                    return -1;
+                }
+
+                realizedIndex += change.insertedCount - change.removedCount;
+            }
+        }
+    }
+
+    return GetDataIndexFromRealizedRangeIndex(realizedIndex);
 }
 
 int ElementManager::GetDataIndexFromRealizedRangeIndex(int rangeIndex) const
@@ -408,24 +463,10 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     // layout pass).
 
     const int realizedRangeSize = GetRealizedElementCount();
-    int frontCutoffIndex = -1;
-    int backCutoffIndex = realizedRangeSize;
-
-    for (int i = 0;
-        i < realizedRangeSize &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        ++i)
-    {
-        ++frontCutoffIndex;
-    }
-
-    for (int i = realizedRangeSize - 1;
-        i >= 0 &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        --i)
-    {
-        --backCutoffIndex;
-    }
+    const float windowStart = orientation == ScrollOrientation::Vertical ? window.Y : window.X;
+    const float windowEnd = orientation == ScrollOrientation::Vertical ? window.Y + window.Height : window.X + window.Width;
+    const int frontCutoffIndex = m_realizedElementLayoutBounds.FindFirstIntersecting(windowStart, windowEnd, orientation) - 1;
+    const int backCutoffIndex = m_realizedElementLayoutBounds.FindLastIntersecting(windowStart, windowEnd, orientation) + 1;
 
     if (backCutoffIndex < realizedRangeSize - 1)
     {
@@ -438,19 +479,10 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     }
 }
 
-/* static */
-bool ElementManager::Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation)
-{
-    const auto lhsStart = orientation == ScrollOrientation::Vertical ? lhs.Y : lhs.X;
-    const auto lhsEnd = orientation == ScrollOrientation::Vertical ? lhs.Y + lhs.Height : lhs.X + lhs.Width;
-    const auto rhsStart = orientation == ScrollOrientation::Vertical ? rhs.Y : rhs.X;
-    const auto rhsEnd = orientation == ScrollOrientation::Vertical ? rhs.Y + rhs.Height : rhs.X + rhs.Width;
-
-    return lhsEnd >= rhsStart && lhsStart <= rhsEnd;
-}
-
 void ElementManager::OnItemsAdded(int index, int count)
 {
+    MUX_ASSERT(m_hasPendingChanges);
+
     // Using the old indices here (before it was updated by the collection change)
     // if the insert data index is between the first and last realized data index, we need
     // to insert items.
@@ -460,16 +492,11 @@ void ElementManager::OnItemsAdded(int index, int count)
         newStartingIndex <= lastRealizedDataIndex)
     {
         // Inserted within the realized range
+        // Record null (sentinel) slots here instead of elements, that way we dont 
+        // end up creating a lot of elements only to be thrown out in the next layout.
+        // This is to keep the contiguousness of the mapping.
         const int insertRangeStartIndex = newStartingIndex - m_firstRealizedDataIndex;
-        for (int i = 0; i < count; i++)
-        {
-            // Insert null (sentinel) here instead of an element, that way we dont 
-            // end up creating a lot of elements only to be thrown out in the next layout.
-            const int insertRangeIndex = insertRangeStartIndex + i;
-            const int dataIndex = newStartingIndex + i;
-            // This is to keep the contiguousness of the mapping
-            Insert(insertRangeIndex, dataIndex, nullptr);
-        }
+        RecordPendingChange(insertRangeStartIndex, 0 /* removedCount */, count);
     }
     else if (index <= m_firstRealizedDataIndex)
     {
@@ -481,7 +508,7 @@ void ElementManager::OnItemsAdded(int index, int count)
 
 void ElementManager::OnItemsRemoved(int index, int count)
 {
-    const int lastRealizedDataIndex = m_firstRealizedDataIndex + static_cast<int>(m_realizedElements.size()) - 1;
+    const int lastRealizedDataIndex = m_firstRealizedDataIndex + GetRealizedSlotCount() - 1;
     const int startIndex = std::max(m_firstRealizedDataIndex, index);
     const int endIndex = std::min(lastRealizedDataIndex, index + count - 1);
     const bool removeAffectsFirstRealizedDataIndex = (index <= m_firstRealizedDataIndex);
@@ -498,6 +525,188 @@ void ElementManager::OnItemsRemoved(int index, int count)
     }
 }
 
+int ElementManager::GetRealizedSlotCount() const
+{
+    return m_hasPendingChanges ? m_pendingRealizedCount : static_cast<int>(m_realizedElements.size());
+}
+
+// Maps a currently realized index back to its position in m_realizedElements by
+// undoing the recorded changes, newest first. Returns -1 for a sentinel inserted
+// since the last layout pass.
+int ElementManager::GetPendingSlot(int realizedIndex) const
+{
+    MUX_ASSERT(m_hasPendingChanges);
+
+    for (auto it = m_pendingChanges.crbegin(); it != m_pendingChanges.crend(); ++it)
+    {
+        if (realizedIndex >= it->realizedIndex)
+        {
+            if (realizedIndex < it->realizedIndex + it->insertedCount)
+            {
+                return -1;
+            }
+
+            realizedIndex += it->removedCount - it->insertedCount;
+        }
+    }
+
+    return realizedIndex;
+}
+
+void ElementManager::RecordPendingChange(int realizedIndex, int removedCount, int insertedCount)
+{
+    MUX_ASSERT(m_hasPendingChanges);
+
+    m_pendingRealizedCount += insertedCount - removedCount;
+
+    // Extend the last change when this one continues it, so that adding or removing
+    // items one at a time in the same spot still leaves a single recorded range.
+    if (!m_pendingChanges.empty())
+    {
+        auto& last = m_pendingChanges.back();
+        if (removedCount == 0 &&
+            realizedIndex >= last.realizedIndex &&
+            realizedIndex <= last.realizedIndex + last.insertedCount)
+        {
+            last.insertedCount += insertedCount;
+            return;
+        }
+
+        if (insertedCount == 0 &&
+            realizedIndex == last.realizedIndex + last.insertedCount)
+        {
+            last.removedCount += removedCount;
+            return;
+        }
+    }
+
+    m_pendingChanges.push_back({ realizedIndex, removedCount, insertedCount });
+}
+
+void ElementManager::RecycleRealizedElement(int realizedIndex)
+{
+    const int slot = m_hasPendingChanges ? GetPendingSlot(realizedIndex) : realizedIndex;
+    if (slot >= 0)
+    {
+        if (auto elementRef = m_realizedElements[slot])
+        {
+            m_context.RecycleElement(elementRef.get());
+            m_realizedElements[slot] = tracker_ref<winrt::UIElement>{ m_owner, nullptr };
+        }
+    }
+}
+
+void ElementManager::BeginPendingChanges()
+{
+    if (!m_hasPendingChanges)
+    {
+        m_pendingRealizedCount = static_cast<int>(m_realizedElements.size());
+        m_hasPendingChanges = true;
+    }
+}
+
+// Rebuilds the realized element and bounds vectors from the ranges recorded by
+// DataSourceChanged. The ranges are first folded into runs of consecutive slots,
+// which only depends on the number of changes, and then every surviving entry is
+// moved once regardless of how many collection changes happened since the last call.
+void ElementManager::ApplyPendingChanges()
+{
+    if (m_hasPendingChanges)
+    {
+        m_hasPendingChanges = false;
+
+        struct SlotRun
+        {
+            int firstSlot; // -1 for a run of sentinels.
+            int count;
+        };
+
+        std::vector<SlotRun> runs;
+        if (!m_realizedElements.empty())
+        {
+            runs.push_back({ 0, static_cast<int>(m_realizedElements.size()) });
+        }
+
+        // Returns the index of the run starting at realizedIndex, splitting the run
+        // containing it if needed.
+        auto splitRunsAt = [&runs](int realizedIndex)
+        {
+            int runStartIndex = 0;
+            for (size_t i = 0; i < runs.size(); i++)
+            {
+                const auto run = runs[i];
+                if (realizedIndex == runStartIndex)
+                {
+                    return i;
+                }
+
+                if (realizedIndex < runStartIndex + run.count)
+                {
+                    const int headCount = realizedIndex - runStartIndex;
+                    runs[i].count = headCount;
+                    runs.insert(runs.begin() + i + 1, { run.firstSlot >= 0 ? run.firstSlot + headCount : -1, run.count - headCount });
+                    return i + 1;
+                }
+
+                runStartIndex += run.count;
+            }
+
+            return runs.size();
+        };
+
+        for (const auto& change : m_pendingChanges)
+        {
+            const auto first = splitRunsAt(change.realizedIndex);
+            const auto last = splitRunsAt(change.realizedIndex + change.removedCount);
+            runs.erase(runs.begin() + first, runs.begin() + last);
+            if (change.insertedCount > 0)
+            {
+                runs.insert(runs.begin() + first, { -1, change.insertedCount });
+            }
+        }
+
+        std::vector<tracker_ref<winrt::UIElement>> realizedElements;
+        RealizedElementLayoutBounds realizedElementLayoutBounds;
+        realizedElements.reserve(m_pendingRealizedCount);
+        if (m_useLayoutBounds)
+        {
+            realizedElementLayoutBounds.reserve(m_pendingRealizedCount);
+        }
+
+        for (const auto& run : runs)
+        {
+            for (int i = 0; i < run.count; i++)
+            {
+                if (run.firstSlot >= 0)
+                {
+                    const int slot = run.firstSlot + i;
+                    realizedElements.emplace_back(std::move(m_realizedElements[slot]));
+                    if (m_useLayoutBounds)
+                    {
+                        realizedElementLayoutBounds.push_back(m_realizedElementLayoutBounds[slot]);
+                    }
+                }
+                else
+                {
+                    realizedElements.emplace_back(tracker_ref<winrt::UIElement>{ m_owner, nullptr });
+                    if (m_useLayoutBounds)
+                    {
+                        // Set bounds to an invalid rect since we do not know it yet.
+                        realizedElementLayoutBounds.push_back(InvalidBounds);
+                    }
+                }
+            }
+        }
+
+        MUX_ASSERT(static_cast<int>(realizedElements.size()) == m_pendingRealizedCount);
+
+        m_realizedElements = std::move(realizedElements);
+        m_realizedElementLayoutBounds = std::move(realizedElementLayoutBounds);
+        m_pendingChanges.clear();
+        m_pendingRealizedCount = 0;
+    }
+}
+
 bool ElementManager::IsVirtualizingContext() const
 {
     if (m_context)
@@ -514,6 +723,8 @@ void ElementManager::LogElementManagerDbg(
     int indent,
     const wstring_view& layoutId)
 {
+    ApplyPendingChanges();
+
     ITEMSREPEATER_TRACE_VERBOSE(nullptr, TRACE_MSG_METH_IND_STR_STR_INT, METH_NAME, this,
         indent, layoutId.data(),
         L"FirstRealizedDataIndex:",
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "OrientationBasedMeasures.h"
+#include "RealizedElementLayoutBounds.h"
 
 // Internal component for layout to keep track of elements and
 // help with collection changes.
@@ -55,22 +56,49 @@ public:
     void LogElementManagerDbg(int indent, const wstring_view& layoutId);
 #endif // DBG
 
+    // When enabled, DataSourceChanged only records the index remapping of the realized range
+    // and the element and bounds vectors are rebuilt once, by the next call that needs them.
+    static bool IsCollectionChangeCoalescingEnabled() { return s_isCollectionChangeCoalescingEnabled; }
+    static void IsCollectionChangeCoalescingEnabled(bool value) { s_isCollectionChangeCoalescingEnabled = value; }
+
 private:
     void DiscardElementsOutsideWindow(const winrt::Rect& window, const ScrollOrientation& orientation);
-    static bool Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation);
 
     void OnItemsAdded(int index, int count);
     void OnItemsRemoved(int index, int count);
 
+    int GetRealizedSlotCount() const;
+    int GetPendingSlot(int realizedIndex) const;
+    void RecordPendingChange(int realizedIndex, int removedCount, int insertedCount);
+    void RecycleRealizedElement(int realizedIndex);
+    void BeginPendingChanges();
+    void ApplyPendingChanges();
+
     bool IsVirtualizingContext() const;
 
     const ITrackerHandleManager* m_owner;
 
     bool m_useLayoutBounds{ false };
     std::vector<tracker_ref<winrt::UIElement>> m_realizedElements;
-    std::vector<winrt::Rect> m_realizedElementLayoutBounds;
+    RealizedElementLayoutBounds m_realizedElementLayoutBounds;
     int m_firstRealizedDataIndex{ -1 };
+
+    // While collection changes are pending, m_realizedElements and m_realizedElementLayoutBounds
+    // still reflect the last layout pass. Each recorded change removed removedCount entries at
+    // realizedIndex and inserted insertedCount sentinels in their place, in the realized index
+    // space as it was when the change happened.
+    struct PendingChange
+    {
+        int realizedIndex;
+        int removedCount;
+        int insertedCount;
+    };
+
+    std::vector<PendingChange> m_pendingChanges;
+    int m_pendingRealizedCount{ 0 };
+    bool m_hasPendingChanges{ false };
+    static bool s_isCollectionChangeCoalescingEnabled;
     winrt::VirtualizingLayoutContext m_context{ nullptr };
 
-    static constexpr winrt::Rect InvalidBounds{ -1.0f, -1.0f, -1.0f, -1.0f };
+    static constexpr winrt::Rect InvalidBounds{ RealizedElementLayoutBounds::InvalidBounds };
 };
@@ -7,6 +7,9 @@
 #include "ItemsRepeater.common.h"
 #include "InspectingDataSource.h"
 
+/* static */
+bool InspectingDataSource::s_isIndexOfCacheEnabled{ true };
+
 InspectingDataSource::InspectingDataSource(const winrt::IInspectable& source)
 {
     if (!source)
@@ -32,10 +35,12 @@ InspectingDataSource::InspectingDataSource(const winrt::IInspectable& source)
     else if (const auto iterable = source.try_as<winrt::IIterable<winrt::IInspectable>>())
     {
         m_vector.set(WrapIterable(iterable));
+        m_isIterableSnapshot = true;
     }
     else if (const auto bindableIterable = source.try_as<winrt::IBindableIterable>())
     {
         m_vector.set(WrapIterable(reinterpret_cast<const winrt::IIterable<winrt::IInspectable>&>(bindableIterable)));
+        m_isIterableSnapshot = true;
     }
     else
     {
@@ -106,6 +111,19 @@ int InspectingDataSource::IndexFromKeyCore(winrt::hstring const& id)
 }
 
 int InspectingDataSource::IndexOfCore(winrt::IInspectable const& value)
+{
+    if (EnsureIndexOfCache())
+    {
+        const auto it = m_indexOfCache.find(GetItemIdentity(value));
+        return it != m_indexOfCache.end() ? it->second : -1;
+    }
+
+    return IndexOfLinear(value);
+}
+
+#pragma endregion
+
+int InspectingDataSource::IndexOfLinear(winrt::IInspectable const& value)
 {
     int index = -1;
     if (m_vectorView)
@@ -127,7 +145,48 @@ int InspectingDataSource::IndexOfCore(winrt::IInspectable const& value)
     return index;
 }
 
-#pragma endregion
+/* static */
+void* InspectingDataSource::GetItemIdentity(winrt::IInspectable const& item)
+{
+    // COM identity is defined by the IUnknown pointer. The reference taken by as() is
+    // released right away; the snapshot keeps the item alive.
+    return item ? winrt::get_abi(item.as<winrt::IUnknown>()) : nullptr;
+}
+
+// Returns true when m_indexOfCache can be used to answer IndexOf, building it on first use.
+// Only the snapshot created by WrapIterable is indexed: it never changes, and its IndexOf
+// compares COM identity, so the index gives the same answers. Sources that are vectors
+// already may compare items by value (e.g. a .NET Equals override), so they are always
+// asked directly.
+bool InspectingDataSource::EnsureIndexOfCache()
+{
+    if (!s_isIndexOfCacheEnabled || !m_isIterableSnapshot)
+    {
+        return false;
+    }
+
+    if (!m_isIndexOfCacheBuilt)
+    {
+        const int size = GetSizeCore();
+        if (size < c_minItemsForIndexOfCache)
+        {
+            return false;
+        }
+
+        m_indexOfCache.reserve(size);
+
+        // Note that GetMany cannot be used here: m_vector may really be an IBindableVector.
+        for (int i = 0; i < size; i++)
+        {
+            // emplace keeps the first occurrence, matching IndexOf semantics.
+            m_indexOfCache.emplace(GetItemIdentity(GetAtCore(i)), i);
+        }
+
+        m_isIndexOfCacheBuilt = true;
+    }
+
+    return true;
+}
 
 winrt::IVector<winrt::IInspectable>
 InspectingDataSource::WrapIterable(const winrt::IIterable<winrt::IInspectable>& iterable)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ItemsSourceView.h"
+#include <unordered_map>
 
 class InspectingDataSource : 
     public winrt::implements<InspectingDataSource, ItemsSourceView>
@@ -24,6 +25,9 @@ public:
     int IndexOfCore(winrt::IInspectable const& value);
 #pragma endregion
 
+    static bool IsIndexOfCacheEnabled() { return s_isIndexOfCacheEnabled; }
+    static void IsIndexOfCacheEnabled(bool isIndexOfCacheEnabled) { s_isIndexOfCacheEnabled = isIndexOfCacheEnabled; }
+
 private:
     winrt::Collections::IVector<winrt::IInspectable>
     WrapIterable(const winrt::Collections::IIterable<winrt::IInspectable>& iterable);
@@ -43,6 +47,10 @@ private:
         const winrt::Collections::IObservableVector<winrt::IInspectable>& sender,
         const winrt::Collections::IVectorChangedEventArgs& e);
 
+    int IndexOfLinear(winrt::IInspectable const& value);
+    bool EnsureIndexOfCache();
+    static void* GetItemIdentity(winrt::IInspectable const& item);
+
     tracker_ref<winrt::Collections::IVector<winrt::IInspectable>> m_vector{ this };
     tracker_ref<winrt::Collections::IVectorView<winrt::IInspectable>> m_vectorView{ this };
 
@@ -52,4 +60,15 @@ private:
     tracker_ref<winrt::IBindableObservableVector> m_bindableObservableVector{ this };
     winrt::event_token m_eventToken{ };
     winrt::IKeyIndexMapping m_uniqueIdMaping{ nullptr };
+
+    // Identity index backing IndexOfCore. Maps the canonical IUnknown of each item to the
+    // index of its first occurrence. Identities are only compared, never dereferenced.
+    std::unordered_map<void*, int> m_indexOfCache{};
+    bool m_isIndexOfCacheBuilt{ false };
+    // m_vector is the private snapshot created by WrapIterable.
+    bool m_isIterableSnapshot{ false };
+
+    static bool s_isIndexOfCacheEnabled;
+    // Below this size a linear IndexOf is cheaper than maintaining the index.
+    static constexpr int c_minItemsForIndexOfCache{ 64 };
 };
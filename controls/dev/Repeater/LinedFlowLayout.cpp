@@ -30,6 +30,9 @@ const int c_maxAnchorIndexRetentionCount{ 10 };
 // An area sized 80% of a scroll viewport made of frozen lines is placed before the displayed lines. An identically sized area is also placed after the displayed lines.
 const double c_frozenLinesRatio{ 0.8 };
 
+// Minimum item count for a fast path layout to only solve the lines up to the realization rect synchronously, and all lines on a worker thread.
+const int c_minItemCountForAsyncFastPathLayout{ 5000 };
+
 #pragma region ILinedFlowLayout
 
 LinedFlowLayout::LinedFlowLayout()
@@ -49,6 +52,7 @@ LinedFlowLayout::~LinedFlowLayout()
     LINEDFLOWLAYOUT_TRACE_INFO(nullptr, TRACE_MSG_METH, METH_NAME, this);
 
     InvalidateMeasureTimerStop(true /*isForDestructor*/);
+    CancelFastPathLayoutSolve();
 }
 
 // Locks the 'itemIndex' into its line until the m_averageItemsPerLine or collection changes,
@@ -235,6 +239,8 @@ void LinedFlowLayout::UninitializeForContextCore(
 
     __super::UninitializeForContextCore(context);
 
+    CancelFastPathLayoutSolve();
+
     m_wasInitializedForContext = false;
     m_itemCount = 0;
     if (m_isVirtualizingContext)
@@ -570,6 +576,30 @@ void LinedFlowLayout::OnItemsChangedCore(
 
 #pragma region private helpers
 
+// Populates the m_itemsInfoArrangeWidths and m_lineItemCounts vectors with the provided fast path layout.
+// Returns the largest line width among the solved lines.
+float LinedFlowLayout::ApplyFastPathLayout(
+    LinedFlowLayoutFastPathSolver::Layout&& layout)
+{
+    MUX_ASSERT(static_cast<int>(layout.m_arrangeWidths.size()) == m_itemCount);
+    MUX_ASSERT(!layout.m_lineItemCounts.empty());
+
+    m_itemsInfoArrangeWidths = std::move(layout.m_arrangeWidths);
+
+    MUX_ASSERT(UsesFastPathLayout());
+
+    EnsureLineItemCounts(static_cast<int>(layout.m_lineItemCounts.size()));
+
+    for (size_t lineIndex = 0; lineIndex < layout.m_lineItemCounts.size(); lineIndex++)
+    {
+        m_lineItemCounts.Set(lineIndex, layout.m_lineItemCounts[lineIndex]);
+    }
+
+    MUX_ASSERT(m_lineItemCounts.Total() == m_itemCount);
+
+    return layout.m_maxLineWidth;
+}
+
 // Items arrangement when the non-scrolling dimension is constrained.
 void LinedFlowLayout::ArrangeConstrainedLines(
     winrt::VirtualizingLayoutContext const& context)
@@ -915,6 +945,21 @@ void LinedFlowLayout::ArrangeUnconstrainedLine(
     }
 }
 
+// Cancels the potential fast path layout solve running on a worker thread, and discards a potential solved layout
+// that was not applied yet. Invoked whenever the snapshot they are based on becomes outdated.
+void LinedFlowLayout::CancelFastPathLayoutSolve()
+{
+    // Completion handlers already queued on the UI thread ignore their outcome because of the version change.
+    m_fastPathLayoutSolveVersion++;
+    m_solvedFastPathLayout = nullptr;
+
+    if (m_fastPathLayoutSolveAction)
+    {
+        m_fastPathLayoutSolveAction.Cancel();
+        m_fastPathLayoutSolveAction = nullptr;
+    }
+}
+
 void LinedFlowLayout::ClearItemAspectRatios()
 {
     if (m_aspectRatios)
@@ -1452,7 +1497,7 @@ bool LinedFlowLayout::ComputeFrozenItemsRange(
                 MUX_ASSERT(m_lineItemCounts[frozenLineVectorIndex] > 0);
 
                 adjustedBeginSizedItemIndex += m_lineItemCounts[frozenLineVectorIndex];
-                m_lineItemCounts[frozenLineVectorIndex] = 0;
+                m_lineItemCounts.Set(frozenLineVectorIndex, 0);
             }
 
             firstFrozenItemIndex = adjustedBeginSizedItemIndex;
@@ -1482,7 +1527,7 @@ bool LinedFlowLayout::ComputeFrozenItemsRange(
                 MUX_ASSERT(m_lineItemCounts[frozenLineVectorIndex] > 0);
 
                 adjustedEndSizedItemIndex -= m_lineItemCounts[frozenLineVectorIndex];
-                m_lineItemCounts[frozenLineVectorIndex] = 0;
+                m_lineItemCounts.Set(frozenLineVectorIndex, 0);
             }
 
             lastFrozenItemIndex = adjustedEndSizedItemIndex;
@@ -1602,7 +1647,7 @@ void LinedFlowLayout::ComputeItemsLayoutWithLockedItems(
     {
         MUX_ASSERT(itemsLayout.m_lineItemCounts[lineVectorIndex] > 0);
 
-        m_lineItemCounts[static_cast<size_t>(beginLineVectorIndex) + lineVectorIndex] = itemsLayout.m_lineItemCounts[lineVectorIndex];
+        m_lineItemCounts.Set(static_cast<size_t>(beginLineVectorIndex) + lineVectorIndex, itemsLayout.m_lineItemCounts[lineVectorIndex]);
     }
 
     const bool itemsAreStretched = ItemsStretch() == winrt::LinedFlowLayoutItemsStretch::Fill;
@@ -1816,244 +1861,83 @@ void LinedFlowLayout::ComputeItemsLayoutWithLockedItems(
 }
 
 // Computes the best layout by assigning items to lines - for the fast path.
-// This method populates the m_itemsInfoArrangeWidths and m_lineItemCounts vectors successively, using the
-// m_itemsInfoDesiredAspectRatiosForFastPath, m_itemsInfoMinWidthsForFastPath, m_itemsInfoMaxWidthsForFastPath,
-// m_itemsInfoMinWidth, m_itemsInfoMaxWidth fields.
-// Returns the largest line width among all the lines.
+// This method populates the m_itemsInfoArrangeWidths and m_lineItemCounts vectors using a LinedFlowLayoutFastPathSolver, from a
+// snapshot of the m_itemsInfoDesiredAspectRatiosForFastPath, m_itemsInfoMinWidthsForFastPath, m_itemsInfoMaxWidthsForFastPath,
+// m_itemsInfoMinWidth, m_itemsInfoMaxWidth fields. The three arrays are moved into that snapshot.
+// In a virtualizing context with at least c_minItemCountForAsyncFastPathLayout items, only the lines covering the realization rect
+// and the anchor item are solved synchronously. The remaining items are spread over estimated lines while all the lines are solved on
+// a worker thread. That complete layout is applied by MeasureConstrainedLinesFastPath in a subsequent measure pass.
+// Returns the largest line width among the solved lines.
 float LinedFlowLayout::ComputeItemsLayoutFastPath(
+    winrt::VirtualizingLayoutContext const& context,
     float availableWidth,
     double actualLineHeight)
 {
     MUX_ASSERT(m_itemCount > 0);
+    MUX_ASSERT(m_itemsInfoFirstIndex == -1);
 
-    EnsureItemsInfoArrangeWidths(m_itemCount);
+    // A layout potentially being solved on a worker thread is based on outdated items info.
+    CancelFastPathLayoutSolve();
 
-    MUX_ASSERT(UsesFastPathLayout());
+    auto snapshot = std::make_shared<LinedFlowLayoutFastPathSolver::Snapshot>();
 
     // The existing average aspect ratio is used as a fallback aspect ratio for items
     // given an aspect ratio <= 0 by the ItemsInfoRequested handler.
-    const double averageAspectRatio = GetAverageAspectRatio(availableWidth, actualLineHeight);
+    snapshot->m_averageAspectRatio = GetAverageAspectRatio(availableWidth, actualLineHeight);
+    snapshot->m_desiredAspectRatios = std::move(m_itemsInfoDesiredAspectRatiosForFastPath);
+    snapshot->m_minWidths = std::move(m_itemsInfoMinWidthsForFastPath);
+    snapshot->m_maxWidths = std::move(m_itemsInfoMaxWidthsForFastPath);
+    snapshot->m_minWidth = m_itemsInfoMinWidth;
+    snapshot->m_maxWidth = m_itemsInfoMaxWidth;
+    snapshot->m_actualLineHeight = actualLineHeight;
+    snapshot->m_availableWidth = availableWidth;
+    snapshot->m_minItemSpacing = static_cast<float>(MinItemSpacing());
+    snapshot->m_itemCount = m_itemCount;
+    snapshot->m_itemsAreStretched = ItemsStretch() == winrt::LinedFlowLayoutItemsStretch::Fill;
 
-    for (int itemIndex = 0; itemIndex < m_itemCount; itemIndex++)
+    if (!m_isVirtualizingContext || m_itemCount < c_minItemCountForAsyncFastPathLayout)
     {
-        const float arrangeWidth = GetArrangeWidthFromItemsInfo(itemIndex, actualLineHeight, averageAspectRatio);
-
-        SetArrangeWidthFromItemsInfo(itemIndex, arrangeWidth);
+        return ApplyFastPathLayout(LinedFlowLayoutFastPathSolver::Solve(
+            *snapshot,
+            -1 /*minLineCount*/,
+            -1 /*minItemIndex*/,
+            nullptr /*isCanceled*/));
     }
 
-    // Final line count is originally unknown. m_lineItemCounts is originally allocated to accommodate 5 items per line.
-    // The vector is progressively grown as needed when that assumption is too optimistic.
-    constexpr int c_itemsPerLineAllocation = 5;
-    // The vector capacity is increased by 25% each time its size becomes too small.
-    constexpr double c_lineCountGrowthFactor = 1.25;
-    int allocatedLineCount{ m_itemCount / c_itemsPerLineAllocation + 1 };
+    // Only the lines up to the far edge of the realization rect, and up to the potential anchor item, are needed by the
+    // current measure pass. Because of the greedy assignment, they are identical to the lines of a complete solve.
+    const winrt::Rect realizationRect = context.RealizationRect();
+    const double farRealizationRect = static_cast<double>(realizationRect.Y) + realizationRect.Height;
+    const int minLineCount = std::max(1, static_cast<int>(std::ceil(farRealizationRect / (actualLineHeight + LineSpacing()))));
+    const int minItemIndex = std::min(std::max(context.RecommendedAnchorIndex(), m_anchorIndex), m_itemCount - 1);
 
-    EnsureLineItemCounts(allocatedLineCount);
+    LinedFlowLayoutFastPathSolver::Layout layout = LinedFlowLayoutFastPathSolver::Solve(
+        *snapshot,
+        minLineCount,
+        minItemIndex,
+        nullptr /*isCanceled*/);
 
-    const float minItemSpacing{ static_cast<float>(MinItemSpacing()) };
-    const bool itemsAreStretched{ ItemsStretch() == winrt::LinedFlowLayoutItemsStretch::Fill };
-    int lineIndex{ -1 };
-    int lineItemCount{ 0 };
-    float lineWidth{ 0.0f };
-    float maxLineWidth{ 0.0f };
-
-    for (int itemIndex = 0; itemIndex < m_itemCount; itemIndex++)
+    if (layout.m_solvedItemCount < m_itemCount)
     {
-        const float arrangeWidth{ m_itemsInfoArrangeWidths[itemIndex] };
-        double scaleFactor{ 1.0 };
-
-        if (lineWidth == 0.0f || lineWidth + minItemSpacing + arrangeWidth > availableWidth)
-        {
-            bool cumulate{ lineWidth != 0.0f };
-
-            if (cumulate)
-            {
-                // Additional item goes beyond the available width.
-                MUX_ASSERT(lineWidth > 0.0);
-                MUX_ASSERT(lineWidth + minItemSpacing + arrangeWidth > availableWidth);
-                MUX_ASSERT(lineItemCount > 0);
-
-                // Determine whether it is better to create a new line or not.
-
-                const double shrinkScaleFactor = ComputeLineShrinkFactor(
-                    true /*forward*/,
-                    itemIndex - lineItemCount /*sizedItemIndex*/,
-                    lineItemCount + 1,
-                    static_cast<double>(lineWidth) + minItemSpacing + arrangeWidth /*lineItemsWidth*/,
-                    availableWidth,
-                    static_cast<double>(lineItemCount) * minItemSpacing /*minItemSpacings*/,
-                    actualLineHeight,
-                    averageAspectRatio);
-
-                MUX_ASSERT(shrinkScaleFactor >= 0.0);
-                MUX_ASSERT(shrinkScaleFactor < 1.0);
-
-                const double expandScaleFactor = ComputeLineExpandFactor(
-                    true /*forward*/,
-                    itemIndex - lineItemCount /*sizedItemIndex*/,
-                    lineItemCount,
-                    lineWidth /*lineItemsWidth*/,
-                    availableWidth,
-                    (static_cast<double>(lineItemCount) - 1) * minItemSpacing /*minItemSpacings*/,
-                    actualLineHeight,
-                    averageAspectRatio);
-
-                MUX_ASSERT(expandScaleFactor > 1.0);
-
-                if (expandScaleFactor - 1.0 < 1.0 - shrinkScaleFactor || shrinkScaleFactor == 0.0)
-                {
-                    // Creating a new line and leaving a gap in the current one requires a smaller
-                    // expansion than the shrinkage required to add this item.
-                    // Or the items' min widths prevent the shrinkage required to fit them in the line.
-                    cumulate = false;
-
-                    if (itemsAreStretched)
-                    {
-                        // Only expand the items when ItemsStretch is LinedFlowLayoutItemsStretch::Fill.
-                        scaleFactor = expandScaleFactor;
-                    }
-                }
-                else
-                {
-                    // The line items need to shrink less to accommodate this additional item than expand to fill the gap,
-                    // let it belong to the current line (cumulate == true).
-                    scaleFactor = shrinkScaleFactor;
-                }
-            }
-
-            if (cumulate)
-            {
-                lineWidth += minItemSpacing + arrangeWidth;
-                lineItemCount++;
-            }
-            else
-            {
-                if (lineIndex >= 0 && m_lineItemCounts[lineIndex] == 0)
-                {
-                    MUX_ASSERT(lineIndex < allocatedLineCount);
-                    MUX_ASSERT(lineItemCount > 0);
-                    MUX_ASSERT(lineWidth > 0);
+        LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_STR_INT, METH_NAME, this, L"Solved item count", layout.m_solvedItemCount);
 
-                    m_lineItemCounts[lineIndex] = lineItemCount;
+        // Spread the unsolved items over lines holding the average item count of the solved lines, so that the extent is
+        // roughly correct until the complete layout is applied.
+        const int unsolvedItemCount = m_itemCount - layout.m_solvedItemCount;
+        const double averageItemsPerLine = static_cast<double>(layout.m_solvedItemCount) / static_cast<double>(layout.m_lineItemCounts.size());
+        const int estimatedLineCount = std::max(1, static_cast<int>(std::round(unsolvedItemCount / averageItemsPerLine)));
 
-                    if (lineIndex + 1 == allocatedLineCount)
-                    {
-                        allocatedLineCount = std::max(allocatedLineCount + 1, static_cast<int>(c_lineCountGrowthFactor * allocatedLineCount));
-                        m_lineItemCounts.resize(allocatedLineCount, 0);
-                    }
+        MUX_ASSERT(estimatedLineCount <= unsolvedItemCount);
 
-                    if (scaleFactor == 1.0)
-                    {
-                        maxLineWidth = std::max(lineWidth, maxLineWidth);
-                    }
-                    else
-                    {
-                        // Apply shrinking or expanding scale factor to line's m_itemsInfoArrangeWidths.
-                        const float totalArrangeWidth = SetItemRangeArrangeWidth(
-                            itemIndex - lineItemCount /*beginItemIndex*/,
-                            itemIndex - 1 /*endItemIndex*/,
-                            actualLineHeight,
-                            averageAspectRatio,
-                            scaleFactor);
-
-                        maxLineWidth = std::max(totalArrangeWidth + (lineItemCount - 1) * minItemSpacing, maxLineWidth);
-                    }
-                }
-
-                lineWidth = arrangeWidth;
-                lineItemCount = 1;
-                lineIndex++;
-            }
-        }
-        else
+        for (int lineIndex = 0; lineIndex < estimatedLineCount; lineIndex++)
         {
-            lineWidth += minItemSpacing + arrangeWidth;
-            lineItemCount++;
+            layout.m_lineItemCounts.push_back(unsolvedItemCount / estimatedLineCount + (lineIndex < unsolvedItemCount % estimatedLineCount ? 1 : 0));
         }
 
-        if (lineWidth >= availableWidth)
-        {
-            MUX_ASSERT(lineIndex >= 0);
-            MUX_ASSERT(lineIndex < allocatedLineCount);
-            MUX_ASSERT(lineItemCount > 0);
-            MUX_ASSERT(lineWidth > 0);
-
-            m_lineItemCounts[lineIndex] = lineItemCount;
-
-            if (lineIndex + 1 == allocatedLineCount)
-            {
-                allocatedLineCount = std::max(allocatedLineCount + 1, static_cast<int>(c_lineCountGrowthFactor * allocatedLineCount));
-                m_lineItemCounts.resize(allocatedLineCount, 0);
-            }
-
-            if (lineItemCount == 1 && lineWidth != availableWidth)
-            {
-                // The single item on the line is bigger than the available width.
-                scaleFactor = ComputeLineShrinkFactor(
-                    true /*forward*/,
-                    itemIndex /*sizedItemIndex*/,
-                    1 /*lineItemCount*/,
-                    lineWidth /*lineItemsWidth*/,
-                    availableWidth,
-                    0.0 /*minItemSpacings*/,
-                    actualLineHeight,
-                    averageAspectRatio);
-
-                MUX_ASSERT(scaleFactor >= 0.0);
-                MUX_ASSERT(scaleFactor < 1.0);
-            }
-
-            if (scaleFactor != 0.0 && scaleFactor != 1.0)
-            {
-                // Apply shrinking scale factor to line's m_itemsInfoArrangeWidths.
-                const float totalArrangeWidth = SetItemRangeArrangeWidth(
-                    itemIndex - lineItemCount + 1 /*beginItemIndex*/,
-                    itemIndex /*endItemIndex*/,
-                    actualLineHeight,
-                    averageAspectRatio,
-                    scaleFactor);
-
-                maxLineWidth = std::max(totalArrangeWidth + (lineItemCount - 1) * minItemSpacing, maxLineWidth);
-            }
-            else
-            {
-                maxLineWidth = std::max(lineWidth, maxLineWidth);
-            }
-
-            lineWidth = 0.0f;
-            lineItemCount = 0;
-        }
-    }
-
-    MUX_ASSERT(lineIndex >= 0);
-    MUX_ASSERT(lineIndex < allocatedLineCount);
-
-    if (lineItemCount > 0)
-    {
-        MUX_ASSERT(lineWidth > 0);
-        MUX_ASSERT(availableWidth >= lineWidth);
-
-        maxLineWidth = std::max(lineWidth, maxLineWidth);
-        m_lineItemCounts[lineIndex] = lineItemCount;
+        StartFastPathLayoutSolve(snapshot);
     }
 
-#ifdef DBG
-    for (int lineIndexTmp = 0; lineIndexTmp <= lineIndex; lineIndexTmp++)
-    {
-        MUX_ASSERT(m_lineItemCounts[lineIndexTmp] > 0);
-    }
-#endif
-
-    m_lineItemCounts.resize(static_cast<size_t>(lineIndex) + 1, 0);
-
-#ifdef DBG
-    for (int lineIndexTmp = 0; lineIndexTmp <= lineIndex; lineIndexTmp++)
-    {
-        MUX_ASSERT(m_lineItemCounts[lineIndexTmp] > 0);
-    }
-#endif
-
-    return maxLineWidth;
+    return ApplyFastPathLayout(std::move(layout));
 }
 
 // Computes the ItemsLayout with the best drawback by assigning items to lines - for the regular path.
@@ -2070,6 +1954,9 @@ float LinedFlowLayout::ComputeItemsLayoutFastPath(
 // Phase 5: Keeping the available width from Phase 4, fine tune that layout by moving best equalizing head and best equalizing tail items into their neighboring lines using internal locks.
 //          Whichever item among the best equalizing head and best equalizing tail is present and provides the largest drawback improvement is moved.
 // Phase 6: Items are finally measured based on the best outcome of Phase 5.
+// All phases run synchronously on the UI thread within MeasureOverride. The evaluations of phases 1 through 5 only read the sizedItemWidths
+// snapshot, but they also read and update the public and internal item locks, and phase 6 measures realized elements. Unlike the fast path
+// and its LinedFlowLayoutFastPathSolver, this solver is thus not isolated enough to run on a worker thread against a versioned snapshot.
 void LinedFlowLayout::ComputeItemsLayoutRegularPath(
     float availableWidth,
     double scrollViewport,
@@ -2111,8 +1998,16 @@ void LinedFlowLayout::ComputeItemsLayoutRegularPath(
     // Internal locks are used to force an item to belong to a particular line.
     std::map<int /*itemIndex*/, int /*lineIndex*/> internalLockedItemIndexes;
 
+    // Snapshot of the item widths shared by all the layout evaluations below.
+    const std::vector<double> sizedItemWidths = GetSizedItemWidths(
+        averageAspectRatio,
+        actualLineHeight,
+        beginSizedItemIndex,
+        endSizedItemIndex);
+
     // Phase 1: evaluate layout for an available width equal to the MeasureOverride's available width.
     ItemsLayout itemsLayout = GetItemsLayout(
+        sizedItemWidths,
         &internalLockedItemIndexes,
         scrollViewport,
         availableWidth,
@@ -2169,6 +2064,7 @@ void LinedFlowLayout::ComputeItemsLayoutRegularPath(
             MUX_ASSERT(adjustedAvailableWidth >= 0.0);
 
             itemsLayout = GetItemsLayout(
+                sizedItemWidths,
                 &internalLockedItemIndexes,
                 scrollViewport,
                 availableWidth,
@@ -2276,6 +2172,7 @@ void LinedFlowLayout::ComputeItemsLayoutRegularPath(
         if (availableWidthsProcessed.find(adjustedAvailableWidth) == availableWidthsProcessed.end())
         {
             itemsLayout = GetItemsLayout(
+                sizedItemWidths,
                 &internalLockedItemIndexes,
                 scrollViewport,
                 availableWidth,
@@ -2332,6 +2229,7 @@ void LinedFlowLayout::ComputeItemsLayoutRegularPath(
                             itemsLayoutToImprove.m_bestEqualizingHeadItemIndex))
                     {
                         itemsLayout = GetItemsLayout(
+                            sizedItemWidths,
                             &internalLockedItemIndexes,
                             scrollViewport,
                             availableWidth,
@@ -2385,6 +2283,7 @@ void LinedFlowLayout::ComputeItemsLayoutRegularPath(
                             itemsLayoutToImprove.m_bestEqualizingTailItemIndex))
                     {
                         itemsLayout = GetItemsLayout(
+                            sizedItemWidths,
                             &internalLockedItemIndexes,
                             scrollViewport,
                             availableWidth,
@@ -3795,11 +3694,15 @@ void LinedFlowLayout::GetFirstFullyRealizedLineIndex(
     MUX_ASSERT(sizedItemIndex >= 0);
     MUX_ASSERT(sizedLineIndex >= 0);
 
-    while (sizedItemIndex < firstRealizedItemIndex)
+    if (sizedItemIndex < firstRealizedItemIndex)
     {
-        sizedItemIndex += m_lineItemCounts[sizedLineVectorIndex];
-        sizedLineIndex++;
-        sizedLineVectorIndex++;
+        // The first fully realized line is the one following the line holding the item just before firstRealizedItemIndex.
+        sizedLineVectorIndex = std::min(
+            m_lineItemCounts.GetLineVectorIndexFromItemOffset(firstRealizedItemIndex - sizedItemIndex - 1) + 1,
+            static_cast<int>(m_lineItemCounts.size()));
+
+        sizedItemIndex += m_lineItemCounts.PrefixSum(sizedLineVectorIndex);
+        sizedLineIndex += sizedLineVectorIndex;
     }
 
     MUX_ASSERT(m_lastSizedLineIndex == -1 || sizedLineIndex <= m_lastSizedLineIndex);
@@ -3809,21 +3712,14 @@ void LinedFlowLayout::GetFirstFullyRealizedLineIndex(
     *firstItemInFullyRealizedLine = sizedItemIndex;
 }
 
-// Uses the m_lineItemCounts vector to return the index of the first item in the provided line index.
+// Uses the m_lineItemCounts prefix sums to return the index of the first item in the provided line index.
 int LinedFlowLayout::GetFirstItemIndexInLineIndex(
     int lineVectorIndex) const
 {
     MUX_ASSERT(lineVectorIndex >= 0);
     MUX_ASSERT(lineVectorIndex < static_cast<int>(m_lineItemCounts.size()));
 
-    int itemIndex = 0;
-
-    for (int lineVectorIndexTmp = 0; lineVectorIndexTmp < lineVectorIndex; lineVectorIndexTmp++)
-    {
-        itemIndex += m_lineItemCounts[lineVectorIndexTmp];
-    }
-
-    return itemIndex;
+    return m_lineItemCounts.PrefixSum(lineVectorIndex);
 }
 
 int LinedFlowLayout::GetFrozenLineIndexFromFrozenItemIndex(
@@ -3836,24 +3732,21 @@ int LinedFlowLayout::GetFrozenLineIndexFromFrozenItemIndex(
     MUX_ASSERT(m_firstFrozenLineIndex != -1);
     MUX_ASSERT(m_lastFrozenLineIndex != -1);
 
-    int frozenItemVectorIndex = frozenItemIndex - m_firstFrozenItemIndex;
+    const int firstFrozenLineVectorIndex = m_firstFrozenLineIndex - m_firstSizedLineIndex;
 
-    for (int frozenLineVectorIndex = m_firstFrozenLineIndex - m_firstSizedLineIndex;
-        frozenLineVectorIndex <= m_lastFrozenLineIndex - m_firstSizedLineIndex;
-        frozenLineVectorIndex++)
-    {
-        MUX_ASSERT(frozenLineVectorIndex >= 0);
-        MUX_ASSERT(frozenLineVectorIndex < static_cast<int>(m_lineItemCounts.size()));
+    MUX_ASSERT(firstFrozenLineVectorIndex >= 0);
+    MUX_ASSERT(firstFrozenLineVectorIndex < static_cast<int>(m_lineItemCounts.size()));
 
-        if (frozenItemVectorIndex < m_lineItemCounts[frozenLineVectorIndex])
-        {
-            return frozenLineVectorIndex + m_firstSizedLineIndex;
-        }
-        frozenItemVectorIndex -= m_lineItemCounts[frozenLineVectorIndex];
+    const int frozenItemOffset = m_lineItemCounts.PrefixSum(firstFrozenLineVectorIndex) + frozenItemIndex - m_firstFrozenItemIndex;
+    const int frozenLineVectorIndex = m_lineItemCounts.GetLineVectorIndexFromItemOffset(frozenItemOffset);
+
+    if (frozenLineVectorIndex > m_lastFrozenLineIndex - m_firstSizedLineIndex)
+    {
+        MUX_ASSERT(false);
+        return -1;
     }
 
-    MUX_ASSERT(false);
-    return -1;
+    return frozenLineVectorIndex + m_firstSizedLineIndex;
 }
 
 // Returns the drawback improvement when an item moves from a line to a neighboring one.
@@ -4089,10 +3982,98 @@ double LinedFlowLayout::GetItemWidthMultiplierThreshold() const
     return forcedWrapMultiplierDbg != 0.0 ? forcedWrapMultiplierDbg : c_itemWidthMultiplierThreshold;
 }
 
+// Returns the desired widths of the items in the [beginSizedItemIndex, endSizedItemIndex] range, in processing order.
+// The widths are read once from the realized elements or the ItemsInfoRequested information so that the successive
+// GetItemsLayout evaluations performed by ComputeItemsLayoutRegularPath are purely numeric and do not access the UI tree.
+std::vector<double> LinedFlowLayout::GetSizedItemWidths(
+    double averageAspectRatio,
+    double actualLineHeight,
+    int beginSizedItemIndex,
+    int endSizedItemIndex)
+{
+    const bool forward = beginSizedItemIndex <= endSizedItemIndex;
+    const int sizedItemCount = forward ? endSizedItemIndex - beginSizedItemIndex + 1 : beginSizedItemIndex - endSizedItemIndex + 1;
+    std::vector<double> sizedItemWidths;
+
+    sizedItemWidths.reserve(sizedItemCount);
+
+    for (int sizedItemIndex = beginSizedItemIndex; ; sizedItemIndex = forward ? sizedItemIndex + 1 : sizedItemIndex - 1)
+    {
+        double itemWidth{};
+
+        if (m_itemsInfoFirstIndex == -1)
+        {
+            MUX_ASSERT(m_elementManager.IsDataIndexRealized(sizedItemIndex));
+
+            if (const auto element = m_elementManager.GetRealizedElement(sizedItemIndex /*dataIndex*/))
+            {
+                itemWidth = element.DesiredSize().Width;
+
+#ifdef DBG
+                const auto frameworkElementDbg = element.try_as<winrt::FrameworkElement>();
+
+                if (frameworkElementDbg)
+                {
+                    if (itemWidth < frameworkElementDbg.MinWidth() - 1.0 / m_roundingScaleFactor)
+                    {
+                        LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_DBL_DBL, METH_NAME, this, itemWidth, frameworkElementDbg.MinWidth());
+                    }
+                    if (itemWidth > frameworkElementDbg.MaxWidth() + 1.0 / m_roundingScaleFactor)
+                    {
+                        LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_DBL_DBL, METH_NAME, this, itemWidth, frameworkElementDbg.MaxWidth());
+                    }
+                    MUX_ASSERT(itemWidth >= frameworkElementDbg.MinWidth() - 1.0 / m_roundingScaleFactor);
+                    MUX_ASSERT(itemWidth <= frameworkElementDbg.MaxWidth() + 1.0 / m_roundingScaleFactor);
+                }
+#endif
+            }
+        }
+        else
+        {
+            MUX_ASSERT(sizedItemIndex - m_itemsInfoFirstIndex < static_cast<int>(m_itemsInfoDesiredAspectRatiosForRegularPath.size()));
+
+            const double desiredMinWidth = GetMinWidthFromItemsInfo(sizedItemIndex);
+            const double desiredMaxWidth = GetMaxWidthFromItemsInfo(sizedItemIndex);
+            double desiredAspectRatio = m_itemsInfoDesiredAspectRatiosForRegularPath[static_cast<size_t>(sizedItemIndex) - m_itemsInfoFirstIndex];
+
+            if (desiredAspectRatio <= 0.0)
+            {
+                // The average aspect ratio is used as a fallback value for items that were given a negative ratio
+                // by the ItemsInfoRequested handler.
+                desiredAspectRatio = averageAspectRatio;
+            }
+
+            itemWidth = desiredAspectRatio * actualLineHeight;
+
+            if (desiredMinWidth >= 0.0)
+            {
+                itemWidth = std::max(desiredMinWidth, itemWidth);
+            }
+
+            if (desiredMaxWidth >= 0.0)
+            {
+                itemWidth = std::min(desiredMaxWidth, itemWidth);
+            }
+        }
+
+        sizedItemWidths.push_back(itemWidth);
+
+        if (sizedItemIndex == endSizedItemIndex)
+        {
+            break;
+        }
+    }
+
+    MUX_ASSERT(static_cast<int>(sizedItemWidths.size()) == sizedItemCount);
+
+    return sizedItemWidths;
+}
+
 // Computes an ItemsLayout for the provided available width.
 // availableWidth: available width as provided by MeasureOverride.
 // adjustedAvailableWidth: variation of availableWidth to equalize the items' layout on the lines.
 LinedFlowLayout::ItemsLayout LinedFlowLayout::GetItemsLayout(
+    std::vector<double> const& sizedItemWidths,
     std::map<int, int>* internalLockedItemIndexes,
     double scrollViewport,
     double availableWidth,
@@ -4161,62 +4142,7 @@ LinedFlowLayout::ItemsLayout LinedFlowLayout::GetItemsLayout(
 
     for (int sizedItemIndex = beginSizedItemIndex; ; sizedItemIndex = forward ? sizedItemIndex + 1 : sizedItemIndex - 1)
     {
-        double itemWidth{};
-
-        if (m_itemsInfoFirstIndex == -1)
-        {
-            MUX_ASSERT(m_elementManager.IsDataIndexRealized(sizedItemIndex));
-
-            if (const auto element = m_elementManager.GetRealizedElement(sizedItemIndex /*dataIndex*/))
-            {
-                itemWidth = element.DesiredSize().Width;
-
-#ifdef DBG
-                const auto frameworkElementDbg = element.try_as<winrt::FrameworkElement>();
-
-                if (frameworkElementDbg)
-                {
-                    if (itemWidth < frameworkElementDbg.MinWidth() - 1.0 / m_roundingScaleFactor)
-                    {
-                        LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_DBL_DBL, METH_NAME, this, itemWidth, frameworkElementDbg.MinWidth());
-                    }
-                    if (itemWidth > frameworkElementDbg.MaxWidth() + 1.0 / m_roundingScaleFactor)
-                    {
-                        LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_DBL_DBL, METH_NAME, this, itemWidth, frameworkElementDbg.MaxWidth());
-                    }
-                    MUX_ASSERT(itemWidth >= frameworkElementDbg.MinWidth() - 1.0 / m_roundingScaleFactor);
-                    MUX_ASSERT(itemWidth <= frameworkElementDbg.MaxWidth() + 1.0 / m_roundingScaleFactor);
-                }
-#endif
-            }
-        }
-        else
-        {
-            MUX_ASSERT(sizedItemIndex - m_itemsInfoFirstIndex < static_cast<int>(m_itemsInfoDesiredAspectRatiosForRegularPath.size()));
-
-            const double desiredMinWidth = GetMinWidthFromItemsInfo(sizedItemIndex);
-            const double desiredMaxWidth = GetMaxWidthFromItemsInfo(sizedItemIndex);
-            double desiredAspectRatio = m_itemsInfoDesiredAspectRatiosForRegularPath[static_cast<size_t>(sizedItemIndex) - m_itemsInfoFirstIndex];
-
-            if (desiredAspectRatio <= 0.0)
-            {
-                // The average aspect ratio is used as a fallback value for items that were given a negative ratio
-                // by the ItemsInfoRequested handler.
-                desiredAspectRatio = averageAspectRatio;
-            }
-
-            itemWidth = desiredAspectRatio * actualLineHeight;
-
-            if (desiredMinWidth >= 0.0)
-            {
-                itemWidth = std::max(desiredMinWidth, itemWidth);
-            }
-
-            if (desiredMaxWidth >= 0.0)
-            {
-                itemWidth = std::min(desiredMaxWidth, itemWidth);
-            }
-        }
+        const double itemWidth = sizedItemWidths[static_cast<size_t>(forward ? sizedItemIndex - beginSizedItemIndex : beginSizedItemIndex - sizedItemIndex)];
 
         const auto& internalLockedItemIndexesIterator = internalLockedItemIndexes->find(sizedItemIndex);
         const bool isInternalLockedItem = internalLockedItemIndexesIterator != internalLockedItemIndexes->end();
@@ -4709,9 +4635,7 @@ int LinedFlowLayout::GetLastItemIndexInLineIndex(
     MUX_ASSERT(lineVectorIndex >= 0);
     MUX_ASSERT(lineVectorIndex < static_cast<int>(m_lineItemCounts.size()));
 
-    int firstItemIndexInLineIndex = GetFirstItemIndexInLineIndex(lineVectorIndex);
-
-    return firstItemIndexInLineIndex + m_lineItemCounts[lineVectorIndex] - 1;
+    return m_lineItemCounts.PrefixSum(lineVectorIndex + 1) - 1;
 }
 
 int LinedFlowLayout::GetLineCount(
@@ -4752,13 +4676,9 @@ int LinedFlowLayout::GetLineIndex(
 
     if (usesFastPathLayout)
     {
-        int lineItemCounts{};
+        lineIndex = m_lineItemCounts.GetLineVectorIndexFromItemOffset(itemIndex);
 
-        while (lineItemCounts + m_lineItemCounts[lineIndex] <= itemIndex)
-        {
-            lineItemCounts += m_lineItemCounts[lineIndex];
-            lineIndex++;
-        }
+        MUX_ASSERT(lineIndex < static_cast<int>(m_lineItemCounts.size()));
     }
     else
     {
@@ -4786,15 +4706,9 @@ int LinedFlowLayout::GetLineIndex(
             {
                 MUX_ASSERT(m_firstSizedLineIndex >= 0);
 
-                int sizedLineVectorIndex = 0;
+                const int sizedLineVectorIndex = m_lineItemCounts.GetLineVectorIndexFromItemOffset(itemIndex - sizedItemIndex);
 
-                while (sizedItemIndex + m_lineItemCounts[sizedLineVectorIndex] - 1 < itemIndex)
-                {
-                    sizedItemIndex += m_lineItemCounts[sizedLineVectorIndex];
-                    sizedLineVectorIndex++;
-
-                    MUX_ASSERT(sizedLineVectorIndex < sizedLineVectorCount);
-                }
+                MUX_ASSERT(sizedLineVectorIndex < sizedLineVectorCount);
 
                 lineIndex = m_firstSizedLineIndex + sizedLineVectorIndex;
             }
@@ -5152,6 +5066,9 @@ void LinedFlowLayout::InvalidateLayout(
         // Perform a complete re-layout during the next layout pass.
         NotifyLinedFlowLayoutInvalidatedDbg(winrt::LinedFlowLayoutInvalidationTrigger::InvalidateLayoutCall);
         m_forceRelayout = true;
+
+        // A layout potentially being solved on a worker thread would be outdated.
+        CancelFastPathLayoutSolve();
     }
 
     if (resetItemsInfo)
@@ -5620,12 +5537,7 @@ std::tuple<bool, bool, bool> LinedFlowLayout::ItemRangesHaveNewDesiredWidths(
 int LinedFlowLayout::LineItemsCountTotal(
     int expectedTotal)
 {
-    int sizedItemCount = 0;
-
-    for (const int lineItemsCount : m_lineItemCounts)
-    {
-        sizedItemCount += lineItemsCount;
-    }
+    const int sizedItemCount = m_lineItemCounts.Total();
 
     MUX_ASSERT(expectedTotal == 0 || sizedItemCount == expectedTotal);
 
@@ -5821,6 +5733,7 @@ std::tuple<int, float, LinedFlowLayout::ItemsInfo> LinedFlowLayout::MeasureConst
             }
 
             maxLineWidth = ComputeItemsLayoutFastPath(
+                context,
                 availableWidth,
                 actualLineHeight);
 
@@ -5831,6 +5744,15 @@ std::tuple<int, float, LinedFlowLayout::ItemsInfo> LinedFlowLayout::MeasureConst
             m_forceRelayout = false;
             unlockItems = true;
         }
+        else if (m_solvedFastPathLayout != nullptr && UsesFastPathLayout())
+        {
+            // The worker thread completed the layout started by ComputeItemsLayoutFastPath for the current items info,
+            // available width and line height. It replaces the estimated lines following the synchronously solved ones.
+            maxLineWidth = ApplyFastPathLayout(std::move(*m_solvedFastPathLayout));
+
+            m_solvedFastPathLayout = nullptr;
+            unlockItems = true;
+        }
         else if (!UsesFastPathLayout())
         {
             return std::tuple<int, float, ItemsInfo>(-1 /*lineCount*/, 0.0f /*maxLineWidth*/, s_emptyItemsInfo);
@@ -6351,7 +6273,7 @@ int LinedFlowLayout::MeasureConstrainedLines(
 
     if (!forceRelayout)
     {
-        oldLineItemCounts = m_lineItemCounts;
+        oldLineItemCounts = m_lineItemCounts.Counts();
     }
 
     std::shared_ptr<std::map<tracker_ref<winrt::UIElement>, float>> oldElementAvailableWidths;
@@ -6432,8 +6354,9 @@ int LinedFlowLayout::MeasureConstrainedLines(
 
             for (int lineVectorIndex = oldFirstLineVectorIndex; lineVectorIndex <= oldLastLineVectorIndex; lineVectorIndex++)
             {
-                m_lineItemCounts[static_cast<size_t>(firstStillSizedLineIndex) - m_firstSizedLineIndex + lineVectorIndex - oldFirstLineVectorIndex] =
-                    oldLineItemCounts[lineVectorIndex];
+                m_lineItemCounts.Set(
+                    static_cast<size_t>(firstStillSizedLineIndex) - m_firstSizedLineIndex + lineVectorIndex - oldFirstLineVectorIndex,
+                    oldLineItemCounts[lineVectorIndex]);
 
                 lastStillSizedItemIndex += oldLineItemCounts[lineVectorIndex];
             }
@@ -7070,6 +6993,26 @@ void LinedFlowLayout::NotifyLinedFlowLayoutItemLockedDbg(
     }
 }
 
+// Invoked on the UI thread when the fast path layout solve started by StartFastPathLayoutSolve completed.
+void LinedFlowLayout::OnFastPathLayoutSolved(
+    std::shared_ptr<LinedFlowLayoutFastPathSolver::Layout> const& layout,
+    int version)
+{
+    LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_INT, METH_NAME, this, version);
+
+    if (version != m_fastPathLayoutSolveVersion)
+    {
+        // The solve was canceled after its completion and before this invocation.
+        return;
+    }
+
+    m_fastPathLayoutSolveAction = nullptr;
+    m_solvedFastPathLayout = layout;
+
+    // Trigger a new measure pass to apply the solved layout in MeasureConstrainedLinesFastPath.
+    InvalidateLayout(false /*forceRelayout*/, false /*resetItemsInfo*/, true /*invalidateMeasure*/);
+}
+
 LinedFlowLayout::ItemsInfo LinedFlowLayout::RaiseItemsInfoRequested(
     int itemsRangeStartIndex,
     int itemsRangeRequestedLength)
@@ -7276,6 +7219,8 @@ bool LinedFlowLayout::RequestItemsInfo(
 
 void LinedFlowLayout::ResetItemsInfo()
 {
+    CancelFastPathLayoutSolve();
+
     m_itemsInfoDesiredAspectRatiosForRegularPath.clear();
     m_itemsInfoMinWidthsForRegularPath.clear();
     m_itemsInfoMaxWidthsForRegularPath.clear();
@@ -7398,32 +7343,6 @@ void LinedFlowLayout::SetDesiredAspectRatioFromItemsInfo(
     m_itemsInfoDesiredAspectRatiosForRegularPath[static_cast<size_t>(itemIndex) - m_itemsInfoFirstIndex] = desiredAspectRatio;
 }
 
-// Returns the total arrange width for the provided index range.
-float LinedFlowLayout::SetItemRangeArrangeWidth(
-    int beginItemIndex,
-    int endItemIndex,
-    double actualLineHeight,
-    double averageAspectRatio,
-    double scaleFactor)
-{
-    MUX_ASSERT(beginItemIndex <= endItemIndex);
-    MUX_ASSERT(beginItemIndex >= 0);
-    MUX_ASSERT(endItemIndex < static_cast<int>(m_itemsInfoArrangeWidths.size()));
-
-    float totalArrangeWidth = 0.0f;
-
-    for (int itemIndex = beginItemIndex; itemIndex <= endItemIndex; itemIndex++)
-    {
-        const float arrangeWidth = GetArrangeWidthFromItemsInfo(itemIndex, actualLineHeight, averageAspectRatio, scaleFactor);
-
-        SetArrangeWidthFromItemsInfo(itemIndex, arrangeWidth);
-
-        totalArrangeWidth += arrangeWidth;
-    }
-
-    return totalArrangeWidth;
-}
-
 // Snaps the provided average items per line to a power of 1.1, taking into account the old averageItemsPerLine raw (i.e. unsnapped) value.
 std::pair<double, double> LinedFlowLayout::SnapAverageItemsPerLine(
     double oldAverageItemsPerLineRaw,
@@ -7502,6 +7421,57 @@ double LinedFlowLayout::SnapToPower(
     }
 }
 
+// Starts solving all the lines of the provided fast path snapshot on a worker thread. The outcome is handed
+// to OnFastPathLayoutSolved on the UI thread, unless CancelFastPathLayoutSolve is called in the meantime.
+void LinedFlowLayout::StartFastPathLayoutSolve(
+    std::shared_ptr<const LinedFlowLayoutFastPathSolver::Snapshot> const& snapshot)
+{
+    LINEDFLOWLAYOUT_TRACE_INFO(*this, TRACE_MSG_METH_INT, METH_NAME, this, m_fastPathLayoutSolveVersion);
+
+    MUX_ASSERT(m_fastPathLayoutSolveAction == nullptr);
+
+    auto layout = std::make_shared<LinedFlowLayoutFastPathSolver::Layout>();
+
+    winrt::WorkItemHandler workItemHandler(
+        [snapshot, layout](winrt::IAsyncAction workItem)
+    {
+        *layout = LinedFlowLayoutFastPathSolver::Solve(
+            *snapshot,
+            -1 /*minLineCount*/,
+            -1 /*minItemIndex*/,
+            [&workItem]() { return workItem.Status() == winrt::AsyncStatus::Canceled; });
+    });
+
+    const int version = m_fastPathLayoutSolveVersion;
+    auto weakThis{ winrt::make_weak(static_cast<winrt::LinedFlowLayout>(*this)) };
+    auto dispatcherQueue = m_dispatcherQueue;
+
+    m_fastPathLayoutSolveAction = winrt::ThreadPool::RunAsync(workItemHandler);
+    m_fastPathLayoutSolveAction.Completed(winrt::AsyncActionCompletedHandler(
+        [weakThis, dispatcherQueue, layout, version](winrt::IAsyncAction const& asyncInfo, winrt::AsyncStatus asyncStatus)
+    {
+        if (asyncStatus != winrt::AsyncStatus::Completed)
+        {
+            return;
+        }
+
+        dispatcherQueue.TryEnqueue(winrt::DispatcherQueueHandler(
+            [weakThis, layout, version]()
+        {
+            if (winrt::WindowsXamlManager::GetForCurrentThread() == nullptr)
+            {
+                // Exit early if Xaml core has already shut down.
+                return;
+            }
+
+            if (auto strongThis = weakThis.get())
+            {
+                winrt::get_self<LinedFlowLayout>(strongThis)->OnFastPathLayoutSolved(layout, version);
+            }
+        }));
+    }));
+}
+
 // Raises the ItemsUnlocked event when there are locked items.
 // This event is raised when previously locked items are cleared and declared unlocked because the source collection
 // or the average items per line changed.
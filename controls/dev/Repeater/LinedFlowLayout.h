@@ -8,7 +8,9 @@
 #include "LinedFlowLayoutTrace.h"
 #include "LinedFlowLayout.g.h"
 #include "LinedFlowLayout.properties.h"
+#include "LinedFlowLayoutFastPathSolver.h"
 #include "LinedFlowLayoutItemAspectRatios.h"
+#include "LinedFlowLayoutLineItemCounts.h"
 
 class LinedFlowLayout :
     public ReferenceTracker<LinedFlowLayout, winrt::implementation::LinedFlowLayoutT, VirtualizingLayout>,
@@ -250,12 +252,17 @@ private:
     };
 
     // Methods
+    float ApplyFastPathLayout(
+        LinedFlowLayoutFastPathSolver::Layout&& layout);
+
     void ArrangeConstrainedLines(
         winrt::VirtualizingLayoutContext const& context);
 
     void ArrangeUnconstrainedLine(
         winrt::VirtualizingLayoutContext const& context);
 
+    void CancelFastPathLayoutSolve();
+
     bool ComputeFrozenItemsAndLayout(
         winrt::VirtualizingLayoutContext const& context,
         std::vector<int>& oldLineItemCounts,
@@ -293,6 +300,7 @@ private:
         int& adjustedEndSizedItemIndex);
 
     float ComputeItemsLayoutFastPath(
+        winrt::VirtualizingLayoutContext const& context,
         float availableWidth,
         double actualLineHeight);
 
@@ -478,6 +486,7 @@ private:
     double GetItemWidthMultiplierThreshold() const;
 
     ItemsLayout GetItemsLayout(
+        std::vector<double> const& sizedItemWidths,
         std::map<int, int>* internalLockedItemIndexes,
         double scrollViewport,
         double availableWidth,
@@ -493,6 +502,12 @@ private:
         int beginLineVectorIndex,
         bool isLastSizedLineStretchEnabled);
 
+    std::vector<double> GetSizedItemWidths(
+        double averageAspectRatio,
+        double actualLineHeight,
+        int beginSizedItemIndex,
+        int endSizedItemIndex);
+
     float GetItemsRangeArrangeWidth(
         int beginSizedItemIndex,
         int endSizedItemIndex,
@@ -662,6 +677,10 @@ private:
         int itemIndex,
         int lineIndex);
 
+    void OnFastPathLayoutSolved(
+        std::shared_ptr<LinedFlowLayoutFastPathSolver::Layout> const& layout,
+        int version);
+
     ItemsInfo RaiseItemsInfoRequested(
         int itemsRangeStartIndex,
         int itemsRangeRequestedLength);
@@ -688,13 +707,6 @@ private:
         int itemIndex,
         double desiredAspectRatio);
 
-    float SetItemRangeArrangeWidth(
-        int beginItemIndex,
-        int endItemIndex,
-        double actualLineHeight,
-        double averageAspectRatio,
-        double scaleFactor = 1.0);
-
     std::pair<double, double> SnapAverageItemsPerLine(
         double oldAverageItemsPerLineRaw,
         double newAverageItemsPerLineRaw) const;
@@ -702,6 +714,9 @@ private:
         double value,
         double valuePower) const;
 
+    void StartFastPathLayoutSolve(
+        std::shared_ptr<const LinedFlowLayoutFastPathSolver::Snapshot> const& snapshot);
+
     bool UpdateActualLineHeight(
         winrt::VirtualizingLayoutContext const& context,
         winrt::Size const& availableSize);
@@ -762,7 +777,8 @@ private:
     std::shared_ptr<std::map<tracker_ref<winrt::UIElement>, float>> m_elementAvailableWidths;
     std::shared_ptr<std::map<tracker_ref<winrt::UIElement>, float>> m_elementDesiredWidths;
 
-    std::vector<int> m_lineItemCounts;
+    // Number of items in each sized line, with prefix sums for O(log n) item <-> line lookups.
+    LinedFlowLayoutLineItemCounts m_lineItemCounts;
     std::vector<float> m_itemsInfoArrangeWidths;
 
     // Items info collected through the ItemsInfoRequested event:
@@ -783,6 +799,13 @@ private:
     // in each ItemsInfoRequested event.
     // The fast path is only using cheaper temporary winrt::com_array<double> arrays because no such stitching is performed. Information is gathered for
     // the entire source collection and the arrays are discarded at the end of the measure path.
+
+    // Solve of all the fast path lines running on a worker thread when ComputeItemsLayoutFastPath only solved the lines needed by the
+    // realization rect synchronously, and its outcome until it is applied by MeasureConstrainedLinesFastPath. m_fastPathLayoutSolveVersion
+    // is incremented by each CancelFastPathLayoutSolve call so that outcomes already queued on the UI thread can be recognized as outdated.
+    winrt::IAsyncAction m_fastPathLayoutSolveAction{ nullptr };
+    std::shared_ptr<LinedFlowLayoutFastPathSolver::Layout> m_solvedFastPathLayout{ nullptr };
+    int m_fastPathLayoutSolveVersion{ 0 };
     
     // This countdown is used during initial loading in order to clamp the average aspect ratio between
     // 2/3 and 3/2 to avoid extranuous item realizations while the first items are still unpopulated.
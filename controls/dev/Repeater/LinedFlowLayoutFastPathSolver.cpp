@@ -0,0 +1,475 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include <pch.h>
+#include <common.h>
+#include "LinedFlowLayoutFastPathSolver.h"
+
+// Computes the best layout by assigning items to lines, populating the returned Layout's m_arrangeWidths
+// and m_lineItemCounts vectors successively.
+LinedFlowLayoutFastPathSolver::Layout LinedFlowLayoutFastPathSolver::Solve(
+    Snapshot const& snapshot,
+    int minLineCount,
+    int minItemIndex,
+    std::function<bool()> const& isCanceled)
+{
+    MUX_ASSERT(snapshot.m_itemCount > 0);
+    MUX_ASSERT(snapshot.m_itemCount <= static_cast<int>(snapshot.m_desiredAspectRatios.size()));
+    MUX_ASSERT(minLineCount == -1 || minLineCount > 0);
+
+    const int itemCount = snapshot.m_itemCount;
+    const float availableWidth = snapshot.m_availableWidth;
+    const float minItemSpacing = snapshot.m_minItemSpacing;
+    Layout layout;
+
+    layout.m_arrangeWidths.resize(itemCount);
+
+    for (int itemIndex = 0; itemIndex < itemCount; itemIndex++)
+    {
+        layout.m_arrangeWidths[itemIndex] = GetArrangeWidth(snapshot, itemIndex);
+    }
+
+    // Final line count is originally unknown. m_lineItemCounts is originally reserved to accommodate 5 items per line.
+    constexpr int c_itemsPerLineAllocation = 5;
+
+    layout.m_lineItemCounts.reserve(static_cast<size_t>(itemCount) / c_itemsPerLineAllocation + 1);
+
+    int lineIndex{ -1 };
+    int lineItemCount{ 0 };
+    float lineWidth{ 0.0f };
+    bool isPartial{ false };
+
+    for (int itemIndex = 0; itemIndex < itemCount; itemIndex++)
+    {
+        if (isCanceled && isCanceled())
+        {
+            return layout;
+        }
+
+        const float arrangeWidth{ layout.m_arrangeWidths[itemIndex] };
+        double scaleFactor{ 1.0 };
+
+        if (lineWidth == 0.0f || lineWidth + minItemSpacing + arrangeWidth > availableWidth)
+        {
+            bool cumulate{ lineWidth != 0.0f };
+
+            if (cumulate)
+            {
+                // Additional item goes beyond the available width.
+                MUX_ASSERT(lineWidth > 0.0);
+                MUX_ASSERT(lineWidth + minItemSpacing + arrangeWidth > availableWidth);
+                MUX_ASSERT(lineItemCount > 0);
+
+                // Determine whether it is better to create a new line or not.
+
+                const double shrinkScaleFactor = ComputeLineShrinkFactor(
+                    snapshot,
+                    itemIndex - lineItemCount /*beginItemIndex*/,
+                    lineItemCount + 1,
+                    static_cast<double>(lineWidth) + minItemSpacing + arrangeWidth /*lineItemsWidth*/,
+                    static_cast<double>(lineItemCount) * minItemSpacing /*minItemSpacings*/);
+
+                MUX_ASSERT(shrinkScaleFactor >= 0.0);
+                MUX_ASSERT(shrinkScaleFactor < 1.0);
+
+                const double expandScaleFactor = ComputeLineExpandFactor(
+                    snapshot,
+                    itemIndex - lineItemCount /*beginItemIndex*/,
+                    lineItemCount,
+                    lineWidth /*lineItemsWidth*/,
+                    (static_cast<double>(lineItemCount) - 1) * minItemSpacing /*minItemSpacings*/);
+
+                MUX_ASSERT(expandScaleFactor > 1.0);
+
+                if (expandScaleFactor - 1.0 < 1.0 - shrinkScaleFactor || shrinkScaleFactor == 0.0)
+                {
+                    // Creating a new line and leaving a gap in the current one requires a smaller
+                    // expansion than the shrinkage required to add this item.
+                    // Or the items' min widths prevent the shrinkage required to fit them in the line.
+                    cumulate = false;
+
+                    if (snapshot.m_itemsAreStretched)
+                    {
+                        // Only expand the items when ItemsStretch is LinedFlowLayoutItemsStretch::Fill.
+                        scaleFactor = expandScaleFactor;
+                    }
+                }
+                else
+                {
+                    // The line items need to shrink less to accommodate this additional item than expand to fill the gap,
+                    // let it belong to the current line (cumulate == true).
+                    scaleFactor = shrinkScaleFactor;
+                }
+            }
+
+            if (cumulate)
+            {
+                lineWidth += minItemSpacing + arrangeWidth;
+                lineItemCount++;
+            }
+            else
+            {
+                if (lineIndex >= 0 && layout.m_lineItemCounts.size() == static_cast<size_t>(lineIndex))
+                {
+                    // The current line was not completed by the available width check below. Complete it now.
+                    MUX_ASSERT(lineItemCount > 0);
+                    MUX_ASSERT(lineWidth > 0);
+
+                    layout.m_lineItemCounts.push_back(lineItemCount);
+                    layout.m_solvedItemCount += lineItemCount;
+
+                    if (scaleFactor == 1.0)
+                    {
+                        layout.m_maxLineWidth = std::max(lineWidth, layout.m_maxLineWidth);
+                    }
+                    else
+                    {
+                        // Apply shrinking or expanding scale factor to line's m_arrangeWidths.
+                        const float totalArrangeWidth = SetItemRangeArrangeWidth(
+                            snapshot,
+                            layout,
+                            itemIndex - lineItemCount /*beginItemIndex*/,
+                            itemIndex - 1 /*endItemIndex*/,
+                            scaleFactor);
+
+                        layout.m_maxLineWidth = std::max(totalArrangeWidth + (lineItemCount - 1) * minItemSpacing, layout.m_maxLineWidth);
+                    }
+                }
+
+                lineWidth = arrangeWidth;
+                lineItemCount = 1;
+                lineIndex++;
+            }
+        }
+        else
+        {
+            lineWidth += minItemSpacing + arrangeWidth;
+            lineItemCount++;
+        }
+
+        if (lineWidth >= availableWidth)
+        {
+            MUX_ASSERT(lineIndex >= 0);
+            MUX_ASSERT(layout.m_lineItemCounts.size() == static_cast<size_t>(lineIndex));
+            MUX_ASSERT(lineItemCount > 0);
+            MUX_ASSERT(lineWidth > 0);
+
+            layout.m_lineItemCounts.push_back(lineItemCount);
+            layout.m_solvedItemCount += lineItemCount;
+
+            if (lineItemCount == 1 && lineWidth != availableWidth)
+            {
+                // The single item on the line is bigger than the available width.
+                scaleFactor = ComputeLineShrinkFactor(
+                    snapshot,
+                    itemIndex /*beginItemIndex*/,
+                    1 /*lineItemCount*/,
+                    lineWidth /*lineItemsWidth*/,
+                    0.0 /*minItemSpacings*/);
+
+                MUX_ASSERT(scaleFactor >= 0.0);
+                MUX_ASSERT(scaleFactor < 1.0);
+            }
+
+            if (scaleFactor != 0.0 && scaleFactor != 1.0)
+            {
+                // Apply shrinking scale factor to line's m_arrangeWidths.
+                const float totalArrangeWidth = SetItemRangeArrangeWidth(
+                    snapshot,
+                    layout,
+                    itemIndex - lineItemCount + 1 /*beginItemIndex*/,
+                    itemIndex /*endItemIndex*/,
+                    scaleFactor);
+
+                layout.m_maxLineWidth = std::max(totalArrangeWidth + (lineItemCount - 1) * minItemSpacing, layout.m_maxLineWidth);
+            }
+            else
+            {
+                layout.m_maxLineWidth = std::max(lineWidth, layout.m_maxLineWidth);
+            }
+
+            lineWidth = 0.0f;
+            lineItemCount = 0;
+        }
+
+        if (minLineCount != -1 &&
+            static_cast<int>(layout.m_lineItemCounts.size()) >= minLineCount &&
+            layout.m_solvedItemCount > minItemIndex &&
+            itemIndex < itemCount - 1)
+        {
+            // All the requested lines are complete and will not be affected by the remaining items.
+            isPartial = true;
+            break;
+        }
+    }
+
+    MUX_ASSERT(lineIndex >= 0);
+
+    if (lineItemCount > 0 && !isPartial)
+    {
+        MUX_ASSERT(lineWidth > 0);
+        MUX_ASSERT(availableWidth >= lineWidth);
+
+        layout.m_maxLineWidth = std::max(lineWidth, layout.m_maxLineWidth);
+        layout.m_lineItemCounts.push_back(lineItemCount);
+        layout.m_solvedItemCount += lineItemCount;
+    }
+
+    MUX_ASSERT(isPartial || layout.m_solvedItemCount == itemCount);
+
+#ifdef DBG
+    for (const int lineItemCountDbg : layout.m_lineItemCounts)
+    {
+        MUX_ASSERT(lineItemCountDbg > 0);
+    }
+#endif
+
+    return layout;
+}
+
+// Computes the expanding factor for a line with a desired width smaller than the available width.
+double LinedFlowLayoutFastPathSolver::ComputeLineExpandFactor(
+    Snapshot const& snapshot,
+    int beginItemIndex,
+    int lineItemsCount,
+    double lineItemsWidth,
+    double minItemSpacings)
+{
+    double availableWidth = snapshot.m_availableWidth;
+    double scaleFactor;
+    bool largerScaleFactorNeeded;
+    std::set<int> ignoredItemIndexes;
+
+    MUX_ASSERT(lineItemsWidth < availableWidth);
+
+    availableWidth -= minItemSpacings;
+    lineItemsWidth -= minItemSpacings;
+
+    MUX_ASSERT(availableWidth > 0.0);
+    MUX_ASSERT(lineItemsWidth > 0.0);
+
+    do
+    {
+        largerScaleFactorNeeded = false;
+        scaleFactor = availableWidth / lineItemsWidth;
+
+        for (int itemIndex = 0; itemIndex < lineItemsCount; itemIndex++)
+        {
+            if (ignoredItemIndexes.find(itemIndex) == ignoredItemIndexes.end())
+            {
+                double maxWidth{ std::numeric_limits<double>::infinity() };
+                double desiredWidth = GetDesiredWidth(snapshot, beginItemIndex + itemIndex);
+
+                const double desiredMinWidth = GetMinWidth(snapshot, beginItemIndex + itemIndex);
+
+                if (desiredMinWidth >= 0.0)
+                {
+                    desiredWidth = std::max(desiredMinWidth, desiredWidth);
+                }
+
+                const double desiredMaxWidth = GetMaxWidth(snapshot, beginItemIndex + itemIndex);
+
+                if (desiredMaxWidth >= 0.0)
+                {
+                    maxWidth = desiredMaxWidth;
+                    desiredWidth = std::min(maxWidth, desiredWidth);
+                }
+
+                if (maxWidth < desiredWidth * scaleFactor)
+                {
+                    availableWidth = std::max(0.0, availableWidth - maxWidth);
+                    lineItemsWidth = std::max(0.0, lineItemsWidth - desiredWidth);
+
+                    ignoredItemIndexes.insert(itemIndex);
+                    largerScaleFactorNeeded = true;
+                    break;
+                }
+            }
+        }
+    }
+    while (availableWidth > 0.0 && lineItemsWidth > 0.0 && largerScaleFactorNeeded);
+
+    MUX_ASSERT(scaleFactor > 1.0);
+
+    return scaleFactor;
+}
+
+// Computes the shrinking factor for a line with a desired width larger than the available width.
+// Returns 0 when the items' minimum width prevent enough shrinking to accommodate the available width.
+double LinedFlowLayoutFastPathSolver::ComputeLineShrinkFactor(
+    Snapshot const& snapshot,
+    int beginItemIndex,
+    int lineItemsCount,
+    double lineItemsWidth,
+    double minItemSpacings)
+{
+    double availableWidth = snapshot.m_availableWidth;
+    double scaleFactor;
+    bool smallerScaleFactorNeeded;
+    std::set<int> ignoredItemIndexes;
+
+    MUX_ASSERT(lineItemsWidth > availableWidth);
+
+    availableWidth -= minItemSpacings;
+    lineItemsWidth -= minItemSpacings;
+
+    MUX_ASSERT(availableWidth > 0.0);
+    MUX_ASSERT(lineItemsWidth > 0.0);
+
+    do
+    {
+        smallerScaleFactorNeeded = false;
+        scaleFactor = availableWidth / lineItemsWidth;
+
+        for (int itemIndex = 0; itemIndex < lineItemsCount; itemIndex++)
+        {
+            if (ignoredItemIndexes.find(itemIndex) == ignoredItemIndexes.end())
+            {
+                double minWidth{};
+                double desiredWidth = GetDesiredWidth(snapshot, beginItemIndex + itemIndex);
+
+                const double desiredMaxWidth = GetMaxWidth(snapshot, beginItemIndex + itemIndex);
+
+                if (desiredMaxWidth >= 0.0)
+                {
+                    desiredWidth = std::min(desiredMaxWidth, desiredWidth);
+                }
+
+                const double desiredMinWidth = GetMinWidth(snapshot, beginItemIndex + itemIndex);
+
+                if (desiredMinWidth >= 0.0)
+                {
+                    minWidth = desiredMinWidth;
+                    desiredWidth = std::max(minWidth, desiredWidth);
+                }
+
+                if (minWidth > desiredWidth * scaleFactor)
+                {
+                    availableWidth = std::max(0.0, availableWidth - minWidth);
+                    lineItemsWidth = std::max(0.0, lineItemsWidth - desiredWidth);
+
+                    ignoredItemIndexes.insert(itemIndex);
+                    smallerScaleFactorNeeded = true;
+                    break;
+                }
+            }
+        }
+    }
+    while (availableWidth > 0.0 && lineItemsWidth > 0.0 && smallerScaleFactorNeeded);
+
+    MUX_ASSERT(scaleFactor > 0.0);
+    MUX_ASSERT(scaleFactor < 1.0);
+
+    return smallerScaleFactorNeeded ? 0.0 : scaleFactor;
+}
+
+// Returns the arrange width for the provided item, combined with the provided scaleFactor.
+// Matches LinedFlowLayout::GetArrangeWidth.
+float LinedFlowLayoutFastPathSolver::GetArrangeWidth(
+    Snapshot const& snapshot,
+    int itemIndex,
+    double scaleFactor)
+{
+    const double minWidth = std::max(0.0, GetMinWidth(snapshot, itemIndex));
+    const double maxWidth = GetMaxWidth(snapshot, itemIndex);
+    double arrangeWidth = std::max(minWidth, GetDesiredWidth(snapshot, itemIndex));
+
+    if (maxWidth >= 0.0)
+    {
+        arrangeWidth = std::min(maxWidth, arrangeWidth);
+    }
+
+    if (scaleFactor != 1.0)
+    {
+        arrangeWidth *= scaleFactor;
+
+        if (scaleFactor < 1.0)
+        {
+            arrangeWidth = std::max(minWidth, arrangeWidth);
+        }
+
+        if (maxWidth >= 0.0 && scaleFactor > 1.0)
+        {
+            arrangeWidth = std::min(maxWidth, arrangeWidth);
+        }
+    }
+
+    return static_cast<float>(arrangeWidth);
+}
+
+double LinedFlowLayoutFastPathSolver::GetDesiredWidth(
+    Snapshot const& snapshot,
+    int itemIndex)
+{
+    MUX_ASSERT(itemIndex >= 0);
+    MUX_ASSERT(itemIndex < static_cast<int>(snapshot.m_desiredAspectRatios.size()));
+
+    double desiredAspectRatio = snapshot.m_desiredAspectRatios[itemIndex];
+
+    if (desiredAspectRatio <= 0)
+    {
+        // The average aspect ratio is used as a fallback value for items that were given a negative ratio
+        // by the ItemsInfoRequested handler.
+        desiredAspectRatio = snapshot.m_averageAspectRatio;
+    }
+
+    MUX_ASSERT(desiredAspectRatio > 0.0);
+
+    return desiredAspectRatio * snapshot.m_actualLineHeight;
+}
+
+double LinedFlowLayoutFastPathSolver::GetMaxWidth(
+    Snapshot const& snapshot,
+    int itemIndex)
+{
+    MUX_ASSERT(itemIndex >= 0);
+    MUX_ASSERT(itemIndex < snapshot.m_itemCount);
+
+    if (itemIndex < static_cast<int>(snapshot.m_maxWidths.size()))
+    {
+        return std::min(snapshot.m_maxWidth, snapshot.m_maxWidths[itemIndex]);
+    }
+
+    return snapshot.m_maxWidth;
+}
+
+double LinedFlowLayoutFastPathSolver::GetMinWidth(
+    Snapshot const& snapshot,
+    int itemIndex)
+{
+    MUX_ASSERT(itemIndex >= 0);
+    MUX_ASSERT(itemIndex < snapshot.m_itemCount);
+
+    if (itemIndex < static_cast<int>(snapshot.m_minWidths.size()))
+    {
+        return std::max(snapshot.m_minWidth, snapshot.m_minWidths[itemIndex]);
+    }
+
+    return snapshot.m_minWidth;
+}
+
+// Returns the total arrange width for the provided index range.
+float LinedFlowLayoutFastPathSolver::SetItemRangeArrangeWidth(
+    Snapshot const& snapshot,
+    Layout& layout,
+    int beginItemIndex,
+    int endItemIndex,
+    double scaleFactor)
+{
+    MUX_ASSERT(beginItemIndex <= endItemIndex);
+    MUX_ASSERT(beginItemIndex >= 0);
+    MUX_ASSERT(endItemIndex < static_cast<int>(layout.m_arrangeWidths.size()));
+
+    float totalArrangeWidth = 0.0f;
+
+    for (int itemIndex = beginItemIndex; itemIndex <= endItemIndex; itemIndex++)
+    {
+        const float arrangeWidth = GetArrangeWidth(snapshot, itemIndex, scaleFactor);
+
+        layout.m_arrangeWidths[itemIndex] = arrangeWidth;
+
+        totalArrangeWidth += arrangeWidth;
+    }
+
+    return totalArrangeWidth;
+}
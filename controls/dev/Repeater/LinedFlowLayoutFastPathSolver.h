@@ -0,0 +1,90 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+// This class assigns items to lines for the LinedFlowLayout fast path, i.e. when the ItemsInfoRequested handler
+// provided sizing information for the entire source collection. It only reads the immutable Snapshot it is given,
+// so the pass over all items can run on a worker thread while the UI thread keeps using the previous layout.
+//
+// Items are assigned greedily starting with the first one, and whether an item begins a new line never depends on
+// the items that follow it. So a solve limited to the first lines produces exactly the same lines as a complete solve.
+
+class LinedFlowLayoutFastPathSolver
+{
+public:
+    // Inputs of a fast path layout, captured on the UI thread.
+    struct Snapshot
+    {
+        winrt::com_array<double> m_desiredAspectRatios{};
+        winrt::com_array<double> m_minWidths{};
+        winrt::com_array<double> m_maxWidths{};
+        double m_minWidth{ -1.0 };
+        double m_maxWidth{ -1.0 };
+        double m_averageAspectRatio{};
+        double m_actualLineHeight{};
+        float m_availableWidth{};
+        float m_minItemSpacing{};
+        int m_itemCount{};
+        bool m_itemsAreStretched{};
+    };
+
+    // Outcome of a fast path layout.
+    struct Layout
+    {
+        std::vector<float> m_arrangeWidths{};
+        std::vector<int> m_lineItemCounts{};
+        float m_maxLineWidth{};
+        // Number of items held by m_lineItemCounts. Smaller than the item count when the solve stopped early.
+        int m_solvedItemCount{};
+    };
+
+    // Assigns the snapshot items to lines.
+    // When minLineCount is not -1, the solve stops as soon as minLineCount lines are complete and hold the item
+    // at minItemIndex. The remaining items keep their unscaled arrange widths and belong to no line.
+    // The optional isCanceled callback is polled once per item and the partial Layout is returned when it returns true.
+    static Layout Solve(
+        Snapshot const& snapshot,
+        int minLineCount,
+        int minItemIndex,
+        std::function<bool()> const& isCanceled);
+
+private:
+    static double ComputeLineExpandFactor(
+        Snapshot const& snapshot,
+        int beginItemIndex,
+        int lineItemsCount,
+        double lineItemsWidth,
+        double minItemSpacings);
+
+    static double ComputeLineShrinkFactor(
+        Snapshot const& snapshot,
+        int beginItemIndex,
+        int lineItemsCount,
+        double lineItemsWidth,
+        double minItemSpacings);
+
+    static float GetArrangeWidth(
+        Snapshot const& snapshot,
+        int itemIndex,
+        double scaleFactor = 1.0);
+
+    static double GetDesiredWidth(
+        Snapshot const& snapshot,
+        int itemIndex);
+
+    static double GetMaxWidth(
+        Snapshot const& snapshot,
+        int itemIndex);
+
+    static double GetMinWidth(
+        Snapshot const& snapshot,
+        int itemIndex);
+
+    static float SetItemRangeArrangeWidth(
+        Snapshot const& snapshot,
+        Layout& layout,
+        int beginItemIndex,
+        int endItemIndex,
+        double scaleFactor);
+};
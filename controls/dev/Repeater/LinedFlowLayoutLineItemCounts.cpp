@@ -0,0 +1,163 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include <pch.h>
+#include <common.h>
+#include "LinedFlowLayoutLineItemCounts.h"
+
+void LinedFlowLayoutLineItemCounts::clear()
+{
+    m_lineItemCounts.clear();
+    m_tree.clear();
+    m_isTreeValid = false;
+    m_total = 0;
+}
+
+void LinedFlowLayoutLineItemCounts::resize(
+    size_t lineCount,
+    int lineItemCount)
+{
+    MUX_ASSERT(lineItemCount >= 0);
+
+    const size_t oldLineCount = m_lineItemCounts.size();
+
+    if (lineCount < oldLineCount)
+    {
+        for (size_t lineVectorIndex = lineCount; lineVectorIndex < oldLineCount; lineVectorIndex++)
+        {
+            m_total -= m_lineItemCounts[lineVectorIndex];
+        }
+    }
+    else
+    {
+        m_total += static_cast<int>(lineCount - oldLineCount) * lineItemCount;
+    }
+
+    m_lineItemCounts.resize(lineCount, lineItemCount);
+    m_isTreeValid = false;
+}
+
+// Sets the item count of a line, patching the Fenwick tree when it is up-to-date.
+void LinedFlowLayoutLineItemCounts::Set(
+    size_t lineVectorIndex,
+    int lineItemCount)
+{
+    MUX_ASSERT(lineVectorIndex < m_lineItemCounts.size());
+    MUX_ASSERT(lineItemCount >= 0);
+
+    const int delta = lineItemCount - m_lineItemCounts[lineVectorIndex];
+
+    if (delta == 0)
+    {
+        return;
+    }
+
+    m_lineItemCounts[lineVectorIndex] = lineItemCount;
+    m_total += delta;
+
+    if (m_isTreeValid)
+    {
+        const size_t treeSize = m_lineItemCounts.size();
+
+        for (size_t treeIndex = lineVectorIndex + 1; treeIndex <= treeSize; treeIndex += treeIndex & (~treeIndex + 1))
+        {
+            m_tree[treeIndex] += delta;
+        }
+    }
+}
+
+// Returns the number of items held by the first lineVectorCount lines, i.e. the item offset of line lineVectorCount.
+int LinedFlowLayoutLineItemCounts::PrefixSum(
+    int lineVectorCount) const
+{
+    MUX_ASSERT(lineVectorCount >= 0);
+    MUX_ASSERT(lineVectorCount <= static_cast<int>(m_lineItemCounts.size()));
+
+    if (lineVectorCount == static_cast<int>(m_lineItemCounts.size()))
+    {
+        return m_total;
+    }
+
+    EnsureTree();
+
+    int prefixSum = 0;
+
+    for (size_t treeIndex = static_cast<size_t>(lineVectorCount); treeIndex > 0; treeIndex -= treeIndex & (~treeIndex + 1))
+    {
+        prefixSum += m_tree[treeIndex];
+    }
+
+    return prefixSum;
+}
+
+int LinedFlowLayoutLineItemCounts::Total() const
+{
+    return m_total;
+}
+
+// Returns the index of the line holding the item at the provided offset from the first item of the first line.
+// Lines with no items are skipped. Returns size() when itemOffset is beyond the last line's items.
+int LinedFlowLayoutLineItemCounts::GetLineVectorIndexFromItemOffset(
+    int itemOffset) const
+{
+    MUX_ASSERT(itemOffset >= 0);
+
+    if (itemOffset >= m_total)
+    {
+        return static_cast<int>(m_lineItemCounts.size());
+    }
+
+    EnsureTree();
+
+    const size_t treeSize = m_lineItemCounts.size();
+    size_t step = 1;
+
+    while (step * 2 <= treeSize)
+    {
+        step *= 2;
+    }
+
+    // Descend the tree to find the largest line count whose prefix sum does not exceed itemOffset.
+    size_t lineVectorCount = 0;
+    int remainingItemOffset = itemOffset;
+
+    for (; step > 0; step /= 2)
+    {
+        if (lineVectorCount + step <= treeSize && m_tree[lineVectorCount + step] <= remainingItemOffset)
+        {
+            lineVectorCount += step;
+            remainingItemOffset -= m_tree[lineVectorCount];
+        }
+    }
+
+    MUX_ASSERT(lineVectorCount < treeSize);
+
+    return static_cast<int>(lineVectorCount);
+}
+
+void LinedFlowLayoutLineItemCounts::EnsureTree() const
+{
+    if (m_isTreeValid)
+    {
+        return;
+    }
+
+    const size_t treeSize = m_lineItemCounts.size();
+
+    m_tree.assign(treeSize + 1, 0);
+
+    // Linear-time construction: each node pushes its partial sum to its parent.
+    for (size_t treeIndex = 1; treeIndex <= treeSize; treeIndex++)
+    {
+        m_tree[treeIndex] += m_lineItemCounts[treeIndex - 1];
+
+        const size_t parentTreeIndex = treeIndex + (treeIndex & (~treeIndex + 1));
+
+        if (parentTreeIndex <= treeSize)
+        {
+            m_tree[parentTreeIndex] += m_tree[treeIndex];
+        }
+    }
+
+    m_isTreeValid = true;
+}
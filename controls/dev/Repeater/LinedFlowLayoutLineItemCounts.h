@@ -0,0 +1,77 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+// This class stores the number of items held by each sized line of a LinedFlowLayout. On top of the plain counts,
+// it maintains a Fenwick tree (binary indexed tree) of those counts so that:
+// - the index of the first item in a line is a prefix sum computed in O(log n),
+// - the line owning an item is found with a O(log n) descent of the tree,
+// instead of summing the counts linearly from the first sized line.
+//
+// Individual count changes through Set patch the tree in O(log n). Bulk changes (clear, resize) mark the tree as
+// stale and it is rebuilt in O(n) on the next query, which is no more expensive than a single linear scan.
+
+class LinedFlowLayoutLineItemCounts
+{
+public:
+    LinedFlowLayoutLineItemCounts() {};
+
+    size_t size() const
+    {
+        return m_lineItemCounts.size();
+    }
+
+    bool empty() const
+    {
+        return m_lineItemCounts.empty();
+    }
+
+    int operator[](size_t lineVectorIndex) const
+    {
+        return m_lineItemCounts[lineVectorIndex];
+    }
+
+    std::vector<int>::const_iterator begin() const
+    {
+        return m_lineItemCounts.begin();
+    }
+
+    std::vector<int>::const_iterator end() const
+    {
+        return m_lineItemCounts.end();
+    }
+
+    const std::vector<int>& Counts() const
+    {
+        return m_lineItemCounts;
+    }
+
+    void clear();
+
+    void resize(
+        size_t lineCount,
+        int lineItemCount);
+
+    void Set(
+        size_t lineVectorIndex,
+        int lineItemCount);
+
+    int PrefixSum(
+        int lineVectorCount) const;
+
+    int Total() const;
+
+    int GetLineVectorIndexFromItemOffset(
+        int itemOffset) const;
+
+private:
+    void EnsureTree() const;
+
+    std::vector<int> m_lineItemCounts{};
+
+    // 1-based Fenwick tree over m_lineItemCounts. m_tree[i] holds the sum of the counts in (i - lowbit(i), i].
+    mutable std::vector<int> m_tree{};
+    mutable bool m_isTreeValid{ false };
+    int m_total{ 0 };
+};
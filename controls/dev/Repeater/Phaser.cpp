@@ -23,6 +23,15 @@ Phaser::Phaser(ItemsRepeater* owner) :
     // ItemsRepeater is not fully constructed yet. Don't interact with it.
 }
 
+Phaser::~Phaser()
+{
+    // The queued callback captures this Phaser and must not outlive it.
+    if (m_registeredForCallback)
+    {
+        BuildTreeScheduler::CancelWork(m_callbackWorkId);
+    }
+}
+
 void Phaser::PhaseElement(
     const winrt::UIElement& element,
     const winrt::com_ptr<VirtualizationInfo>& virtInfo)
@@ -87,6 +96,7 @@ void Phaser::StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<V
         if (it != m_pendingElements.end())
         {
             m_pendingElements.erase(it);
+            UpdateCallbackPriority();
         }
     }
 
@@ -177,7 +187,7 @@ void Phaser::RegisterForCallback()
     {
         MUX_ASSERT(!m_pendingElements.empty());
         m_registeredForCallback = true;
-        BuildTreeScheduler::RegisterWork(
+        m_callbackWorkId = BuildTreeScheduler::RegisterWork(
             m_pendingElements[m_pendingElements.size() - 1].VirtInfo()->Phase(), // Use the phase of the last one in the sorted list
             [this]()
         {
@@ -189,6 +199,28 @@ void Phaser::RegisterForCallback()
 void Phaser::MarkCallbackRecieved()
 {
     m_registeredForCallback = false;
+    m_callbackWorkId = BuildTreeScheduler::InvalidWorkId;
+}
+
+// Keeps the queued callback in sync with the remaining pending elements after some were cleared,
+// typically because they scrolled out of the realization window.
+void Phaser::UpdateCallbackPriority()
+{
+    if (!m_registeredForCallback)
+    {
+        return;
+    }
+
+    if (m_pendingElements.empty())
+    {
+        // Nothing left to phase, drop the stale callback instead of waking up for nothing.
+        BuildTreeScheduler::CancelWork(m_callbackWorkId);
+        MarkCallbackRecieved();
+    }
+    else
+    {
+        BuildTreeScheduler::UpdateWorkPriority(m_callbackWorkId, m_pendingElements[m_pendingElements.size() - 1].VirtInfo()->Phase());
+    }
 }
 
 /* static */
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BuildTreeScheduler.h"
+
 class ItemsRepeater;
 
 struct ElementInfo
@@ -20,6 +22,7 @@ class Phaser final
 {
 public:
     Phaser(ItemsRepeater* owner);
+    ~Phaser();
     void PhaseElement(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
     void StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
 
@@ -27,10 +30,12 @@ private:
     void DoPhasedWorkCallback();
     void RegisterForCallback();
     void MarkCallbackRecieved();
+    void UpdateCallbackPriority();
     void SortElements(const winrt::Rect& visibleWindow);
     static void ValidatePhaseOrdering(int currentPhase, int nextPhase);
 
     ItemsRepeater* m_owner{ nullptr };
     std::vector<ElementInfo> m_pendingElements{};
     bool m_registeredForCallback{ false };
+    BuildTreeScheduler::WorkId m_callbackWorkId{ BuildTreeScheduler::InvalidWorkId };
 };
@@ -0,0 +1,155 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include <pch.h>
+#include <common.h>
+#include "RealizedElementLayoutBounds.h"
+
+void RealizedElementLayoutBounds::Set(
+    size_t index,
+    const winrt::Rect& bounds)
+{
+    m_x[index] = bounds.X;
+    m_y[index] = bounds.Y;
+    m_width[index] = bounds.Width;
+    m_height[index] = bounds.Height;
+    m_isSet[index] = bounds != InvalidBounds;
+}
+
+void RealizedElementLayoutBounds::push_back(
+    const winrt::Rect& bounds)
+{
+    m_x.push_back(bounds.X);
+    m_y.push_back(bounds.Y);
+    m_width.push_back(bounds.Width);
+    m_height.push_back(bounds.Height);
+    m_isSet.push_back(bounds != InvalidBounds);
+}
+
+void RealizedElementLayoutBounds::insert(
+    size_t index,
+    const winrt::Rect& bounds)
+{
+    MUX_ASSERT(index <= size());
+
+    m_x.insert(m_x.begin() + index, bounds.X);
+    m_y.insert(m_y.begin() + index, bounds.Y);
+    m_width.insert(m_width.begin() + index, bounds.Width);
+    m_height.insert(m_height.begin() + index, bounds.Height);
+    m_isSet.insert(m_isSet.begin() + index, bounds != InvalidBounds);
+}
+
+void RealizedElementLayoutBounds::erase(
+    size_t beginIndex,
+    size_t endIndex)
+{
+    MUX_ASSERT(beginIndex <= endIndex);
+    MUX_ASSERT(endIndex <= size());
+
+    m_x.erase(m_x.begin() + beginIndex, m_x.begin() + endIndex);
+    m_y.erase(m_y.begin() + beginIndex, m_y.begin() + endIndex);
+    m_width.erase(m_width.begin() + beginIndex, m_width.begin() + endIndex);
+    m_height.erase(m_height.begin() + beginIndex, m_height.begin() + endIndex);
+    m_isSet.erase(m_isSet.begin() + beginIndex, m_isSet.begin() + endIndex);
+}
+
+void RealizedElementLayoutBounds::resize(
+    size_t count,
+    const winrt::Rect& bounds)
+{
+    m_x.resize(count, bounds.X);
+    m_y.resize(count, bounds.Y);
+    m_width.resize(count, bounds.Width);
+    m_height.resize(count, bounds.Height);
+    m_isSet.resize(count, bounds != InvalidBounds);
+}
+
+void RealizedElementLayoutBounds::reserve(
+    size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_width.reserve(count);
+    m_height.reserve(count);
+    m_isSet.reserve(count);
+}
+
+void RealizedElementLayoutBounds::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_width.clear();
+    m_height.clear();
+    m_isSet.clear();
+}
+
+int RealizedElementLayoutBounds::FindFirstIntersecting(
+    float windowStart,
+    float windowEnd,
+    ScrollOrientation orientation) const
+{
+    const float* starts = Starts(orientation).data();
+    const float* sizes = Sizes(orientation).data();
+    const int count = static_cast<int>(size());
+    int blockStart = 0;
+
+    // Test whole blocks without early exits so that the inner loop can be vectorized,
+    // and only look for the exact index within the first block that has a hit.
+    for (; blockStart + s_scanBlockSize <= count; blockStart += s_scanBlockSize)
+    {
+        bool blockIntersects = false;
+        for (int i = blockStart; i < blockStart + s_scanBlockSize; ++i)
+        {
+            blockIntersects |= Intersects(starts[i], sizes[i], windowStart, windowEnd);
+        }
+
+        if (blockIntersects)
+        {
+            break;
+        }
+    }
+
+    for (int i = blockStart; i < count; ++i)
+    {
+        if (Intersects(starts[i], sizes[i], windowStart, windowEnd))
+        {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+int RealizedElementLayoutBounds::FindLastIntersecting(
+    float windowStart,
+    float windowEnd,
+    ScrollOrientation orientation) const
+{
+    const float* starts = Starts(orientation).data();
+    const float* sizes = Sizes(orientation).data();
+    int blockEnd = static_cast<int>(size());
+
+    for (; blockEnd - s_scanBlockSize >= 0; blockEnd -= s_scanBlockSize)
+    {
+        bool blockIntersects = false;
+        for (int i = blockEnd - s_scanBlockSize; i < blockEnd; ++i)
+        {
+            blockIntersects |= Intersects(starts[i], sizes[i], windowStart, windowEnd);
+        }
+
+        if (blockIntersects)
+        {
+            break;
+        }
+    }
+
+    for (int i = blockEnd - 1; i >= 0; --i)
+    {
+        if (Intersects(starts[i], sizes[i], windowStart, windowEnd))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,108 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include "OrientationBasedMeasures.h"
+
+// This class stores the layout bounds of the elements realized by an ElementManager. Instead of a vector of
+// winrt::Rect, each component lives in its own contiguous float vector and a bitmap records which bounds have
+// been set. Scans along the scroll orientation, like finding the first and last elements intersecting the
+// realization window, then only read the two vectors for that orientation and are written so the compiler
+// can vectorize them.
+
+class RealizedElementLayoutBounds
+{
+public:
+    RealizedElementLayoutBounds() = default;
+
+    static constexpr winrt::Rect InvalidBounds{ -1.0f, -1.0f, -1.0f, -1.0f };
+
+    size_t size() const
+    {
+        return m_isSet.size();
+    }
+
+    bool empty() const
+    {
+        return m_isSet.empty();
+    }
+
+    winrt::Rect operator[](size_t index) const
+    {
+        return winrt::Rect{ m_x[index], m_y[index], m_width[index], m_height[index] };
+    }
+
+    bool IsSet(size_t index) const
+    {
+        return m_isSet[index];
+    }
+
+    void Set(
+        size_t index,
+        const winrt::Rect& bounds);
+
+    void push_back(
+        const winrt::Rect& bounds);
+
+    void insert(
+        size_t index,
+        const winrt::Rect& bounds);
+
+    void erase(
+        size_t beginIndex,
+        size_t endIndex);
+
+    void resize(
+        size_t count,
+        const winrt::Rect& bounds);
+
+    void reserve(
+        size_t count);
+
+    void clear();
+
+    // Returns the index of the first element whose bounds intersect [windowStart, windowEnd] along
+    // the given orientation, or size() when there is none.
+    int FindFirstIntersecting(
+        float windowStart,
+        float windowEnd,
+        ScrollOrientation orientation) const;
+
+    // Returns the index of the last element whose bounds intersect [windowStart, windowEnd] along
+    // the given orientation, or -1 when there is none.
+    int FindLastIntersecting(
+        float windowStart,
+        float windowEnd,
+        ScrollOrientation orientation) const;
+
+private:
+    // Number of elements tested without branching before checking whether one of them intersected.
+    static constexpr int s_scanBlockSize{ 16 };
+
+    const std::vector<float>& Starts(ScrollOrientation orientation) const
+    {
+        return orientation == ScrollOrientation::Vertical ? m_y : m_x;
+    }
+
+    const std::vector<float>& Sizes(ScrollOrientation orientation) const
+    {
+        return orientation == ScrollOrientation::Vertical ? m_height : m_width;
+    }
+
+    static bool Intersects(
+        float start,
+        float size,
+        float windowStart,
+        float windowEnd)
+    {
+        return start <= windowEnd && start + size >= windowStart;
+    }
+
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_width;
+    std::vector<float> m_height;
+    // Bit set when the bounds at that index are not InvalidBounds.
+    std::vector<bool> m_isSet;
+};
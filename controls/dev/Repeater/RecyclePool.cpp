@@ -51,7 +51,7 @@ void RecyclePool::PutElementCore(
     const auto& winrtOwner = owner;
     auto winrtOwnerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
 
-    ElementInfo elementInfo{ this /* refManager */, element, winrtOwnerAsPanel };
+    ElementInfo elementInfo{ this /* refManager */, element, winrtOwnerAsPanel, m_nextRecycleOrder++ };
 
     if (iterator != m_elements.end())
     {
@@ -63,6 +63,10 @@ void RecyclePool::PutElementCore(
         pool.emplace_back(elementInfo);
         m_elements.emplace(winrtKey, std::move(pool));
     }
+
+    ++m_elementCount;
+    EnforcePerKeyLimit(winrtKey);
+    EnforceGlobalLimit();
 }
 
 winrt::UIElement RecyclePool::TryGetElementCore(
@@ -96,21 +100,16 @@ winrt::UIElement RecyclePool::TryGetElementCore(
                 elements.pop_back();
             }
 
+            --m_elementCount;
+            ++m_hitCount;
+
             auto ownerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
             if (elementInfo.Owner() && elementInfo.Owner() != ownerAsPanel)
             {
                 // Element is still under its parent. remove it from its parent.
-                auto panel = elementInfo.Owner();
-                if (panel)
+                if (!elementInfo.DetachFromOwner())
                 {
-                    unsigned int childIndex = 0;
-                    bool found = panel.Children().IndexOf(elementInfo.Element(), childIndex);
-                    if (!found)
-                    {
-                        throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
-                    }
-
-                    panel.Children().RemoveAt(childIndex);
+                    throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
                 }
             }
 
@@ -118,12 +117,223 @@ winrt::UIElement RecyclePool::TryGetElementCore(
         }
     }
 
+    ++m_missCount;
     return nullptr;
 }
 
 
 #pragma endregion
 
+void RecyclePool::MaxElementsPerKey(int value)
+{
+    m_maxElementsPerKey = std::max(0, value);
+    for (const auto& [key, elements] : m_elements)
+    {
+        EnforcePerKeyLimit(key);
+    }
+}
+
+void RecyclePool::MaxElements(int value)
+{
+    m_maxElements = std::max(0, value);
+    EnforceGlobalLimit();
+}
+
+int RecyclePool::ElementCount(winrt::hstring const& key) const
+{
+    const auto iterator = m_elements.find(key);
+    return iterator != m_elements.end() ? static_cast<int>(iterator->second.size()) : 0;
+}
+
+void RecyclePool::ResetCounters()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_evictionCount = 0;
+}
+
+void RecyclePool::PreWarm(winrt::hstring const& key, int targetCount, std::function<winrt::UIElement()> const& createElement)
+{
+    if (m_maxElementsPerKey > 0)
+    {
+        targetCount = std::min(targetCount, m_maxElementsPerKey);
+    }
+
+    if (m_maxElements > 0)
+    {
+        targetCount = std::min(targetCount, m_maxElements - m_elementCount + ElementCount(key));
+    }
+
+    for (int count = ElementCount(key); count < targetCount; ++count)
+    {
+        auto element = createElement();
+        if (!element)
+        {
+            break;
+        }
+
+        PutElementCore(element, key, nullptr /* owner */);
+    }
+}
+
+/* static */
+void RecyclePool::PreWarm(winrt::DataTemplate const& dataTemplate, int targetCount)
+{
+    auto recyclePool = GetPoolInstance(dataTemplate);
+    if (!recyclePool)
+    {
+        recyclePool = winrt::make<RecyclePool>();
+        SetPoolInstance(dataTemplate, recyclePool);
+    }
+
+    // Elements are created the same way ItemTemplateWrapper::GetElement creates them on a pool miss
+    // so that ItemTemplateWrapper::RecycleElement can find the pool again through the origin template.
+    winrt::get_self<RecyclePool>(recyclePool)->PreWarm(L"" /* key */, targetCount, [&dataTemplate]()
+    {
+        auto element = dataTemplate.LoadContent().try_as<winrt::UIElement>();
+        if (element)
+        {
+            SetOriginTemplate(element, dataTemplate);
+        }
+        return element;
+    });
+}
+
+void RecyclePool::EnforcePerKeyLimit(winrt::hstring const& key)
+{
+    if (m_maxElementsPerKey > 0)
+    {
+        while (ElementCount(key) > m_maxElementsPerKey)
+        {
+            EvictOldestElement(key);
+        }
+    }
+}
+
+void RecyclePool::EnforceGlobalLimit()
+{
+    if (m_maxElements > 0)
+    {
+        while (m_elementCount > m_maxElements)
+        {
+            // Find the key holding the least recently recycled element. The number of keys
+            // in a pool is small (one per template or ReuseKey), so a linear scan is fine.
+            const winrt::hstring* oldestKey = nullptr;
+            uint64_t oldestRecycleOrder = std::numeric_limits<uint64_t>::max();
+            for (const auto& [candidateKey, elements] : m_elements)
+            {
+                if (!elements.empty() && elements.front().RecycleOrder() < oldestRecycleOrder)
+                {
+                    oldestRecycleOrder = elements.front().RecycleOrder();
+                    oldestKey = &candidateKey;
+                }
+            }
+
+            MUX_ASSERT(oldestKey);
+            EvictOldestElement(*oldestKey);
+        }
+    }
+}
+
+void RecyclePool::EvictOldestElement(winrt::hstring const& key)
+{
+    auto& elements = m_elements[key];
+    MUX_ASSERT(!elements.empty());
+
+    // An evicted element may still be parented to the panel it was recycled from, in which
+    // case it needs to be removed from there as well for its tree to be released.
+    const auto elementInfo = elements.front();
+    elements.erase(elements.begin());
+    --m_elementCount;
+    ++m_evictionCount;
+
+    if (auto owner = elementInfo.Owner())
+    {
+        QueueDetachFromOwner(owner, elementInfo.Element());
+    }
+}
+
+// PutElement is commonly called while the owner is clearing elements during its measure pass,
+// where changing its Children collection is not safe. The removal is queued and performed once
+// the owner's layout has completed.
+void RecyclePool::QueueDetachFromOwner(const winrt::Panel& owner, const winrt::UIElement& element)
+{
+    auto pendingDetach = std::find_if(
+        m_pendingDetaches.begin(),
+        m_pendingDetaches.end(),
+        [&owner](const PendingDetach& pending) { return pending.m_owner.get() == owner; });
+
+    if (pendingDetach == m_pendingDetaches.end())
+    {
+        // Weak references on both sides, so that neither a pool nor an owner that goes away
+        // before the next layout pass is kept alive by this subscription.
+        auto weakThis = winrt::make_weak(static_cast<winrt::RecyclePool>(*this));
+        auto weakOwner = winrt::make_weak(owner);
+
+        PendingDetach pending;
+        pending.m_owner = weakOwner;
+        pending.m_layoutUpdatedRevoker = owner.LayoutUpdated(winrt::auto_revoke,
+            [weakThis, weakOwner](const winrt::IInspectable&, const winrt::IInspectable&)
+        {
+            auto strongThis = weakThis.get();
+            auto strongOwner = weakOwner.get();
+            if (strongThis && strongOwner)
+            {
+                winrt::get_self<RecyclePool>(strongThis)->OnOwnerLayoutUpdated(strongOwner);
+            }
+        });
+
+        m_pendingDetaches.emplace_back(std::move(pending));
+        pendingDetach = m_pendingDetaches.end() - 1;
+    }
+
+    pendingDetach->m_elements.emplace_back(winrt::make_weak(element));
+}
+
+void RecyclePool::OnOwnerLayoutUpdated(const winrt::Panel& owner)
+{
+    const auto pendingDetach = std::find_if(
+        m_pendingDetaches.begin(),
+        m_pendingDetaches.end(),
+        [&owner](const PendingDetach& pending) { return pending.m_owner.get() == owner; });
+
+    if (pendingDetach == m_pendingDetaches.end())
+    {
+        return;
+    }
+
+    // Take the entry out before touching Children, which can raise more layout events.
+    const auto elements = std::move(pendingDetach->m_elements);
+    m_pendingDetaches.erase(pendingDetach);
+
+    auto children = owner.Children();
+    for (const auto& weakElement : elements)
+    {
+        // The element may already have been removed from the panel by someone else, which is fine here.
+        unsigned int childIndex = 0;
+        if (auto element = weakElement.get(); element && children.IndexOf(element, childIndex))
+        {
+            children.RemoveAt(childIndex);
+        }
+    }
+}
+
+bool RecyclePool::ElementInfo::DetachFromOwner() const
+{
+    if (auto panel = Owner())
+    {
+        unsigned int childIndex = 0;
+        if (!panel.Children().IndexOf(Element(), childIndex))
+        {
+            return false;
+        }
+
+        panel.Children().RemoveAt(childIndex);
+    }
+
+    return true;
+}
+
 winrt::Panel RecyclePool::EnsureOwnerIsPanelOrNull(const winrt::UIElement& owner)
 {
     winrt::Panel ownerAsPanel = nullptr;
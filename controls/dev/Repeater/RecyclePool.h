@@ -73,6 +73,32 @@ public:
     static winrt::DataTemplate GetOriginTemplate(winrt::UIElement const& element);
     static void SetOriginTemplate(winrt::UIElement const& element, winrt::DataTemplate const& value);
 
+    // Capacity limits for the pool. Zero means unbounded, which is the default. When a limit
+    // is exceeded, the least recently recycled element is evicted from the pool.
+    int MaxElementsPerKey() const { return m_maxElementsPerKey; }
+    void MaxElementsPerKey(int value);
+    int MaxElements() const { return m_maxElements; }
+    void MaxElements(int value);
+
+    // Limits applied to pools created after they are set.
+    static int DefaultMaxElementsPerKey() { return s_defaultMaxElementsPerKey; }
+    static void DefaultMaxElementsPerKey(int value) { s_defaultMaxElementsPerKey = std::max(0, value); }
+    static int DefaultMaxElements() { return s_defaultMaxElements; }
+    static void DefaultMaxElements(int value) { s_defaultMaxElements = std::max(0, value); }
+
+    // Fills the pool up to targetCount elements for the given key so that the first layout
+    // pass does not pay for template instantiation.
+    void PreWarm(winrt::hstring const& key, int targetCount, std::function<winrt::UIElement()> const& createElement);
+    // Pre-warms the pool attached to dataTemplate, creating the pool if needed.
+    static void PreWarm(winrt::DataTemplate const& dataTemplate, int targetCount);
+
+    int ElementCount() const { return m_elementCount; }
+    int ElementCount(winrt::hstring const& key) const;
+    uint64_t HitCount() const { return m_hitCount; }
+    uint64_t MissCount() const { return m_missCount; }
+    uint64_t EvictionCount() const { return m_evictionCount; }
+    void ResetCounters();
+
 private:
 #ifndef MUX_PRERELEASE
     static GlobalDependencyProperty s_PoolInstanceProperty;
@@ -81,19 +107,55 @@ private:
     static GlobalDependencyProperty s_originTemplateProperty;
 
     winrt::Panel EnsureOwnerIsPanelOrNull(const winrt::UIElement& owner);
+    void EnforcePerKeyLimit(winrt::hstring const& key);
+    void EnforceGlobalLimit();
+    void EvictOldestElement(winrt::hstring const& key);
+    void QueueDetachFromOwner(const winrt::Panel& owner, const winrt::UIElement& element);
+    void OnOwnerLayoutUpdated(const winrt::Panel& owner);
 
     struct ElementInfo
     {
-        ElementInfo(const ITrackerHandleManager* refManager, const winrt::UIElement& element, const winrt::Panel& owner)
-            :m_element(refManager, element), m_owner(refManager, owner) {}
+        ElementInfo(const ITrackerHandleManager* refManager, const winrt::UIElement& element, const winrt::Panel& owner, uint64_t recycleOrder = 0)
+            :m_element(refManager, element), m_owner(refManager, owner), m_recycleOrder(recycleOrder) {}
 
         winrt::UIElement Element() const { return m_element.get(); };
         winrt::Panel Owner() const { return m_owner.get(); };
+        uint64_t RecycleOrder() const { return m_recycleOrder; }
+
+        // Removes the element from its owner's Children collection. Returns false if the
+        // element has an owner but is no longer one of its children.
+        bool DetachFromOwner() const;
 
     private:
         tracker_ref<winrt::UIElement> m_element;
         tracker_ref<winrt::Panel> m_owner;
+        uint64_t m_recycleOrder{};
     };
 
+    // Elements for a key are kept in recycle order, so the front of each vector
+    // is the least recently recycled element for that key.
     std::map<winrt::hstring /*key*/, std::vector<ElementInfo>> m_elements;
+
+    // Evicted elements still parented to their owner panel. Eviction can happen while the owner
+    // is in the middle of a layout pass, so removing them from its Children is deferred until the
+    // owner's layout has completed.
+    struct PendingDetach
+    {
+        winrt::weak_ref<winrt::Panel> m_owner{ nullptr };
+        std::vector<winrt::weak_ref<winrt::UIElement>> m_elements;
+        winrt::FrameworkElement::LayoutUpdated_revoker m_layoutUpdatedRevoker{};
+    };
+    std::vector<PendingDetach> m_pendingDetaches;
+
+    int m_maxElementsPerKey{ s_defaultMaxElementsPerKey };
+    int m_maxElements{ s_defaultMaxElements };
+    int m_elementCount{};
+    uint64_t m_nextRecycleOrder{};
+
+    uint64_t m_hitCount{};
+    uint64_t m_missCount{};
+    uint64_t m_evictionCount{};
+
+    static int s_defaultMaxElementsPerKey;
+    static int s_defaultMaxElements;
 };
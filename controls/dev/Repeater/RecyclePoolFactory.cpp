@@ -13,6 +13,11 @@ GlobalDependencyProperty RecyclePool::s_PoolInstanceProperty = nullptr;
 GlobalDependencyProperty RecyclePool::s_reuseKeyProperty = nullptr;
 GlobalDependencyProperty RecyclePool::s_originTemplateProperty = nullptr;
 
+/* static */
+int RecyclePool::s_defaultMaxElementsPerKey{};
+/* static */
+int RecyclePool::s_defaultMaxElements{};
+
 #pragma region IRecyclePoolStatics 
 
 winrt::hstring RecyclePool::GetReuseKey(winrt::UIElement const& element)
@@ -5,10 +5,17 @@
 #include "common.h"
 #include "RepeaterTestHooksFactory.h"
 #include "layout.h"
+#include "InspectingDataSource.h"
+#include "BuildTreeScheduler.h"
+#include "RecyclePool.h"
+#include "ElementManager.h"
 
 /* static */
 int RepeaterTestHooks::s_elementFactoryElementIndex;
 
+/* static */
+std::vector<int> RepeaterTestHooks::s_executedBuildTreeSchedulerWorkTags;
+
 winrt::event_token RepeaterTestHooks::BuildTreeCompletedImpl(
     winrt::TypedEventHandler<winrt::IInspectable, winrt::IInspectable> const& value)
 {
@@ -68,3 +75,151 @@ void RepeaterTestHooks::SetLogItemIndex(int logItemIndex)
 {
     ItemsRepeater::SetLogItemIndex(logItemIndex);
 }
+
+/* static */
+bool RepeaterTestHooks::GetIsIndexOfCacheEnabled()
+{
+    return InspectingDataSource::IsIndexOfCacheEnabled();
+}
+
+/* static */
+void RepeaterTestHooks::SetIsIndexOfCacheEnabled(bool isIndexOfCacheEnabled)
+{
+    InspectingDataSource::IsIndexOfCacheEnabled(isIndexOfCacheEnabled);
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetBuildTreeSchedulerExecutedWorkCount()
+{
+    return BuildTreeScheduler::ExecutedWorkCount();
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetBuildTreeSchedulerDeferredWorkCount()
+{
+    return BuildTreeScheduler::DeferredWorkCount();
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetBuildTreeSchedulerDroppedWorkCount()
+{
+    return BuildTreeScheduler::DroppedWorkCount();
+}
+
+/* static */
+void RepeaterTestHooks::ResetBuildTreeSchedulerCounters()
+{
+    BuildTreeScheduler::ResetCounters();
+    s_executedBuildTreeSchedulerWorkTags.clear();
+}
+
+/* static */
+uint64_t RepeaterTestHooks::RegisterBuildTreeSchedulerWork(int priority, int tag)
+{
+    return BuildTreeScheduler::RegisterWork(priority, [tag]()
+    {
+        s_executedBuildTreeSchedulerWorkTags.push_back(tag);
+    });
+}
+
+/* static */
+bool RepeaterTestHooks::CancelBuildTreeSchedulerWork(uint64_t workId)
+{
+    return BuildTreeScheduler::CancelWork(workId);
+}
+
+/* static */
+bool RepeaterTestHooks::UpdateBuildTreeSchedulerWorkPriority(uint64_t workId, int priority)
+{
+    return BuildTreeScheduler::UpdateWorkPriority(workId, priority);
+}
+
+/* static */
+winrt::IVectorView<int> RepeaterTestHooks::GetExecutedBuildTreeSchedulerWorkTags()
+{
+    return winrt::single_threaded_vector<int>(std::vector<int>(s_executedBuildTreeSchedulerWorkTags)).GetView();
+}
+
+/* static */
+bool RepeaterTestHooks::GetIsCollectionChangeCoalescingEnabled()
+{
+    return ElementManager::IsCollectionChangeCoalescingEnabled();
+}
+
+/* static */
+void RepeaterTestHooks::SetIsCollectionChangeCoalescingEnabled(bool isCollectionChangeCoalescingEnabled)
+{
+    ElementManager::IsCollectionChangeCoalescingEnabled(isCollectionChangeCoalescingEnabled);
+}
+
+/* static */
+bool RepeaterTestHooks::GetIsVelocityAwareCacheEnabled()
+{
+    return ViewportManager::IsVelocityAwareCacheEnabled();
+}
+
+/* static */
+void RepeaterTestHooks::SetIsVelocityAwareCacheEnabled(bool isVelocityAwareCacheEnabled)
+{
+    ViewportManager::IsVelocityAwareCacheEnabled(isVelocityAwareCacheEnabled);
+}
+
+/* static */
+void RepeaterTestHooks::SetRecyclePoolLimits(winrt::IInspectable const& recyclePool, int maxElementsPerKey, int maxElements)
+{
+    if (auto instance = recyclePool.as<RecyclePool>())
+    {
+        instance->MaxElementsPerKey(maxElementsPerKey);
+        instance->MaxElements(maxElements);
+    }
+}
+
+/* static */
+void RepeaterTestHooks::PreWarmRecyclePool(winrt::DataTemplate const& dataTemplate, int targetCount)
+{
+    RecyclePool::PreWarm(dataTemplate, targetCount);
+}
+
+/* static */
+int RepeaterTestHooks::GetRecyclePoolElementCount(winrt::IInspectable const& recyclePool)
+{
+    if (auto instance = recyclePool.as<RecyclePool>())
+    {
+        return instance->ElementCount();
+    }
+
+    return 0;
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetRecyclePoolHitCount(winrt::IInspectable const& recyclePool)
+{
+    if (auto instance = recyclePool.as<RecyclePool>())
+    {
+        return instance->HitCount();
+    }
+
+    return 0;
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetRecyclePoolMissCount(winrt::IInspectable const& recyclePool)
+{
+    if (auto instance = recyclePool.as<RecyclePool>())
+    {
+        return instance->MissCount();
+    }
+
+    return 0;
+}
+
+/* static */
+uint64_t RepeaterTestHooks::GetRecyclePoolEvictionCount(winrt::IInspectable const& recyclePool)
+{
+    if (auto instance = recyclePool.as<RecyclePool>())
+    {
+        return instance->EvictionCount();
+    }
+
+    return 0;
+}
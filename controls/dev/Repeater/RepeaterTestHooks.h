@@ -30,9 +30,31 @@ public:
     static void SetElementFactoryElementIndex(int index);
     static int GetLogItemIndex();
     static void SetLogItemIndex(int logItemIndex);
+    static bool GetIsIndexOfCacheEnabled();
+    static void SetIsIndexOfCacheEnabled(bool isIndexOfCacheEnabled);
+    static uint64_t GetBuildTreeSchedulerExecutedWorkCount();
+    static uint64_t GetBuildTreeSchedulerDeferredWorkCount();
+    static uint64_t GetBuildTreeSchedulerDroppedWorkCount();
+    static void ResetBuildTreeSchedulerCounters();
+    static uint64_t RegisterBuildTreeSchedulerWork(int priority, int tag);
+    static bool CancelBuildTreeSchedulerWork(uint64_t workId);
+    static bool UpdateBuildTreeSchedulerWorkPriority(uint64_t workId, int priority);
+    static winrt::IVectorView<int> GetExecutedBuildTreeSchedulerWorkTags();
+    static bool GetIsCollectionChangeCoalescingEnabled();
+    static void SetIsCollectionChangeCoalescingEnabled(bool isCollectionChangeCoalescingEnabled);
+    static bool GetIsVelocityAwareCacheEnabled();
+    static void SetIsVelocityAwareCacheEnabled(bool isVelocityAwareCacheEnabled);
+    static void SetRecyclePoolLimits(winrt::IInspectable const& recyclePool, int maxElementsPerKey, int maxElements);
+    static void PreWarmRecyclePool(winrt::DataTemplate const& dataTemplate, int targetCount);
+    static int GetRecyclePoolElementCount(winrt::IInspectable const& recyclePool);
+    static uint64_t GetRecyclePoolHitCount(winrt::IInspectable const& recyclePool);
+    static uint64_t GetRecyclePoolMissCount(winrt::IInspectable const& recyclePool);
+    static uint64_t GetRecyclePoolEvictionCount(winrt::IInspectable const& recyclePool);
 
 private:
     static int s_elementFactoryElementIndex;
+    // Tags of the work registered through RegisterBuildTreeSchedulerWork, in execution order.
+    static std::vector<int> s_executedBuildTreeSchedulerWorkTags;
     static RepeaterTestHooks* s_testHooks;
     static void EnsureHooks();    
     winrt::event<winrt::TypedEventHandler<winrt::IInspectable, winrt::IInspectable>> m_buildTreeCompleted;    
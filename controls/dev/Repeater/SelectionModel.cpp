@@ -190,7 +190,7 @@ winrt::IVectorView<winrt::IInspectable> SelectionModel::SelectedItems()
                     const unsigned int currentCount = node->SelectedCount();
                     if (index >= currentIndex && index < currentIndex + currentCount)
                     {
-                        const int targetIndex = node->SelectedIndices().at(index - currentIndex);
+                        const int targetIndex = node->SelectedIndexAt(index - currentIndex);
 
                         MUX_ASSERT(targetIndex >= 0);
 
@@ -248,7 +248,7 @@ winrt::IVectorView<winrt::IndexPath> SelectionModel::SelectedIndices()
                     const unsigned int currentCount = node->SelectedCount();
                     if (index >= currentIndex && index < currentIndex + currentCount)
                     {
-                        const int targetIndex = node->SelectedIndices().at(index - currentIndex);
+                        const int targetIndex = node->SelectedIndexAt(index - currentIndex);
                         path = winrt::get_self<IndexPath>(info.Path)->CloneWithChildIndex(targetIndex);
                         break;
                     }
@@ -170,17 +170,10 @@ int SelectionNode::SelectedCount()
 
 bool SelectionNode::IsSelected(int index)
 {
-    bool isSelected = false;
-    for (auto& range : m_selected)
-    {
-        if (range.Contains(index))
-        {
-            isSelected = true;
-            break;
-        }
-    }
-
-    return isSelected;
+    // m_selected is sorted and non-overlapping, so only the first range ending
+    // at or after index can contain it.
+    const auto it = FirstRangeEndingAtOrAfter(index);
+    return it != m_selected.end() && it->Contains(index);
 }
 
 // True  -> Selected
@@ -233,7 +226,7 @@ winrt::IReference<bool> SelectionNode::IsSelectedWithPartial(int index)
 
 int SelectionNode::SelectedIndex()
 {
-    return SelectedCount() > 0 ? SelectedIndices().at(0) : -1;
+    return SelectedCount() > 0 ? m_selected.front().Begin() : -1;
 }
 
 void SelectionNode::SelectedIndex(int value)
@@ -254,25 +247,39 @@ std::vector<int> SelectionNode::SelectedIndices()
     if (!m_selectedIndicesCacheIsValid)
     {
         m_selectedIndicesCacheIsValid = true;
+        m_selectedIndicesCached.reserve(m_selectedCount);
+
+        // The ranges are sorted and don't overlap, so this produces a sorted list without duplicates.
         for (auto& range : m_selected)
         {
             for (int index = range.Begin(); index <= range.End(); index++)
             {
-                // Avoid duplicates
-                if (std::find(m_selectedIndicesCached.begin(), m_selectedIndicesCached.end(), index) == m_selectedIndicesCached.end())
-                {
-                    m_selectedIndicesCached.emplace_back(index);
-                }
+                m_selectedIndicesCached.emplace_back(index);
             }
         }
-
-        // Sort the list for easy consumption
-        std::sort(m_selectedIndicesCached.begin(), m_selectedIndicesCached.end());
     }
 
     return m_selectedIndicesCached;
 }
 
+// Returns the index at the given position in the sorted list of selected indices,
+// without materializing that list.
+int SelectionNode::SelectedIndexAt(int position)
+{
+    if (position < 0 || position >= m_selectedCount)
+    {
+        throw winrt::hresult_out_of_bounds();
+    }
+
+    EnsureSelectedRangeOffsets();
+
+    const auto it = std::upper_bound(m_selectedRangeOffsets.begin(), m_selectedRangeOffsets.end(), position);
+    const auto rangeIndex = static_cast<int>(it - m_selectedRangeOffsets.begin()) - 1;
+    MUX_ASSERT(rangeIndex >= 0);
+
+    return m_selected[rangeIndex].Begin() + (position - m_selectedRangeOffsets[rangeIndex]);
+}
+
 bool SelectionNode::Select(int index, bool select)
 {
     return Select(index, select, true /* raiseOnSelectionChanged */);
@@ -337,24 +344,67 @@ bool SelectionNode::IsValidIndex(int index)
     return (ItemsSourceView() == nullptr || (index >= 0 && index < ItemsSourceView().Count()));
 }
 
-void SelectionNode::AddRange(const IndexRange& addRange, bool raiseOnSelectionChanged)
+std::vector<IndexRange>::iterator SelectionNode::FirstRangeEndingAtOrAfter(int index)
 {
-    // TODO: Check for duplicates (Task 14107720)
-    // TODO: Optimize by merging adjacent ranges (Task 14107720)
-
-    const int oldCount = SelectedCount();
+    return std::lower_bound(
+        m_selected.begin(),
+        m_selected.end(),
+        index,
+        [](const IndexRange& range, int value) { return range.End() < value; });
+}
 
-    for (int i = addRange.Begin(); i <= addRange.End(); i++)
+void SelectionNode::EnsureSelectedRangeOffsets()
+{
+    if (!m_selectedRangeOffsetsAreValid)
     {
-        if (!IsSelected(i))
+        m_selectedRangeOffsetsAreValid = true;
+        m_selectedRangeOffsets.resize(m_selected.size());
+
+        int offset = 0;
+        for (size_t i = 0; i < m_selected.size(); i++)
         {
-            m_selectedCount++;
+            m_selectedRangeOffsets[i] = offset;
+            offset += m_selected[i].End() - m_selected[i].Begin() + 1;
         }
+
+        MUX_ASSERT(offset == m_selectedCount);
+    }
+}
+
+void SelectionNode::AddRange(const IndexRange& addRange, bool raiseOnSelectionChanged)
+{
+    // Find the ranges that overlap or are adjacent to addRange. Together with addRange
+    // they collapse into a single range, which keeps m_selected sorted and disjoint.
+    const auto first = FirstRangeEndingAtOrAfter(addRange.Begin() - 1);
+    auto last = first;
+    int begin = addRange.Begin();
+    int end = addRange.End();
+    int mergedCount = 0;
+
+    while (last != m_selected.end() && last->Begin() <= addRange.End() + 1)
+    {
+        begin = std::min(begin, last->Begin());
+        end = std::max(end, last->End());
+        mergedCount += last->End() - last->Begin() + 1;
+        ++last;
     }
 
-    if (oldCount != m_selectedCount)
+    const int addedCount = (end - begin + 1) - mergedCount;
+    if (addedCount > 0)
     {
-        m_selected.emplace_back(addRange);
+        m_selectedCount += addedCount;
+
+        if (first == last)
+        {
+            m_selected.insert(first, IndexRange(begin, end));
+        }
+        else
+        {
+            *first = IndexRange(begin, end);
+            m_selected.erase(first + 1, last);
+        }
+
+        InvalidateSelectedIndicesCache();
 
         if (raiseOnSelectionChanged)
         {
@@ -365,79 +415,66 @@ void SelectionNode::AddRange(const IndexRange& addRange, bool raiseOnSelectionCh
 
 void SelectionNode::RemoveRange(const IndexRange& removeRange, bool raiseOnSelectionChanged)
 {
-    const int oldCount = m_selectedCount;
+    // Find the ranges that intersect removeRange. Only the first one can stick out
+    // to the left of removeRange and only the last one can stick out to the right.
+    const auto first = FirstRangeEndingAtOrAfter(removeRange.Begin());
+    auto last = first;
+    int removedCount = 0;
+    IndexRange before;
+    IndexRange after;
+    bool hasBefore = false;
+    bool hasAfter = false;
 
-    // TODO: Prevent overlap of Ranges in _selected (Task 14107720)
-    for (int i = removeRange.Begin(); i <= removeRange.End(); i++)
+    while (last != m_selected.end() && last->Begin() <= removeRange.End())
     {
-        if (IsSelected(i))
+        removedCount += std::min(last->End(), removeRange.End()) - std::max(last->Begin(), removeRange.Begin()) + 1;
+
+        if (last->Begin() < removeRange.Begin())
         {
-            m_selectedCount--;
+            before = IndexRange(last->Begin(), removeRange.Begin() - 1);
+            hasBefore = true;
         }
+
+        if (last->End() > removeRange.End())
+        {
+            after = IndexRange(removeRange.End() + 1, last->End());
+            hasAfter = true;
+        }
+
+        ++last;
     }
 
-    if (oldCount != m_selectedCount)
+    if (removedCount > 0)
     {
-        // Build up a both a list of Ranges to remove and ranges to add
-        std::vector<IndexRange> toRemove;
-        std::vector<IndexRange> toAdd;
+        m_selectedCount -= removedCount;
 
-        for (IndexRange& range : m_selected)
+        // Replace the intersected ranges with what is left of them. Only cutting a hole
+        // in the middle of a single range needs to grow the vector.
+        auto out = first;
+        if (hasBefore)
         {
-            // If this range intersects the remove range, we have to do something
-            if (removeRange.Intersects(range))
-            {
-                IndexRange before(-1, -1);
-                IndexRange cut(-1, -1);
-                IndexRange after(-1, -1);
-
-                // Intersection with the beginning of the range
-                //  Anything to the left of the point (exclusive) stays
-                //  Anything to the right of the point (inclusive) gets clipped
-                if (range.Contains(removeRange.Begin() - 1))
-                {
-                    range.Split(removeRange.Begin() - 1, before, cut);
-                    toAdd.emplace_back(before);
-                }
-
-                // Intersection with the end of the range
-                //  Anything to the left of the point (inclusive) gets clipped
-                //  Anything to the right of the point (exclusive) stays
-                if (range.Contains(removeRange.End()))
-                {
-                    if (range.Split(removeRange.End(), cut, after))
-                    {
-                        toAdd.emplace_back(after);
-                    }
-                }
-
-                // Remove this Range from the collection
-                // New ranges will be added for any remaining subsections
-                toRemove.emplace_back(range);
-            }
+            *out++ = before;
         }
 
-        const bool change = ((toRemove.size() > 0) || (toAdd.size() > 0));
-
-        if (change)
+        if (hasAfter && out == last)
+        {
+            m_selected.insert(out, after);
+        }
+        else
         {
-            // Remove tagged ranges
-            for (const IndexRange& remove : toRemove)
+            if (hasAfter)
             {
-                auto iter = std::find(m_selected.begin(), m_selected.end(), remove);
-                m_selected.erase(iter);
+                *out++ = after;
             }
 
-            // Add new ranges
-            for (const IndexRange& add : toAdd)
-            {
-                m_selected.emplace_back(add);
-            }
+            m_selected.erase(out, last);
+        }
 
-            if (raiseOnSelectionChanged)
-            {
-                OnSelectionChanged();
-            }
+        InvalidateSelectedIndicesCache();
+
+        if (raiseOnSelectionChanged)
+        {
+            OnSelectionChanged();
         }
     }
 }
@@ -529,39 +566,27 @@ void SelectionNode::OnSourceListChanged(const winrt::IInspectable& dataSource, c
 bool SelectionNode::OnItemsAdded(int index, int count)
 {
     bool selectionInvalidated = false;
-    // Update ranges for leaf items
-    std::vector<IndexRange> toAdd;
-    for (int i = 0; i < static_cast<int>(m_selected.size()); i++)
+    // Update ranges for leaf items. Only the ranges ending at or after index need to
+    // be shifted right, and only the first of those can contain index - 1.
+    auto it = FirstRangeEndingAtOrAfter(index);
+    if (it != m_selected.end())
     {
-        auto range = m_selected[i];
-
-        // The range is after the inserted items, need to shift the range right
-        if (range.End() >= index)
+        if (it->Begin() < index)
         {
-            int begin = range.Begin();
-            // If the index left of newIndex is inside the range,
-            // Split the range and remember the left piece to add later
-            if (range.Contains(index - 1))
-            {
-                IndexRange before(-1, -1), after(-1, -1);
-                range.Split(index - 1, before, after);
-                toAdd.emplace_back(before);
-                begin = index;
-            }
-
-            // Shift the range to the right
-            m_selected[i] = IndexRange(begin + count, range.End() + count);
-            selectionInvalidated = true;
+            // Split the range, keeping the left piece in place.
+            const IndexRange after(index + count, it->End() + count);
+            *it = IndexRange(it->Begin(), index - 1);
+            it = m_selected.insert(it + 1, after) + 1;
         }
-    }
 
-    if (toAdd.size() > 0)
-    {
-        // Add the left sides of the split ranges
-        for (auto& add : toAdd)
+        // Shift the remaining ranges to the right
+        for (; it != m_selected.end(); ++it)
         {
-            m_selected.emplace_back(add);
+            *it = IndexRange(it->Begin() + count, it->End() + count);
         }
+
+        InvalidateSelectedIndicesCache();
+        selectionInvalidated = true;
     }
 
     // Update for non-leaf if we are tracking non-leaf nodes
@@ -610,35 +635,41 @@ bool SelectionNode::OnItemsRemoved(int index, int count)
     // Remove the items from the selection for leaf
     if (ItemsSourceView().Count() > 0)
     {
-        bool isSelected = false;
-        for (int i = index; i <= index + count - 1; i++)
+        const int oldSelectedCount = m_selectedCount;
+        if (count > 0)
         {
-            if (IsSelected(i))
-            {
-                isSelected = true;
-                break;
-            }
+            RemoveRange(IndexRange(index, index + count - 1), false /* raiseOnSelectionChanged */);
         }
 
-        if (isSelected)
+        if (oldSelectedCount != m_selectedCount)
         {
-            RemoveRange(IndexRange(index, index + count - 1), false /* raiseOnSelectionChanged */);
             selectionInvalidated = true;
         }
 
-        for (int i = 0; i < static_cast<int>(m_selected.size()); i++)
+        // The ranges after the removed items need to be shifted left.
+        auto it = FirstRangeEndingAtOrAfter(index);
+        if (it != m_selected.end())
         {
-            auto range = m_selected[i];
+            MUX_ASSERT(!it->Contains(index));
 
-            // The range is after the removed items, need to shift the range left
-            if (range.End() > index)
+            for (auto shifted = it; shifted != m_selected.end(); ++shifted)
             {
-                MUX_ASSERT(!range.Contains(index));
+                *shifted = IndexRange(shifted->Begin() - count, shifted->End() - count);
+            }
 
-                // Shift the range to the left
-                m_selected[i] = IndexRange(range.Begin() - count, range.End() - count);
-                selectionInvalidated = true;
+            // The ranges on either side of the removed items can now be adjacent, merge them.
+            if (it != m_selected.begin())
+            {
+                const auto previous = it - 1;
+                if (previous->End() + 1 == it->Begin())
+                {
+                    *previous = IndexRange(previous->Begin(), it->End());
+                    m_selected.erase(it);
+                }
             }
+
+            InvalidateSelectedIndicesCache();
+            selectionInvalidated = true;
         }
 
         // Update for non-leaf if we are tracking non-leaf nodes
@@ -694,9 +725,18 @@ bool SelectionNode::OnItemsRemoved(int index, int count)
 }
 
 void SelectionNode::OnSelectionChanged()
+{
+    InvalidateSelectedIndicesCache();
+}
+
+void SelectionNode::InvalidateSelectedIndicesCache()
 {
     m_selectedIndicesCacheIsValid = false;
+    m_selectedRangeOffsetsAreValid = false;
+
+    // Release the storage as well, it can be large after selecting a large range.
     m_selectedIndicesCached.clear();
+    m_selectedIndicesCached.shrink_to_fit();
 }
 
 /* static */
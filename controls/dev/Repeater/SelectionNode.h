@@ -41,6 +41,7 @@ public:
     int SelectedIndex();
     void SelectedIndex(int value);
     std::vector<int> SelectedIndices();
+    int SelectedIndexAt(int position);
     bool Select(int index, bool select);
     bool ToggleSelect(int index);
     void SelectAll();
@@ -54,6 +55,8 @@ private:
     void HookupCollectionChangedHandler();
     void UnhookCollectionChangedHandler();
     bool IsValidIndex(int index);
+    std::vector<IndexRange>::iterator FirstRangeEndingAtOrAfter(int index);
+    void EnsureSelectedRangeOffsets();
     void AddRange(const IndexRange& addRange, bool raiseOnSelectionChanged);
     void RemoveRange(const IndexRange& removeRange, bool raiseOnSelectionChanged);
     void ClearSelection();
@@ -62,6 +65,7 @@ private:
     bool OnItemsAdded(int index, int count);
     bool OnItemsRemoved(int index, int count);
     void OnSelectionChanged();
+    void InvalidateSelectedIndicesCache();
 
     SelectionModel* m_manager;
 
@@ -74,6 +78,7 @@ private:
     SelectionNode* m_parent { nullptr };
 
     // For parents of leaf nodes (any node whose children are not data sources)
+    // Sorted, non-overlapping and non-adjacent ranges of selected indices.
     std::vector<IndexRange> m_selected;
     
     tracker_ref<winrt::IInspectable> m_source;
@@ -83,6 +88,9 @@ private:
     int m_selectedCount{ 0 };
     std::vector<int> m_selectedIndicesCached;
     bool m_selectedIndicesCacheIsValid = false;
+    // m_selectedRangeOffsets[i] is the number of selected indices before m_selected[i].
+    std::vector<int> m_selectedRangeOffsets;
+    bool m_selectedRangeOffsetsAreValid = false;
     int m_anchorIndex{ -1 };
     int m_realizedChildrenNodeCount{ 0 };
 };
@@ -7,6 +7,7 @@
 #include "ViewportManager.h"
 #include "ItemsRepeater.h"
 #include "Layout.h"
+#include "ScrollPresenter.h"
 
 // Pixel delta by which to inflate the cache buffer on each side.  Rather than fill the entire
 // cache buffer all at once, we chunk the work to make the UI thread more responsive.  We inflate
@@ -14,6 +15,20 @@
 // properties.
 constexpr double CacheBufferPerSideInflationPixelDelta = 40.0;
 
+// Largest fraction of the trailing side's cache buffer that can be moved to the leading side
+// while scrolling. The trailing side always keeps at least 1 - MaximumCacheBufferBias of its buffer
+// so that a direction reversal does not immediately show blank content.
+constexpr double MaximumCacheBufferBias = 0.75;
+
+// Scrolling velocity, in layout pixels per second, at which MaximumCacheBufferBias is reached
+// during a direct manipulation. Slower velocities get a proportionally smaller bias.
+constexpr double CacheBufferBiasFullVelocity = 2000.0;
+
+// Viewport updates further apart than this, in milliseconds, are not used to estimate velocity.
+constexpr int MaximumVelocitySampleInterval = 100;
+
+bool ViewportManager::s_isVelocityAwareCacheEnabled{ true };
+
 ViewportManager::ViewportManager(ItemsRepeater* owner) :
     m_owner(owner),
     m_scroller(owner),
@@ -139,8 +154,10 @@ winrt::Rect ViewportManager::GetLayoutRealizationWindow() const
     auto realizationWindow = GetLayoutVisibleWindow();
     if (HasScroller())
     {
-        realizationWindow.X -= static_cast<float>(m_horizontalCacheBufferPerSide);
-        realizationWindow.Y -= static_cast<float>(m_verticalCacheBufferPerSide);
+        // A non-zero bias shifts the window towards the scrolling direction: the leading side
+        // gets (1 + bias) times the per-side buffer and the trailing side (1 - bias) times.
+        realizationWindow.X -= static_cast<float>(m_horizontalCacheBufferPerSide * (1.0 - m_horizontalCacheBufferBias));
+        realizationWindow.Y -= static_cast<float>(m_verticalCacheBufferPerSide * (1.0 - m_verticalCacheBufferBias));
         realizationWindow.Width += static_cast<float>(m_horizontalCacheBufferPerSide) * 2.0f;
         realizationWindow.Height += static_cast<float>(m_verticalCacheBufferPerSide) * 2.0f;
     }
@@ -730,6 +747,7 @@ void ViewportManager::ResetScrollers()
     m_scrollPresenterScrollCompletedRevoker.revoke();
     m_scrollPresenterZoomStartingRevoker.revoke();
     m_scrollPresenterZoomCompletedRevoker.revoke();
+    m_scrollPresenterStateChangedRevoker.revoke();
     m_effectiveViewportChangedRevoker.revoke();
     m_isAnchorOutsideRealizedRange = false;
     m_skipScrollAnchorRegistrationsDuringNextMeasurePass = false;
@@ -739,6 +757,7 @@ void ViewportManager::ResetScrollers()
     ResetPendingViewportShift();
     ResetUnshiftableShift();
     ResetLastScrollPresenterViewChangeCorrelationId();
+    ResetCacheBufferBias();
 }
 
 void ViewportManager::OnCacheBuildActionCompleted()
@@ -886,6 +905,16 @@ void ViewportManager::OnScrollPresenterViewChangeCompleted(int correlationId)
     }
 }
 
+void ViewportManager::OnScrollPresenterStateChanged(winrt::ScrollPresenter const& scrollPresenter, winrt::IInspectable const& args)
+{
+    if (scrollPresenter.State() == winrt::ScrollingInteractionState::Idle && ResetCacheBufferBias())
+    {
+        // The view came to rest: split the cache buffer evenly again so that the user
+        // can reverse the scrolling direction without showing blank content.
+        TryInvalidateMeasure();
+    }
+}
+
 void ViewportManager::OnEffectiveViewportChanged(winrt::FrameworkElement const& sender, winrt::EffectiveViewportChangedEventArgs const& args)
 {
     const winrt::Rect effectiveViewport = args.EffectiveViewport();
@@ -906,6 +935,8 @@ void ViewportManager::OnEffectiveViewportChanged(winrt::FrameworkElement const&
         return;
     }
 
+    UpdateCacheBufferBias(effectiveViewport);
+
     bool invalidateMeasure = false;
     const bool invalidatedMeasure = UpdateViewport(effectiveViewport);
     const winrt::Point emptyPoint = {};
@@ -972,6 +1003,7 @@ void ViewportManager::EnsureScroller()
                 m_scrollPresenterScrollCompletedRevoker = scrollPresenter.ScrollCompleted(winrt::auto_revoke, { this, &ViewportManager::OnScrollPresenterScrollCompleted });
                 m_scrollPresenterZoomStartingRevoker = scrollPresenter2.ZoomStarting(winrt::auto_revoke, { this, &ViewportManager::OnScrollPresenterZoomStarting });
                 m_scrollPresenterZoomCompletedRevoker = scrollPresenter.ZoomCompleted(winrt::auto_revoke, { this, &ViewportManager::OnScrollPresenterZoomCompleted });
+                m_scrollPresenterStateChangedRevoker = scrollPresenter.StateChanged(winrt::auto_revoke, { this, &ViewportManager::OnScrollPresenterStateChanged });
             }
         }
 #ifdef DBG
@@ -1064,6 +1096,108 @@ void ViewportManager::ResetCacheBuffer(bool registerCacheBuildWork)
     }
 }
 
+// Estimates the scrolling velocity from consecutive effective viewports and derives the cache buffer
+// biases from it. During inertia, the ScrollPresenter's anticipated resting position is used instead
+// so that the leading side reaches the final view when the cache buffer is large enough.
+void ViewportManager::UpdateCacheBufferBias(winrt::Rect const& effectiveViewport)
+{
+    const int elapsedMilliseconds = m_visibleWindowTimer.DurationInMilliSeconds();
+    m_visibleWindowTimer.Reset();
+
+    const auto scrollPresenter = s_isVelocityAwareCacheEnabled ? m_scroller.try_as<winrt::ScrollPresenter>() : nullptr;
+    const winrt::ScrollingInteractionState state = scrollPresenter ? scrollPresenter.State() : winrt::ScrollingInteractionState::Idle;
+
+    if (state == winrt::ScrollingInteractionState::Idle)
+    {
+        ResetCacheBufferBias();
+        return;
+    }
+
+    if (m_visibleWindow.Width != effectiveViewport.Width || m_visibleWindow.Height != effectiveViewport.Height)
+    {
+        // Zooming or resizing, the position delta is not a scrolling velocity.
+        m_scrollVelocity = {};
+    }
+    else if (elapsedMilliseconds > 0)
+    {
+        const winrt::Point instantVelocity = {
+            (effectiveViewport.X - m_visibleWindow.X) * 1000.0f / elapsedMilliseconds,
+            (effectiveViewport.Y - m_visibleWindow.Y) * 1000.0f / elapsedMilliseconds };
+
+        if (elapsedMilliseconds > MaximumVelocitySampleInterval)
+        {
+            m_scrollVelocity = instantVelocity;
+        }
+        else
+        {
+            // Smooth out the jitter of individual frames.
+            m_scrollVelocity.X = (m_scrollVelocity.X + instantVelocity.X) / 2.0f;
+            m_scrollVelocity.Y = (m_scrollVelocity.Y + instantVelocity.Y) / 2.0f;
+        }
+    }
+
+    const bool isInertial = state == winrt::ScrollingInteractionState::Inertia;
+    double remainingInertiaDistanceX = 0.0;
+    double remainingInertiaDistanceY = 0.0;
+
+    if (isInertial)
+    {
+        const auto scrollPresenterImpl = winrt::get_self<ScrollPresenter>(scrollPresenter);
+        const winrt::float2 endOfInertiaPosition = scrollPresenterImpl->EndOfInertiaPosition();
+        const float endOfInertiaZoomFactor = scrollPresenterImpl->EndOfInertiaZoomFactor();
+        const float zoomFactor = scrollPresenter.ZoomFactor();
+
+        remainingInertiaDistanceX = endOfInertiaPosition.x / endOfInertiaZoomFactor - scrollPresenter.HorizontalOffset() / zoomFactor;
+        remainingInertiaDistanceY = endOfInertiaPosition.y / endOfInertiaZoomFactor - scrollPresenter.VerticalOffset() / zoomFactor;
+    }
+
+    m_horizontalCacheBufferBias = GetCacheBufferBias(
+        m_scrollVelocity.X, remainingInertiaDistanceX, m_maximumHorizontalCacheLength * effectiveViewport.Width / 2.0, isInertial);
+    m_verticalCacheBufferBias = GetCacheBufferBias(
+        m_scrollVelocity.Y, remainingInertiaDistanceY, m_maximumVerticalCacheLength * effectiveViewport.Height / 2.0, isInertial);
+
+    ITEMSREPEATER_TRACE_VERBOSE_DBG(nullptr, TRACE_MSG_METH_STR_STR_DBL_DBL, METH_NAME, this,
+        GetLayoutId().data(), L"Cache buffer biases:", m_horizontalCacheBufferBias, m_verticalCacheBufferBias);
+}
+
+// Returns True when a bias was reset.
+bool ViewportManager::ResetCacheBufferBias()
+{
+    m_scrollVelocity = {};
+
+    if (m_horizontalCacheBufferBias != 0.0 || m_verticalCacheBufferBias != 0.0)
+    {
+        ITEMSREPEATER_TRACE_VERBOSE_DBG(nullptr, TRACE_MSG_METH_STR_STR_DBL_DBL, METH_NAME, this,
+            GetLayoutId().data(), L"Cache buffer biases reset:", m_horizontalCacheBufferBias, m_verticalCacheBufferBias);
+
+        m_horizontalCacheBufferBias = 0.0;
+        m_verticalCacheBufferBias = 0.0;
+        return true;
+    }
+
+    return false;
+}
+
+/* static */
+double ViewportManager::GetCacheBufferBias(double velocity, double remainingInertiaDistance, double maximumCacheBufferPerSide, bool isInertial)
+{
+    if (maximumCacheBufferPerSide <= 0.0)
+    {
+        return 0.0;
+    }
+
+    if (isInertial)
+    {
+        // The leading side spans (1 + bias) * maximumCacheBufferPerSide once the cache is fully built.
+        // Only bias as much as needed to reach the resting view, so that no element beyond it gets realized.
+        const double bias = std::min(std::abs(remainingInertiaDistance) / maximumCacheBufferPerSide - 1.0, MaximumCacheBufferBias);
+
+        return bias <= 0.0 ? 0.0 : std::copysign(bias, remainingInertiaDistance);
+    }
+
+    return std::clamp(velocity / CacheBufferBiasFullVelocity, -1.0, 1.0) * MaximumCacheBufferBias;
+}
+
 void ViewportManager::ValidateCacheLength(double cacheLength)
 {
     if (cacheLength < 0.0 || std::isinf(cacheLength) || std::isnan(cacheLength))
@@ -5,6 +5,7 @@
 
 #include "ScrollingScrollStartingEventArgs.h"
 #include "ScrollingZoomStartingEventArgs.h"
+#include "QPCTimer.h"
 
 class ItemsRepeater;
 
@@ -44,6 +45,11 @@ public:
 
     winrt::UIElement MadeAnchor() const { return m_makeAnchorElement.get(); }
 
+    // When enabled, the cache buffer is shifted towards the scrolling direction while a ScrollPresenter
+    // is interacted with or in inertia, instead of being split evenly around the visible window.
+    static bool IsVelocityAwareCacheEnabled() { return s_isVelocityAwareCacheEnabled; }
+    static void IsVelocityAwareCacheEnabled(bool value) { s_isVelocityAwareCacheEnabled = value; }
+
 private:
     struct ScrollerInfo;
 
@@ -71,11 +77,15 @@ private:
     void OnScrollPresenterZoomCompleted(winrt::ScrollPresenter const& scrollPresenter, winrt::ScrollingZoomCompletedEventArgs const& args);
     void OnScrollPresenterViewChangeStarting(winrt::ScrollPresenter const& scrollPresenter, int correlationId, double horizontalOffset, double verticalOffset, float zoomFactor);
     void OnScrollPresenterViewChangeCompleted(int correlationId);
+    void OnScrollPresenterStateChanged(winrt::ScrollPresenter const& scrollPresenter, winrt::IInspectable const& args);
 
     void EnsureScroller();
     bool HasScroller() const { return m_scroller != nullptr; }
     bool UpdateViewport(winrt::Rect const& effectiveViewport);
     void ResetCacheBuffer(bool registerCacheBuildWork = true);
+    void UpdateCacheBufferBias(winrt::Rect const& effectiveViewport);
+    bool ResetCacheBufferBias();
+    static double GetCacheBufferBias(double velocity, double remainingInertiaDistance, double maximumCacheBufferPerSide, bool isInertial);
     void ValidateCacheLength(double cacheLength);
     void RegisterPreparedElementsAsArranged();
     void RegisterPreparedAndArrangedElementsAsScrollAnchorCandidates();
@@ -138,6 +148,16 @@ private:
     double m_horizontalCacheBufferPerSide{};
     double m_verticalCacheBufferPerSide{};
 
+    // Velocity-aware realization window fields.
+    // The biases are in [-MaximumCacheBufferBias, MaximumCacheBufferBias] and move that fraction
+    // of the trailing side's cache buffer to the leading side. A positive bias favors the
+    // right/bottom side.
+    static bool s_isVelocityAwareCacheEnabled;
+    QPCTimer m_visibleWindowTimer{};
+    winrt::Point m_scrollVelocity{};  // Smoothed, in layout pixels per second.
+    double m_horizontalCacheBufferBias{};
+    double m_verticalCacheBufferBias{};
+
     bool m_isBringIntoViewInProgress{ false };
     // For non-virtualizing layouts, we do not need to keep
     // updating viewports and invalidating measure often. So when
@@ -153,6 +173,7 @@ private:
     winrt::ScrollPresenter::ScrollCompleted_revoker m_scrollPresenterScrollCompletedRevoker{};
     winrt::ScrollPresenter::ZoomStarting_revoker m_scrollPresenterZoomStartingRevoker{};
     winrt::ScrollPresenter::ZoomCompleted_revoker m_scrollPresenterZoomCompletedRevoker{};
+    winrt::ScrollPresenter::StateChanged_revoker m_scrollPresenterStateChangedRevoker{};
     winrt::FrameworkElement::EffectiveViewportChanged_revoker m_effectiveViewportChangedRevoker{};
     winrt::FrameworkElement::LayoutUpdated_revoker m_layoutUpdatedRevoker{};
     winrt::Microsoft::UI::Xaml::Media::CompositionTarget::Rendering_revoker m_renderingToken{};
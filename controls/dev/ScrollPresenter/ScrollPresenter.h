@@ -192,6 +192,18 @@ public:
     bool IsElementValidAnchor(
         const winrt::UIElement& element);
 
+    // Invoked by ItemsRepeater's ViewportManager to anticipate the view at the end of an inertial phase.
+    // Only meaningful while State() is ScrollingInteractionState::Inertia.
+    winrt::float2 EndOfInertiaPosition() const
+    {
+        return m_endOfInertiaPosition;
+    }
+
+    float EndOfInertiaZoomFactor() const
+    {
+        return m_endOfInertiaZoomFactor;
+    }
+
 #pragma region Invoked by ScrollPresenterTestHooks
     float GetContentLayoutOffsetXDbg() const
     {
@@ -4172,4 +4172,317 @@ namespace Framework { namespace DataBinding {
         VerifyBindingTraceHelper(xamlString, expectedMessage);
     }
 
+
+    // A source whose properties change without raising PropertyChanged, so that tests choose which event is raised.
+    ref class TwoPropertyDataSource sealed : public Microsoft::UI::Xaml::Tests::Common::CustomPropertyProviderBase
+    {
+    protected:
+        void AddCustomProperties() override
+        {
+            AddCustomProperty(L"First", String::typeid,
+                MAKEPROPGET(TwoPropertyDataSource^, First),
+                MAKEPROPSET(TwoPropertyDataSource^, First, String^)
+                );
+            AddCustomProperty(L"Second", String::typeid,
+                MAKEPROPGET(TwoPropertyDataSource^, Second),
+                MAKEPROPSET(TwoPropertyDataSource^, Second, String^)
+                );
+        }
+
+    public:
+        property String^ First;
+        property String^ Second;
+
+        void RaisePropertyChanged(String^ name)
+        {
+            FirePropertyChanged(name);
+        }
+    };
+
+    void BindingIntegrationTests::CanNotifyAllPropertiesInSubscriptionOrder()
+    {
+        TestCleanupWrapper cleanup;
+        RunOnUIThread([]()
+        {
+            auto dataSource = ref new TwoPropertyDataSource();
+            dataSource->First = L"First";
+            dataSource->Second = L"Second";
+
+            // The bindings alternate between the two properties, so that notifying them property by property would
+            // change the order.
+            const wchar_t* paths[] = { L"Second", L"First", L"Second", L"First" };
+            std::vector<TextBlock^> targets;
+            std::vector<size_t> notifiedTargets;
+
+            for (const wchar_t* path : paths)
+            {
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(ref new String(path));
+                binding->Source = dataSource;
+                target->SetBinding(TextBlock::TextProperty, binding);
+
+                const size_t targetIndex = targets.size();
+                target->RegisterPropertyChangedCallback(TextBlock::TextProperty,
+                    ref new DependencyPropertyChangedCallback([&notifiedTargets, targetIndex](DependencyObject^, DependencyProperty^)
+                {
+                    notifiedTargets.push_back(targetIndex);
+                }));
+
+                targets.push_back(target);
+            }
+
+            String^ oldSecond = dataSource->Second;
+            dataSource->First = L"New first";
+            dataSource->Second = L"New second";
+
+            // A change to a single property only updates its bindings.
+            dataSource->RaisePropertyChanged(L"First");
+            VERIFY_IS_TRUE(notifiedTargets == std::vector<size_t>({ 1, 3 }));
+            VERIFY_ARE_EQUAL(oldSecond, targets[0]->Text);
+
+            // A change with no property name updates every binding, in the order they subscribed.
+            notifiedTargets.clear();
+            dataSource->First = L"Newer first";
+            dataSource->RaisePropertyChanged(nullptr);
+            VERIFY_IS_TRUE(notifiedTargets == std::vector<size_t>({ 0, 1, 2, 3 }));
+
+            for (size_t i = 0; i < targets.size(); ++i)
+            {
+                VERIFY_ARE_EQUAL((i % 2 == 0) ? dataSource->Second : dataSource->First, targets[i]->Text);
+            }
+
+            // Bindings that are cleared and set again subscribe last.
+            targets[0]->ClearValue(TextBlock::TextProperty);
+            auto binding = ref new Binding;
+            binding->Path = ref new PropertyPath(L"Second");
+            binding->Source = dataSource;
+            targets[0]->SetBinding(TextBlock::TextProperty, binding);
+
+            notifiedTargets.clear();
+            dataSource->First = L"Newest first";
+            dataSource->Second = L"Newest second";
+            dataSource->RaisePropertyChanged(L"");
+            VERIFY_IS_TRUE(notifiedTargets == std::vector<size_t>({ 1, 2, 3, 0 }));
+        });
+    }
+
+    void BindingIntegrationTests::CanNotifyEveryListenerWhenOneFails()
+    {
+        TestCleanupWrapper cleanup;
+        DisableErrorReportingScopeGuard disableErrors;
+
+        RunOnUIThread([]()
+        {
+            auto dataSource = ref new TwoPropertyDataSource();
+            dataSource->First = L"First";
+
+            bool shouldThrow = false;
+            auto converter = ref new CustomConverter;
+            converter->m_convertFunction = [&shouldThrow](Object^ value, wxaml_interop::TypeName, Object^, String^) -> Object^
+            {
+                if (shouldThrow)
+                {
+                    throw ref new Platform::FailureException;
+                }
+
+                return value;
+            };
+
+            std::vector<TextBlock^> targets;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(L"First");
+                binding->Source = dataSource;
+
+                // Only the binding in the middle fails.
+                if (i == 1)
+                {
+                    binding->Converter = converter;
+                }
+
+                target->SetBinding(TextBlock::TextProperty, binding);
+                targets.push_back(target);
+            }
+
+            shouldThrow = true;
+
+            for (String^ name : { ref new String(L"First"), static_cast<String^>(nullptr) })
+            {
+                dataSource->First = ref new String((name == nullptr) ? L"All properties" : L"Named property");
+
+                VERIFY_THROWS_WINRT(
+                    dataSource->RaisePropertyChanged(name),
+                    Platform::Exception^,
+                    L"The failure of the listener should be propagated to the source");
+
+                // The listeners after the one that failed are still notified.
+                VERIFY_ARE_EQUAL(dataSource->First, targets[0]->Text);
+                VERIFY_ARE_EQUAL(dataSource->First, targets[2]->Text);
+            }
+        });
+    }
+
+    void BindingIntegrationTests::CanRaiseUnboundPropertyOffThread()
+    {
+        TestCleanupWrapper cleanup;
+        DisableErrorReportingScopeGuard disableErrors;
+
+        TwoPropertyDataSource^ dataSource = nullptr;
+        TextBlock^ target = nullptr;
+
+        RunOnUIThread([&]()
+        {
+            dataSource = ref new TwoPropertyDataSource();
+            dataSource->First = L"First";
+
+            target = ref new TextBlock;
+            auto binding = ref new Binding;
+            binding->Path = ref new PropertyPath(L"First");
+            binding->Source = dataSource;
+            target->SetBinding(TextBlock::TextProperty, binding);
+        });
+
+        // Nothing listens to the second property, so the test thread can raise changes to it.
+        dataSource->RaisePropertyChanged(L"Second");
+
+        for (String^ name : { ref new String(L"First"), static_cast<String^>(nullptr) })
+        {
+            VERIFY_THROWS_WINRT(
+                dataSource->RaisePropertyChanged(name),
+                Platform::Exception^,
+                L"A change to a bound property can't be raised off the UI thread");
+        }
+
+        RunOnUIThread([&]()
+        {
+            VERIFY_ARE_EQUAL(L"First", target->Text);
+            target = nullptr;
+        });
+    }
+
+    void BindingIntegrationTests::CanShareCompiledPathAcrossSourceTypes()
+    {
+        TestCleanupWrapper cleanup;
+
+        RunOnUIThread([]()
+        {
+            auto dataSource = ref new TwoPropertyDataSource();
+            dataSource->First = L"Data source";
+
+            auto border = ref new Border;
+            border->Tag = L"Border";
+
+            // The source without the property comes first, so the data source is resolved after a failed lookup.
+            Object^ sources[] = { border, dataSource, border, dataSource };
+            std::vector<TextBlock^> targets;
+
+            for (Object^ source : sources)
+            {
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(L"First");
+                binding->Source = source;
+                binding->FallbackValue = L"Fallback";
+                target->SetBinding(TextBlock::TextProperty, binding);
+                targets.push_back(target);
+            }
+
+            for (size_t i = 0; i < targets.size(); ++i)
+            {
+                VERIFY_ARE_EQUAL(ref new String((i % 2 == 0) ? L"Fallback" : L"Data source"), targets[i]->Text);
+            }
+
+            // The same path resolves to a dependency property on one type of source, and to nothing on another.
+            for (Object^ source : { static_cast<Object^>(border), static_cast<Object^>(dataSource) })
+            {
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(L"Tag");
+                binding->Source = source;
+                binding->FallbackValue = L"Fallback";
+                target->SetBinding(TextBlock::TextProperty, binding);
+
+                VERIFY_ARE_EQUAL(ref new String((source == border) ? L"Border" : L"Fallback"), target->Text);
+            }
+
+            dataSource->First = L"New data source";
+            dataSource->RaisePropertyChanged(L"First");
+            VERIFY_ARE_EQUAL(dataSource->First, targets[1]->Text);
+            VERIFY_ARE_EQUAL(dataSource->First, targets[3]->Text);
+        });
+    }
+
+    void BindingIntegrationTests::CanBindAttachedPropertyPathFromSeveralTargets()
+    {
+        TestCleanupWrapper cleanup;
+
+        RunOnUIThread([]()
+        {
+            auto source = ref new Border;
+            Canvas::SetLeft(source, 12);
+
+            std::vector<TextBlock^> targets;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(L"(Canvas.Left)");
+                binding->Source = source;
+                target->SetBinding(TextBlock::TextProperty, binding);
+                targets.push_back(target);
+            }
+
+            for (TextBlock^ target : targets)
+            {
+                VERIFY_IS_TRUE(L"12" == target->Text);
+            }
+
+            Canvas::SetLeft(source, 24);
+
+            for (TextBlock^ target : targets)
+            {
+                VERIFY_IS_TRUE(L"24" == target->Text);
+            }
+        });
+    }
+
+    void BindingIntegrationTests::CanResolveCompiledPathAfterMetadataReset()
+    {
+        TestCleanupWrapper cleanup;
+
+        auto bindCustomString = [](String^ value)
+        {
+            RunOnUIThread([value]()
+            {
+                auto source = ref new CustomControl;
+                source->CustomString = value;
+
+                auto target = ref new TextBlock;
+                auto binding = ref new Binding;
+                binding->Path = ref new PropertyPath(L"CustomString");
+                binding->Source = source;
+                target->SetBinding(TextBlock::TextProperty, binding);
+
+                VERIFY_ARE_EQUAL(value, target->Text);
+
+                source->CustomString = L"Changed";
+                VERIFY_IS_TRUE(L"Changed" == target->Text);
+            });
+        };
+
+        bindCustomString(L"Before reset");
+
+        // Shutting down resets the metadata, and initializing registers the custom properties again.
+        LOG_OUTPUT(L"Re-initializing XAML");
+        TestServices::WindowHelper->ShutdownXaml();
+        TestServices::WindowHelper->InitializeXaml(ref new MetadataProvider(), ref new CustomMetadataRegistrar<MultiClassRegistrator>());
+
+        bindCustomString(L"After reset");
+    }
+
 } } } } } }
@@ -353,6 +353,30 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests {
                 TEST_METHOD_PROPERTY(L"Description", L"Verify the BindingFailed event if the binding couldn't connect to a string indexer.")
             END_TEST_METHOD()
 
+            BEGIN_TEST_METHOD(CanNotifyAllPropertiesInSubscriptionOrder)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that a PropertyChanged event with no property name updates the bindings of a source in the order they subscribed.")
+            END_TEST_METHOD()
+
+            BEGIN_TEST_METHOD(CanNotifyEveryListenerWhenOneFails)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that a binding that fails to update doesn't keep the other bindings of the source from updating, and that the failure reaches the source.")
+            END_TEST_METHOD()
+
+            BEGIN_TEST_METHOD(CanRaiseUnboundPropertyOffThread)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that a source can raise PropertyChanged on another thread for properties that aren't bound, and that changes to bound properties still fail there.")
+            END_TEST_METHOD()
+
+            BEGIN_TEST_METHOD(CanShareCompiledPathAcrossSourceTypes)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that bindings with the same path resolve it for each type of source, including sources that don't have the property.")
+            END_TEST_METHOD()
+
+            BEGIN_TEST_METHOD(CanBindAttachedPropertyPathFromSeveralTargets)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that bindings with the same attached property path each resolve and update it.")
+            END_TEST_METHOD()
+
+            BEGIN_TEST_METHOD(CanResolveCompiledPathAfterMetadataReset)
+                TEST_METHOD_PROPERTY(L"Description", L"Verify that a path resolved to a custom property before the metadata is reset resolves to the property registered after it.")
+            END_TEST_METHOD()
+
         private:
         };
 
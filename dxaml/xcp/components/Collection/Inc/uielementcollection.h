@@ -9,6 +9,7 @@
 
 enum UnloadCleanup;
 class CTransitionRoot;
+class HitTestGrid;
 class UIElementCollectionUnloadingStorage;
 struct ICollectionChangeCallback;
 
@@ -71,6 +72,11 @@ public:
 
     void SetSortedCollectionDirty(_In_ bool fDirty) { m_fSortedElementsDirty = fDirty; }
 
+    // Spatial index over the children in render order, maintained by the owner while it computes its child bounds.
+    HitTestGrid* GetHitTestGrid() const { return m_pHitTestGrid; }
+    HitTestGrid& EnsureHitTestGrid();
+    void DestroyHitTestGrid();
+
     // the bool indicates whether we executed extra removal code which indicates this was an element that
     // was unloading.
     _Check_return_ HRESULT RemoveUnloadedElement(_In_ CUIElement* pTarget, UINT unloadContext, _Out_ bool* pfExecutedUnload);
@@ -130,6 +136,9 @@ private:
     // Because this list doesn't hold references, it's not safe to access once the collection is modified.
     CUIElement**                            m_ppSortedUIElements    = nullptr;
 
+    // Only created for collections with enough children to make hit testing them linearly expensive.
+    HitTestGrid*                            m_pHitTestGrid          = nullptr;
+
     bool m_fSortedElementsDirty = false;
 
     std::weak_ptr<ICollectionChangeCallback> m_wrChangeCallback;
@@ -165,6 +165,9 @@ CResourceDictionaryCollection::OnRemoveFromCollection(_In_ CDependencyObject *pD
     }
     pDictionary->SetResourceOwner(nullptr);
 
+    // Keys found through the removed dictionary are no longer found through its parent.
+    pDictionary->InvalidateResolutionCache();
+
     IFC_RETURN(CDOCollection::OnRemoveFromCollection(pDO, iPreviousIndex));
 
     return S_OK;
@@ -216,6 +219,11 @@ CResourceDictionaryCollection::Clear()
 
     if (pOldDictionaries)
     {
+        if (CResourceDictionary* parentDictionary = do_pointer_cast<CResourceDictionary>(GetParentInternal(false)))
+        {
+            parentDictionary->InvalidateResolutionCache();
+        }
+
         IFC(pOldDictionaries->InvalidateImplicitStyles());
         // has sideeffects that were skipped in the clear of this dictionary because it was not the parent.
         // The dtor of pOldDictionaries will not run on the Cleanup because there is a managed peer holding on to it
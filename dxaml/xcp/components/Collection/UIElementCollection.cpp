@@ -10,6 +10,7 @@
 #include <DOCollection.h>
 #include <DXamlServices.h>
 #include <AutoReentrantReferenceLock.h>
+#include <HitTestGrid.h>
 #include <CValue.h>
 #include <UIElement.h>
 #include <double.h>
@@ -179,6 +180,7 @@ CUIElementCollection::~CUIElementCollection()
     ReleaseInterface(m_pLocalTransitionRoot);
     IGNOREHR(RemoveAllElements(false)); // do not attempt to unload elements that we are removing when destructing.
     delete m_pUnloadingStorage;
+    DestroyHitTestGrid();
 }
 
 //------------------------------------------------------------------------
@@ -221,6 +223,29 @@ CUIElementCollection::DestroySortedCollection()
     SAFE_DELETE_ARRAY(m_ppSortedUIElements);
 }
 
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Returns the hit test grid, creating an empty one if needed.
+//
+//------------------------------------------------------------------------
+HitTestGrid&
+CUIElementCollection::EnsureHitTestGrid()
+{
+    if (!m_pHitTestGrid)
+    {
+        m_pHitTestGrid = new HitTestGrid();
+    }
+
+    return *m_pHitTestGrid;
+}
+
+void
+CUIElementCollection::DestroyHitTestGrid()
+{
+    SAFE_DELETE(m_pHitTestGrid);
+}
+
 //------------------------------------------------------------------------
 //
 //  Synopsis:
@@ -37,6 +37,7 @@
 #include "KeyTimeVO.h"
 #include <FocusableHelper.h>
 #include "CircularMemoryLogger.h"
+#include "XamlTelemetry.h"
 
 using namespace DirectUI;
 
@@ -2531,7 +2532,7 @@ _Check_return_ HRESULT CDependencyObject::SetEffectiveValueInSparseStorage(_In_
         // and replacing the table must be done in a gc thread safe manner
         AutoReentrantReferenceLock lock(DXamlServices::GetPeerTableHost());
 
-        m_pValueTable.reset(new SparseValueTable);
+        m_pValueTable.reset(new SparseValueTable(SparseValueTableLayout::Get(GetTypeIndex())));
     }
 
     SparseValueTable::iterator sparseEntry;
@@ -2542,7 +2543,15 @@ _Check_return_ HRESULT CDependencyObject::SetEffectiveValueInSparseStorage(_In_
 
         // If this property doesn't yet have an entry, populate a default one
         // If it does, then insert is a no-op
-        sparseEntry = m_pValueTable->insert(std::make_pair(args.m_pDP->GetIndex(), EffectiveValue())).first;
+        auto insertResult = m_pValueTable->insert(std::make_pair(args.m_pDP->GetIndex(), EffectiveValue()));
+        sparseEntry = insertResult.first;
+
+#ifdef TRACE_SPARSE_PROPERTIES
+        if (insertResult.second)
+        {
+            SparseValueTableLayout::RecordNewEntry(GetTypeIndex(), args.m_pDP->GetIndex());
+        }
+#endif
     }
 
     if (sparseEntry->second.value.GetType() != valueAny)
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include <SparseValueTable.h>
+#include <MetadataAPI.h>
+#include <TypeTableStructs.h>
+#include "XamlTelemetry.h"
+
+#ifdef TRACE_SPARSE_PROPERTIES
+#include <mutex>
+#include <unordered_map>
+#endif
+
+using namespace DirectUI;
+
+namespace
+{
+    // Properties are listed from most to least frequently set, as counted while loading the built-in control
+    // templates. Types not listed here use the layout of their closest listed base type.
+    const SparseValueTableLayout c_layouts[] =
+    {
+        {
+            KnownTypeIndex::Control, 5,
+            {
+                KnownPropertyIndex::UIElement_UseSystemFocusVisuals,
+                KnownPropertyIndex::FrameworkElement_FocusVisualMargin,
+                KnownPropertyIndex::FrameworkElement_AllowFocusOnInteraction,
+                KnownPropertyIndex::Control_BackgroundSizing,
+                KnownPropertyIndex::Control_CornerRadius,
+            }
+        },
+        {
+            KnownTypeIndex::ContentPresenter, 8,
+            {
+                KnownPropertyIndex::ContentPresenter_VerticalContentAlignment,
+                KnownPropertyIndex::ContentPresenter_HorizontalContentAlignment,
+                KnownPropertyIndex::ContentPresenter_BorderBrush,
+                KnownPropertyIndex::ContentPresenter_BorderThickness,
+                KnownPropertyIndex::ContentPresenter_Padding,
+                KnownPropertyIndex::ContentPresenter_Background,
+                KnownPropertyIndex::ContentPresenter_CornerRadius,
+                KnownPropertyIndex::ContentPresenter_BackgroundSizing,
+            }
+        },
+        {
+            KnownTypeIndex::Grid, 4,
+            {
+                KnownPropertyIndex::Grid_CornerRadius,
+                KnownPropertyIndex::Grid_BorderBrush,
+                KnownPropertyIndex::Grid_BorderThickness,
+                KnownPropertyIndex::Grid_Padding,
+            }
+        },
+        {
+            KnownTypeIndex::ScrollViewer, 5,
+            {
+                KnownPropertyIndex::ScrollViewer_VerticalScrollBarVisibility,
+                KnownPropertyIndex::ScrollViewer_ZoomMode,
+                KnownPropertyIndex::ScrollViewer_HorizontalScrollBarVisibility,
+                KnownPropertyIndex::ScrollViewer_HorizontalScrollMode,
+                KnownPropertyIndex::ScrollViewer_VerticalScrollMode,
+            }
+        },
+        {
+            KnownTypeIndex::Border, 2,
+            {
+                KnownPropertyIndex::Border_BackgroundSizing,
+                KnownPropertyIndex::UIElement_RenderTransformOrigin,
+            }
+        },
+        {
+            KnownTypeIndex::TextBlock, 1,
+            {
+                KnownPropertyIndex::FrameworkElement_Style,
+            }
+        },
+        {
+            KnownTypeIndex::FontIcon, 1,
+            {
+                KnownPropertyIndex::FontIcon_MirroredWhenRightToLeft,
+            }
+        },
+        {
+            KnownTypeIndex::Shape, 1,
+            {
+                KnownPropertyIndex::Shape_StrokeThickness,
+            }
+        },
+    };
+}
+
+const SparseValueTableLayout SparseValueTableLayout::s_empty = { KnownTypeIndex::UnknownType, 0, {} };
+
+const SparseValueTableLayout* SparseValueTableLayout::Get(KnownTypeIndex typeIndex)
+{
+    // Only called when an object creates its sparse storage, so walking the base types each time is cheap enough.
+    for (const CClassInfo* type = MetadataAPI::GetClassInfoByIndex(typeIndex);
+         type->GetIndex() != KnownTypeIndex::UnknownType;
+         type = type->GetBaseType())
+    {
+        for (const auto& layout : c_layouts)
+        {
+            if (layout.m_typeIndex == type->GetIndex())
+            {
+                return &layout;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+#ifdef TRACE_SPARSE_PROPERTIES
+void SparseValueTableLayout::RecordNewEntry(KnownTypeIndex typeIndex, KnownPropertyIndex propertyIndex)
+{
+    static std::mutex s_mutex;
+    static std::unordered_map<std::uint32_t, std::uint32_t> s_counts;
+
+    std::uint32_t count = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        count = ++s_counts[(static_cast<std::uint32_t>(typeIndex) << 16) | static_cast<std::uint32_t>(propertyIndex)];
+    }
+
+    // Log each pair at every power of two rather than on every set. The last event for a pair has its count within
+    // a factor of two, which is precise enough to rank the properties of a type.
+    if ((count & (count - 1)) == 0)
+    {
+        TraceLoggingProviderWrite(
+            XamlTelemetry, "SparseProperties - NewEntry",
+            TraceLoggingWideString(MetadataAPI::GetClassInfoByIndex(typeIndex)->GetName().GetBuffer(), "Type"),
+            TraceLoggingWideString(MetadataAPI::GetPropertyBaseByIndex(propertyIndex)->GetName().GetBuffer(), "Property"),
+            TraceLoggingUInt32(count, "Count"),
+            TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+    }
+}
+#endif
@@ -0,0 +1,350 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <cstdint>
+#include <Indexes.g.h>
+#include "EffectiveValue.h"
+
+// Assigns a type's most frequently set sparse properties to dense slots in its SparseValueTable. The layouts are
+// picked from the counters emitted with TRACE_SPARSE_PROPERTIES (see XamlTelemetry.h).
+struct SparseValueTableLayout
+{
+    static constexpr std::uint8_t c_maxDenseSlots = 8;
+    static constexpr std::uint8_t c_noSlot = c_maxDenseSlots;
+
+    constexpr SparseValueTableLayout(
+        KnownTypeIndex typeIndex,
+        std::uint8_t slotCount,
+        const KnownPropertyIndex (&properties)[c_maxDenseSlots])
+        : m_typeIndex(typeIndex)
+        , m_slotCount(slotCount)
+        , m_properties{}
+        , m_propertyFilter(0)
+    {
+        for (std::uint8_t slot = 0; slot < slotCount; ++slot)
+        {
+            m_properties[slot] = properties[slot];
+            m_propertyFilter |= GetFilterBit(properties[slot]);
+        }
+    }
+
+    KnownTypeIndex      m_typeIndex;
+    std::uint8_t        m_slotCount;
+    KnownPropertyIndex  m_properties[c_maxDenseSlots];
+
+    // One bit per property index modulo 64. Most properties set on an object aren't in its layout, and a single test
+    // of this filter rejects them without scanning m_properties.
+    std::uint64_t       m_propertyFilter;
+
+    std::uint8_t GetSlot(KnownPropertyIndex index) const
+    {
+        if ((m_propertyFilter & GetFilterBit(index)) == 0)
+        {
+            return c_noSlot;
+        }
+
+        for (std::uint8_t slot = 0; slot < m_slotCount; ++slot)
+        {
+            if (m_properties[slot] == index)
+            {
+                return slot;
+            }
+        }
+
+        return c_noSlot;
+    }
+
+    // Returns the layout of the type or of its closest base type that has one, or nullptr.
+    static const SparseValueTableLayout* Get(KnownTypeIndex typeIndex);
+
+    // A layout without dense slots, used by tables whose type has no layout so that looking up a slot doesn't need a
+    // null check.
+    static const SparseValueTableLayout s_empty;
+
+    // Counts a property getting an entry in the sparse storage of an object of the given type. Only available with
+    // TRACE_SPARSE_PROPERTIES.
+    static void RecordNewEntry(KnownTypeIndex typeIndex, KnownPropertyIndex propertyIndex);
+
+private:
+    static constexpr std::uint64_t GetFilterBit(KnownPropertyIndex index)
+    {
+        return std::uint64_t(1) << (static_cast<std::uint32_t>(index) & 63);
+    }
+};
+
+// Sparse property storage of a CDependencyObject. Behaves like a vector_map<KnownPropertyIndex, EffectiveValue>, except
+// that the properties in the owner type's layout live in dense slots at the front of the storage, where they are
+// found without a binary search and inserted without shifting other entries. Other properties follow in key order.
+// The dense slots are only allocated once one of the layout's properties is set, so objects that never set any of
+// them pay nothing for the layout.
+//
+// Iteration visits the occupied dense slots first, so entries aren't returned in key order. As with vector_map,
+// adding an entry can invalidate iterators.
+class SparseValueTable
+{
+public:
+    using key_type      = KnownPropertyIndex;
+    using mapped_type   = EffectiveValue;
+    using value_type    = std::pair<KnownPropertyIndex, EffectiveValue>;
+    using size_type     = std::size_t;
+
+private:
+    template <typename Table, typename Value>
+    class iterator_base
+    {
+        friend class SparseValueTable;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = SparseValueTable::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Value*;
+        using reference         = Value&;
+
+        iterator_base() = default;
+
+        // Allows converting an iterator into a const_iterator.
+        template <typename OtherTable, typename OtherValue>
+        iterator_base(const iterator_base<OtherTable, OtherValue>& other)
+            : m_table(other.m_table)
+            , m_position(other.m_position)
+        {}
+
+        reference operator*() const     { return m_table->m_entries[m_position]; }
+        pointer operator->() const      { return &m_table->m_entries[m_position]; }
+
+        iterator_base& operator++()
+        {
+            m_position = m_table->SkipEmptySlots(m_position + 1);
+            return *this;
+        }
+
+        iterator_base operator++(int)
+        {
+            iterator_base result = *this;
+            ++(*this);
+            return result;
+        }
+
+        template <typename OtherTable, typename OtherValue>
+        bool operator==(const iterator_base<OtherTable, OtherValue>& other) const
+        {
+            return m_position == other.m_position;
+        }
+
+        template <typename OtherTable, typename OtherValue>
+        bool operator!=(const iterator_base<OtherTable, OtherValue>& other) const
+        {
+            return m_position != other.m_position;
+        }
+
+    private:
+        template <typename OtherTable, typename OtherValue>
+        friend class iterator_base;
+
+        iterator_base(Table* table, std::size_t position)
+            : m_table(table)
+            , m_position(position)
+        {}
+
+        Table*      m_table     = nullptr;
+        std::size_t m_position  = 0;
+    };
+
+public:
+    using iterator          = iterator_base<SparseValueTable, value_type>;
+    using const_iterator    = iterator_base<const SparseValueTable, const value_type>;
+
+    explicit SparseValueTable(_In_opt_ const SparseValueTableLayout* layout = nullptr)
+        : m_layout(layout ? layout : &SparseValueTableLayout::s_empty)
+    {}
+
+    SparseValueTable(const SparseValueTable&) = delete;
+    SparseValueTable& operator=(const SparseValueTable&) = delete;
+
+    iterator begin()                    { return iterator(this, SkipEmptySlots(0)); }
+    const_iterator begin() const        { return const_iterator(this, SkipEmptySlots(0)); }
+    iterator end()                      { return iterator(this, m_entries.size()); }
+    const_iterator end() const          { return const_iterator(this, m_entries.size()); }
+
+    size_type size() const              { return m_size; }
+    bool empty() const                  { return m_size == 0; }
+
+    iterator find(KnownPropertyIndex index)
+    {
+        return iterator(this, FindPosition(index));
+    }
+
+    const_iterator find(KnownPropertyIndex index) const
+    {
+        return const_iterator(this, FindPosition(index));
+    }
+
+    // If the property doesn't have an entry yet, adds one with the value moved from the pair. Returns the entry and
+    // whether it was added.
+    std::pair<iterator, bool> insert(value_type&& entry)
+    {
+        const std::uint8_t slot = GetSlot(entry.first);
+
+        if (slot != SparseValueTableLayout::c_noSlot)
+        {
+            if (m_denseCount == 0)
+            {
+                AllocateDenseSlots();
+            }
+
+            const bool inserted = !IsSlotOccupied(slot);
+
+            if (inserted)
+            {
+                m_entries[slot].second = std::move(entry.second);
+                m_occupiedSlots |= static_cast<std::uint8_t>(1u << slot);
+                ++m_size;
+            }
+
+            return { iterator(this, slot), inserted };
+        }
+
+        auto position = LowerBound(entry.first);
+
+        if (position != m_entries.end() && position->first == entry.first)
+        {
+            return { iterator(this, position - m_entries.begin()), false };
+        }
+
+        position = m_entries.insert(position, std::move(entry));
+        ++m_size;
+
+        return { iterator(this, position - m_entries.begin()), true };
+    }
+
+    // Returns the value of the property, adding a default-constructed one if it doesn't have an entry yet.
+    EffectiveValue& operator[](KnownPropertyIndex index)
+    {
+        return insert(value_type(index, EffectiveValue())).first->second;
+    }
+
+    iterator erase(iterator position)
+    {
+        ASSERT(position.m_table == this && position.m_position < m_entries.size());
+
+        if (position.m_position < m_denseCount)
+        {
+            const std::uint8_t slot = static_cast<std::uint8_t>(position.m_position);
+
+            ASSERT(IsSlotOccupied(slot));
+
+            // The slot keeps its key, so only release the value.
+            m_entries[slot].second = EffectiveValue();
+            m_occupiedSlots &= static_cast<std::uint8_t>(~(1u << slot));
+            --m_size;
+
+            return iterator(this, SkipEmptySlots(position.m_position + 1));
+        }
+
+        auto next = m_entries.erase(m_entries.begin() + position.m_position);
+        --m_size;
+
+        return iterator(this, next - m_entries.begin());
+    }
+
+    const SparseValueTableLayout* GetLayout() const
+    {
+        return (m_layout != &SparseValueTableLayout::s_empty) ? m_layout : nullptr;
+    }
+
+    // Number of dense slots allocated, which is zero until one of the layout's properties is set.
+    std::uint8_t GetDenseSlotCount() const
+    {
+        return m_denseCount;
+    }
+
+private:
+    std::uint8_t GetSlot(KnownPropertyIndex index) const
+    {
+        return m_layout->GetSlot(index);
+    }
+
+    // Puts the layout's slots in front of the sorted entries. Done once, on the first set of a layout property.
+    void AllocateDenseSlots()
+    {
+        std::vector<value_type> entries;
+        entries.reserve(m_layout->m_slotCount + m_entries.size());
+
+        for (std::uint8_t slot = 0; slot < m_layout->m_slotCount; ++slot)
+        {
+            entries.emplace_back(m_layout->m_properties[slot], EffectiveValue());
+        }
+
+        entries.insert(entries.end(), std::make_move_iterator(m_entries.begin()), std::make_move_iterator(m_entries.end()));
+        m_entries.swap(entries);
+        m_denseCount = m_layout->m_slotCount;
+    }
+
+    bool IsSlotOccupied(std::uint8_t slot) const
+    {
+        return (m_occupiedSlots & (1u << slot)) != 0;
+    }
+
+    std::size_t SkipEmptySlots(std::size_t position) const
+    {
+        while (position < m_denseCount && !IsSlotOccupied(static_cast<std::uint8_t>(position)))
+        {
+            ++position;
+        }
+
+        return position;
+    }
+
+    std::vector<value_type>::iterator LowerBound(KnownPropertyIndex index)
+    {
+        return std::lower_bound(
+            m_entries.begin() + m_denseCount,
+            m_entries.end(),
+            index,
+            [](const value_type& entry, KnownPropertyIndex key) { return entry.first < key; });
+    }
+
+    std::vector<value_type>::const_iterator LowerBound(KnownPropertyIndex index) const
+    {
+        return std::lower_bound(
+            m_entries.begin() + m_denseCount,
+            m_entries.end(),
+            index,
+            [](const value_type& entry, KnownPropertyIndex key) { return entry.first < key; });
+    }
+
+    std::size_t FindPosition(KnownPropertyIndex index) const
+    {
+        const std::uint8_t slot = GetSlot(index);
+
+        if (slot != SparseValueTableLayout::c_noSlot)
+        {
+            return IsSlotOccupied(slot) ? slot : m_entries.size();
+        }
+
+        auto position = LowerBound(index);
+
+        if (position != m_entries.end() && position->first == index)
+        {
+            return position - m_entries.begin();
+        }
+
+        return m_entries.size();
+    }
+
+    static_assert(SparseValueTableLayout::c_maxDenseSlots <= 8, "m_occupiedSlots needs a bit per dense slot.");
+
+    // The first m_denseCount entries are the dense slots, in layout order. The rest are sorted by key.
+    std::vector<value_type>             m_entries;
+    const SparseValueTableLayout*       m_layout;
+    std::size_t                         m_size          = 0;
+    std::uint8_t                        m_denseCount    = 0;
+    std::uint8_t                        m_occupiedSlots = 0;
+};
@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+
+#include "SparseValueTableUnitTests.h"
+
+#include <vector>
+#include <MetadataAPI.h>
+#include <SparseValueTable.h>
+
+using namespace DirectUI;
+
+namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespace Framework { namespace DependencyObject {
+
+    namespace
+    {
+        const SparseValueTableLayout c_testLayout =
+        {
+            KnownTypeIndex::ContentPresenter, 2,
+            {
+                KnownPropertyIndex::ContentPresenter_Padding,
+                KnownPropertyIndex::ContentPresenter_BorderThickness,
+            }
+        };
+
+        void SetEntry(SparseValueTable& table, KnownPropertyIndex index, XINT32 value)
+        {
+            table[index].value.SetSigned(value);
+        }
+
+        XINT32 GetEntry(SparseValueTable& table, KnownPropertyIndex index)
+        {
+            auto iter = table.find(index);
+            VERIFY_IS_TRUE(iter != table.end());
+            return iter->second.value.AsSigned();
+        }
+    }
+
+    void SparseValueTableUnitTests::CanInsertFindAndEraseDenseAndSparseEntries()
+    {
+        SparseValueTable table(&c_testLayout);
+        VERIFY_IS_TRUE(table.empty());
+        VERIFY_IS_TRUE(table.begin() == table.end());
+
+        // The dense slots are only allocated once a property of the layout is set.
+        VERIFY_IS_TRUE(table.find(KnownPropertyIndex::ContentPresenter_Padding) == table.end());
+        VERIFY_ARE_EQUAL(table.GetDenseSlotCount(), static_cast<std::uint8_t>(0));
+
+        SetEntry(table, KnownPropertyIndex::FrameworkElement_Tag, 2);
+        SetEntry(table, KnownPropertyIndex::UnknownType_UnknownProperty, 3);
+        VERIFY_ARE_EQUAL(table.GetDenseSlotCount(), static_cast<std::uint8_t>(0));
+
+        // Allocating the dense slots keeps the entries that were already there.
+        SetEntry(table, KnownPropertyIndex::ContentPresenter_Padding, 1);
+        VERIFY_ARE_EQUAL(table.GetDenseSlotCount(), c_testLayout.m_slotCount);
+        VERIFY_ARE_EQUAL(table.size(), static_cast<size_t>(3));
+
+        VERIFY_ARE_EQUAL(GetEntry(table, KnownPropertyIndex::ContentPresenter_Padding), 1);
+        VERIFY_ARE_EQUAL(GetEntry(table, KnownPropertyIndex::FrameworkElement_Tag), 2);
+        VERIFY_ARE_EQUAL(GetEntry(table, KnownPropertyIndex::UnknownType_UnknownProperty), 3);
+        VERIFY_IS_TRUE(table.find(KnownPropertyIndex::ContentPresenter_BorderThickness) == table.end());
+
+        // Inserting an existing entry keeps its value.
+        auto result = table.insert(std::make_pair(KnownPropertyIndex::ContentPresenter_Padding, EffectiveValue()));
+        VERIFY_IS_FALSE(result.second);
+        VERIFY_ARE_EQUAL(result.first->second.value.AsSigned(), 1);
+
+        result = table.insert(std::make_pair(KnownPropertyIndex::FrameworkElement_Tag, EffectiveValue()));
+        VERIFY_IS_FALSE(result.second);
+        VERIFY_ARE_EQUAL(result.first->second.value.AsSigned(), 2);
+
+        table.erase(table.find(KnownPropertyIndex::ContentPresenter_Padding));
+        table.erase(table.find(KnownPropertyIndex::FrameworkElement_Tag));
+        VERIFY_ARE_EQUAL(table.size(), static_cast<size_t>(1));
+        VERIFY_IS_TRUE(table.find(KnownPropertyIndex::ContentPresenter_Padding) == table.end());
+        VERIFY_IS_TRUE(table.find(KnownPropertyIndex::FrameworkElement_Tag) == table.end());
+
+        // An erased dense slot comes back with a fresh value.
+        result = table.insert(std::make_pair(KnownPropertyIndex::ContentPresenter_Padding, EffectiveValue()));
+        VERIFY_IS_TRUE(result.second);
+        VERIFY_IS_TRUE(result.first->second.value.IsUnset());
+    }
+
+    void SparseValueTableUnitTests::CanIterateDenseAndSparseEntries()
+    {
+        SparseValueTable table(&c_testLayout);
+
+        SetEntry(table, KnownPropertyIndex::FrameworkElement_Tag, 1);
+        SetEntry(table, KnownPropertyIndex::ContentPresenter_BorderThickness, 2);
+        SetEntry(table, KnownPropertyIndex::UIElement_RenderTransformOrigin, 3);
+
+        // Occupied dense slots come first, in layout order, followed by the other entries in key order. The empty
+        // Padding slot is skipped.
+        std::vector<KnownPropertyIndex> expected =
+        {
+            KnownPropertyIndex::ContentPresenter_BorderThickness,
+            std::min(KnownPropertyIndex::FrameworkElement_Tag, KnownPropertyIndex::UIElement_RenderTransformOrigin),
+            std::max(KnownPropertyIndex::FrameworkElement_Tag, KnownPropertyIndex::UIElement_RenderTransformOrigin),
+        };
+
+        std::vector<KnownPropertyIndex> actual;
+        for (auto& entry : table)
+        {
+            actual.push_back(entry.first);
+        }
+
+        VERIFY_IS_TRUE(actual == expected);
+
+        // Erasing while iterating returns the next entry.
+        auto iter = table.begin();
+        while (iter != table.end())
+        {
+            iter = table.erase(iter);
+        }
+
+        VERIFY_IS_TRUE(table.empty());
+        VERIFY_IS_TRUE(table.begin() == table.end());
+    }
+
+    void SparseValueTableUnitTests::DoesUseClosestBaseTypeLayout()
+    {
+        const SparseValueTableLayout* controlLayout = SparseValueTableLayout::Get(KnownTypeIndex::Control);
+        VERIFY_IS_NOT_NULL(controlLayout);
+        VERIFY_IS_TRUE(controlLayout->m_typeIndex == KnownTypeIndex::Control);
+
+        // Button has no layout of its own.
+        VERIFY_ARE_EQUAL(SparseValueTableLayout::Get(KnownTypeIndex::Button), controlLayout);
+
+        const SparseValueTableLayout* contentPresenterLayout = SparseValueTableLayout::Get(KnownTypeIndex::ContentPresenter);
+        VERIFY_IS_NOT_NULL(contentPresenterLayout);
+        VERIFY_IS_TRUE(contentPresenterLayout->m_typeIndex == KnownTypeIndex::ContentPresenter);
+
+        VERIFY_IS_NULL(SparseValueTableLayout::Get(KnownTypeIndex::DependencyObject));
+        VERIFY_IS_NULL(SparseValueTableLayout::Get(KnownTypeIndex::FrameworkElement));
+    }
+
+    void SparseValueTableUnitTests::DoesRejectPropertiesOutsideLayout()
+    {
+        VERIFY_ARE_EQUAL(c_testLayout.GetSlot(KnownPropertyIndex::ContentPresenter_Padding), static_cast<std::uint8_t>(0));
+        VERIFY_ARE_EQUAL(c_testLayout.GetSlot(KnownPropertyIndex::ContentPresenter_BorderThickness), static_cast<std::uint8_t>(1));
+
+        // Properties outside of the layout are rejected, whether or not they share a filter bit with one inside it.
+        VERIFY_ARE_EQUAL(c_testLayout.GetSlot(KnownPropertyIndex::FrameworkElement_Tag), SparseValueTableLayout::c_noSlot);
+        VERIFY_ARE_EQUAL(c_testLayout.GetSlot(KnownPropertyIndex::ContentPresenter_Background), SparseValueTableLayout::c_noSlot);
+
+        // A table without a layout never gets dense slots.
+        SparseValueTable table;
+        VERIFY_IS_NULL(table.GetLayout());
+        SetEntry(table, KnownPropertyIndex::ContentPresenter_Padding, 1);
+        VERIFY_ARE_EQUAL(table.GetDenseSlotCount(), static_cast<std::uint8_t>(0));
+        VERIFY_ARE_EQUAL(GetEntry(table, KnownPropertyIndex::ContentPresenter_Padding), 1);
+    }
+
+    void SparseValueTableUnitTests::TemplateInstantiationBenchmark()
+    {
+        // The sparse properties a typical control template sets on its ContentPresenter, in markup order, plus two that
+        // aren't in the layout.
+        static const KnownPropertyIndex templateProperties[] =
+        {
+            KnownPropertyIndex::ContentPresenter_Background,
+            KnownPropertyIndex::ContentPresenter_BackgroundSizing,
+            KnownPropertyIndex::ContentPresenter_BorderBrush,
+            KnownPropertyIndex::ContentPresenter_BorderThickness,
+            KnownPropertyIndex::ContentPresenter_CornerRadius,
+            KnownPropertyIndex::ContentPresenter_Padding,
+            KnownPropertyIndex::ContentPresenter_HorizontalContentAlignment,
+            KnownPropertyIndex::ContentPresenter_VerticalContentAlignment,
+            KnownPropertyIndex::UIElement_RenderTransformOrigin,
+            KnownPropertyIndex::FrameworkElement_Tag,
+        };
+
+        const SparseValueTableLayout* layout = SparseValueTableLayout::Get(KnownTypeIndex::ContentPresenter);
+        VERIFY_IS_NOT_NULL(layout);
+
+        RunBenchmark(L"ContentPresenter template instantiation", layout, templateProperties, ARRAYSIZE(templateProperties));
+    }
+
+    void SparseValueTableUnitTests::OutOfLayoutPropertiesBenchmark()
+    {
+        // Properties commonly set on a ContentPresenter from markup or code, all but the last of which are outside of
+        // its layout. This measures what the layout costs objects that rarely set the properties it was ranked for.
+        static const KnownPropertyIndex properties[] =
+        {
+            KnownPropertyIndex::FrameworkElement_Tag,
+            KnownPropertyIndex::UIElement_RenderTransformOrigin,
+            KnownPropertyIndex::FrameworkElement_Style,
+            KnownPropertyIndex::FrameworkElement_FocusVisualMargin,
+            KnownPropertyIndex::FrameworkElement_AllowFocusOnInteraction,
+            KnownPropertyIndex::UIElement_UseSystemFocusVisuals,
+            KnownPropertyIndex::ContentPresenter_Padding,
+        };
+
+        const SparseValueTableLayout* layout = SparseValueTableLayout::Get(KnownTypeIndex::ContentPresenter);
+        VERIFY_IS_NOT_NULL(layout);
+
+        RunBenchmark(L"ContentPresenter with properties mostly outside its layout", layout, properties, ARRAYSIZE(properties));
+    }
+
+    void SparseValueTableUnitTests::RunBenchmark(
+        _In_z_ const wchar_t* name,
+        _In_ const SparseValueTableLayout* layout,
+        _In_reads_(propertyCount) const KnownPropertyIndex* properties,
+        size_t propertyCount)
+    {
+        static const int instances = 20000;
+
+        // Each layout pass reads every property a few times (measure, arrange, render).
+        static const int readsPerProperty = 4;
+
+        // Creates the storage of each instance, sets the properties, then reads them back, and returns the time taken
+        // in QPC ticks.
+        auto run = [properties, propertyCount](const SparseValueTableLayout* runLayout) -> LONGLONG
+        {
+            std::vector<std::unique_ptr<SparseValueTable>> tables;
+            tables.reserve(instances);
+
+            XUINT32 checksum = 0;
+
+            LARGE_INTEGER start, end;
+            QueryPerformanceCounter(&start);
+
+            for (int i = 0; i < instances; ++i)
+            {
+                tables.emplace_back(new SparseValueTable(runLayout));
+                SparseValueTable& table = *tables.back();
+
+                for (size_t property = 0; property < propertyCount; ++property)
+                {
+                    auto entry = table.insert(std::make_pair(properties[property], EffectiveValue())).first;
+                    entry->second.value.SetSigned(i);
+                }
+            }
+
+            for (int read = 0; read < readsPerProperty; ++read)
+            {
+                for (auto& table : tables)
+                {
+                    for (size_t property = 0; property < propertyCount; ++property)
+                    {
+                        auto entry = table->find(properties[property]);
+                        if (entry != table->end())
+                        {
+                            checksum += static_cast<XUINT32>(entry->second.value.AsSigned());
+                        }
+                    }
+                }
+            }
+
+            QueryPerformanceCounter(&end);
+
+            VERIFY_ARE_NOT_EQUAL(checksum, 0u);
+            return end.QuadPart - start.QuadPart;
+        };
+
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+
+        WEX::Logging::Log::Comment(WEX::Common::String().Format(L"=== SparseValueTable benchmark: %s, dense slots vs sorted only ===", name));
+        WEX::Logging::Log::Comment(
+            WEX::Common::String().Format(L"Instances: %d, properties: %d, reads per property: %d, QPC freq: %lld Hz",
+                instances, static_cast<int>(propertyCount), readsPerProperty, freq.QuadPart));
+
+        // Warm up the allocator and caches before measuring either run.
+        run(layout);
+        run(nullptr);
+
+        const LONGLONG denseTicks = run(layout);
+        const LONGLONG sparseTicks = run(nullptr);
+
+        const double operations = static_cast<double>(instances) * propertyCount * (1 + readsPerProperty);
+        const double denseNsPerOperation = (static_cast<double>(denseTicks) * 1.0e9 / freq.QuadPart) / operations;
+        const double sparseNsPerOperation = (static_cast<double>(sparseTicks) * 1.0e9 / freq.QuadPart) / operations;
+
+        WEX::Logging::Log::Comment(
+            WEX::Common::String().Format(
+                L"dense slots: %6.2f ns/op | sorted only: %6.2f ns/op | speedup: %.2fx",
+                denseNsPerOperation,
+                sparseNsPerOperation,
+                sparseNsPerOperation / denseNsPerOperation));
+    }
+
+} } } } } }
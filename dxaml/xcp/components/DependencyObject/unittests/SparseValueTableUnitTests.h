@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <WexTestClass.h>
+
+namespace Microsoft { namespace UI { namespace Xaml { namespace Tests {
+    namespace Framework { namespace DependencyObject {
+
+        class SparseValueTableUnitTests : public WEX::TestClass<SparseValueTableUnitTests>
+        {
+        public:
+            BEGIN_TEST_CLASS(SparseValueTableUnitTests)
+                TEST_CLASS_PROPERTY(L"Classification", L"Integration")
+                TEST_CLASS_PROPERTY(L"TestPass:IncludeOnlyOn", L"Desktop")
+            END_TEST_CLASS()
+
+            TEST_METHOD(CanInsertFindAndEraseDenseAndSparseEntries)
+
+            TEST_METHOD(CanIterateDenseAndSparseEntries)
+
+            TEST_METHOD(DoesUseClosestBaseTypeLayout)
+
+            TEST_METHOD(DoesRejectPropertiesOutsideLayout)
+
+            TEST_METHOD(TemplateInstantiationBenchmark)
+
+            TEST_METHOD(OutOfLayoutPropertiesBenchmark)
+
+        private:
+            static void RunBenchmark(
+                _In_z_ const wchar_t* name,
+                _In_ const SparseValueTableLayout* layout,
+                _In_reads_(propertyCount) const KnownPropertyIndex* properties,
+                size_t propertyCount);
+        };
+    }}
+} } } }
@@ -34,6 +34,7 @@ namespace
         {
             case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v3:
             case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4:
+            case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5:
             case CustomWriterRuntimeDataTypeIndex::Style_v3:
             {
                 return true;
@@ -87,6 +88,7 @@ HRESULT CustomWriterRuntimeData::Deserialize(_In_ XamlBinaryFormatSubReader2* re
         case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v2:
         case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v3:
         case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4:
+        case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5:
             runtimeData = CreateAndDeserializeRuntimeData<ResourceDictionaryCustomRuntimeData>(reader, typeIndex);
             break;
 
@@ -121,6 +121,11 @@ bool ResourceDictionaryCustomRuntimeData::TryGetResourceOffset(
     _In_ const ResourceKey& key,
     _Out_ StreamOffsetToken& token)
 {
+    if (m_resourcesTable.TryGetResourceOffset(key, token))
+    {
+        return true;
+    }
+
     bool foundValue = false;
 
     auto search = m_resourcesMap.find(key);
@@ -167,6 +172,9 @@ _Check_return_ HRESULT ResourceDictionaryCustomRuntimeData::ResolveConditionalRe
 
             if (foundValue)
             {
+                // Resources that are only present under some conditions can't be part of the compiled
+                // table, so fall back to the map for this dictionary.
+                MaterializeResourcesTable();
                 m_resourcesMap.emplace(conditionalResource.first, token);
             }
         }
@@ -182,7 +190,7 @@ _Check_return_ HRESULT ResourceDictionaryCustomRuntimeData::ResolveConditionalRe
 std::size_t ResourceDictionaryCustomRuntimeData::size()
 {
     ASSERT(m_conditionalResourcesResolved);
-    return m_resourcesMap.size() + m_conditionalResourcesMap.size();
+    return m_resourcesTable.size() + m_resourcesMap.size() + m_conditionalResourcesMap.size();
 }
 
 std::size_t ResourceDictionaryCustomRuntimeData::GetImplicitResourceCount()
@@ -190,7 +198,7 @@ std::size_t ResourceDictionaryCustomRuntimeData::GetImplicitResourceCount()
     ASSERT(m_conditionalResourcesResolved);
 
     std::size_t count = 0;
-    for (const auto& kvp : m_resourcesMap)
+    for (const auto& kvp : GetResourceEntries())
     {
         if (kvp.first.IsKeyType())
         {
@@ -207,4 +215,24 @@ std::size_t ResourceDictionaryCustomRuntimeData::GetImplicitResourceCount()
     return count;
 }
 
+// Once conditional resources are resolved, resources live in exactly one of m_resourcesTable and
+// m_resourcesMap, and both store their entries in the same layout.
+const ResourceKeyPerfectHashTable::Entries& ResourceDictionaryCustomRuntimeData::GetResourceEntries() const
+{
+    ASSERT(m_conditionalResourcesResolved);
+    ASSERT(m_resourcesTable.empty() || m_resourcesMap.empty());
+
+    return m_resourcesTable.empty() ? m_resourcesMap.values() : m_resourcesTable.GetEntries();
+}
+
+void ResourceDictionaryCustomRuntimeData::MaterializeResourcesTable()
+{
+    if (!m_resourcesTable.empty())
+    {
+        auto entries = m_resourcesTable.ExtractEntries();
+        m_resourcesMap.reserve(m_resourcesMap.size() + entries.size());
+        m_resourcesMap.insert(entries.begin(), entries.end());
+    }
+}
+
 #pragma endregion
@@ -9,6 +9,7 @@
 
 #include <ResourceDictionaryCustomRuntimeData.h>
 #include <ResourceDictionaryKey.h>
+#include <ResourceKeyPerfectHashTable.h>
 #include <vector_map.h>
 #include <xamlbinaryformatsubreader2.h>
 #include <xamlbinaryformatsubwriter2.h>
@@ -36,6 +37,28 @@ namespace CustomRuntimeDataSerializationHelpers
         return ResourceKeyStorage(key, hashAndIsKeyType);
     }
 
+    _Check_return_ HRESULT Serializer<ResourceKeyPerfectHashTable>::Write(
+        _In_ const ResourceKeyPerfectHashTable& target,
+        _In_ XamlBinaryFormatSubWriter2* writer,
+        _In_ const std::vector<unsigned int>& streamOffsetTokenTable)
+    {
+        IFC_RETURN(Serialize(target.m_seeds, writer, streamOffsetTokenTable));
+        IFC_RETURN(Serialize(target.m_entries, writer, streamOffsetTokenTable));
+        return S_OK;
+    }
+
+    ResourceKeyPerfectHashTable Serializer<ResourceKeyPerfectHashTable>::Read(_In_ XamlBinaryFormatSubReader2* reader)
+    {
+        ResourceKeyPerfectHashTable table;
+        table.m_seeds = Deserialize<std::vector<unsigned int>>(reader);
+        table.m_entries = Deserialize<ResourceKeyPerfectHashTable::Entries>(reader);
+
+        // Lookups index straight into both vectors, so a mismatched table is malformed XBF.
+        THROW_HR_IF(E_FAIL, table.m_seeds.size() != ResourceKeyPerfectHashTable::GetBucketCount(table.m_entries.size()));
+
+        return table;
+    }
+
     template<>
     _Check_return_ HRESULT Serialize(_In_ const ResourceDictionaryCustomRuntimeData& target, _In_ XamlBinaryFormatSubWriter2* writer, _In_ const std::vector<unsigned int>& streamOffsetTokenTable)
     {
@@ -117,6 +140,22 @@ namespace CustomRuntimeDataSerializationHelpers
             }
             break;
 
+            case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5:
+            {
+                // ResourceDictionary_v5 stores the resources as a minimal perfect hash table in slot order, followed
+                // by a map of the resources that aren't in the table. The map is only populated in the unlikely
+                // event that the table couldn't be built (e.g. two keys with the same 64-bit hash).
+                ResourceKeyPerfectHashTable table;
+                DeferredResourceMap noUnindexedResources;
+                const auto& unindexedResources = table.TryBuild(target.m_resourcesMap) ? noUnindexedResources : target.m_resourcesMap;
+
+                IFC_RETURN(CustomRuntimeDataSerializationHelpers::Serialize(table, writer, streamOffsetTokenTable));
+                IFC_RETURN(CustomRuntimeDataSerializationHelpers::Serialize(unindexedResources, writer, streamOffsetTokenTable));
+                IFC_RETURN(CustomRuntimeDataSerializationHelpers::Serialize(target.m_resourcesForAutoUndeferral, writer, streamOffsetTokenTable));
+                IFC_RETURN(CustomRuntimeDataSerializationHelpers::Serialize(target.m_conditionalResourcesMap, writer, streamOffsetTokenTable));
+            }
+            break;
+
             default:
                 ASSERT(false); // unknown case; investigate
         }
@@ -200,6 +239,16 @@ namespace CustomRuntimeDataSerializationHelpers
             }
             break;
 
+            case CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5:
+            {
+                // The table is used as-is; no map is built for the resources it holds.
+                data.m_resourcesTable = Deserialize<ResourceKeyPerfectHashTable>(reader);
+                data.m_resourcesMap = Deserialize<DeferredResourceMap>(reader);
+                data.m_resourcesForAutoUndeferral = Deserialize<std::vector<xstring_ptr>>(reader);
+                data.m_conditionalResourcesMap = Deserialize<ConditionalDeferredResourceMap>(reader);
+            }
+            break;
+
             default:
                 ASSERT(false); // unknown case; investigate
         }
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+
+#include <ResourceKeyPerfectHashTable.h>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // Upper bound on the seeds tried for a single bucket before giving up. The last buckets placed
+    // hold a single key and need about size() / (free slots) attempts, so this is far above
+    // anything a real dictionary needs.
+    constexpr unsigned int c_maxSeed = 1u << 20;
+
+    // MurmurHash3 finalizer. Key hashes are already avalanching, but bucket and slot selection
+    // both reduce the same 64-bit value, so they are decorrelated by mixing first.
+    std::uint64_t Mix(std::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+}
+
+std::size_t ResourceKeyPerfectHashTable::GetBucketCount(_In_ std::size_t entryCount)
+{
+    return (entryCount + c_averageBucketSize - 1) / c_averageBucketSize;
+}
+
+// ResourceKey::hash() masks off the IsKeyType bit, so an implicit style and an explicit
+// resource with the same key string would otherwise collide. Put it back for placement.
+std::uint64_t ResourceKeyPerfectHashTable::GetPlacementHash(_In_ std::uint64_t hash, _In_ bool isKeyType)
+{
+    return ResourceDictionaryKey::details::EncodeHashAndIsTypeHelper(hash, isKeyType);
+}
+
+std::size_t ResourceKeyPerfectHashTable::GetBucket(_In_ std::uint64_t placementHash) const
+{
+    return static_cast<std::size_t>(Mix(placementHash) % m_seeds.size());
+}
+
+std::size_t ResourceKeyPerfectHashTable::GetSlot(_In_ std::uint64_t placementHash, _In_ unsigned int seed) const
+{
+    return static_cast<std::size_t>(Mix(placementHash + (static_cast<std::uint64_t>(seed) + 1) * 0x9e3779b97f4a7c15ULL) % m_entries.size());
+}
+
+// Builds the table using hash-and-displace: buckets are placed largest first, and for each one
+// the smallest seed that maps all of its keys to free slots is recorded.
+_Success_(return != false)
+bool ResourceKeyPerfectHashTable::TryBuild(_In_ const DeferredResourceMap& map)
+{
+    m_seeds.clear();
+    m_entries.clear();
+
+    if (map.empty())
+    {
+        return true;
+    }
+
+    const Entries& source = map.values();
+    const std::size_t entryCount = source.size();
+
+    std::vector<std::uint64_t> placementHashes;
+    placementHashes.reserve(entryCount);
+    for (const auto& entry : source)
+    {
+        placementHashes.push_back(GetPlacementHash(entry.first.hash(), entry.first.IsKeyType()));
+    }
+
+    {
+        // Keys with identical placement hashes can never be separated by any seed.
+        std::vector<std::uint64_t> sortedHashes(placementHashes);
+        std::sort(sortedHashes.begin(), sortedHashes.end());
+        if (std::adjacent_find(sortedHashes.begin(), sortedHashes.end()) != sortedHashes.end())
+        {
+            return false;
+        }
+    }
+
+    // GetBucket() and GetSlot() read the table sizes, so size both up front.
+    m_seeds.assign(GetBucketCount(entryCount), 0);
+    m_entries.resize(entryCount);
+
+    std::vector<std::vector<std::size_t>> buckets(m_seeds.size());
+    for (std::size_t i = 0; i < entryCount; ++i)
+    {
+        buckets[GetBucket(placementHashes[i])].push_back(i);
+    }
+
+    std::vector<std::size_t> bucketOrder(buckets.size());
+    std::iota(bucketOrder.begin(), bucketOrder.end(), 0);
+    std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](std::size_t lhs, std::size_t rhs)
+    {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    std::vector<bool> occupied(entryCount, false);
+    std::vector<std::size_t> candidateSlots;
+
+    for (auto bucketIndex : bucketOrder)
+    {
+        const auto& bucket = buckets[bucketIndex];
+        if (bucket.empty())
+        {
+            // Buckets are sorted by size, so the rest are empty too.
+            break;
+        }
+
+        bool placed = false;
+        for (unsigned int seed = 0; seed < c_maxSeed && !placed; ++seed)
+        {
+            candidateSlots.clear();
+            placed = true;
+
+            for (auto entryIndex : bucket)
+            {
+                auto slot = GetSlot(placementHashes[entryIndex], seed);
+                if (occupied[slot] || std::find(candidateSlots.begin(), candidateSlots.end(), slot) != candidateSlots.end())
+                {
+                    placed = false;
+                    break;
+                }
+                candidateSlots.push_back(slot);
+            }
+
+            if (placed)
+            {
+                m_seeds[bucketIndex] = seed;
+            }
+        }
+
+        if (!placed)
+        {
+            m_seeds.clear();
+            m_entries.clear();
+            return false;
+        }
+
+        for (std::size_t i = 0; i < bucket.size(); ++i)
+        {
+            occupied[candidateSlots[i]] = true;
+            m_entries[candidateSlots[i]] = source[bucket[i]];
+        }
+    }
+
+    return true;
+}
+
+_Success_(return != false)
+bool ResourceKeyPerfectHashTable::TryGetResourceOffset(
+    _In_ const ResourceKey& key,
+    _Out_ StreamOffsetToken& token) const
+{
+    if (m_entries.empty())
+    {
+        return false;
+    }
+
+    auto placementHash = GetPlacementHash(key.hash(), key.IsKeyType());
+    const auto& entry = m_entries[GetSlot(placementHash, m_seeds[GetBucket(placementHash)])];
+
+    // Every slot holds some key, so a miss has to be detected by comparing against it.
+    if (!(entry.first == key))
+    {
+        return false;
+    }
+
+    token = entry.second;
+    return true;
+}
+
+ResourceKeyPerfectHashTable::Entries ResourceKeyPerfectHashTable::ExtractEntries()
+{
+    Entries entries = std::move(m_entries);
+    m_entries.clear();
+    m_seeds.clear();
+    return entries;
+}
@@ -5,6 +5,7 @@
 
 #include <CustomWriterRuntimeData.h>
 #include <ResourceDictionaryCustomRuntimeDataSerializer.h>
+#include <ResourceKeyPerfectHashTable.h>
 #include <StreamOffsetToken.h>
 #include <xstring_ptr.h>
 #include <cstdint>
@@ -79,29 +80,26 @@ public:
 
     auto begin() const
     {
-        ASSERT(m_conditionalResourcesResolved);
-        return m_resourcesMap.begin();
+        return GetResourceEntries().begin();
     }
     auto end() const
     {
-        ASSERT(m_conditionalResourcesResolved);
-        return m_resourcesMap.end();
-    }
-    auto begin()
-    {
-        ASSERT(m_conditionalResourcesResolved);
-        return m_resourcesMap.begin();
-    }
-    auto end()
-    {
-        ASSERT(m_conditionalResourcesResolved);
-        return m_resourcesMap.end();
+        return GetResourceEntries().end();
     }
 
 #pragma endregion
 
 private:
-    // Unified map for runtime lookup of both explicit and implicit keys.
+    const ResourceKeyPerfectHashTable::Entries& GetResourceEntries() const;
+
+    // Moves the contents of m_resourcesTable into m_resourcesMap.
+    void MaterializeResourcesTable();
+
+    // Perfect hash table read directly from ResourceDictionary_v5 data. Empty for older formats
+    // and at compile time.
+    ResourceKeyPerfectHashTable m_resourcesTable;
+
+    // Unified map for runtime lookup of both explicit and implicit keys that aren't in m_resourcesTable.
     // The explicit/implicit distinction is encoded in the ResourceKeyStorage key's IsKeyType() bit.
     DeferredResourceMap m_resourcesMap;
 
@@ -10,6 +10,7 @@
 class XamlBinaryFormatSubWriter2;
 class XamlBinaryFormatSubReader2;
 class ResourceDictionaryCustomRuntimeData;
+class ResourceKeyPerfectHashTable;
 
 namespace CustomRuntimeDataSerializationHelpers
 {
@@ -23,6 +24,16 @@ namespace CustomRuntimeDataSerializationHelpers
         static ResourceKeyStorage Read(_In_ XamlBinaryFormatSubReader2* reader);
     };
 
+    template<>
+    struct Serializer<ResourceKeyPerfectHashTable>
+    {
+        static _Check_return_ HRESULT Write(
+            _In_ const ResourceKeyPerfectHashTable& target,
+            _In_ XamlBinaryFormatSubWriter2* writer,
+            _In_ const std::vector<unsigned int>& streamOffsetTokenTable);
+        static ResourceKeyPerfectHashTable Read(_In_ XamlBinaryFormatSubReader2* reader);
+    };
+
     template<>
      _Check_return_ HRESULT Serialize<ResourceDictionaryCustomRuntimeData>(
         _In_ const ResourceDictionaryCustomRuntimeData& target,
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <StreamOffsetToken.h>
+#include <cstdint>
+#include <vector>
+
+#include <resources\inc\ResourceDictionaryMapTypes.h>
+
+class XamlBinaryFormatSubWriter2;
+class XamlBinaryFormatSubReader2;
+
+// A minimal perfect hash table over the keys of a compiled ResourceDictionary. The XAML compiler
+// builds it from the keys' precomputed hashes and serializes the entries in slot order, so at
+// runtime a lookup probes exactly one deserialized entry instead of rebuilding a hash map every
+// time the dictionary is loaded.
+//
+// Keys are hashed into buckets of about c_averageBucketSize keys, and each bucket stores the
+// displacement seed that sends all of its keys to distinct slots in [0, size()).
+class ResourceKeyPerfectHashTable
+{
+    template <typename> friend struct CustomRuntimeDataSerializationHelpers::Serializer;
+
+public:
+    // Same layout as the value container of DeferredResourceMap, so the two can be iterated
+    // interchangeably.
+    using Entries = DeferredResourceMap::value_container_type;
+
+    static constexpr unsigned int c_averageBucketSize = 4;
+
+    ResourceKeyPerfectHashTable() = default;
+
+    ResourceKeyPerfectHashTable(const ResourceKeyPerfectHashTable&) = delete;
+    ResourceKeyPerfectHashTable& operator=(const ResourceKeyPerfectHashTable&) = delete;
+
+    ResourceKeyPerfectHashTable(ResourceKeyPerfectHashTable&&) = default;
+    ResourceKeyPerfectHashTable& operator=(ResourceKeyPerfectHashTable&&) = default;
+
+    // Builds the table from the entries of a map. Returns false if no set of seeds could be found
+    // (e.g. two keys share a 64-bit hash), in which case the table is left empty.
+    _Success_(return != false)
+    bool TryBuild(_In_ const DeferredResourceMap& map);
+
+    _Success_(return != false)
+    bool TryGetResourceOffset(_In_ const ResourceKey& key, _Out_ StreamOffsetToken& token) const;
+
+    std::size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    // Entries in slot order.
+    const Entries& GetEntries() const { return m_entries; }
+
+    // Moves the entries out, leaving the table empty.
+    Entries ExtractEntries();
+
+private:
+    static std::size_t GetBucketCount(_In_ std::size_t entryCount);
+    static std::uint64_t GetPlacementHash(_In_ std::uint64_t hash, _In_ bool isKeyType);
+    std::size_t GetBucket(_In_ std::uint64_t placementHash) const;
+    std::size_t GetSlot(_In_ std::uint64_t placementHash, _In_ unsigned int seed) const;
+
+    // One seed per bucket; empty if and only if m_entries is empty.
+    std::vector<unsigned int> m_seeds;
+    Entries m_entries;
+};
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+
+#include "ResourceKeyPerfectHashTableUnitTests.h"
+#include <ResourceKeyPerfectHashTable.h>
+#include <StreamOffsetToken.h>
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests {
+    namespace Framework {
+
+        DECLARE_CONST_STRING_IN_TEST_CODE(c_buttonType, L"Microsoft.UI.Xaml.Controls.Button");
+        DECLARE_CONST_STRING_IN_TEST_CODE(c_missingKey, L"MissingKey");
+
+        // Keys are the decimal representations of 0..count-1, with tokens offset by 1000.
+        static DeferredResourceMap CreateNumberedResources(unsigned int count)
+        {
+            DeferredResourceMap map;
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                xstring_ptr key;
+                VERIFY_SUCCEEDED(xstring_ptr::CreateFromUInt32(i, &key));
+                map.emplace(ResourceKeyStorage(key, false), StreamOffsetToken(1000 + i));
+            }
+            return map;
+        }
+
+        void ResourceKeyPerfectHashTableUnitTests::ValidateEmptyTable()
+        {
+            ResourceKeyPerfectHashTable table;
+            VERIFY_IS_TRUE(table.TryBuild(DeferredResourceMap()));
+            VERIFY_IS_TRUE(table.empty());
+
+            StreamOffsetToken token;
+            VERIFY_IS_FALSE(table.TryGetResourceOffset(ResourceKey(c_missingKey, false), token));
+        }
+
+        void ResourceKeyPerfectHashTableUnitTests::ValidateLookup()
+        {
+            // Cover dictionaries smaller than, equal to and much larger than a single bucket.
+            for (unsigned int count : { 1u, 3u, 4u, 5u, 17u, 256u, 2000u })
+            {
+                auto map = CreateNumberedResources(count);
+
+                ResourceKeyPerfectHashTable table;
+                VERIFY_IS_TRUE(table.TryBuild(map));
+                VERIFY_ARE_EQUAL(table.size(), static_cast<std::size_t>(count));
+
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    xstring_ptr key;
+                    VERIFY_SUCCEEDED(xstring_ptr::CreateFromUInt32(i, &key));
+
+                    StreamOffsetToken token;
+                    VERIFY_IS_TRUE(table.TryGetResourceOffset(ResourceKey(key, false), token));
+                    VERIFY_ARE_EQUAL(token.GetIndex(), 1000 + i);
+
+                    // The same string as an implicit key is a different resource.
+                    VERIFY_IS_FALSE(table.TryGetResourceOffset(ResourceKey(key, true), token));
+                }
+
+                xstring_ptr outOfRangeKey;
+                VERIFY_SUCCEEDED(xstring_ptr::CreateFromUInt32(count, &outOfRangeKey));
+                StreamOffsetToken token;
+                VERIFY_IS_FALSE(table.TryGetResourceOffset(ResourceKey(outOfRangeKey, false), token));
+            }
+        }
+
+        void ResourceKeyPerfectHashTableUnitTests::ValidateImplicitAndExplicitKeysWithSameName()
+        {
+            DeferredResourceMap map;
+            map.emplace(ResourceKeyStorage(c_buttonType, true), StreamOffsetToken(1));
+            map.emplace(ResourceKeyStorage(c_buttonType, false), StreamOffsetToken(2));
+
+            ResourceKeyPerfectHashTable table;
+            VERIFY_IS_TRUE(table.TryBuild(map));
+
+            StreamOffsetToken token;
+            VERIFY_IS_TRUE(table.TryGetResourceOffset(ResourceKey(c_buttonType, true), token));
+            VERIFY_ARE_EQUAL(token.GetIndex(), 1u);
+            VERIFY_IS_TRUE(table.TryGetResourceOffset(ResourceKey(c_buttonType, false), token));
+            VERIFY_ARE_EQUAL(token.GetIndex(), 2u);
+        }
+
+        void ResourceKeyPerfectHashTableUnitTests::ValidateExtractEntries()
+        {
+            auto map = CreateNumberedResources(50);
+
+            ResourceKeyPerfectHashTable table;
+            VERIFY_IS_TRUE(table.TryBuild(map));
+
+            auto entries = table.ExtractEntries();
+            VERIFY_ARE_EQUAL(entries.size(), map.size());
+            VERIFY_IS_TRUE(table.empty());
+
+            for (const auto& entry : entries)
+            {
+                auto search = map.find(entry.first);
+                VERIFY_IS_TRUE(search != map.end());
+                VERIFY_ARE_EQUAL(search->second.GetIndex(), entry.second.GetIndex());
+            }
+
+            StreamOffsetToken token;
+            VERIFY_IS_FALSE(table.TryGetResourceOffset(entries.front().first.ToResourceKey(), token));
+        }
+    }
+} } } }
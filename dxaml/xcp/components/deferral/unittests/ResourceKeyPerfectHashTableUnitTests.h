@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <WexTestClass.h>
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests {
+    namespace Framework {
+
+        class ResourceKeyPerfectHashTableUnitTests : public WEX::TestClass<ResourceKeyPerfectHashTableUnitTests>
+        {
+        public:
+            BEGIN_TEST_CLASS(ResourceKeyPerfectHashTableUnitTests)
+                TEST_METHOD_PROPERTY(L"Classification", L"Integration")
+                TEST_METHOD_PROPERTY(L"TestPass:IncludeOnlyOn", L"Desktop")
+            END_TEST_CLASS()
+
+            TEST_METHOD(ValidateEmptyTable)
+            TEST_METHOD(ValidateLookup)
+            TEST_METHOD(ValidateImplicitAndExplicitKeysWithSameName)
+            TEST_METHOD(ValidateExtractEntries)
+        };
+    }
+} } } }
@@ -5,7 +5,7 @@
 
 #include <utility>              // for std::forward
 #include <vector>
-#include <array>
+#include <cstdint>
 #include <xref_ptr.h>
 #include "ValueObjectBase.h"
 
@@ -18,49 +18,217 @@ namespace Flyweight
         using wrapper_type      = typename Wrapper<T>::Type;
         using wrapper_ref_type  = xref_ptr<wrapper_type>;
 
-        // How many non-default inserts between purging a bucket from unused items (e.g. ref-count = 1).
-        static constexpr std::size_t c_autoPurgeInterval    = 250;
+        // Number of slots the table starts with once the first non-default element is added.  Must be a power of two.
+        static constexpr std::size_t c_initialCapacity      = 16;
 
-        // Used to avoid purging too frequently when bucket is on cusp of resizing.
-        static constexpr std::size_t c_minPurgeInterval     = 50;
+        // The table grows (or purges) once more than this share of its slots would be in use, keeping probe sequences short.
+        static constexpr std::size_t c_maxLoadFactorPercent = 50;
 
-        // Hard limit on how many elements are allowed in a bucket.  Used to limit lookup times in misbehaving cases.
-        // Once this limit is reached, if element is not found it will be allocated but not managed / shared.
-        // This number is std::vector implementation dependent.
-        static constexpr std::size_t c_bucketSizeLimit      = 271;
+        // How many slots to check for unused items (e.g. ref-count = 1) on each non-default insert.
+        // Every slot is visited once per capacity / c_purgeSlotsPerCreate inserts, without ever sweeping the whole table at once.
+        static constexpr std::size_t c_purgeSlotsPerCreate  = 2;
 
-        static bool WillAdditionResize(const std::vector<wrapper_ref_type>& instances, std::size_t capacity)
+        // Operators::hash() is often a plain hash_combine of a few fields, so spread it over all bits before masking.
+        static std::size_t Mix(std::size_t hash)
         {
-            return instances.size() + 1 >= capacity;
+            std::uint64_t value = static_cast<std::uint64_t>(hash);
+            value ^= value >> 33;
+            value *= 0xff51afd7ed558ccdULL;
+            value ^= value >> 33;
+            value *= 0xc4ceb9fe1a85ec53ULL;
+            value ^= value >> 33;
+            return static_cast<std::size_t>(value);
         }
 
-        struct Bucket
+        static bool IsUnused(const wrapper_ref_type& instance)
         {
-            Bucket()
+            return instance->GetRefCount() == 1;
+        }
+
+        struct Slot
+        {
+            wrapper_ref_type    m_instance;
+            std::size_t         m_hash = 0;
+        };
+
+        // Open-addressed hash table with linear probing.  Removing an element shifts the rest of its probe sequence
+        // back instead of leaving a tombstone, so lookups never step over deleted slots.
+        class Table
+        {
+        public:
+            wrapper_type* Find(const value_type& value, std::size_t hash) const
+            {
+                if (m_count == 0)
+                {
+                    return nullptr;
+                }
+
+                const std::size_t mask = m_slots.size() - 1;
+
+                for (std::size_t index = hash & mask; m_slots[index].m_instance; index = (index + 1) & mask)
+                {
+                    const Slot& slot = m_slots[index];
+
+                    if (slot.m_hash == hash &&
+                        Operators::equal(value, slot.m_instance->Value()))
+                    {
+                        return slot.m_instance.get();
+                    }
+                }
+
+                return nullptr;
+            }
+
+            // Makes room for one more element.  Resizing visits every slot anyway, so unused items are dropped along
+            // the way, and the table only grows if that didn't free up enough of it - otherwise an app hovering at
+            // the threshold would rebuild the table on every insert.  Returns the number of items purged.
+            std::size_t EnsureCapacityForInsert()
+            {
+                if ((m_count + 1) * 100 <= m_slots.size() * c_maxLoadFactorPercent)
+                {
+                    return 0;
+                }
+
+                std::size_t usedCount = 0;
+
+                for (const Slot& slot : m_slots)
+                {
+                    if (slot.m_instance && !IsUnused(slot.m_instance))
+                    {
+                        ++usedCount;
+                    }
+                }
+
+                std::size_t capacity = m_slots.size();
+
+                if ((usedCount + 1) * 4 > capacity)
+                {
+                    capacity = (capacity == 0) ? c_initialCapacity : capacity * 2;
+                }
+
+                return Rehash(capacity);
+            }
+
+            // Requires the element to be absent and EnsureCapacityForInsert() to have been called.
+            wrapper_type* Insert(wrapper_ref_type&& instance, std::size_t hash)
             {
-                m_instances.reserve(16);
+                const std::size_t mask = m_slots.size() - 1;
+                std::size_t index = hash & mask;
+
+                while (m_slots[index].m_instance)
+                {
+                    index = (index + 1) & mask;
+                }
+
+                m_slots[index].m_instance = std::move(instance);
+                m_slots[index].m_hash = hash;
+                ++m_count;
+
+                return m_slots[index].m_instance.get();
+            }
+
+            // Checks the next slotCount slots for unused items, continuing where the last call left off.
+            // Returns the number of items purged.
+            std::size_t PurgeStep(std::size_t slotCount)
+            {
+                std::size_t purged = 0;
+
+                for (std::size_t step = 0; step < slotCount && m_count > 0; ++step)
+                {
+                    if (m_slots[m_purgeCursor].m_instance &&
+                        IsUnused(m_slots[m_purgeCursor].m_instance))
+                    {
+                        // An element may get shifted into this slot, so stay on it for the next step.
+                        RemoveAt(m_purgeCursor);
+                        ++purged;
+                    }
+                    else
+                    {
+                        m_purgeCursor = (m_purgeCursor + 1) & (m_slots.size() - 1);
+                    }
+                }
+
+                return purged;
             }
 
             void Reset()
             {
-                m_instances.clear();
-                m_instances.shrink_to_fit();        // Keep leak-detection happy by clearing the vector.
-                m_counterSinceLastPurge = 0;
+                m_slots.clear();
+                m_slots.shrink_to_fit();        // Keep leak-detection happy by clearing the vector.
+                m_count = 0;
+                m_purgeCursor = 0;
+            }
+
+            std::size_t size() const
+            {
+                return m_count;
             }
 
-            std::vector<wrapper_ref_type>   m_instances;
-            unsigned int                    m_counterSinceLastPurge = 0;
+        private:
+            std::size_t Rehash(std::size_t capacity)
+            {
+                std::vector<Slot> oldSlots = std::move(m_slots);
+                m_slots = std::vector<Slot>(capacity);
+
+                const std::size_t oldCount = m_count;
+                m_count = 0;
+                m_purgeCursor = 0;
+
+                for (Slot& slot : oldSlots)
+                {
+                    if (slot.m_instance && !IsUnused(slot.m_instance))
+                    {
+                        Insert(std::move(slot.m_instance), slot.m_hash);
+                    }
+                }
+
+                return oldCount - m_count;
+            }
+
+            void RemoveAt(std::size_t index)
+            {
+                const std::size_t mask = m_slots.size() - 1;
+                std::size_t hole = index;
+
+                for (std::size_t next = (hole + 1) & mask; m_slots[next].m_instance; next = (next + 1) & mask)
+                {
+                    // The element at next can fill the hole if the hole is between its ideal slot and next.
+                    const std::size_t ideal = m_slots[next].m_hash & mask;
+
+                    if (((next - ideal) & mask) >= ((next - hole) & mask))
+                    {
+                        m_slots[hole] = std::move(m_slots[next]);
+                        hole = next;
+                    }
+                }
+
+                m_slots[hole].m_instance.reset();
+                m_slots[hole].m_hash = 0;
+                --m_count;
+            }
+
+            std::vector<Slot>   m_slots;
+            std::size_t         m_count         = 0;
+            std::size_t         m_purgeCursor   = 0;
         };
 
     public:
+        struct Statistics
+        {
+            std::uint64_t   m_defaultHits   = 0;    // Requests for the default value
+            std::uint64_t   m_hits          = 0;    // Requests for a non-default value that was already shared
+            std::uint64_t   m_misses        = 0;    // Requests that created a new shared instance
+            std::uint64_t   m_purged        = 0;    // Shared instances dropped after everything else released them
+        };
+
         // state externalized to store per-core
         class State
         {
             friend class Factory<value_type>;
 
             wrapper_type                        m_default;
-            Bucket                              m_bucket;
-            unsigned int                        m_countPassThru     = 0;
+            Table                               m_table;
+            Statistics                          m_statistics;
 
         public:
             State(const value_type& defaultValue = Operators::Default<value_type>())
@@ -69,13 +237,24 @@ namespace Flyweight
 
             void Reset()
             {
-                m_bucket.Reset();
+                m_table.Reset();
             }
 
             wrapper_type* GetDefaultNoRef()
             {
                 return &m_default;
             }
+
+            // Number of non-default instances being shared, including unused ones which haven't been purged yet.
+            std::size_t GetCount() const
+            {
+                return m_table.size();
+            }
+
+            const Statistics& GetStatistics() const
+            {
+                return m_statistics;
+            }
         };
 
 #pragma warning(suppress: 28251 28253) // Prefast says this is not consistent with itself
@@ -91,70 +270,27 @@ namespace Flyweight
                 if (Operators::equal(requested, state->m_default.Value()))
                 {
                     // short-circuit to default value
+                    ++state->m_statistics.m_defaultHits;
                     return wrapper_ref_type(&state->m_default);
                 }
                 else
                 {
-                    Bucket& bucket = state->m_bucket;
+                    Table& table = state->m_table;
 
-                    // Purge unused entries if it's time or we are possibly going to resize.
-                    // Since we want to avoid searching for item (or where to insert) twice,
-                    // purge needs to happen before the search.  A problem arises when we are
-                    // on cusp of resizing, but item exists in the bucket.  The algorithm will
-                    // try to purge every time - hence c_minPurgeInterval to prevent that.
+                    state->m_statistics.m_purged += table.PurgeStep(c_purgeSlotsPerCreate);
 
-                    if ((bucket.m_counterSinceLastPurge >= c_minPurgeInterval &&
-                         WillAdditionResize(bucket.m_instances, bucket.m_instances.capacity())) ||
-                        bucket.m_counterSinceLastPurge >= c_autoPurgeInterval)
-                    {
-                        bucket.m_instances.erase(
-                            std::remove_if(
-                                bucket.m_instances.begin(),
-                                bucket.m_instances.end(),
-                                [](const wrapper_ref_type& element) -> bool
-                                {
-                                    return element->GetRefCount() == 1;
-                                }),
-                            bucket.m_instances.end());
-
-                        bucket.m_counterSinceLastPurge = 0;
-                    }
+                    const std::size_t hash = Mix(Operators::hash(requested));
 
-                    // Find where this element should exist in a bucket.
-                    auto iter = std::lower_bound(
-                        bucket.m_instances.begin(),
-                        bucket.m_instances.end(),
-                        requested,
-                        [](const wrapper_ref_type& lhs, const value_type& rhs) -> bool
-                        {
-                            return Operators::less(lhs->Value(), rhs);
-                        }
-                    );
-
-                    ++bucket.m_counterSinceLastPurge;
-
-                    if (iter == bucket.m_instances.end() ||
-                        !Operators::equal(requested, iter->get()->Value()))
+                    if (wrapper_type* existing = table.Find(requested, hash))
                     {
-                        // It does not exist yet...
-
-                        if (!WillAdditionResize(bucket.m_instances, c_bucketSizeLimit))
-                        {
-                            // Not reached capacity yet, so just add it.
-                            iter = bucket.m_instances.emplace(
-                                iter,
-                                make_xref<wrapper_type>(requested));
-                        }
-                        else
-                        {
-                            ++state->m_countPassThru;
-                            
-                            // We reached the limit of number of elements in a bucket, so just create one and don't manage it.
-                            return make_xref<wrapper_type>(requested);
-                        }
+                        ++state->m_statistics.m_hits;
+                        return wrapper_ref_type(existing);
                     }
 
-                    return wrapper_ref_type(iter->get());
+                    ++state->m_statistics.m_misses;
+                    state->m_statistics.m_purged += table.EnsureCapacityForInsert();
+
+                    return wrapper_ref_type(table.Insert(make_xref<wrapper_type>(requested), hash));
                 }
             }
             else
@@ -165,4 +301,4 @@ namespace Flyweight
             }
         }
     };
-}
\ No newline at end of file
+}
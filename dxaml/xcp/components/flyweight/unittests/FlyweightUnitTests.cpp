@@ -5,8 +5,10 @@
 #include "FlyweightUnitTests.h"
 #include "FlyweightFactory.h"
 #include <XamlLogging.h>
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 #include <CommonUtilities.h>
 
 using namespace WEX::Common;
@@ -110,6 +112,104 @@ namespace Flyweight
     }
 }
 
+namespace
+{
+    // The factory as it was before the hashed table, kept as a baseline for FactoryBenchmark: one sorted bucket per
+    // type, purged every c_autoPurgeInterval inserts, and no sharing past c_bucketSizeLimit elements.
+    template <typename T>
+    class LinearBucketFactory
+    {
+        using value_type        = T;
+        using wrapper_type      = typename ::Flyweight::Wrapper<T>::Type;
+        using wrapper_ref_type  = xref_ptr<wrapper_type>;
+
+        static constexpr std::size_t c_autoPurgeInterval    = 250;
+        static constexpr std::size_t c_minPurgeInterval     = 50;
+        static constexpr std::size_t c_bucketSizeLimit      = 271;
+
+        static bool WillAdditionResize(const std::vector<wrapper_ref_type>& instances, std::size_t capacity)
+        {
+            return instances.size() + 1 >= capacity;
+        }
+
+    public:
+        struct State
+        {
+            State()
+                : m_default(::Flyweight::Operators::Default<value_type>())
+            {
+                m_instances.reserve(16);
+            }
+
+            wrapper_type                    m_default;
+            std::vector<wrapper_ref_type>   m_instances;
+            unsigned int                    m_counterSinceLastPurge = 0;
+            unsigned int                    m_countPassThru         = 0;
+        };
+
+        template <typename ...Types>
+        static wrapper_ref_type Create(
+            _In_ State* state,
+            _In_ Types&&... args)
+        {
+            value_type requested(std::forward<Types>(args)...);
+
+            if (::Flyweight::Operators::equal(requested, state->m_default.Value()))
+            {
+                return wrapper_ref_type(&state->m_default);
+            }
+
+            auto& instances = state->m_instances;
+
+            if ((state->m_counterSinceLastPurge >= c_minPurgeInterval &&
+                 WillAdditionResize(instances, instances.capacity())) ||
+                state->m_counterSinceLastPurge >= c_autoPurgeInterval)
+            {
+                instances.erase(
+                    std::remove_if(
+                        instances.begin(),
+                        instances.end(),
+                        [](const wrapper_ref_type& element) -> bool
+                        {
+                            return element->GetRefCount() == 1;
+                        }),
+                    instances.end());
+
+                state->m_counterSinceLastPurge = 0;
+            }
+
+            auto iter = std::lower_bound(
+                instances.begin(),
+                instances.end(),
+                requested,
+                [](const wrapper_ref_type& lhs, const value_type& rhs) -> bool
+                {
+                    return ::Flyweight::Operators::less(lhs->Value(), rhs);
+                });
+
+            ++state->m_counterSinceLastPurge;
+
+            if (iter == instances.end() ||
+                !::Flyweight::Operators::equal(requested, iter->get()->Value()))
+            {
+                if (!WillAdditionResize(instances, c_bucketSizeLimit))
+                {
+                    iter = instances.emplace(
+                        iter,
+                        make_xref<wrapper_type>(requested));
+                }
+                else
+                {
+                    ++state->m_countPassThru;
+                    return make_xref<wrapper_type>(requested);
+                }
+            }
+
+            return wrapper_ref_type(iter->get());
+        }
+    };
+}
+
 namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace Flyweight {
 
     bool FlyweightUnitTests::ClassSetup()
@@ -175,15 +275,15 @@ namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace
         VERIFY_ARE_EQUAL(3, ptr_01->GetRefCount());
     }
 
-    void FlyweightUnitTests::OverflowTests()
+    void FlyweightUnitTests::NoSizeLimitTests()
     {
         ::Flyweight::Factory<TestVO2>::State state;
 
         std::vector<xref_ptr<TestVO2::Wrapper>> ptrs;
 
-        // Add unique VOs to max capacity.
+        // Add far more unique VOs than the old per-type bucket could hold (271).
 
-        for (int i = 0; i < 271; ++i)
+        for (int i = 1; i <= 2000; ++i)
         {
             ptrs.emplace_back(
                 ::Flyweight::Factory<TestVO2>::Create(
@@ -198,37 +298,137 @@ namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace
             VERIFY_ARE_EQUAL(2, ptr->GetRefCount());
         }
 
-        // Adding past capacity will trigger pass-through.
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2000), state.GetCount());
 
-        xref_ptr<TestVO2::Wrapper> ptr1 = ::Flyweight::Factory<TestVO2>::Create(
-            &state,
-            99999);
+        // ...and shared when requested again.
+
+        for (int i = 1; i <= 2000; ++i)
+        {
+            xref_ptr<TestVO2::Wrapper> ptr = ::Flyweight::Factory<TestVO2>::Create(
+                &state,
+                i);
 
-        VERIFY_ARE_EQUAL(1, ptr1->GetRefCount());
+            VERIFY_ARE_EQUAL(ptrs[i - 1].get(), ptr.get());
+        }
+
+        const auto& statistics = state.GetStatistics();
+        VERIFY_ARE_EQUAL(static_cast<std::uint64_t>(2000), statistics.m_misses);
+        VERIFY_ARE_EQUAL(static_cast<std::uint64_t>(2000), statistics.m_hits);
+        VERIFY_ARE_EQUAL(static_cast<std::uint64_t>(0), statistics.m_purged);
+    }
 
-        // Drop all references to existing ones and trigger purge by going over min purge limit.
-        // Factory should have no VOs after this.
+    void FlyweightUnitTests::PurgeTests()
+    {
+        ::Flyweight::Factory<TestVO2>::State state;
 
-        ptrs.clear();
+        // Create unique VOs without holding on to them, so only the factory references them.
 
-        for (int i = 0; i < 49; ++i)
+        for (int i = 1; i <= 1000; ++i)
         {
-            xref_ptr<TestVO2::Wrapper> temp = ::Flyweight::Factory<TestVO2>::Create(
+            ::Flyweight::Factory<TestVO2>::Create(
                 &state,
-                999);
+                i);
         }
 
-        // Adding a new one, which should be managed by factory.
+        // Unused VOs get purged a few at a time by later inserts, until only the one being held is left.
 
-        xref_ptr<TestVO2::Wrapper> ptr2 = ::Flyweight::Factory<TestVO2>::Create(
+        xref_ptr<TestVO2::Wrapper> held = ::Flyweight::Factory<TestVO2>::Create(
             &state,
             99999);
 
-        VERIFY_ARE_EQUAL(2, ptr2->GetRefCount());
+        for (int i = 0; i < 10000 && state.GetCount() > 1; ++i)
+        {
+            xref_ptr<TestVO2::Wrapper> temp = ::Flyweight::Factory<TestVO2>::Create(
+                &state,
+                99999);
+
+            VERIFY_ARE_EQUAL(held.get(), temp.get());
+        }
+
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), state.GetCount());
+        VERIFY_ARE_EQUAL(2, held->GetRefCount());
+
+        const auto& statistics = state.GetStatistics();
+        VERIFY_ARE_EQUAL(static_cast<std::uint64_t>(1001), statistics.m_misses);
+        VERIFY_ARE_EQUAL(static_cast<std::uint64_t>(1000), statistics.m_purged);
+    }
+
+    void FlyweightUnitTests::FactoryBenchmark()
+    {
+        struct BenchmarkCase
+        {
+            const wchar_t* label;
+            int distinctValues;
+        };
+
+        static const BenchmarkCase cases[] =
+        {
+            { L"   64 distinct", 64 },
+            { L"  271 distinct", 271 },
+            { L" 2000 distinct", 2000 },
+        };
+
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+
+        static const int measureIterations = 1000000;
 
-        // Even though the state is the same, they are not the same instances.
+        WEX::Logging::Log::Comment(L"=== Flyweight factory benchmark: hashed table (current) vs sorted linear bucket ===");
+        WEX::Logging::Log::Comment(
+            WEX::Common::String().Format(L"Iterations: %d, QPC freq: %lld Hz", measureIterations, freq.QuadPart));
 
-        VERIFY_IS_TRUE(::Flyweight::Operators::equal(ptr1->Value(), ptr2->Value()));
-        VERIFY_ARE_NOT_EQUAL(ptr1.get(), ptr2.get());
+        for (int c = 0; c < ARRAYSIZE(cases); ++c)
+        {
+            const int distinctValues = cases[c].distinctValues;
+
+            // Requests cycle through the values in a scattered order, while every value stays referenced by the app.
+            std::vector<int> requests(measureIterations);
+            for (int i = 0; i < measureIterations; ++i)
+            {
+                requests[i] = 1 + static_cast<int>((static_cast<unsigned int>(i) * 2654435761u) % distinctValues);
+            }
+
+            ::Flyweight::Factory<TestVO>::State hashedState;
+            LinearBucketFactory<TestVO>::State linearState;
+            std::vector<xref_ptr<TestVO::Wrapper>> hashedHeld;
+            std::vector<xref_ptr<TestVO::Wrapper>> linearHeld;
+
+            for (int value = 1; value <= distinctValues; ++value)
+            {
+                hashedHeld.emplace_back(::Flyweight::Factory<TestVO>::Create(&hashedState, 1.0f, value, nullptr));
+                linearHeld.emplace_back(LinearBucketFactory<TestVO>::Create(&linearState, 1.0f, value, nullptr));
+            }
+
+            LARGE_INTEGER startHashed, endHashed;
+            QueryPerformanceCounter(&startHashed);
+            for (int value : requests)
+            {
+                xref_ptr<TestVO::Wrapper> temp = ::Flyweight::Factory<TestVO>::Create(&hashedState, 1.0f, value, nullptr);
+            }
+            QueryPerformanceCounter(&endHashed);
+
+            LARGE_INTEGER startLinear, endLinear;
+            QueryPerformanceCounter(&startLinear);
+            for (int value : requests)
+            {
+                xref_ptr<TestVO::Wrapper> temp = LinearBucketFactory<TestVO>::Create(&linearState, 1.0f, value, nullptr);
+            }
+            QueryPerformanceCounter(&endLinear);
+
+            double hashedNsPerCall = (static_cast<double>(endHashed.QuadPart - startHashed.QuadPart) * 1.0e9 / freq.QuadPart) / measureIterations;
+            double linearNsPerCall = (static_cast<double>(endLinear.QuadPart - startLinear.QuadPart) * 1.0e9 / freq.QuadPart) / measureIterations;
+
+            const auto& statistics = hashedState.GetStatistics();
+            double hashedHitRate = 100.0 * statistics.m_hits / (statistics.m_hits + statistics.m_misses);
+            double linearShareRate = 100.0 * (measureIterations - linearState.m_countPassThru) / measureIterations;
+
+            WEX::Logging::Log::Comment(
+                WEX::Common::String().Format(
+                    L"[%s] hashed: %6.1f ns/call, %5.1f%% hits | linear: %6.1f ns/call, %5.1f%% shared | speedup: %.2fx",
+                    cases[c].label,
+                    hashedNsPerCall, hashedHitRate,
+                    linearNsPerCall, linearShareRate,
+                    linearNsPerCall / hashedNsPerCall));
+        }
     }
 } } } } }
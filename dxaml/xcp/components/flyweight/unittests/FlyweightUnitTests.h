@@ -21,7 +21,11 @@ namespace Windows { namespace UI { namespace Xaml { namespace Tests {
 
             TEST_METHOD(BasicTests)
 
-            TEST_METHOD(OverflowTests)
+            TEST_METHOD(NoSizeLimitTests)
+
+            TEST_METHOD(PurgeTests)
+
+            TEST_METHOD(FactoryBenchmark)
         };
     }
 } } } }
@@ -59,7 +59,7 @@ CDependencyObject* XYFocus::GetNextFocusableElement(
     if (m_exploredList.empty() == false)
     {
         hash = ExploredListHash(direction, element, engagedControl, xyFocusOptions);
-        if (std::find(m_exploredList.begin(), m_exploredList.end(), hash) != m_exploredList.end())
+        if (m_exploredList.find(hash) != m_exploredList.end())
         {
             CacheHitTrace(direction);
             return nullptr;
@@ -140,7 +140,7 @@ CDependencyObject* XYFocus::GetNextFocusableElement(
             hash = ExploredListHash(direction, element, engagedControl, xyFocusOptions);
         }
 
-        m_exploredList.push_back(hash);
+        m_exploredList.insert(hash);
     }
 
     return nextFocusableElement;
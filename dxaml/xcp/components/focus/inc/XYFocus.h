@@ -6,6 +6,7 @@
 #include "enumdefs.g.h"
 #include "minxcptypes.h"
 
+#include <unordered_set>
 #include <vector>
 
 #include <CommonUtilities.h>
@@ -190,6 +191,6 @@ namespace Focus {
 
         Manifolds m_manifolds;
 
-        std::vector<std::size_t> m_exploredList;
+        std::unordered_set<std::size_t> m_exploredList;
     };
 }
@@ -5,6 +5,7 @@
 
 #include <ReferenceTrackerExtension.h>
 #include <unordered_set>
+#include <vector>
 
 class CoreWindowRootScale;
 
@@ -61,10 +62,15 @@ namespace DirectUI
     typedef std::unordered_set<xaml_hosting::IReferenceTrackerInternal*> ReferenceTrackerTable;
 #endif
 
+    // The tracker references set on a core since the last reference tracking, whose target was pegged when they
+    // were set.  Guarded by the core's reference lock.  Entries of references that went away are null.
+    typedef std::vector<TrackerTargetReference*> PendingUnpegTable;
+
     interface IPeerTableHost
     {
         virtual PeerTable& GetPeers() = 0;
         virtual ReferenceTrackerTable& GetReferenceTrackers() = 0;
+        virtual PendingUnpegTable& GetPendingUnpegs() = 0;
 
         virtual void AddToReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* pItem) = 0;
         virtual void RemoveFromReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* pItem) = 0;
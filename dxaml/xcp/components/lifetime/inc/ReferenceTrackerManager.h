@@ -12,6 +12,7 @@
 #include "ReferenceTrackerInterfaces.h"
 
 #include <wil\resource.h>
+#include <atomic>
 
 namespace DirectUI
 {
@@ -300,6 +301,21 @@ namespace DirectUI
         static bool CalculateIsPeerStressEnabled();
 #endif
 
+        // Tracker references whose target was pegged when they were set.  The target stays pegged until the next
+        // reference tracking, which might not walk the owner of the reference, so these are unpegged directly.
+        // They're kept in the PendingUnpegTable of the core of the thread that set them, under its reference lock;
+        // AddPendingUnpeg is called with that lock held, and the others take the lock of the core that has the slot.
+        static void AddPendingUnpeg(_In_ TrackerTargetReference *pTrackerPtr, _In_opt_ IDXamlCore *pCore);
+        static void RemovePendingUnpeg(_In_ TrackerTargetReference *pTrackerPtr);
+        static void MovePendingUnpeg(_In_ TrackerTargetReference *pFromTrackerPtr, _In_ TrackerTargetReference *pToTrackerPtr);
+
+        // True during a reference tracking if a reference was set without a core since the previous one, so that
+        // no peer can skip its RTW_Unpeg walk.
+        static bool IsUnpegWalkOfAllPeers()
+        {
+            return This != nullptr && This->m_unpegWalkOfAllPeers;
+        }
+
 #if DBG
         static void UnregisterTrackerPtr(_In_ TrackerTargetReference *pTrackerPtr, IDXamlCore *pCore);
         static void RegisterTrackerPtr(_In_ TrackerTargetReference *pTrackerPtr, IDXamlCore *pCore);
@@ -335,9 +351,14 @@ namespace DirectUI
         static int _targetCount;
         static int _unreachableCount;
 
+        // Peers walked and skipped by the RTW_Unpeg walks of the last reference tracking
+        static int _walkedPeerCount;
+        static int _skippedPeerCount;
+
     private:
 
         void ResetLastFindWalkIdForAllPeers();
+        void UnpegPendingTrackerPtrs(_In_ IDXamlCore *pCore);
 
         // The single instance of this class
         static ReferenceTrackerManager *This;
@@ -356,6 +377,11 @@ namespace DirectUI
 
         DWORD m_startThreadId;
 
+        // Set when a reference is set on a thread without a core, and so without a PendingUnpegTable, and
+        // read into m_unpegWalkOfAllPeers by the next reference tracking.
+        static std::atomic<bool> s_unpegWalkOfAllPeersPending;
+        bool m_unpegWalkOfAllPeers;
+
 #if DBG
         // Use the LeakIgnoringAllocator. If objects holding a TrackerPtr have been leaked, they won't unregister that pointer with the ReferenceTrackerManager
         // so we need to ignore these leaks. We also don't want a perfectly clean test getting dinged if this container has to reallocate
@@ -126,6 +126,24 @@ namespace DirectUI
         bool m_isTrackerInternal : 1;
         bool m_isManagedReference : 1;
 
+        // The slot of this reference in the PendingUnpegTable of m_pPendingUnpegCore, if the target was pegged when
+        // it was set and the next reference tracking will unpeg it, or c_noPendingUnpeg.  Only changed under that
+        // core's reference lock, but read without it (and from the thread running the reference tracking), so it's
+        // only accessed with interlocked operations.  The core is set before the slot, and only read while there's one,
+        // since the reference can be destroyed or moved on the thread of another core.
+        LONG m_pendingUnpegIndex;
+        IDXamlCore* m_pPendingUnpegCore;
+        static constexpr LONG c_noPendingUnpeg = -1;
+
+        LONG GetPendingUnpegIndex() const { return ReadAcquire(&m_pendingUnpegIndex); }
+        IDXamlCore* GetPendingUnpegCore() const { return m_pPendingUnpegCore; }
+        void SetPendingUnpegIndex(LONG index) { WriteRelease(&m_pendingUnpegIndex, index); }
+        void SetPendingUnpegSlot(_In_ IDXamlCore* pCore, LONG index)
+        {
+            m_pPendingUnpegCore = pCore;
+            SetPendingUnpegIndex(index);
+        }
+
 #if DBG
         INSTRUCTION_ADDRESS m_frameAddresses[40];
 #endif
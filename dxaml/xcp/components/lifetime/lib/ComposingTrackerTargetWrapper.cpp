@@ -62,6 +62,7 @@ DirectUI::ComposingTrackerTargetWrapper::Ensure(
             // To work around a race condition, peg the target now.  That will protect it until the next round of
             // reference tracking, at which point we'll correct it if necessary.
             IFC_RETURN(composingTrackerTarget->Peg());
+            tracker->m_referenceTrackerBitFields.bUnpegPending = true;
 
             composingTrackerTarget->Release();
         }
@@ -18,6 +18,7 @@ using namespace xaml_hosting;
 
 ReferenceTrackerManager* ReferenceTrackerManager::This = NULL;
 SRWLOCK ReferenceTrackerManager::s_lock {SRWLOCK_INIT};
+std::atomic<bool> ReferenceTrackerManager::s_unpegWalkOfAllPeersPending {false};
 
 #if XCP_MONITOR
 int ReferenceTrackerManager::s_cPeerStressIteration = 0;
@@ -233,6 +234,20 @@ ReferenceTrackerManager::UnregisterCore( _In_ IDXamlCore *pCore )
 
         This->m_activeCores.remove(pCore);
         This->m_allCores.remove(pCore);
+
+        // The references set on this core won't be walked anymore.
+        AutoReentrantReferenceLock peerTableLock(pCore);
+        PendingUnpegTable& pendingUnpegs = pCore->GetPendingUnpegs();
+
+        for (TrackerTargetReference* pTrackerPtr : pendingUnpegs)
+        {
+            if (pTrackerPtr != nullptr)
+            {
+                pTrackerPtr->SetPendingUnpegIndex(TrackerTargetReference::c_noPendingUnpeg);
+            }
+        }
+
+        pendingUnpegs.clear();
     }
 
     This->Release();    //RRETURN_REMOVAL
@@ -368,6 +383,29 @@ ReferenceTrackerManager::TriggerCollectionForSuspend( )
 
 }
 
+namespace
+{
+    // Peg tracker targets that are reachable from the pegged peers and core roots of a core.
+    // Called with the core's reference lock held.
+    void PegWalkCore(_In_ IDXamlCore* pCore)
+    {
+        PeerMapEntriesHelper peerMap(pCore);
+
+        for (auto it = peerMap.begin(); it != peerMap.end(); ++it)
+        {
+            xaml_hosting::IReferenceTrackerInternal *pObject = *it;
+            ASSERT( pObject != NULL );
+
+            pObject->ReferenceTrackerWalk( RTW_Peg, /* fIsRoot */ TRUE );
+        }
+
+        // Walk the core roots too.  We didn't need to walk them for the Unpeg walk, because
+        // they don't do anything special in that case.  But we need it in the Peg walk, because
+        // the Peg walk only continues if the root of the walk is pegged.
+        pCore->ReferenceTrackerWalkOnCoreGCRoots(RTW_Peg);
+    }
+}
+
 //+-------------------------------------- ------------------------------
 //
 //  ReferenceTrackingStarted
@@ -380,6 +418,8 @@ ReferenceTrackerManager::TriggerCollectionForSuspend( )
 int ReferenceTrackerManager::_peerCount = 0;
 int ReferenceTrackerManager::_targetCount = 0;
 int ReferenceTrackerManager::_unreachableCount = 0;
+int ReferenceTrackerManager::_walkedPeerCount = 0;
+int ReferenceTrackerManager::_skippedPeerCount = 0;
 
 _Check_return_
 IFACEMETHODIMP
@@ -406,6 +446,10 @@ ReferenceTrackerManager::ReferenceTrackingStarted()
     _peerCount = 0;
     _targetCount = 0;
     _unreachableCount = 0;
+    _walkedPeerCount = 0;
+    _skippedPeerCount = 0;
+
+    m_unpegWalkOfAllPeers = s_unpegWalkOfAllPeersPending.exchange(false);
 
 
     #if XCP_MONITOR
@@ -442,42 +486,49 @@ ReferenceTrackerManager::ReferenceTrackingStarted()
 
         PeerMapEntriesHelper peerMap(pCore);
 
-        // Unpeg all tracker targets
+        // Unpeg all tracker targets.  Only the peers that were walked by the previous peg walks have pegged
+        // their tracker targets, so the others skip the walk.  The targets that were pegged since then, when
+        // they were set into a tracker reference, are unpegged here instead.
+
+        UnpegPendingTrackerPtrs(pCore);
 
         for (auto it = peerMap.begin(); it != peerMap.end(); ++it)
         {
             xaml_hosting::IReferenceTrackerInternal* pObject = *it;
             ASSERT( pObject != NULL );
 
-            pObject->ReferenceTrackerWalk( RTW_Unpeg, /* fIsRoot */ TRUE );
+            if (pObject->ReferenceTrackerWalk( RTW_Unpeg, /* fIsRoot */ TRUE ))
+            {
+                _walkedPeerCount++;
+            }
+            else
+            {
+                _skippedPeerCount++;
+            }
 
             // Clear the 'reachable' flag.  We'll set it again, as appropriate, in
             // OnReferenceTrackingProcessed.  We can't clear it earlier than here,
             // because the previous value was being used during the previous RTW_Unpeg walk.
-            // This also clears the 'bPegWalked' flag that's used later in the RTW_Peg walks.
+            // This also clears the 'peg walked' flag that's used later in the RTW_Peg walks.
             pObject->PrepareForReferenceWalking();
 
             // For an ETW trace, calculate how many peers we have.
             _peerCount++;
         }
+    }
 
-        // Peg tracker targets that are reachable from a pegged peer
-        // We do this now so that during the tracker walks (calls to
-        // DependencyObject::FindTrackerTargets), we can prune the tree walks
-        // on an object if this pegging already walked through it.
-
-        for (auto it = peerMap.begin(); it != peerMap.end(); ++it)
-        {
-            xaml_hosting::IReferenceTrackerInternal *pObject = *it;
-            ASSERT( pObject != NULL );
-
-            pObject->ReferenceTrackerWalk( RTW_Peg, /* fIsRoot */ TRUE );
-        }
+    // Peg tracker targets that are reachable from a pegged peer
+    // We do this now so that during the tracker walks (calls to
+    // DependencyObject::FindTrackerTargets), we can prune the tree walks
+    // on an object if this pegging already walked through it.
+    // All the cores are unpegged first, so that the peg walk of one core can't be reset by the
+    // PrepareForReferenceWalking of another.  The walks stay serial: objects reachable from more
+    // than one core, and the cycle guard of the core tree (IsProcessingReferenceTrackerWalk), aren't
+    // safe to walk from several threads.
 
-        // Walk the core roots too.  We didn't need to walk them for the Unpeg walk, because
-        // they don't do anything special in that case.  But we need it in the Peg walk, because
-        // the Peg walk only continues if the root of the walk is pegged.
-        pCore->ReferenceTrackerWalkOnCoreGCRoots(RTW_Peg);
+    for (auto pCore : m_activeCores)
+    {
+        PegWalkCore(pCore);
     }
 
     // The counter starts at 0, but it'll be incremented to 1 when we start our first
@@ -489,6 +540,28 @@ ReferenceTrackerManager::ReferenceTrackingStarted()
 
 }
 
+//
+// Unpeg the targets of the tracker references that were set on the given core since the last
+// reference tracking.  Called with the core's reference lock held.
+//
+void
+ReferenceTrackerManager::UnpegPendingTrackerPtrs(_In_ IDXamlCore* pCore)
+{
+    PendingUnpegTable& pendingUnpegs = pCore->GetPendingUnpegs();
+
+    for (TrackerTargetReference* pTrackerPtr : pendingUnpegs)
+    {
+        if (pTrackerPtr != nullptr)
+        {
+            pTrackerPtr->SetPendingUnpegIndex(TrackerTargetReference::c_noPendingUnpeg);
+            pTrackerPtr->ReferenceTrackerWalk(RTW_Unpeg);
+        }
+    }
+
+    // Keeps its capacity, since about as many references are usually set before the next tracking.
+    pendingUnpegs.clear();
+}
+
 //
 // When the find walk counter m_currentFindWalkID wraps back to zero, we need
 // to reset the last find walk ID on every peer so we can re-use find walk IDs
@@ -674,8 +747,8 @@ ReferenceTrackerManager::ReferenceTrackingCompleted()
     if( !m_backgroundGCEnabled)
     #endif
     {
-        LOG(L"Reference tracking completed.  Objects=%d, Sources=%d, Targets=%d, Unreachable=%d",
-            _peerCount, m_currentFindWalkID, _targetCount, _unreachableCount );
+        LOG(L"Reference tracking completed.  Objects=%d, Sources=%d, Targets=%d, Unreachable=%d, Walked=%d, Skipped=%d",
+            _peerCount, m_currentFindWalkID, _targetCount, _unreachableCount, _walkedPeerCount, _skippedPeerCount );
     }
     #endif
 
@@ -1020,6 +1093,7 @@ ReferenceTrackerManager::ReferenceTrackerManager(  )
     , _pReferenceTrackerHost(nullptr)
     , _refs(0)
     , m_startThreadId(0)
+    , m_unpegWalkOfAllPeers(false)
 { }
 
 //+--------------------------------------------------------------------
@@ -1045,6 +1119,100 @@ ReferenceTrackerManager::~ReferenceTrackerManager()
 }
 
 
+//+--------------------------------------------------------------------
+//
+//  AddPendingUnpeg/RemovePendingUnpeg/MovePendingUnpeg
+//
+//  Keep track of the tracker references that pegged their target when they were
+//  set, until the next ReferenceTrackingStarted unpegs them.
+//
+//  Like the peer tables, the pending unpegs of a core are only changed under the core's reference
+//  lock.  A reference remembers the core whose table has its slot, since it can be destroyed or
+//  moved on the thread of another core.  When a core goes away, it releases the slots in its table
+//  first, under its lock.
+//
+//+--------------------------------------------------------------------
+
+//static
+void
+ReferenceTrackerManager::AddPendingUnpeg( _In_ TrackerTargetReference *pTrackerPtr, _In_opt_ IDXamlCore *pCore )
+{
+    if (pCore == nullptr)
+    {
+        // There's no table to put the reference in, so the next tracking walks every peer instead.
+        s_unpegWalkOfAllPeersPending = true;
+        return;
+    }
+
+    // A reference that's set again before the next tracking keeps its slot, and gets unpegged once.
+    if (pTrackerPtr->GetPendingUnpegIndex() == TrackerTargetReference::c_noPendingUnpeg)
+    {
+        PendingUnpegTable& pendingUnpegs = pCore->GetPendingUnpegs();
+
+        pTrackerPtr->SetPendingUnpegSlot(pCore, static_cast<LONG>(pendingUnpegs.size()));
+        pendingUnpegs.push_back(pTrackerPtr);
+    }
+}
+
+//static
+void
+ReferenceTrackerManager::RemovePendingUnpeg( _In_ TrackerTargetReference *pTrackerPtr )
+{
+    // Without a slot, the reference tracking unpegged the reference, or its core went away with its table.
+    if (pTrackerPtr->GetPendingUnpegIndex() != TrackerTargetReference::c_noPendingUnpeg)
+    {
+        IDXamlCore* pCore = pTrackerPtr->GetPendingUnpegCore();
+        AutoReentrantReferenceLock peerTableLock(pCore);
+
+        // The tracking may have unpegged the reference since the caller checked.
+        const LONG index = pTrackerPtr->GetPendingUnpegIndex();
+
+        if (index != TrackerTargetReference::c_noPendingUnpeg)
+        {
+            PendingUnpegTable& pendingUnpegs = pCore->GetPendingUnpegs();
+
+            ASSERT(static_cast<size_t>(index) < pendingUnpegs.size() && pendingUnpegs[index] == pTrackerPtr);
+            pendingUnpegs[index] = nullptr;
+        }
+    }
+
+    pTrackerPtr->SetPendingUnpegIndex(TrackerTargetReference::c_noPendingUnpeg);
+}
+
+//static
+void
+ReferenceTrackerManager::MovePendingUnpeg( _In_ TrackerTargetReference *pFromTrackerPtr, _In_ TrackerTargetReference *pToTrackerPtr )
+{
+    if (pFromTrackerPtr->GetPendingUnpegIndex() != TrackerTargetReference::c_noPendingUnpeg)
+    {
+        IDXamlCore* pCore = pFromTrackerPtr->GetPendingUnpegCore();
+        AutoReentrantReferenceLock peerTableLock(pCore);
+
+        const LONG index = pFromTrackerPtr->GetPendingUnpegIndex();
+
+        if (index != TrackerTargetReference::c_noPendingUnpeg)
+        {
+            PendingUnpegTable& pendingUnpegs = pCore->GetPendingUnpegs();
+
+            ASSERT(static_cast<size_t>(index) < pendingUnpegs.size() && pendingUnpegs[index] == pFromTrackerPtr);
+
+            // If the destination has a slot of its own, it's unpegged through that one.
+            if (pToTrackerPtr->GetPendingUnpegIndex() == TrackerTargetReference::c_noPendingUnpeg)
+            {
+                pendingUnpegs[index] = pToTrackerPtr;
+                pToTrackerPtr->SetPendingUnpegSlot(pCore, index);
+            }
+            else
+            {
+                pendingUnpegs[index] = nullptr;
+            }
+        }
+    }
+
+    pFromTrackerPtr->SetPendingUnpegIndex(TrackerTargetReference::c_noPendingUnpeg);
+}
+
+
 #if DBG
 void
 ReferenceTrackerManager::UnregisterTrackerPtr( _In_ TrackerTargetReference *pTrackerPtr, IDXamlCore *pCore )
@@ -241,10 +241,25 @@ TrackerTargetReference::TrackerTargetReference(TrackerTargetReference&& other) n
     Initialize();
 
     *this = std::move(other);
+
+    // The copy above doesn't read the slot atomically, and the slot is still the other reference's.
+    SetPendingUnpegIndex(c_noPendingUnpeg);
+
+    if (other.GetPendingUnpegIndex() != c_noPendingUnpeg)
+    {
+        ReferenceTrackerManager::MovePendingUnpeg(&other, this);
+    }
 }
 
 TrackerTargetReference::~TrackerTargetReference()
 {
+    // The slot is kept when the reference is cleared or set again, and the reference tracking unpegs whatever
+    // the reference holds by then, but it can't be left pointing to a reference that's gone.
+    if (GetPendingUnpegIndex() != c_noPendingUnpeg)
+    {
+        ReferenceTrackerManager::RemovePendingUnpeg(this);
+    }
+
     ClearRawValue();
 
 #if DBG
@@ -269,6 +284,8 @@ void TrackerTargetReference::Initialize()
     m_extraExpectedRef = false;
     m_isTrackerInternal = false;
     m_isManagedReference = false;
+    m_pendingUnpegIndex = c_noPendingUnpeg;
+    m_pPendingUnpegCore = nullptr;
 
 #if DBG
     m_fStatic = false;
@@ -313,7 +330,8 @@ TrackerTargetReference& TrackerTargetReference::Assign(_In_ TrackerTargetReferen
         Clear();
 
         {
-            AutoReentrantReferenceLock lock(DXamlServices::GetDXamlCore());
+            IDXamlCore* pCore = DXamlServices::GetDXamlCore();
+            AutoReentrantReferenceLock lock(pCore);
 
             m_value = other.m_value;
             m_trackerData = other.m_trackerData;
@@ -323,6 +341,21 @@ TrackerTargetReference& TrackerTargetReference::Assign(_In_ TrackerTargetReferen
             m_isTrackerInternal = other.m_isTrackerInternal;
             m_isManagedReference = other.m_isManagedReference;
 
+            // The slot can only move within the table of its core, which is the one locked here unless the other
+            // reference was set on the thread of another core.  Taking that core's lock too could deadlock with the
+            // reference tracking, so this reference gets a slot of its own, and the other one is removed below.
+            if (other.GetPendingUnpegIndex() != c_noPendingUnpeg)
+            {
+                if (other.GetPendingUnpegCore() == pCore)
+                {
+                    ReferenceTrackerManager::MovePendingUnpeg(&other, this);
+                }
+                else
+                {
+                    ReferenceTrackerManager::AddPendingUnpeg(this, pCore);
+                }
+            }
+
 #if DBG
             m_fStatic = other.m_fStatic;
             m_fHasBeenWalked = other.m_fHasBeenWalked;
@@ -342,6 +375,11 @@ TrackerTargetReference& TrackerTargetReference::Assign(_In_ TrackerTargetReferen
             other.m_fHasBeenWalked = false;
 #endif
         }
+
+        if (other.GetPendingUnpegIndex() != c_noPendingUnpeg)
+        {
+            ReferenceTrackerManager::RemovePendingUnpeg(&other);
+        }
     }
 
     return *this;
@@ -454,11 +492,20 @@ void TrackerTargetReference::Set(
 
     // Swap the new values in under protection of the lock
     {
-        AutoReentrantReferenceLock lock(DXamlServices::GetDXamlCore());
+        IDXamlCore* pCore = DXamlServices::GetDXamlCore();
+        AutoReentrantReferenceLock lock(pCore);
 
         SetRawValue(pNewValue, pNewTrackerTarget, pNewReferenceTracker);
         pNewValue = nullptr;
 
+        // The owner of this reference only gets an unpeg walk if it was walked by the last peg walk,
+        // so have the temporary pegs taken above undone by the next reference tracking.  This is under
+        // the core's lock already, so it takes no other lock.
+        if (pNewTrackerTarget != nullptr || fPegged)
+        {
+            ReferenceTrackerManager::AddPendingUnpeg(this, pCore);
+        }
+
         m_isDO = fIsDO;
         pNewDO = nullptr;
 
@@ -365,6 +365,20 @@ WeakReferenceSourceNoThreadId::ReferenceTrackerWalkCore(EReferenceTrackerWalkTyp
                 goto Cleanup;
             }
 
+            // Tracker targets only get pegged by peg walks, or temporarily when they're set.  So if this object
+            // wasn't walked by the last peg walks, and hasn't pegged anything since, there's nothing to unpeg.
+            // (The tracker references that were set since then are unpegged by the ReferenceTrackerManager, unless
+            // they were set without a core, in which case every peer is walked.)
+            if (!m_referenceTrackerBitFields.bPegWalked
+                && !m_referenceTrackerBitFields.bUnpegPending
+                && !IsPegged(true /*isRefCountPegged*/)
+                && !ReferenceTrackerManager::IsUnpegWalkOfAllPeers())
+            {
+                goto Cleanup;
+            }
+
+            m_referenceTrackerBitFields.bUnpegPending = false;
+
             ClearRefCountPeg();
 
             // Clear the flag that indicates we've been pegged because of being in the core's
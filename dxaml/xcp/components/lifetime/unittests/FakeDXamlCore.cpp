@@ -10,7 +10,7 @@
 
 using namespace DirectUI;
 
-IDXamlCore* FakeDXamlCore::s_currentDXamlCore = nullptr;
+thread_local IDXamlCore* FakeDXamlCore::s_currentDXamlCore = nullptr;
 
 FakeDXamlCore::FakeDXamlCore()
 {
@@ -23,6 +23,7 @@ namespace DirectUI
         // IPeerTableHost
         PeerTable& GetPeers() override { return m_peers; }
         ReferenceTrackerTable& GetReferenceTrackers() override { return m_referenceTrackers; }
+        PendingUnpegTable& GetPendingUnpegs() override { return m_pendingUnpegs; }
 
         void AddToReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* item) override;
         void RemoveFromReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* item) override;
@@ -65,6 +66,7 @@ namespace DirectUI
     private:
         PeerTable m_peers;
         ReferenceTrackerTable m_referenceTrackers;
+        PendingUnpegTable m_pendingUnpegs;
 
         std::vector<ctl::WeakReferenceSourceNoThreadId*> m_unreachableQueue;
         std::vector<ctl::WeakReferenceSourceNoThreadId*> m_finalReleaseQueue;
@@ -74,7 +76,8 @@ namespace DirectUI
         SRWLOCK m_peerReferenceLock;
         LONG m_cReferenceLockEnters = 0;
 
-        static IDXamlCore* s_currentDXamlCore;
+        // Like the real cores, there's one per thread at most.
+        static thread_local IDXamlCore* s_currentDXamlCore;
         UINT32 m_threadId;
 
         std::uint64_t m_rtwElementCount = 0;
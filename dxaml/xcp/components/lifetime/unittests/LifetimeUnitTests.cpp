@@ -12,6 +12,7 @@
 #include <ComPtr.h>
 #include <CStaticLock.h>
 #include <WeakReferenceSourceNoThreadId.h>
+#include <vector>
 #include <ReferenceTrackerManager.h>
 
 using namespace ctl;
@@ -237,10 +238,253 @@ namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace
         return 0;
     }
 
+    void LifetimeUnitTests::UnpegWalkSkipsTrackersThatPeggedNothing()
+    {
+        auto manager = ReferenceTrackerManager::GetNoRef();
 
+        ctl::ComPtr<DirectUI::WuxTracker> peggedTracker;
+        ctl::ComPtr<DirectUI::WuxTracker> reachableTracker;
+        ctl::ComPtr<DirectUI::WuxTracker> sourceTracker;
+        wrl::ComPtr<DirectUI::TrackerTarget> peggedTarget;
+        wrl::ComPtr<DirectUI::TrackerTarget> sourceTarget;
+
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(peggedTracker.GetAddressOf()));
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(reachableTracker.GetAddressOf()));
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(sourceTracker.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(peggedTarget.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(sourceTarget.GetAddressOf()));
+
+        // peggedTracker keeps its create-time peg, so the peg walk goes through reachableTracker to peggedTarget.
+        // sourceTracker is only referenced by a tracker source, so it stays reachable but never pegs its target.
+        THROW_IF_FAILED(peggedTracker->SetTrackerReference(reachableTracker.Get()));
+        THROW_IF_FAILED(reachableTracker->SetTrackerReference(peggedTarget.Get()));
+        THROW_IF_FAILED(sourceTracker->AddRefFromTrackerSource());
+        THROW_IF_FAILED(sourceTracker->SetTrackerReference(sourceTarget.Get()));
+
+        // The targets were pegged when they were set.  The first GC unpegs them, although none of the trackers
+        // was walked by a previous peg walk.
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
 
+        VERIFY_ARE_EQUAL(2, peggedTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(1, peggedTarget->GetUnpegCount());
+        VERIFY_ARE_EQUAL(1, sourceTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(1, sourceTarget->GetUnpegCount());
+
+        // From then on, only the trackers that were walked by the peg walk get an unpeg walk.
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        VERIFY_ARE_EQUAL(3, peggedTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(2, peggedTarget->GetUnpegCount());
+        VERIFY_ARE_EQUAL(1, sourceTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(1, sourceTarget->GetUnpegCount());
+        VERIFY_IS_TRUE(ReferenceTrackerManager::_walkedPeerCount >= 2);
+        VERIFY_IS_TRUE(ReferenceTrackerManager::_skippedPeerCount >= 1);
+
+        // A new target is pegged until the next GC, which unpegs it without walking sourceTracker.
+        wrl::ComPtr<DirectUI::TrackerTarget> newSourceTarget;
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(newSourceTarget.GetAddressOf()));
+        THROW_IF_FAILED(sourceTracker->SetTrackerReference(newSourceTarget.Get()));
+
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        VERIFY_ARE_EQUAL(1, newSourceTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(1, newSourceTarget->GetUnpegCount());
+        VERIFY_ARE_EQUAL(1, sourceTarget->GetUnpegCount());
+
+        THROW_IF_FAILED(sourceTracker->ReleaseFromTrackerSource());
+    }
+
+    void LifetimeUnitTests::PendingUnpegsFollowTheirReferences()
+    {
+        auto manager = ReferenceTrackerManager::GetNoRef();
+        PendingUnpegTable& pendingUnpegs = m_dxamlCore->GetPendingUnpegs();
+
+        ctl::ComPtr<DirectUI::WuxTracker> sourceTracker;
+        ctl::ComPtr<DirectUI::WuxTracker> releasedTracker;
+        wrl::ComPtr<DirectUI::TrackerTarget> firstTarget;
+        wrl::ComPtr<DirectUI::TrackerTarget> secondTarget;
+        wrl::ComPtr<DirectUI::TrackerTarget> releasedTarget;
+
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(sourceTracker.GetAddressOf()));
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(releasedTracker.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(firstTarget.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(secondTarget.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(releasedTarget.GetAddressOf()));
+        THROW_IF_FAILED(sourceTracker->AddRefFromTrackerSource());
+
+        // Start from an empty table.
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+        VERIFY_ARE_EQUAL(0u, static_cast<unsigned>(pendingUnpegs.size()));
+
+        // Setting the same reference twice takes a single slot, which unpegs whatever it holds at the next tracking.
+        THROW_IF_FAILED(sourceTracker->SetTrackerReference(firstTarget.Get()));
+        THROW_IF_FAILED(sourceTracker->SetTrackerReference(secondTarget.Get()));
+        VERIFY_ARE_EQUAL(1u, static_cast<unsigned>(pendingUnpegs.size()));
+
+        // A reference that goes away before the next tracking leaves an empty slot behind.
+        THROW_IF_FAILED(releasedTracker->SetTrackerReference(releasedTarget.Get()));
+        VERIFY_ARE_EQUAL(2u, static_cast<unsigned>(pendingUnpegs.size()));
+        releasedTracker = nullptr;
+        VERIFY_IS_NULL(pendingUnpegs[1]);
+
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        VERIFY_ARE_EQUAL(0u, static_cast<unsigned>(pendingUnpegs.size()));
+        VERIFY_ARE_EQUAL(1u, secondTarget->GetPegCount());
+        VERIFY_ARE_EQUAL(1u, secondTarget->GetUnpegCount());
+        VERIFY_ARE_EQUAL(0u, releasedTarget->GetUnpegCount());
+
+        THROW_IF_FAILED(sourceTracker->ReleaseFromTrackerSource());
+    }
+
+    // The other core of PendingUnpegsAreRemovedFromTheirCore.  Its thread sets a reference, and then keeps the core
+    // alive until the test is done with it.
+    struct PendingUnpegCore
+    {
+        wil::unique_event_nothrow m_readyEvent;
+        wil::unique_event_nothrow m_doneEvent;
+        PendingUnpegTable* m_pendingUnpegs = nullptr;
+        ctl::ComPtr<DirectUI::WuxTracker> m_tracker;
+        wrl::ComPtr<DirectUI::TrackerTarget> m_target;
+    };
+
+    static DWORD WINAPI PendingUnpegCoreThread(_In_ LPVOID parameter)
+    {
+        auto core = static_cast<PendingUnpegCore*>(parameter);
+
+        {
+            FakeDXamlCore dxamlCore;
+            core->m_pendingUnpegs = &dxamlCore.GetPendingUnpegs();
+
+            THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(core->m_tracker.GetAddressOf()));
+            THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(core->m_target.GetAddressOf()));
+            THROW_IF_FAILED(core->m_tracker->SetTrackerReference(core->m_target.Get()));
+
+            core->m_readyEvent.SetEvent();
+            core->m_doneEvent.wait();
+        }
+
+        return 0;
+    }
+
+    void LifetimeUnitTests::PendingUnpegsAreRemovedFromTheirCore()
+    {
+        auto manager = ReferenceTrackerManager::GetNoRef();
+        PendingUnpegTable& pendingUnpegs = m_dxamlCore->GetPendingUnpegs();
+
+        // Start from an empty table.
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        ctl::ComPtr<DirectUI::WuxTracker> tracker;
+        wrl::ComPtr<DirectUI::TrackerTarget> target;
+        THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(tracker.GetAddressOf()));
+        THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(target.GetAddressOf()));
+        THROW_IF_FAILED(tracker->SetTrackerReference(target.Get()));
+        VERIFY_ARE_EQUAL(1u, static_cast<unsigned>(pendingUnpegs.size()));
+
+        PendingUnpegCore core;
+        core.m_readyEvent.create();
+        core.m_doneEvent.create();
+
+        wil::unique_handle thread(CreateThread(NULL, 0, PendingUnpegCoreThread, &core, 0, NULL));
+        if (thread == nullptr)
+        {
+            THROW_IF_FAILED(HRESULT_FROM_WIN32(GetLastError()));
+        }
+
+        core.m_readyEvent.wait();
+        VERIFY_ARE_EQUAL(1u, static_cast<unsigned>(core.m_pendingUnpegs->size()));
+
+        // Both references have the first slot of their table, so removing the other one from this core's table would
+        // drop the reference set here.
+        core.m_tracker = nullptr;
+        VERIFY_IS_NULL((*core.m_pendingUnpegs)[0]);
+        VERIFY_IS_NOT_NULL(pendingUnpegs[0]);
+
+        core.m_doneEvent.SetEvent();
+        WaitForSingleObject(thread.get(), INFINITE);
+
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        VERIFY_ARE_EQUAL(0u, static_cast<unsigned>(pendingUnpegs.size()));
+        VERIFY_ARE_EQUAL(1u, target->GetUnpegCount());
+        VERIFY_ARE_EQUAL(0u, core.m_target->GetUnpegCount());
+    }
+
+    void LifetimeUnitTests::UnpegWalkStress()
+    {
+        auto manager = ReferenceTrackerManager::GetNoRef();
+
+        // Trackers only referenced by tracker sources, like most of the peers of a large managed app.
+        static const int trackerCount = 10000;
+
+        // As with peer stress, a GC runs after every few reference updates.
+        static const int updatesPerTracking = 10;
+        static const int trackings = 100;
+
+        std::vector<ctl::ComPtr<DirectUI::WuxTracker>> trackers(trackerCount);
+        std::vector<wrl::ComPtr<DirectUI::TrackerTarget>> targets(trackerCount);
+
+        for (int i = 0; i < trackerCount; ++i)
+        {
+            THROW_IF_FAILED(ctl::ComObject<DirectUI::WuxTracker>::CreateInstance(trackers[i].GetAddressOf()));
+            THROW_IF_FAILED(wrl::MakeAndInitialize<DirectUI::TrackerTarget>(targets[i].GetAddressOf()));
+            THROW_IF_FAILED(trackers[i]->AddRefFromTrackerSource());
+            THROW_IF_FAILED(trackers[i]->SetTrackerReference(targets[i].Get()));
+        }
+
+        // Unpeg the targets set above.
+        THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+        THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+        int walkedPeers = 0;
+        int skippedPeers = 0;
+
+        LARGE_INTEGER freq, start, end;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&start);
+
+        for (int tracking = 0; tracking < trackings; ++tracking)
+        {
+            for (int update = 0; update < updatesPerTracking; ++update)
+            {
+                const int index = (tracking * updatesPerTracking + update) % trackerCount;
+                THROW_IF_FAILED(trackers[index]->SetTrackerReference(targets[(index + 1) % trackerCount].Get()));
+            }
+
+            THROW_IF_FAILED(manager->ReferenceTrackingStarted());
+            THROW_IF_FAILED(manager->ReferenceTrackingCompleted());
+
+            // None of the trackers pegged anything, including the ones that were just updated.
+            VERIFY_IS_TRUE(ReferenceTrackerManager::_skippedPeerCount >= trackerCount);
+
+            walkedPeers += ReferenceTrackerManager::_walkedPeerCount;
+            skippedPeers += ReferenceTrackerManager::_skippedPeerCount;
+        }
+
+        QueryPerformanceCounter(&end);
+
+        WEX::Logging::Log::Comment(L"=== Reference tracking stress: unpeg walks over trackers referenced by tracker sources ===");
+        WEX::Logging::Log::Comment(
+            WEX::Common::String().Format(L"Trackers: %d, trackings: %d, updates per tracking: %d",
+                trackerCount, trackings, updatesPerTracking));
+        WEX::Logging::Log::Comment(
+            WEX::Common::String().Format(L"Peers walked: %d, skipped: %d, average tracking: %.3f ms",
+                walkedPeers, skippedPeers, (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart / trackings));
+
+        for (auto& tracker : trackers)
+        {
+            THROW_IF_FAILED(tracker->ReleaseFromTrackerSource());
+        }
+    }
 
-    
 } } } } }
 
 
@@ -31,6 +31,22 @@ namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace
             TEST_METHOD_PROPERTY(L"Description", L"Description")
         END_TEST_METHOD()
 
+        BEGIN_TEST_METHOD(UnpegWalkSkipsTrackersThatPeggedNothing)
+            TEST_METHOD_PROPERTY(L"Description", L"Validates that the unpeg walk only walks the trackers that pegged their targets since the last reference tracking.")
+        END_TEST_METHOD()
+
+        BEGIN_TEST_METHOD(PendingUnpegsFollowTheirReferences)
+            TEST_METHOD_PROPERTY(L"Description", L"Validates that the core's pending unpegs keep one slot for a reference that's set again, and drop the references that are destroyed before the next reference tracking.")
+        END_TEST_METHOD()
+
+        BEGIN_TEST_METHOD(PendingUnpegsAreRemovedFromTheirCore)
+            TEST_METHOD_PROPERTY(L"Description", L"Validates that a reference destroyed on the thread of another core leaves an empty slot in the pending unpegs of the core that set it, and doesn't touch those of its own core.")
+        END_TEST_METHOD()
+
+        BEGIN_TEST_METHOD(UnpegWalkStress)
+            TEST_METHOD_PROPERTY(L"Description", L"Measures reference tracking over many unpegged trackers, with reference updates between each tracking as in peer stress.")
+        END_TEST_METHOD()
+
     private:
 
         DirectUI::FakeDXamlCore* m_dxamlCore;
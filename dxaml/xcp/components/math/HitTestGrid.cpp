@@ -0,0 +1,315 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include "HitTestGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+    bool IsUsableBounds(const XRECTF_RB& bounds)
+    {
+        return std::isfinite(bounds.left)
+            && std::isfinite(bounds.top)
+            && std::isfinite(bounds.right)
+            && std::isfinite(bounds.bottom)
+            && bounds.left <= bounds.right
+            && bounds.top <= bounds.bottom;
+    }
+
+    // Touching counts as intersecting, so the grid never drops an item an exact test could hit.
+    bool DoBoundsIntersect(const XRECTF_RB& a, const XRECTF_RB& b)
+    {
+        return a.left <= b.right
+            && b.left <= a.right
+            && a.top <= b.bottom
+            && b.top <= a.bottom;
+    }
+
+    XUINT32 ClampCellCount(double count, XUINT32 maxCount)
+    {
+        if (!(count > 1.0))
+        {
+            return 1;
+        }
+
+        return (count < maxCount) ? static_cast<XUINT32>(count) : maxCount;
+    }
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Discards the grid and starts collecting the items of a new one.
+//
+//------------------------------------------------------------------------
+void HitTestGrid::BeginBuild(XUINT32 itemCount)
+{
+    m_isValid = false;
+    m_itemCount = itemCount;
+
+    m_items.assign(itemCount, nullptr);
+    m_entries.clear();
+    m_cellStarts.clear();
+    m_cellEntries.clear();
+    m_largeEntries.clear();
+    m_alwaysTested.clear();
+
+    m_entries.reserve(itemCount);
+}
+
+void HitTestGrid::Add(XUINT32 position, _In_ const void* item, _In_ const XRECTF_RB& bounds)
+{
+    ASSERT(position < m_itemCount && !m_isValid);
+
+    m_items[position] = item;
+
+    if (IsUsableBounds(bounds))
+    {
+        m_entries.push_back({ bounds, position });
+    }
+    else
+    {
+        m_alwaysTested.push_back(position);
+    }
+}
+
+void HitTestGrid::AddAlwaysTested(XUINT32 position, _In_ const void* item)
+{
+    ASSERT(position < m_itemCount && !m_isValid);
+
+    m_items[position] = item;
+    m_alwaysTested.push_back(position);
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Sizes the grid to the combined bounds of the items and sorts the
+//      items into the cells they overlap.
+//
+//------------------------------------------------------------------------
+void HitTestGrid::EndBuild()
+{
+    ASSERT(!m_isValid);
+
+    m_columnCount = 0;
+    m_rowCount = 0;
+
+    if (!m_entries.empty())
+    {
+        m_extent = m_entries[0].m_bounds;
+
+        for (const Entry& entry : m_entries)
+        {
+            m_extent.left = std::min(m_extent.left, entry.m_bounds.left);
+            m_extent.top = std::min(m_extent.top, entry.m_bounds.top);
+            m_extent.right = std::max(m_extent.right, entry.m_bounds.right);
+            m_extent.bottom = std::max(m_extent.bottom, entry.m_bounds.bottom);
+        }
+
+        // Pick roughly square cells, so that both wide and tall layouts spread their items over the grid.
+        const double width = static_cast<double>(m_extent.right) - m_extent.left;
+        const double height = static_cast<double>(m_extent.bottom) - m_extent.top;
+        const double cellCount = std::max<double>(1.0, static_cast<double>(m_entries.size()) / c_itemsPerCell);
+
+        if (width > 0.0 && height > 0.0)
+        {
+            m_columnCount = ClampCellCount(std::sqrt(cellCount * width / height), c_maxCellsPerSide);
+            m_rowCount = ClampCellCount(std::ceil(cellCount / m_columnCount), c_maxCellsPerSide);
+        }
+        else
+        {
+            m_columnCount = (width > 0.0) ? ClampCellCount(cellCount, c_maxCellsPerSide) : 1;
+            m_rowCount = (height > 0.0) ? ClampCellCount(cellCount, c_maxCellsPerSide) : 1;
+        }
+
+        m_columnScale = (width > 0.0) ? static_cast<XFLOAT>(m_columnCount / width) : 0.0f;
+        m_rowScale = (height > 0.0) ? static_cast<XFLOAT>(m_rowCount / height) : 0.0f;
+
+        // Count the entries in each cell, then turn the counts into the start of each cell's range and fill the
+        // ranges in a second pass.
+        m_cellStarts.assign(m_columnCount * m_rowCount + 1, 0);
+
+        auto forEachCell = [this](const Entry& entry, XUINT32 entryIndex, const auto& callback)
+        {
+            const XUINT32 firstColumn = GetColumn(entry.m_bounds.left);
+            const XUINT32 lastColumn = GetColumn(entry.m_bounds.right);
+            const XUINT32 firstRow = GetRow(entry.m_bounds.top);
+            const XUINT32 lastRow = GetRow(entry.m_bounds.bottom);
+
+            if ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) > c_maxCellsPerEntry)
+            {
+                return false;
+            }
+
+            for (XUINT32 row = firstRow; row <= lastRow; ++row)
+            {
+                for (XUINT32 column = firstColumn; column <= lastColumn; ++column)
+                {
+                    callback(row * m_columnCount + column, entryIndex);
+                }
+            }
+
+            return true;
+        };
+
+        for (XUINT32 entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+        {
+            const bool isInCells = forEachCell(m_entries[entryIndex], entryIndex, [this](XUINT32 cell, XUINT32)
+            {
+                ++m_cellStarts[cell + 1];
+            });
+
+            if (!isInCells)
+            {
+                m_largeEntries.push_back(entryIndex);
+            }
+        }
+
+        for (XUINT32 cell = 0; cell < m_columnCount * m_rowCount; ++cell)
+        {
+            m_cellStarts[cell + 1] += m_cellStarts[cell];
+        }
+
+        m_cellEntries.resize(m_cellStarts.back());
+
+        std::vector<XUINT32> cellEnds(m_cellStarts.begin(), m_cellStarts.end() - 1);
+
+        for (XUINT32 entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+        {
+            forEachCell(m_entries[entryIndex], entryIndex, [this, &cellEnds](XUINT32 cell, XUINT32 index)
+            {
+                m_cellEntries[cellEnds[cell]++] = index;
+            });
+        }
+    }
+
+    m_isValid = true;
+}
+
+void HitTestGrid::Reset()
+{
+    m_isValid = false;
+    m_itemCount = 0;
+    m_columnCount = 0;
+    m_rowCount = 0;
+
+    m_items.clear();
+    m_items.shrink_to_fit();
+    m_entries.clear();
+    m_entries.shrink_to_fit();
+    m_cellStarts.clear();
+    m_cellStarts.shrink_to_fit();
+    m_cellEntries.clear();
+    m_cellEntries.shrink_to_fit();
+    m_largeEntries.clear();
+    m_largeEntries.shrink_to_fit();
+    m_alwaysTested.clear();
+    m_alwaysTested.shrink_to_fit();
+}
+
+// Both return the last column/row for coordinates past the extent, so every coordinate maps to a cell and the mapping
+// never decreases. An item's cells then always include the cell of any point inside it.
+XUINT32 HitTestGrid::GetColumn(XFLOAT x) const
+{
+    const XFLOAT column = (x - m_extent.left) * m_columnScale;
+
+    if (!(column > 0.0f))
+    {
+        return 0;
+    }
+
+    return (column < m_columnCount) ? static_cast<XUINT32>(column) : m_columnCount - 1;
+}
+
+XUINT32 HitTestGrid::GetRow(XFLOAT y) const
+{
+    const XFLOAT row = (y - m_extent.top) * m_rowScale;
+
+    if (!(row > 0.0f))
+    {
+        return 0;
+    }
+
+    return (row < m_rowCount) ? static_cast<XUINT32>(row) : m_rowCount - 1;
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Collects the positions of the items in the cells the target
+//      overlaps, plus the large and always tested items, sorted in
+//      descending order without duplicates.
+//
+//------------------------------------------------------------------------
+bool HitTestGrid::CollectCandidates(_In_ const XRECTF_RB& target, _Inout_ std::vector<XUINT32>& positions) const
+{
+    // Also rejects NaNs, which can't be mapped to a cell.
+    if (!(target.left <= target.right) || !(target.top <= target.bottom))
+    {
+        return false;
+    }
+
+    XUINT32 firstColumn = 0;
+    XUINT32 lastColumn = 0;
+    XUINT32 firstRow = 0;
+    XUINT32 lastRow = 0;
+    const bool isInExtent = m_columnCount > 0 && DoBoundsIntersect(m_extent, target);
+
+    if (isInExtent)
+    {
+        firstColumn = GetColumn(target.left);
+        lastColumn = GetColumn(target.right);
+        firstRow = GetRow(target.top);
+        lastRow = GetRow(target.bottom);
+
+        // Visiting most of the cells costs more than testing every item.
+        const XUINT32 targetCellCount = (lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+
+        if (targetCellCount > 1 && targetCellCount * 4 > m_columnCount * m_rowCount)
+        {
+            return false;
+        }
+    }
+
+    positions.insert(positions.end(), m_alwaysTested.begin(), m_alwaysTested.end());
+
+    for (XUINT32 entryIndex : m_largeEntries)
+    {
+        if (DoBoundsIntersect(m_entries[entryIndex].m_bounds, target))
+        {
+            positions.push_back(m_entries[entryIndex].m_position);
+        }
+    }
+
+    if (isInExtent)
+    {
+        for (XUINT32 row = firstRow; row <= lastRow; ++row)
+        {
+            for (XUINT32 column = firstColumn; column <= lastColumn; ++column)
+            {
+                const XUINT32 cell = row * m_columnCount + column;
+
+                for (XUINT32 i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+                {
+                    const Entry& entry = m_entries[m_cellEntries[i]];
+
+                    if (DoBoundsIntersect(entry.m_bounds, target))
+                    {
+                        positions.push_back(entry.m_position);
+                    }
+                }
+            }
+        }
+    }
+
+    // Items that span several of the target's cells are found once per cell.
+    std::sort(positions.begin(), positions.end(), std::greater<XUINT32>());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    return true;
+}
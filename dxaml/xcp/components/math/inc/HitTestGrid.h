@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <vector>
+
+// Uniform grid over the bounds of a list of items, used to find the items a hit test target can intersect without
+// testing every one of them. Items are identified by their position in the list. The grid is built in one pass over
+// the list and has to be rebuilt when it changes.
+//
+// The grid is conservative: it returns every item whose bounds intersect the target, including ones that only touch
+// it, plus any item added with AddAlwaysTested. The caller still tests each candidate exactly.
+class HitTestGrid
+{
+public:
+    // Lists with fewer items than this are cheap enough to test linearly.
+    static constexpr XUINT32 c_minItemCount = 128;
+
+    // Starts building the grid for a list of itemCount items. The grid can't be queried until EndBuild is called.
+    void BeginBuild(XUINT32 itemCount);
+
+    // Adds the item at the given position with its bounds. Items with inverted or non-finite bounds are
+    // treated as if they were added with AddAlwaysTested.
+    void Add(XUINT32 position, _In_ const void* item, _In_ const XRECTF_RB& bounds);
+
+    // Adds an item that is returned by every query, for items whose bounds aren't known or can't be used for culling.
+    void AddAlwaysTested(XUINT32 position, _In_ const void* item);
+
+    void EndBuild();
+
+    void Reset();
+
+    bool IsValid() const { return m_isValid; }
+    XUINT32 GetItemCount() const { return m_itemCount; }
+
+    // Collects the positions of the items that can intersect the target, in descending order. Returns false, leaving
+    // the positions unspecified, if the caller should test the whole list instead: the grid wasn't built, the list
+    // changed since it was built, or the target covers so much of the grid that it wouldn't save anything. The list
+    // is only checked at the candidate positions, so the caller is responsible for rebuilding the grid when the
+    // bounds of an item change.
+    template <typename T>
+    bool GetCandidates(
+        _In_ const XRECTF_RB& target,
+        _In_reads_(itemCount) T* const* items,
+        XUINT32 itemCount,
+        _Out_ std::vector<XUINT32>& positions) const
+    {
+        positions.clear();
+
+        if (!m_isValid || itemCount != m_itemCount || !CollectCandidates(target, positions))
+        {
+            return false;
+        }
+
+        for (XUINT32 position : positions)
+        {
+            if (m_items[position] != items[position])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        XRECTF_RB   m_bounds;
+        XUINT32     m_position;
+    };
+
+    bool CollectCandidates(_In_ const XRECTF_RB& target, _Inout_ std::vector<XUINT32>& positions) const;
+
+    XUINT32 GetColumn(XFLOAT x) const;
+    XUINT32 GetRow(XFLOAT y) const;
+
+    // Items too large to be worth putting in each of the cells they cover are tested against every target.
+    static constexpr XUINT32 c_maxCellsPerEntry = 16;
+
+    // Aim for this many items per cell, on average.
+    static constexpr XUINT32 c_itemsPerCell = 4;
+
+    static constexpr XUINT32 c_maxCellsPerSide = 256;
+
+    // The item at each position, to detect a list that changed since the grid was built.
+    std::vector<const void*>    m_items;
+
+    // Items with usable bounds, in the order they were added.
+    std::vector<Entry>          m_entries;
+
+    // Indexes into m_entries of the items in each cell, row by row. The items of cell i are
+    // m_cellEntries[m_cellStarts[i]] to m_cellEntries[m_cellStarts[i + 1] - 1].
+    std::vector<XUINT32>        m_cellStarts;
+    std::vector<XUINT32>        m_cellEntries;
+
+    // Indexes into m_entries of the items that cover too many cells.
+    std::vector<XUINT32>        m_largeEntries;
+
+    // Positions of the items that are returned by every query.
+    std::vector<XUINT32>        m_alwaysTested;
+
+    XRECTF_RB   m_extent        = {};
+    XFLOAT      m_columnScale   = 0.0f;
+    XFLOAT      m_rowScale      = 0.0f;
+    XUINT32     m_columnCount   = 0;
+    XUINT32     m_rowCount      = 0;
+    XUINT32     m_itemCount     = 0;
+    bool        m_isValid       = false;
+};
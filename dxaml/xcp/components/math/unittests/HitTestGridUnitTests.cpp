@@ -0,0 +1,284 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include "XamlLogging.h"
+#include "HitTestGridUnitTests.h"
+#include "HitTestGrid.h"
+
+#include <limits>
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace Foundation { namespace Math {
+
+namespace
+{
+    struct TestItem
+    {
+        XRECTF_RB bounds;
+    };
+
+    // Lays out the items in rows of columnCount, with cellSize spacing and itemSize squares.
+    std::vector<TestItem> MakeItems(XUINT32 count, XUINT32 columnCount, XFLOAT cellSize, XFLOAT itemSize)
+    {
+        std::vector<TestItem> items(count);
+
+        for (XUINT32 i = 0; i < count; ++i)
+        {
+            const XFLOAT left = (i % columnCount) * cellSize;
+            const XFLOAT top = (i / columnCount) * cellSize;
+            items[i].bounds = { left, top, left + itemSize, top + itemSize };
+        }
+
+        return items;
+    }
+
+    std::vector<TestItem*> GetPointers(std::vector<TestItem>& items)
+    {
+        std::vector<TestItem*> pointers;
+
+        for (TestItem& item : items)
+        {
+            pointers.push_back(&item);
+        }
+
+        return pointers;
+    }
+
+    void BuildGrid(HitTestGrid& grid, const std::vector<TestItem*>& pointers)
+    {
+        grid.BeginBuild(static_cast<XUINT32>(pointers.size()));
+
+        for (XUINT32 i = 0; i < pointers.size(); ++i)
+        {
+            grid.Add(i, pointers[i], pointers[i]->bounds);
+        }
+
+        grid.EndBuild();
+    }
+
+    XRECTF_RB PointBounds(XFLOAT x, XFLOAT y)
+    {
+        return { x, y, x, y };
+    }
+}
+
+void HitTestGridUnitTests::DoesReturnIntersectingItemsInDescendingOrder()
+{
+    std::vector<TestItem> items = MakeItems(400, 20, 10.0f, 10.0f);
+
+    // An item on top of the others in the middle, and one overlapping all of them.
+    items.push_back({ { 95.0f, 95.0f, 105.0f, 105.0f } });
+    items.push_back({ { 0.0f, 0.0f, 200.0f, 200.0f } });
+
+    std::vector<TestItem*> pointers = GetPointers(items);
+    const XUINT32 count = static_cast<XUINT32>(pointers.size());
+
+    HitTestGrid grid;
+    VERIFY_IS_FALSE(grid.IsValid());
+
+    BuildGrid(grid, pointers);
+    VERIFY_IS_TRUE(grid.IsValid());
+    VERIFY_ARE_EQUAL(grid.GetItemCount(), count);
+
+    std::vector<XUINT32> candidates;
+
+    // Inside item 21 (second row, second column) and under both overlapping items.
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+    VERIFY_ARE_EQUAL(candidates.size(), static_cast<size_t>(2));
+    VERIFY_ARE_EQUAL(candidates[0], count - 1);
+    VERIFY_ARE_EQUAL(candidates[1], 21u);
+
+    // On the corner shared by items 189, 190, 209 and 210, where touching counts as intersecting.
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(100.0f, 100.0f), pointers.data(), count, candidates));
+    const std::vector<XUINT32> expected = { count - 1, count - 2, 210, 209, 190, 189 };
+    VERIFY_IS_TRUE(candidates == expected);
+
+    // Outside all of the items.
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(500.0f, 15.0f), pointers.data(), count, candidates));
+    VERIFY_IS_TRUE(candidates.empty());
+
+    // A small rect returns every item it overlaps, each once.
+    VERIFY_IS_TRUE(grid.GetCandidates({ 12.0f, 12.0f, 28.0f, 18.0f }, pointers.data(), count, candidates));
+    const std::vector<XUINT32> expectedForRect = { count - 1, 22, 21 };
+    VERIFY_IS_TRUE(candidates == expectedForRect);
+
+    // A target covering most of the grid isn't worth looking up.
+    VERIFY_IS_FALSE(grid.GetCandidates({ 0.0f, 0.0f, 190.0f, 190.0f }, pointers.data(), count, candidates));
+
+    grid.Reset();
+    VERIFY_IS_FALSE(grid.IsValid());
+    VERIFY_IS_FALSE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+}
+
+void HitTestGridUnitTests::DoesReturnAlwaysTestedItems()
+{
+    std::vector<TestItem> items = MakeItems(200, 20, 10.0f, 10.0f);
+    std::vector<TestItem*> pointers = GetPointers(items);
+    const XUINT32 count = static_cast<XUINT32>(pointers.size());
+
+    const XFLOAT infinity = std::numeric_limits<XFLOAT>::infinity();
+
+    HitTestGrid grid;
+    grid.BeginBuild(count);
+
+    for (XUINT32 i = 0; i < count; ++i)
+    {
+        if (i == 5)
+        {
+            grid.AddAlwaysTested(i, pointers[i]);
+        }
+        else if (i == 150)
+        {
+            grid.Add(i, pointers[i], { 0.0f, 0.0f, infinity, 10.0f });
+        }
+        else if (i == 160)
+        {
+            // Inverted bounds.
+            grid.Add(i, pointers[i], { 1.0f, 1.0f, 0.0f, 0.0f });
+        }
+        else
+        {
+            grid.Add(i, pointers[i], pointers[i]->bounds);
+        }
+    }
+
+    grid.EndBuild();
+
+    std::vector<XUINT32> candidates;
+
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(-50.0f, -50.0f), pointers.data(), count, candidates));
+    const std::vector<XUINT32> expected = { 160, 150, 5 };
+    VERIFY_IS_TRUE(candidates == expected);
+
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+    const std::vector<XUINT32> expectedInside = { 160, 150, 21, 5 };
+    VERIFY_IS_TRUE(candidates == expectedInside);
+
+    // A NaN target can't be looked up.
+    const XFLOAT nan = std::numeric_limits<XFLOAT>::quiet_NaN();
+    VERIFY_IS_FALSE(grid.GetCandidates(PointBounds(nan, 15.0f), pointers.data(), count, candidates));
+}
+
+void HitTestGridUnitTests::DoesRejectChangedList()
+{
+    std::vector<TestItem> items = MakeItems(200, 20, 10.0f, 10.0f);
+    std::vector<TestItem*> pointers = GetPointers(items);
+    const XUINT32 count = static_cast<XUINT32>(pointers.size());
+
+    HitTestGrid grid;
+    BuildGrid(grid, pointers);
+
+    std::vector<XUINT32> candidates;
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+
+    // A different number of items.
+    VERIFY_IS_FALSE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count - 1, candidates));
+
+    // Reordered items, e.g. after a ZIndex change. Item 21 is now where item 20 was, and is still found through
+    // the position of item 20.
+    std::swap(pointers[20], pointers[21]);
+    VERIFY_IS_FALSE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+    VERIFY_IS_FALSE(grid.GetCandidates(PointBounds(5.0f, 15.0f), pointers.data(), count, candidates));
+
+    // Positions that aren't candidates aren't checked.
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(55.0f, 55.0f), pointers.data(), count, candidates));
+
+    BuildGrid(grid, pointers);
+    VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(15.0f, 15.0f), pointers.data(), count, candidates));
+    VERIFY_ARE_EQUAL(candidates.size(), static_cast<size_t>(1));
+    VERIFY_ARE_EQUAL(candidates[0], 20u);
+}
+
+void HitTestGridUnitTests::PointerMoveBenchmark()
+{
+    // A diagramming canvas: 20k shapes laid out 200 to a row, hit tested along a pointer path.
+    static const XUINT32 itemCount = 20000;
+    static const XUINT32 columnCount = 200;
+    static const int moves = 20000;
+    static const int builds = 20;
+
+    std::vector<TestItem> items = MakeItems(itemCount, columnCount, 30.0f, 24.0f);
+    std::vector<TestItem*> pointers = GetPointers(items);
+
+    const XFLOAT width = columnCount * 30.0f;
+    const XFLOAT height = (itemCount / columnCount) * 30.0f;
+
+    auto getPoint = [&](int move)
+    {
+        return XPOINTF { static_cast<XFLOAT>((move * 37) % static_cast<int>(width)), static_cast<XFLOAT>((move * 53) % static_cast<int>(height)) };
+    };
+
+    LARGE_INTEGER freq, start, end;
+    QueryPerformanceFrequency(&freq);
+
+    HitTestGrid grid;
+
+    QueryPerformanceCounter(&start);
+    for (int build = 0; build < builds; ++build)
+    {
+        BuildGrid(grid, pointers);
+    }
+    QueryPerformanceCounter(&end);
+    const LONGLONG buildTicks = end.QuadPart - start.QuadPart;
+
+    // Finds the topmost item under each point, as the hit testing walk would.
+    XUINT32 gridHits = 0;
+    std::vector<XUINT32> candidates;
+
+    QueryPerformanceCounter(&start);
+    for (int move = 0; move < moves; ++move)
+    {
+        const XPOINTF point = getPoint(move);
+        VERIFY_IS_TRUE(grid.GetCandidates(PointBounds(point.x, point.y), pointers.data(), itemCount, candidates));
+
+        for (XUINT32 position : candidates)
+        {
+            if (DoesRectContainPoint(pointers[position]->bounds, point))
+            {
+                ++gridHits;
+                break;
+            }
+        }
+    }
+    QueryPerformanceCounter(&end);
+    const LONGLONG gridTicks = end.QuadPart - start.QuadPart;
+
+    XUINT32 linearHits = 0;
+
+    QueryPerformanceCounter(&start);
+    for (int move = 0; move < moves; ++move)
+    {
+        const XPOINTF point = getPoint(move);
+
+        for (XUINT32 i = itemCount; i > 0; --i)
+        {
+            if (DoesRectContainPoint(pointers[i - 1]->bounds, point))
+            {
+                ++linearHits;
+                break;
+            }
+        }
+    }
+    QueryPerformanceCounter(&end);
+    const LONGLONG linearTicks = end.QuadPart - start.QuadPart;
+
+    VERIFY_ARE_EQUAL(gridHits, linearHits);
+
+    const double buildUs = (static_cast<double>(buildTicks) * 1.0e6 / freq.QuadPart) / builds;
+    const double gridNsPerMove = (static_cast<double>(gridTicks) * 1.0e9 / freq.QuadPart) / moves;
+    const double linearNsPerMove = (static_cast<double>(linearTicks) * 1.0e9 / freq.QuadPart) / moves;
+
+    WEX::Logging::Log::Comment(L"=== HitTestGrid benchmark: pointer moves over 20k items, grid vs linear scan ===");
+    WEX::Logging::Log::Comment(
+        WEX::Common::String().Format(L"Items: %u, moves: %d, hits: %u, QPC freq: %lld Hz",
+            itemCount, moves, gridHits, freq.QuadPart));
+    WEX::Logging::Log::Comment(
+        WEX::Common::String().Format(
+            L"build: %8.1f us | grid: %8.1f ns/move | linear: %10.1f ns/move | speedup: %.1fx",
+            buildUs,
+            gridNsPerMove,
+            linearNsPerMove,
+            linearNsPerMove / gridNsPerMove));
+}
+
+} } } } } }
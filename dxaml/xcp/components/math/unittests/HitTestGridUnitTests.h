@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <WexTestClass.h>
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace Foundation { namespace Math {
+
+class HitTestGridUnitTests : public WEX::TestClass<HitTestGridUnitTests>
+{
+public:
+    BEGIN_TEST_CLASS(HitTestGridUnitTests)
+        TEST_CLASS_PROPERTY(L"Classification", L"Integration")
+        TEST_CLASS_PROPERTY(L"TestPass:IncludeOnlyOn", L"Desktop")
+    END_TEST_CLASS()
+
+    TEST_METHOD(DoesReturnIntersectingItemsInDescendingOrder)
+    TEST_METHOD(DoesReturnAlwaysTestedItems)
+    TEST_METHOD(DoesRejectChangedList)
+    TEST_METHOD(PointerMoveBenchmark)
+};
+
+} } } } } }
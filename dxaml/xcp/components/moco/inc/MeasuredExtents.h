@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+//  Abstract:
+//      Per-index store of measured extents in the virtualizing direction, used by
+//      layout strategies to estimate offsets from real sizes instead of averages.
+
+#pragma once
+
+#include <vector>
+
+namespace DirectUI { namespace Components { namespace Moco {
+
+    // Keeps the measured extent of every element of a collection in a prefix-sum (Fenwick)
+    // tree, together with how many elements have been measured. Elements that were never
+    // measured are estimated with the average extent supplied by the caller, so both offset
+    // and index lookups take O(log n) regardless of how many elements have been realized.
+    // Inserting or removing an element shifts the measurements after it; the trees are then
+    // rebuilt in O(n) by the next lookup, so a burst of collection changes pays for one rebuild.
+    class MeasuredExtents
+    {
+    public:
+        MeasuredExtents() = default;
+
+        // Drops all measurements and resizes the store for the given element count.
+        void Reset(_In_ int count);
+
+        int GetCount() const { return m_count; }
+
+        // Inserts an unmeasured element at index, which can be count to append.
+        void Insert(_In_ int index);
+
+        // Removes the element at index, along with its measurement.
+        void Remove(_In_ int index);
+
+        // Records the measured extent of an element. Returns true if the element
+        // had not been measured before.
+        bool SetExtent(_In_ int index, _In_ float extent);
+
+        // Returns true and the measured extent if the element has been measured.
+        bool TryGetExtent(_In_ int index, _Out_ float* pExtent) const;
+
+        // Returns the offset of the element at index from the start of the first element.
+        // Index is clamped to [0, count], count being the offset past the last element.
+        double GetOffset(_In_ int index, _In_ float averageExtent) const;
+
+        // Returns the extent of the elements in [beginIndex, endIndex). If endIndex is
+        // before beginIndex, the result is the negated extent of [endIndex, beginIndex).
+        float GetExtent(_In_ int beginIndex, _In_ int endIndex, _In_ float averageExtent) const;
+
+        // Returns the index of the element containing the given offset, clamped to [0, count - 1].
+        int GetIndexFromOffset(_In_ double offset, _In_ float averageExtent) const;
+
+    private:
+        // Sum of the measured extents and number of measured elements in [0, index).
+        void GetPrefix(_In_ int index, _Out_ double* pMeasuredExtent, _Out_ int* pMeasuredCount) const;
+
+        void Update(_In_ int index, _In_ double extentDelta, _In_ int countDelta);
+
+        // Rebuilds the trees from m_extents after an insertion or removal.
+        void EnsureTrees() const;
+
+        static constexpr float c_unmeasured = -1.0f;
+
+        int m_count = 0;
+
+        // Measured extent of every element, c_unmeasured for elements never measured.
+        std::vector<float> m_extents;
+
+        // 1-based Fenwick trees, node i covers the (i & -i) elements ending at element i - 1.
+        // Built from m_extents on demand, hence mutable.
+        mutable std::vector<double> m_extentTree;
+        mutable std::vector<int> m_measuredCountTree;
+        mutable bool m_areTreesStale = false;
+    };
+
+} } }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "LayoutStrategyBase.h"
+#include "MeasuredExtents.h"
 
 namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespace Controls {
                     class StackingLayoutStrategyUnitTests;
@@ -166,15 +167,33 @@ namespace DirectUI { namespace Components { namespace Moco {
         float GetAverageHeaderSize() const;
         float GetAverageContainerSize() const;
 
+        // Keeps the measured extents in step with the collection. The index is the layout index
+        // of the item or group header, before the removal or after the insertion.
+        void OnElementInserted(_In_ xaml_controls::ElementType elementType, _In_ int index);
+        void OnElementRemoved(_In_ xaml_controls::ElementType elementType, _In_ int index);
+        void OnElementsReset();
+
+        // Estimation error counters, used for telemetry. Each element measured for the first
+        // time adds the difference between its measured extent and the extent we estimated for it.
+        int GetEstimatedElementCount() const { return m_estimatedElementCount; }
+        double GetTotalEstimationError() const { return m_totalEstimationError; }
+
     private:
         const float GetDistanceBetweenGroups() const;
 
-        float GetVirtualizedGroupExtent(_In_ float itemsInGroup, _In_ float headerExtent) const;
-        float GetAverageVirtualizedGroupExtent(_In_ float averageItemsPerGroup) const;
-        float GetAverageVirtualizedExtentOfItems(_In_ float itemCount) const;
+        float GetGroupExtentFromItemsExtent(_In_ float itemsExtent, _In_ float headerExtent) const;
 
         void RegisterSize(_In_ int index, _In_ bool isHeader, _In_ float size);
 
+        // Measured extents, used instead of the averages for elements that have been realized.
+        _Check_return_ HRESULT SyncMeasuredExtents();
+        void RegisterMeasuredExtent(_In_ int index, _In_ bool isHeader, _In_ float extent);
+        float GetContainerExtent(_In_ int itemIndex) const;
+        float GetHeaderExtent(_In_ int groupIndex) const;
+        float GetExtentOfItems(_In_ int beginItemIndex, _In_ int endItemIndex) const;
+        _Check_return_ HRESULT GetGroupExtent(_In_ int groupIndex, _In_ float headerExtent, _Out_ float* pExtent) const;
+        _Check_return_ HRESULT GetExtentOfGroups(_In_ int beginGroupIndex, _In_ int endGroupIndex, _Out_ float* pExtent) const;
+
         // Used by GetElementBounds for each element type.
         wf::Rect GetContainerBounds(
             _In_ int indexInItems,
@@ -255,6 +274,16 @@ namespace DirectUI { namespace Components { namespace Moco {
         int m_containerSizesStoredTotal;
         int m_headerSizesStoredTotal;
 
+        // measured extent of every item and group header, indexed by item and group index.
+        // Shifted as elements are inserted and removed, and dropped if the counts still disagree
+        // with the data at measure time, i.e. for changes we were not told about.
+        MeasuredExtents m_measuredContainerExtents;
+        MeasuredExtents m_measuredHeaderExtents;
+
+        // estimation error counters
+        int m_estimatedElementCount;
+        double m_totalEstimationError;
+
         float m_extentInNonVirtualizingDirection;
     };
 
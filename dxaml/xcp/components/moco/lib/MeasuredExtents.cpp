@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include "MeasuredExtents.h"
+
+// Work around disruptive max/min macros
+#undef max
+#undef min
+
+namespace DirectUI { namespace Components { namespace Moco {
+
+void MeasuredExtents::Reset(_In_ int count)
+{
+    m_count = std::max(0, count);
+    m_extents.assign(m_count, c_unmeasured);
+    m_extentTree.assign(m_count + 1, 0.0);
+    m_measuredCountTree.assign(m_count + 1, 0);
+    m_areTreesStale = false;
+}
+
+void MeasuredExtents::Insert(_In_ int index)
+{
+    ASSERT(0 <= index && index <= m_count);
+
+    m_extents.insert(m_extents.begin() + index, c_unmeasured);
+    ++m_count;
+    m_areTreesStale = true;
+}
+
+void MeasuredExtents::Remove(_In_ int index)
+{
+    ASSERT(0 <= index && index < m_count);
+
+    m_extents.erase(m_extents.begin() + index);
+    --m_count;
+    m_areTreesStale = true;
+}
+
+bool MeasuredExtents::SetExtent(_In_ int index, _In_ float extent)
+{
+    ASSERT(0 <= index && index < m_count);
+    ASSERT(extent >= 0.0f);
+
+    const float oldExtent = m_extents[index];
+    const bool wasMeasured = oldExtent != c_unmeasured;
+
+    if (!wasMeasured || oldExtent != extent)
+    {
+        m_extents[index] = extent;
+
+        // Stale trees pick the new extent up when they are rebuilt.
+        if (!m_areTreesStale)
+        {
+            Update(index, static_cast<double>(extent) - (wasMeasured ? oldExtent : 0.0f), wasMeasured ? 0 : 1);
+        }
+    }
+
+    return !wasMeasured;
+}
+
+bool MeasuredExtents::TryGetExtent(_In_ int index, _Out_ float* pExtent) const
+{
+    ASSERT(0 <= index && index < m_count);
+
+    const float extent = m_extents[index];
+    *pExtent = extent != c_unmeasured ? extent : 0.0f;
+    return extent != c_unmeasured;
+}
+
+double MeasuredExtents::GetOffset(_In_ int index, _In_ float averageExtent) const
+{
+    index = std::max(0, std::min(index, m_count));
+
+    double measuredExtent = 0.0;
+    int measuredCount = 0;
+    GetPrefix(index, &measuredExtent, &measuredCount);
+
+    return measuredExtent + static_cast<double>(index - measuredCount) * averageExtent;
+}
+
+float MeasuredExtents::GetExtent(_In_ int beginIndex, _In_ int endIndex, _In_ float averageExtent) const
+{
+    if (beginIndex == endIndex)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(GetOffset(endIndex, averageExtent) - GetOffset(beginIndex, averageExtent));
+}
+
+int MeasuredExtents::GetIndexFromOffset(_In_ double offset, _In_ float averageExtent) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    EnsureTrees();
+
+    int highestStep = 1;
+    while (highestStep * 2 <= m_count)
+    {
+        highestStep *= 2;
+    }
+
+    // Descend the tree looking for the last element whose start offset is at or before
+    // the given offset. Measured extents and the average are both non-negative, so the
+    // estimated start offsets never decrease with the index.
+    int position = 0;
+    double measuredExtent = 0.0;
+    int measuredCount = 0;
+
+    for (int step = highestStep; step > 0; step /= 2)
+    {
+        const int candidate = position + step;
+        if (candidate <= m_count)
+        {
+            const double candidateExtent = measuredExtent + m_extentTree[candidate];
+            const int candidateCount = measuredCount + m_measuredCountTree[candidate];
+            const double candidateOffset = candidateExtent + static_cast<double>(candidate - candidateCount) * averageExtent;
+
+            if (candidateOffset <= offset)
+            {
+                position = candidate;
+                measuredExtent = candidateExtent;
+                measuredCount = candidateCount;
+            }
+        }
+    }
+
+    return std::min(position, m_count - 1);
+}
+
+void MeasuredExtents::GetPrefix(_In_ int index, _Out_ double* pMeasuredExtent, _Out_ int* pMeasuredCount) const
+{
+    ASSERT(0 <= index && index <= m_count);
+
+    EnsureTrees();
+
+    double measuredExtent = 0.0;
+    int measuredCount = 0;
+
+    for (int node = index; node > 0; node -= node & -node)
+    {
+        measuredExtent += m_extentTree[node];
+        measuredCount += m_measuredCountTree[node];
+    }
+
+    *pMeasuredExtent = measuredExtent;
+    *pMeasuredCount = measuredCount;
+}
+
+void MeasuredExtents::Update(_In_ int index, _In_ double extentDelta, _In_ int countDelta)
+{
+    for (int node = index + 1; node <= m_count; node += node & -node)
+    {
+        m_extentTree[node] += extentDelta;
+        m_measuredCountTree[node] += countDelta;
+    }
+}
+
+void MeasuredExtents::EnsureTrees() const
+{
+    if (!m_areTreesStale)
+    {
+        return;
+    }
+
+    m_extentTree.assign(m_count + 1, 0.0);
+    m_measuredCountTree.assign(m_count + 1, 0);
+
+    // Each node is complete once the nodes below it have been added, which all have
+    // a smaller index, so a single pass pushing every node into its parent builds the trees.
+    for (int node = 1; node <= m_count; ++node)
+    {
+        const float extent = m_extents[node - 1];
+        if (extent != c_unmeasured)
+        {
+            m_extentTree[node] += extent;
+            m_measuredCountTree[node] += 1;
+        }
+
+        const int parent = node + (node & -node);
+        if (parent <= m_count)
+        {
+            m_extentTree[parent] += m_extentTree[node];
+            m_measuredCountTree[parent] += m_measuredCountTree[node];
+        }
+    }
+
+    m_areTreesStale = false;
+}
+
+} } }
@@ -23,6 +23,8 @@ StackingLayoutStrategyImpl::StackingLayoutStrategyImpl()
     , m_headerSizesTotal(0)
     , m_containerSizesStoredTotal(0)
     , m_headerSizesStoredTotal(0)
+    , m_estimatedElementCount(0)
+    , m_totalEstimationError(0)
     , m_extentInNonVirtualizingDirection(0.0f)
 {
 }
@@ -78,6 +80,8 @@ StackingLayoutStrategyImpl::GetElementBounds(
     _In_ wf::Rect windowConstraint, 
     _Out_ wf::Rect* pReturnValue)
 {
+    IFC_RETURN(SyncMeasuredExtents());
+
     if (elementType == xaml_controls::ElementType_ItemContainer)
     {
         int indexInGroup = elementIndex;
@@ -646,19 +650,19 @@ const float StackingLayoutStrategyImpl::GetDistanceBetweenGroups() const
 
 }
 
-float StackingLayoutStrategyImpl::GetVirtualizedGroupExtent(_In_ float itemsInGroup, _In_ float headerExtent) const
+float StackingLayoutStrategyImpl::GetGroupExtentFromItemsExtent(_In_ float itemsExtent, _In_ float headerExtent) const
 {
-    float result = GetAverageVirtualizedExtentOfItems(itemsInGroup);
+    float result = itemsExtent;
 
     switch (GetGroupHeaderStrategy())
     {
     case GroupHeaderStrategy::Parallel:
-        // Constrain it by the average header size
+        // Constrain it by the header size
         result = std::max(result, headerExtent);
         break;
 
     case GroupHeaderStrategy::Inline:
-        // Add the average header size
+        // Add the header size
         result += headerExtent;
         break;
 
@@ -670,25 +674,6 @@ float StackingLayoutStrategyImpl::GetVirtualizedGroupExtent(_In_ float itemsInGr
     return result + GetDistanceBetweenGroups();
 }
 
-// todo: validate that this needs the header size as well, seems like it from usage
-float StackingLayoutStrategyImpl::GetAverageVirtualizedGroupExtent(_In_ float averageItemsPerGroup) const
-{
-    const float averageHeaderSize = GetAverageHeaderSize();
-
-    return GetVirtualizedGroupExtent(averageItemsPerGroup, averageHeaderSize);
-}
-
-float StackingLayoutStrategyImpl::GetAverageVirtualizedExtentOfItems(_In_ float itemCount) const
-{
-    if (itemCount > 0)
-    {
-        float averageItemSize = GetAverageContainerSize();
-        return averageItemSize * itemCount;
-    }
-
-    return 0.0f;
-}
-
 void StackingLayoutStrategyImpl::RegisterSpecialContainerSize(_In_ int itemIndex, _In_ wf::Size containerDesiredSize)
 {
     ASSERT(itemIndex == c_specialItemIndex);
@@ -754,6 +739,171 @@ float StackingLayoutStrategyImpl::GetAverageContainerSize() const
     return  static_cast<float>(m_containerSizesStoredTotal > 0 ? m_containerSizesTotal / m_containerSizesStoredTotal : 10.0);
 }
 
+void StackingLayoutStrategyImpl::OnElementInserted(_In_ xaml_controls::ElementType elementType, _In_ int index)
+{
+    MeasuredExtents& measuredExtents = elementType == xaml_controls::ElementType_GroupHeader ? m_measuredHeaderExtents : m_measuredContainerExtents;
+
+    // An index we can't place leaves the counts out of step, and SyncMeasuredExtents starts over.
+    if (0 <= index && index <= measuredExtents.GetCount())
+    {
+        measuredExtents.Insert(index);
+    }
+}
+
+void StackingLayoutStrategyImpl::OnElementRemoved(_In_ xaml_controls::ElementType elementType, _In_ int index)
+{
+    MeasuredExtents& measuredExtents = elementType == xaml_controls::ElementType_GroupHeader ? m_measuredHeaderExtents : m_measuredContainerExtents;
+
+    if (0 <= index && index < measuredExtents.GetCount())
+    {
+        measuredExtents.Remove(index);
+    }
+}
+
+void StackingLayoutStrategyImpl::OnElementsReset()
+{
+    // the counts may not change on a reset, so drop the measurements here rather than in SyncMeasuredExtents
+    m_measuredContainerExtents.Reset(0);
+    m_measuredHeaderExtents.Reset(0);
+}
+
+// makes sure the measured extents cover the current items and groups.
+// Insertions and removals we are told about have already been applied, so the counts only
+// disagree after changes we could not follow, in which case we start over.
+_Check_return_ HRESULT StackingLayoutStrategyImpl::SyncMeasuredExtents()
+{
+    int totalItems;
+    int totalGroups = 0;
+    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
+    if (IsGrouping())
+    {
+        IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalGroupCount(&totalGroups));
+    }
+
+    if (totalItems != m_measuredContainerExtents.GetCount())
+    {
+        m_measuredContainerExtents.Reset(totalItems);
+    }
+    if (totalGroups != m_measuredHeaderExtents.GetCount())
+    {
+        m_measuredHeaderExtents.Reset(totalGroups);
+    }
+
+    return S_OK;
+}
+
+// records the measured extent of an element, and how far it is from what we would have estimated
+void StackingLayoutStrategyImpl::RegisterMeasuredExtent(_In_ int index, _In_ bool isHeader, _In_ float extent)
+{
+    MeasuredExtents& measuredExtents = isHeader ? m_measuredHeaderExtents : m_measuredContainerExtents;
+
+    if (0 <= index && index < measuredExtents.GetCount())
+    {
+        const float estimatedExtent = isHeader ? GetAverageHeaderSize() : GetAverageContainerSize();
+
+        if (measuredExtents.SetExtent(index, std::max(0.0f, extent)))
+        {
+            ++m_estimatedElementCount;
+            m_totalEstimationError += std::abs(extent - estimatedExtent);
+        }
+    }
+}
+
+float StackingLayoutStrategyImpl::GetContainerExtent(_In_ int itemIndex) const
+{
+    float extent;
+    if (0 <= itemIndex && itemIndex < m_measuredContainerExtents.GetCount() &&
+        m_measuredContainerExtents.TryGetExtent(itemIndex, &extent))
+    {
+        return extent;
+    }
+
+    return GetAverageContainerSize();
+}
+
+float StackingLayoutStrategyImpl::GetHeaderExtent(_In_ int groupIndex) const
+{
+    float extent;
+    if (0 <= groupIndex && groupIndex < m_measuredHeaderExtents.GetCount() &&
+        m_measuredHeaderExtents.TryGetExtent(groupIndex, &extent))
+    {
+        return extent;
+    }
+
+    return GetAverageHeaderSize();
+}
+
+// extent of the items in [beginItemIndex, endItemIndex), negative when going backward
+float StackingLayoutStrategyImpl::GetExtentOfItems(_In_ int beginItemIndex, _In_ int endItemIndex) const
+{
+    return m_measuredContainerExtents.GetExtent(beginItemIndex, endItemIndex, GetAverageContainerSize());
+}
+
+_Check_return_ HRESULT StackingLayoutStrategyImpl::GetGroupExtent(_In_ int groupIndex, _In_ float headerExtent, _Out_ float* pExtent) const
+{
+    int firstItemIndexInGroup;
+    int itemCountInGroup;
+    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
+        groupIndex,
+        &firstItemIndexInGroup,
+        &itemCountInGroup));
+
+    *pExtent = GetGroupExtentFromItemsExtent(
+        GetExtentOfItems(firstItemIndexInGroup, firstItemIndexInGroup + itemCountInGroup),
+        headerExtent);
+
+    return S_OK;
+}
+
+// extent of the groups in [beginGroupIndex, endGroupIndex), including the distance between them
+_Check_return_ HRESULT StackingLayoutStrategyImpl::GetExtentOfGroups(_In_ int beginGroupIndex, _In_ int endGroupIndex, _Out_ float* pExtent) const
+{
+    *pExtent = 0.0f;
+
+    if (beginGroupIndex >= endGroupIndex)
+    {
+        return S_OK;
+    }
+
+    int firstItemIndex;
+    int lastGroupStartItemIndex;
+    int lastGroupItemCount;
+    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
+        beginGroupIndex,
+        &firstItemIndex,
+        nullptr /* pItemCountInGroup */));
+    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
+        endGroupIndex - 1,
+        &lastGroupStartItemIndex,
+        &lastGroupItemCount));
+
+    const float itemsExtent = GetExtentOfItems(firstItemIndex, lastGroupStartItemIndex + lastGroupItemCount);
+    const float headersExtent = m_measuredHeaderExtents.GetExtent(beginGroupIndex, endGroupIndex, GetAverageHeaderSize());
+
+    switch (GetGroupHeaderStrategy())
+    {
+    case GroupHeaderStrategy::Parallel:
+        // Each group is as long as the longer of its header and its items, so the exact extent is the sum
+        // of the per-group maxima, which would cost a lookup per group. The max of the sums is an estimate
+        // that never exceeds it, and matches it when the items are longer than the header in every group
+        // (or the header in every group). Single groups are sized exactly, by GetGroupExtent.
+        *pExtent = std::max(itemsExtent, headersExtent);
+        break;
+
+    case GroupHeaderStrategy::Inline:
+        *pExtent = itemsExtent + headersExtent;
+        break;
+
+    default:
+        ASSERT(false);
+        break;
+    }
+
+    *pExtent += (endGroupIndex - beginGroupIndex) * GetDistanceBetweenGroups();
+
+    return S_OK;
+}
+
 //
 // Private methods
 //
@@ -772,6 +922,7 @@ StackingLayoutStrategyImpl::GetContainerBounds(
     ASSERT(!IsGrouping() || (IsGrouping() && m_headerSizeSet));
 
     // register the size of this item for better averaging
+    RegisterMeasuredExtent(indexInItems, false /* isHeader */, containerDesiredSize.*SizeInVirtualizingDirection());
     RegisterSize(indexInItems, FALSE /* isHeader */, containerDesiredSize.*SizeInVirtualizingDirection());
 
     if (referenceInformation.ReferenceIsHeader)
@@ -845,6 +996,7 @@ StackingLayoutStrategyImpl::GetHeaderBounds(
     ASSERT(IsGrouping() && m_headerSizeSet);
 
     // register the size of this item for better averaging
+    RegisterMeasuredExtent(groupIndex, true /* isHeader */, headerDesiredSize.*SizeInVirtualizingDirection());
     RegisterSize(groupIndex, TRUE /* isHeader */, headerDesiredSize.*SizeInVirtualizingDirection());
 
     if (referenceInformation.ReferenceIsHeader)
@@ -949,6 +1101,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
 {
     int totalItems;
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
+    IFC_RETURN(SyncMeasuredExtents());
 
     ASSERT(0 < totalItems);
 
@@ -981,7 +1134,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
         float headerExtent = headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection();
         if (headerExtent <= 0)
         {
-            headerExtent = GetAverageHeaderSize();
+            headerExtent = GetHeaderExtent(headerReference.ElementIndex);
         }
         // If we have inline headers, take the size into account before we start counting items
         if (GetGroupHeaderStrategy() == GroupHeaderStrategy::Inline)
@@ -1002,6 +1155,9 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
 
     const float averageContainerSize = GetAverageContainerSize();
 
+    // Walk the measured extents, falling back to the average for items we have not seen yet
+    const double referenceOffset = m_measuredContainerExtents.GetOffset(referenceIndex, averageContainerSize);
+
     int itemDelta = 0;
     switch (relativeReferencePosition)
     {
@@ -1015,7 +1171,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
             const float distance = nearWindowEdge - virtualizedReferencePoint;
             if (distance > 0)
             {
-                itemDelta = static_cast<int>(std::floor(distance / averageContainerSize));
+                itemDelta = m_measuredContainerExtents.GetIndexFromOffset(referenceOffset + distance, averageContainerSize) - referenceIndex;
             }
             else
             {
@@ -1031,7 +1187,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
             const float distance = nearWindowEdge - virtualizedReferencePoint;
             if (distance < 0 && !referenceIsHeader)
             {
-                itemDelta = static_cast<int>(std::floor(distance / averageContainerSize));
+                itemDelta = m_measuredContainerExtents.GetIndexFromOffset(referenceOffset + distance, averageContainerSize) - referenceIndex;
             }
             else
             {
@@ -1052,8 +1208,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
     targetItemIndex = referenceIndex + itemDelta;
     targetItemIndex = std::max(0, targetItemIndex);
     targetItemIndex = std::min(targetItemIndex, totalItems - 1);
-    itemDelta = targetItemIndex - referenceIndex;
-    calculatedPosition = virtualizedReferencePoint + (itemDelta * averageContainerSize);
+    calculatedPosition = virtualizedReferencePoint + GetExtentOfItems(referenceIndex, targetItemIndex);
 
     pTargetRect->*PointFromRectInVirtualizingDirection() = calculatedPosition;
     switch (GetGroupHeaderStrategy())
@@ -1068,7 +1223,7 @@ StackingLayoutStrategyImpl::EstimateItemIndexFromWindow(
         break;
     }
     pTargetRect->*PointFromRectInNonVirtualizingDirection() += GetGroupPaddingAtStart().*SizeInNonVirtualizingDirection();
-    pTargetRect->*SizeFromRectInVirtualizingDirection() = averageContainerSize;
+    pTargetRect->*SizeFromRectInVirtualizingDirection() = GetContainerExtent(targetItemIndex);
     pTargetRect->*SizeFromRectInNonVirtualizingDirection() = 0;
 
     return S_OK;
@@ -1088,10 +1243,10 @@ _Out_ int& targetGroupIndex)
     int totalGroups;
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalGroupCount(&totalGroups));
+    IFC_RETURN(SyncMeasuredExtents());
 
-    const float averageHeaderSize = GetAverageHeaderSize();
     const float referenceHeaderSize = (headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() > 0) ?
-        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : averageHeaderSize;
+        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : GetHeaderExtent(headerReference.ElementIndex);
     const float nearWindowEdge = window.*PointFromRectInVirtualizingDirection();
     const float farWindowEdge = nearWindowEdge + window.*SizeFromRectInVirtualizingDirection();
 
@@ -1109,14 +1264,11 @@ _Out_ int& targetGroupIndex)
         // To perform the backtrack in this case, we first calculate a "candidate position", accepting it only if we didn't overshoot
 
         bool found = false;
-        int itemsInGroup;
-        IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
-            targetGroupIndex,
-            nullptr /* pStartItemIndex */,
-            &itemsInGroup));
+        float groupExtent;
 
-        // Since we have this header's size and group count, let's just use it first before jumping off into averages
-        float candidatePosition = calculatedPosition + GetVirtualizedGroupExtent(static_cast<float>(itemsInGroup), referenceHeaderSize);
+        // Since we have this header's size, let's just use it first before jumping off into measured extents and averages
+        IFC_RETURN(GetGroupExtent(targetGroupIndex, referenceHeaderSize, &groupExtent));
+        float candidatePosition = calculatedPosition + groupExtent;
 
         // Bail out if we encounter the last group, as we can't go farther than that.
         while (!found && targetGroupIndex + 1 < totalGroups)
@@ -1126,16 +1278,13 @@ _Out_ int& targetGroupIndex)
                 // That group was big! We overshot the window, so let's not move to the next group and use the current one
                 found = true;
             }
-            else if (candidatePosition + averageHeaderSize < nearWindowEdge)
+            else if (candidatePosition + GetHeaderExtent(targetGroupIndex + 1) < nearWindowEdge)
             {
                 // We're going to move to the next group and continue
                 ++targetGroupIndex;
                 calculatedPosition = candidatePosition;
-                IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
-                    targetGroupIndex,
-                    nullptr /* pStartItemIndex */,
-                    &itemsInGroup));
-                candidatePosition = calculatedPosition + GetVirtualizedGroupExtent(static_cast<float>(itemsInGroup), averageHeaderSize);
+                IFC_RETURN(GetGroupExtent(targetGroupIndex, GetHeaderExtent(targetGroupIndex), &groupExtent));
+                candidatePosition = calculatedPosition + groupExtent;
             }
             else
             {
@@ -1156,13 +1305,10 @@ _Out_ int& targetGroupIndex)
         while (!found && targetGroupIndex > 0)
         {
             --targetGroupIndex;
-            int itemsInGroup;
-            IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
-                targetGroupIndex,
-                nullptr /* pStartItemIndex */,
-                &itemsInGroup));
+            float groupExtent;
+            IFC_RETURN(GetGroupExtent(targetGroupIndex, GetHeaderExtent(targetGroupIndex), &groupExtent));
 
-            calculatedPosition -= GetVirtualizedGroupExtent(static_cast<float>(itemsInGroup), averageHeaderSize);
+            calculatedPosition -= groupExtent;
 
             if (calculatedPosition <= farWindowEdge)
             {
@@ -1186,7 +1332,7 @@ _Out_ int& targetGroupIndex)
     }
     else
     {
-        targetRect.*SizeFromRectInVirtualizingDirection() = GetAverageHeaderSize();
+        targetRect.*SizeFromRectInVirtualizingDirection() = GetHeaderExtent(targetGroupIndex);
     }
     targetRect.*SizeFromRectInNonVirtualizingDirection() = m_headerSize.*SizeInNonVirtualizingDirection();
     *pTargetRect = targetRect;
@@ -1206,6 +1352,8 @@ StackingLayoutStrategyImpl::EstimateContainerLocation(
     int totalItems;
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
 
+    IFC_RETURN(SyncMeasuredExtents());
+
     ASSERT(0 < totalItems);
     ASSERT(0 <= targetItemIndex && targetItemIndex < totalItems);
 
@@ -1238,7 +1386,7 @@ StackingLayoutStrategyImpl::EstimateContainerLocation(
         float headerExtent = headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection();
         if (headerExtent <= 0)
         {
-            headerExtent = GetAverageHeaderSize();
+            headerExtent = GetHeaderExtent(headerReference.ElementIndex);
         }
         // If we have inline headers, take the size into account before we start counting items
         if (GetGroupHeaderStrategy() == GroupHeaderStrategy::Inline)
@@ -1255,10 +1403,8 @@ StackingLayoutStrategyImpl::EstimateContainerLocation(
         targetItemIndex = std::max(targetItemIndex, referenceIndex);
     }
     const float virtualizedReferencePoint = referenceRect.*PointFromRectInVirtualizingDirection() + headerAdjustment;
-    const float averageContainerSize = GetAverageContainerSize();
 
-    const int itemDelta = targetItemIndex - referenceIndex;
-    targetRect.*PointFromRectInVirtualizingDirection() = virtualizedReferencePoint + (itemDelta * averageContainerSize);
+    targetRect.*PointFromRectInVirtualizingDirection() = virtualizedReferencePoint + GetExtentOfItems(referenceIndex, targetItemIndex);
 
     switch (GetGroupHeaderStrategy())
     {
@@ -1272,7 +1418,7 @@ StackingLayoutStrategyImpl::EstimateContainerLocation(
         break;
     }
     targetRect.*PointFromRectInNonVirtualizingDirection() += GetGroupPaddingAtStart().*SizeInNonVirtualizingDirection();
-    targetRect.*SizeFromRectInVirtualizingDirection() = averageContainerSize;
+    targetRect.*SizeFromRectInVirtualizingDirection() = GetContainerExtent(targetItemIndex);
     targetRect.*SizeFromRectInNonVirtualizingDirection() = 0;
 
     return S_OK;
@@ -1287,19 +1433,17 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
     _In_ wf::Rect window,
     _Out_ wf::Rect& targetRect)
 {
-    int totalItems;
     int totalGroups;
-    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalGroupCount(&totalGroups));
+    IFC_RETURN(SyncMeasuredExtents());
 
     ASSERT(0 < totalGroups);
     ASSERT(0 <= targetGroupIndex && targetGroupIndex < static_cast<INT>(totalGroups));
 
     targetRect = {};
 
-    const float averageHeaderSize = GetAverageHeaderSize();
     const float referenceHeaderSize = (headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() > 0) ?
-        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : averageHeaderSize;
+        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : GetHeaderExtent(headerReference.ElementIndex);
 
     float calculatedPosition;
 
@@ -1316,19 +1460,16 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
 
         if (containerReference.ElementIndex != -1 && firstItemInGroup <= containerReference.ElementIndex && containerReference.ElementIndex < firstItemInGroup + itemCountInGroup)
         {
-            const float averageContainerSize = GetAverageContainerSize();
-
             float referenceItemSize = (containerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() > 0) ?
-                containerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : averageContainerSize;
+                containerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : GetContainerExtent(containerReference.ElementIndex);
 
             // We're using this item to estimate the placement of an adjacent header
-            const int itemIndexInGroup = containerReference.ElementIndex - firstItemInGroup;
             float itemReference = containerReference.ElementBounds.*PointFromRectInVirtualizingDirection();
 
             if (targetGroupIndex == headerReference.ElementIndex)
             {
                 // We're looking for the header immediately before our item
-                calculatedPosition = itemReference - itemIndexInGroup * averageContainerSize;
+                calculatedPosition = itemReference - GetExtentOfItems(firstItemInGroup, containerReference.ElementIndex);
 
                 if (GetGroupHeaderStrategy() == GroupHeaderStrategy::Inline)
                 {
@@ -1342,11 +1483,7 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
                 // Add the item we know about
                 calculatedPosition = itemReference + referenceItemSize;
                 // And now, add the rest
-                int remainingItems = itemCountInGroup - itemIndexInGroup - 1;
-                if (remainingItems > 0)
-                {
-                    calculatedPosition += remainingItems * averageContainerSize;
-                }
+                calculatedPosition += GetExtentOfItems(containerReference.ElementIndex + 1, firstItemInGroup + itemCountInGroup);
             }
         }
         else
@@ -1355,7 +1492,9 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
             calculatedPosition = headerReference.ElementBounds.*PointFromRectInVirtualizingDirection();
             if (targetGroupIndex == headerReference.ElementIndex + 1)
             {
-                calculatedPosition += GetVirtualizedGroupExtent(static_cast<float>(itemCountInGroup), referenceHeaderSize);
+                float groupExtent;
+                IFC_RETURN(GetGroupExtent(headerReference.ElementIndex, referenceHeaderSize, &groupExtent));
+                calculatedPosition += groupExtent;
             }
         }
     }
@@ -1368,41 +1507,19 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
         targetGroupIndex = std::max(0, targetGroupIndex);
         targetGroupIndex = std::min(targetGroupIndex, static_cast<INT>(totalGroups - 1));
 
-        // Determine which direction we're going, and calculate average group sizes accordingly
-        RelativePosition relativePos;
+        // Determine which direction we're going, and add up the groups in between
+        float groupsExtent;
         if (headerReference.ElementIndex < targetGroupIndex)
         {
             // Going forward, i.e., our reference is before the estimation region
-            relativePos = RelativePosition::Before;
-        }
-        else if (targetGroupIndex < headerReference.ElementIndex)
-        {
-            // Going backward, i.e., our reference is after the estimation region
-            relativePos = RelativePosition::After;
+            IFC_RETURN(GetExtentOfGroups(headerReference.ElementIndex, targetGroupIndex, &groupsExtent));
+            calculatedPosition = virtualizedReferencePoint + groupsExtent;
         }
         else
         {
-            relativePos = RelativePosition::Inside;
-        }
-
-        int firstItemIndexInGroup;
-        IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetGroupInformationFromGroupIndex(
-            headerReference.ElementIndex,
-            &firstItemIndexInGroup,
-            nullptr /* pItemCountInGroup */));
-
-        int remainingGroups = GetRemainingGroups(headerReference.ElementIndex, totalGroups, relativePos);
-        int remainingItems = GetRemainingItems(firstItemIndexInGroup, totalItems, relativePos);
-
-        if (remainingGroups > 0)
-        {
-            const float averageItemsPerRemainingGroup = (remainingItems) / static_cast<float>(remainingGroups);
-            const float averageExtentOfRemainingGroups = GetAverageVirtualizedGroupExtent(averageItemsPerRemainingGroup);
-            calculatedPosition = virtualizedReferencePoint + averageExtentOfRemainingGroups * (targetGroupIndex - headerReference.ElementIndex);
-        }
-        else
-        {
-            calculatedPosition = virtualizedReferencePoint;
+            // Going backward, i.e., our reference is after the estimation region
+            IFC_RETURN(GetExtentOfGroups(targetGroupIndex, headerReference.ElementIndex, &groupsExtent));
+            calculatedPosition = virtualizedReferencePoint - groupsExtent;
         }
     }
 
@@ -1415,7 +1532,7 @@ StackingLayoutStrategyImpl::EstimateHeaderLocation(
     }
     else
     {
-        targetRect.*SizeFromRectInVirtualizingDirection() = averageHeaderSize;
+        targetRect.*SizeFromRectInVirtualizingDirection() = GetHeaderExtent(targetGroupIndex);
     }
     targetRect.*SizeFromRectInNonVirtualizingDirection() = m_headerSize.*SizeInNonVirtualizingDirection();
 
@@ -1431,12 +1548,13 @@ StackingLayoutStrategyImpl::EstimateNonGroupedExtent(
     estimate = {};
     int totalItems;
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
+    IFC_RETURN(SyncMeasuredExtents());
 
-    // containers are variable size, so going off just the average is wrong
+    // containers are variable size, so use what we measured and the average for the rest
     float distance = 0;
     if (totalItems > containerReference.ElementIndex + 1)
     {
-        distance = GetAverageVirtualizedExtentOfItems(static_cast<float>(totalItems - (containerReference.ElementIndex + 1))); // don't include lastitem itself
+        distance = GetExtentOfItems(containerReference.ElementIndex + 1, totalItems); // don't include lastitem itself
     }
 
     estimate.*SizeInVirtualizingDirection() = distance +
@@ -1459,16 +1577,14 @@ StackingLayoutStrategyImpl::EstimateGroupedExtent(
 {
     ASSERT(IsGrouping() && m_headerSizeSet);
 
-    int totalItems;
     int totalGroups;
-    IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalItemCount(&totalItems));
     IFC_RETURN(GetLayoutDataInfoProviderNoRef()->GetTotalGroupCount(&totalGroups));
+    IFC_RETURN(SyncMeasuredExtents());
 
     extent = {};
 
-    const float averageHeaderSize = GetAverageHeaderSize();
     const float referenceHeaderExtent = (headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() > 0) ?
-        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : averageHeaderSize;
+        headerReference.ElementBounds.*SizeFromRectInVirtualizingDirection() : GetHeaderExtent(headerReference.ElementIndex);
 
     float referencePoint;
     int firstItemIndexInGroup;
@@ -1481,16 +1597,11 @@ StackingLayoutStrategyImpl::EstimateGroupedExtent(
     if (containerReference.ElementIndex != -1 && containerReference.ElementIndex >= firstItemIndexInGroup)
     {
         // This item will gives us an idea of the group extent that's better than going from the header
-        // So, we'll estimate from here to the end of the group, then pick back up with average group sizes
+        // So, we'll estimate from here to the end of the group, then pick back up with the remaining groups
         referencePoint = containerReference.ElementBounds.*PointFromRectInVirtualizingDirection() + containerReference.ElementBounds.*SizeFromRectInVirtualizingDirection();
 
         ASSERT(containerReference.ElementIndex < firstItemIndexInGroup + itemCountInGroup);
-        int itemInGroup = containerReference.ElementIndex - firstItemIndexInGroup;
-        int itemsLeftInThisGroup = itemCountInGroup - itemInGroup - 1;
-        ASSERT(itemsLeftInThisGroup >= 0);
-
-        const float averageContainerSize = GetAverageContainerSize();
-        referencePoint += averageContainerSize * itemsLeftInThisGroup;
+        referencePoint += GetExtentOfItems(containerReference.ElementIndex + 1, firstItemIndexInGroup + itemCountInGroup);
 
         // Make sure we don't have a header that's bigger than this
         float headerEnd = headerReference.ElementBounds.*PointFromRectInVirtualizingDirection() + referenceHeaderExtent;
@@ -1504,26 +1615,22 @@ StackingLayoutStrategyImpl::EstimateGroupedExtent(
     }
     else
     {
-        // Don't have an item in this group. Just estimate it based on item count and average item sizes
+        // Don't have an item in this group. Just estimate it based on measured and average item sizes
+        float groupExtent;
+        IFC_RETURN(GetGroupExtent(headerReference.ElementIndex, referenceHeaderExtent, &groupExtent));
         referencePoint = headerReference.ElementBounds.*PointFromRectInVirtualizingDirection();
-        referencePoint += GetVirtualizedGroupExtent(static_cast<float>(itemCountInGroup), referenceHeaderExtent);
+        referencePoint += groupExtent;
 
-        // GetVirtualizedGroupExtent adds in the group padding on both ends, but our header has already had the left/top padding applied
+        // GetGroupExtent adds in the group padding on both ends, but our header has already had the left/top padding applied
         // Subtract it out so it's not counted twice
         referencePoint -= GetGroupPaddingAtStart().*SizeInVirtualizingDirection();
     }
 
     // Now we have a point at the end of the reference group
-    // Let's estimate any remaining groups based on an average group size
-    const int remainingGroups = GetRemainingGroups(headerReference.ElementIndex + 1, totalGroups, RelativePosition::Before);
-    const int remainingItems = GetRemainingItems(firstItemIndexInGroup + itemCountInGroup, totalItems, RelativePosition::Before);
-
-    if (remainingGroups > 0)
-    {
-        const float averageItemsPerRemainingGroup = remainingItems / static_cast<float>(remainingGroups);
-        const float averageExtentOfRemainingGroups = GetAverageVirtualizedGroupExtent(averageItemsPerRemainingGroup);
-        referencePoint += remainingGroups * averageExtentOfRemainingGroups;
-    }
+    // Let's add up any remaining groups
+    float remainingGroupsExtent;
+    IFC_RETURN(GetExtentOfGroups(headerReference.ElementIndex + 1, totalGroups, &remainingGroupsExtent));
+    referencePoint += remainingGroupsExtent;
 
     extent.*SizeInVirtualizingDirection() = referencePoint;
     extent.*SizeInNonVirtualizingDirection() = m_extentInNonVirtualizingDirection;
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+
+#include <MeasuredExtents.h>
+
+#include "MeasuredExtentsUnitTests.h"
+
+using namespace DirectUI::Components::Moco;
+
+#undef max
+#undef min
+
+namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespace Controls {
+
+void MeasuredExtentsUnitTests::CanCalculateOffsetsFromAverage()
+{
+    MeasuredExtents extents;
+    extents.Reset(100);
+
+    VERIFY_ARE_EQUAL(100, extents.GetCount());
+    VERIFY_ARE_EQUAL(0.0, extents.GetOffset(0, 20.0f));
+    VERIFY_ARE_EQUAL(200.0, extents.GetOffset(10, 20.0f));
+    VERIFY_ARE_EQUAL(2000.0, extents.GetOffset(100, 20.0f));
+
+    // Offsets are clamped to the elements we have.
+    VERIFY_ARE_EQUAL(0.0, extents.GetOffset(-5, 20.0f));
+    VERIFY_ARE_EQUAL(2000.0, extents.GetOffset(150, 20.0f));
+
+    VERIFY_ARE_EQUAL(100.0f, extents.GetExtent(10, 15, 20.0f));
+    VERIFY_ARE_EQUAL(-100.0f, extents.GetExtent(15, 10, 20.0f));
+
+    float extent = 0.0f;
+    VERIFY_IS_FALSE(extents.TryGetExtent(10, &extent));
+}
+
+void MeasuredExtentsUnitTests::CanCalculateOffsetsFromMeasuredExtents()
+{
+    MeasuredExtents extents;
+    extents.Reset(100);
+
+    VERIFY_IS_TRUE(extents.SetExtent(2, 50.0f));
+    VERIFY_IS_TRUE(extents.SetExtent(5, 0.0f));
+    VERIFY_IS_TRUE(extents.SetExtent(7, 100.0f));
+
+    // Measuring again replaces the extent and is not a new measurement.
+    VERIFY_IS_FALSE(extents.SetExtent(7, 80.0f));
+
+    float extent = 0.0f;
+    VERIFY_IS_TRUE(extents.TryGetExtent(5, &extent));
+    VERIFY_ARE_EQUAL(0.0f, extent);
+    VERIFY_IS_TRUE(extents.TryGetExtent(7, &extent));
+    VERIFY_ARE_EQUAL(80.0f, extent);
+
+    // 0, 1: 20 each, 2: 50, 3, 4: 20 each, 5: 0, 6: 20, 7: 80.
+    VERIFY_ARE_EQUAL(40.0, extents.GetOffset(2, 20.0f));
+    VERIFY_ARE_EQUAL(90.0, extents.GetOffset(3, 20.0f));
+    VERIFY_ARE_EQUAL(130.0, extents.GetOffset(6, 20.0f));
+    VERIFY_ARE_EQUAL(230.0, extents.GetOffset(8, 20.0f));
+    VERIFY_ARE_EQUAL(230.0 + 92 * 20.0, extents.GetOffset(100, 20.0f));
+
+    // Changing the average only affects the elements that were not measured.
+    VERIFY_ARE_EQUAL(130.0f + 5 * 10.0f, extents.GetExtent(0, 8, 10.0f));
+}
+
+void MeasuredExtentsUnitTests::CanFindIndexFromOffset()
+{
+    const int count = 257;
+    const float averageExtent = 25.0f;
+
+    MeasuredExtents extents;
+    extents.Reset(count);
+
+    std::vector<float> expectedExtents(count, averageExtent);
+    for (int index = 0; index < count; index += 3)
+    {
+        const float measuredExtent = static_cast<float>((index * 7) % 60);
+        extents.SetExtent(index, measuredExtent);
+        expectedExtents[index] = measuredExtent;
+    }
+
+    double start = 0.0;
+    for (int index = 0; index < count; ++index)
+    {
+        const double end = start + expectedExtents[index];
+
+        VERIFY_ARE_EQUAL(start, extents.GetOffset(index, averageExtent));
+
+        if (end > start)
+        {
+            VERIFY_ARE_EQUAL(index, extents.GetIndexFromOffset(start, averageExtent));
+            VERIFY_ARE_EQUAL(index, extents.GetIndexFromOffset((start + end) / 2, averageExtent));
+        }
+
+        start = end;
+    }
+
+    // Offsets outside of the elements are clamped to the first and last element.
+    VERIFY_ARE_EQUAL(0, extents.GetIndexFromOffset(-100.0, averageExtent));
+    VERIFY_ARE_EQUAL(count - 1, extents.GetIndexFromOffset(start + 100.0, averageExtent));
+}
+
+void MeasuredExtentsUnitTests::ResetDropsMeasurements()
+{
+    MeasuredExtents extents;
+    extents.Reset(10);
+    extents.SetExtent(3, 100.0f);
+    VERIFY_ARE_EQUAL(190.0, extents.GetOffset(10, 10.0f));
+
+    extents.Reset(20);
+
+    float extent = 0.0f;
+    VERIFY_ARE_EQUAL(20, extents.GetCount());
+    VERIFY_IS_FALSE(extents.TryGetExtent(3, &extent));
+    VERIFY_ARE_EQUAL(200.0, extents.GetOffset(20, 10.0f));
+}
+
+void MeasuredExtentsUnitTests::InsertAndRemoveShiftMeasurements()
+{
+    const float averageExtent = 10.0f;
+
+    MeasuredExtents extents;
+    extents.Reset(10);
+    extents.SetExtent(2, 50.0f);
+    extents.SetExtent(5, 0.0f);
+    extents.SetExtent(9, 30.0f);
+
+    // Insert before the first measurement, between two, and at the end.
+    extents.Insert(0);
+    extents.Insert(5);
+    extents.Insert(12);
+
+    // Measure a new element before the trees are rebuilt.
+    VERIFY_IS_TRUE(extents.SetExtent(5, 70.0f));
+
+    std::vector<float> expectedExtents(13, averageExtent);
+    expectedExtents[3] = 50.0f;
+    expectedExtents[5] = 70.0f;
+    expectedExtents[7] = 0.0f;
+    expectedExtents[11] = 30.0f;
+
+    VERIFY_ARE_EQUAL(13, extents.GetCount());
+
+    float extent = 0.0f;
+    VERIFY_IS_FALSE(extents.TryGetExtent(0, &extent));
+    VERIFY_IS_FALSE(extents.TryGetExtent(2, &extent));
+    VERIFY_IS_TRUE(extents.TryGetExtent(3, &extent));
+    VERIFY_ARE_EQUAL(50.0f, extent);
+    VERIFY_IS_TRUE(extents.TryGetExtent(11, &extent));
+    VERIFY_ARE_EQUAL(30.0f, extent);
+
+    double start = 0.0;
+    for (int index = 0; index < extents.GetCount(); ++index)
+    {
+        VERIFY_ARE_EQUAL(start, extents.GetOffset(index, averageExtent));
+        start += expectedExtents[index];
+    }
+    VERIFY_ARE_EQUAL(start, extents.GetOffset(extents.GetCount(), averageExtent));
+    VERIFY_ARE_EQUAL(11, extents.GetIndexFromOffset(expectedExtents[11] / 2 + extents.GetOffset(11, averageExtent), averageExtent));
+
+    // Remove a measured element, an unmeasured one and the last one.
+    extents.Remove(3);
+    extents.Remove(0);
+    extents.Remove(10);
+
+    expectedExtents.erase(expectedExtents.begin() + 12);
+    expectedExtents.erase(expectedExtents.begin() + 3);
+    expectedExtents.erase(expectedExtents.begin());
+
+    VERIFY_ARE_EQUAL(10, extents.GetCount());
+    VERIFY_IS_TRUE(extents.TryGetExtent(3, &extent));
+    VERIFY_ARE_EQUAL(70.0f, extent);
+    VERIFY_IS_FALSE(extents.TryGetExtent(8, &extent));
+    VERIFY_IS_TRUE(extents.TryGetExtent(9, &extent));
+    VERIFY_ARE_EQUAL(30.0f, extent);
+
+    start = 0.0;
+    for (int index = 0; index < extents.GetCount(); ++index)
+    {
+        VERIFY_ARE_EQUAL(start, extents.GetOffset(index, averageExtent));
+        start += expectedExtents[index];
+    }
+    VERIFY_ARE_EQUAL(start, extents.GetOffset(extents.GetCount(), averageExtent));
+}
+
+} } } } }
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <WexTestClass.h>
+
+namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespace Controls {
+
+class MeasuredExtentsUnitTests : public WEX::TestClass<MeasuredExtentsUnitTests>
+{
+public:
+    BEGIN_TEST_CLASS(MeasuredExtentsUnitTests)
+        TEST_METHOD_PROPERTY(L"Classification", L"Integration")
+        TEST_METHOD_PROPERTY(L"TestPass:IncludeOnlyOn", L"Desktop")
+    END_TEST_CLASS()
+
+    BEGIN_TEST_METHOD(CanCalculateOffsetsFromAverage)
+        TEST_METHOD_PROPERTY(L"Description", L"Validates offsets and extents when nothing has been measured.")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(CanCalculateOffsetsFromMeasuredExtents)
+        TEST_METHOD_PROPERTY(L"Description", L"Validates offsets and extents mixing measured and unmeasured elements.")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(CanFindIndexFromOffset)
+        TEST_METHOD_PROPERTY(L"Description", L"Validates GetIndexFromOffset against a linear walk of the extents.")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(ResetDropsMeasurements)
+        TEST_METHOD_PROPERTY(L"Description", L"Validates that Reset forgets all measured extents.")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(InsertAndRemoveShiftMeasurements)
+        TEST_METHOD_PROPERTY(L"Description", L"Validates that measurements follow their elements across insertions and removals.")
+    END_TEST_METHOD()
+};
+
+} } } } }
@@ -123,6 +123,11 @@ namespace OSVersions
 
     // Update this when adding a new version
     static const TargetOSVersion& Latest() { return WIN10_19H1; }
+
+    // ResourceDictionary_v5 can only be read by runtimes that know about the perfect hash key table, so it is
+    // only emitted for targets at or above this version. No shipped target qualifies yet; lower this once the
+    // minimum supported runtime understands ResourceDictionary_v5.
+    static const TargetOSVersion ResourceDictionary_v5_Minimum = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
 };
 
 // Returns the version of XBF to use for the given target OS
@@ -138,8 +143,13 @@ static CustomWriterRuntimeDataTypeIndex GetDeferredElementSerializationVersion(c
 }
 
 // Returns the CustomWriterRuntimeDataTypeIndex to use when serializing ResourceDictionaryCustomWriterRuntimeData for the given target OS
-static CustomWriterRuntimeDataTypeIndex GetResourceDictionarySerializationVersion(const TargetOSVersion& /* osVersion */)
+static CustomWriterRuntimeDataTypeIndex GetResourceDictionarySerializationVersion(const TargetOSVersion& osVersion)
 {
+    if (osVersion >= OSVersions::ResourceDictionary_v5_Minimum)
+    {
+        return CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5;
+    }
+
     return CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4;
 }
 
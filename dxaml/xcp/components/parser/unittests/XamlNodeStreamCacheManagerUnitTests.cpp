@@ -9,6 +9,7 @@
 #include "MockResourceManager.h"
 #include "MockUri.h"
 #include "MockParserCoreServices.h"
+#include <XamlOptimizedNodeList.h>
 #include <XamlLogging.h>
 #include <CStaticLock.h>
 
@@ -221,5 +222,102 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
         VERIFY_ARE_EQUAL(spXamlNodeStreamCacheManager->m_UriToXbfResourceMap.size(), static_cast<size_t>(0));
     }
 
+    void XamlNodeStreamCacheManagerUnitTests::NodeListBudgetEvictsLeastRecentlyUsed()
+    {
+        ParserUtilities parserUtils;
+        DECLARE_CONST_STRING_IN_TEST_CODE(uri1, L"ms-appx:///Page1.xaml");
+        DECLARE_CONST_STRING_IN_TEST_CODE(uri2, L"ms-appx:///Page2.xaml");
+        DECLARE_CONST_STRING_IN_TEST_CODE(uri3, L"ms-appx:///Page3.xaml");
+
+        auto spSchemaContext = parserUtils.GetSchemaContext(nullptr);
+
+        std::shared_ptr<MockParserCoreServices> spParserCoreServices;
+        spParserCoreServices.reset(new MockParserCoreServices());
+
+        std::shared_ptr<XamlNodeStreamCacheManager> spXamlNodeStreamCacheManager;
+        VERIFY_SUCCEEDED(XamlNodeStreamCacheManager::Create(spParserCoreServices.get(), spXamlNodeStreamCacheManager));
+
+        // Eviction is opt-in: without a budget, every node list stays cached.
+        VERIFY_ARE_EQUAL(spXamlNodeStreamCacheManager->GetNodeListBudget(), static_cast<size_t>(0));
+
+        auto cacheNodeList = [&](const xstring_ptr& uri)
+        {
+            std::shared_ptr<XamlNodeStreamCacheManager::NodeStreamCacheEntry> spEntry;
+            VERIFY_SUCCEEDED(spXamlNodeStreamCacheManager->EnsureCacheEntry(uri, spEntry));
+            VERIFY_SUCCEEDED(spEntry->SetNodeList(CreateGridNodeList(spSchemaContext)));
+            spXamlNodeStreamCacheManager->OnNodeListCached(spEntry);
+        };
+
+        auto hasNodeList = [&](const xstring_ptr& uri)
+        {
+            bool hasCache = false;
+            VERIFY_SUCCEEDED(spXamlNodeStreamCacheManager->HasCacheForUri(uri, &hasCache));
+            return hasCache;
+        };
+
+        const size_t cbNodeList = CreateGridNodeList(spSchemaContext)->GetEstimatedSizeInBytes();
+
+        cacheNodeList(uri1);
+        cacheNodeList(uri2);
+        cacheNodeList(uri3);
+        VERIFY_IS_TRUE(hasNodeList(uri1));
+        VERIFY_IS_TRUE(hasNodeList(uri2));
+        VERIFY_IS_TRUE(hasNodeList(uri3));
+        VERIFY_ARE_EQUAL(spXamlNodeStreamCacheManager->GetStatistics().evictions, 0u);
+
+        spXamlNodeStreamCacheManager->Flush();
+
+        // Size the budget so that exactly two node lists fit.
+        spXamlNodeStreamCacheManager->SetNodeListBudget(cbNodeList * 2);
+
+        cacheNodeList(uri1);
+        cacheNodeList(uri2);
+        VERIFY_ARE_EQUAL(spXamlNodeStreamCacheManager->GetStatistics().cachedBytes, cbNodeList * 2);
+
+        // Reading page 1 makes page 2 the least recently used entry.
+        std::shared_ptr<XamlReader> spXamlReader;
+        std::shared_ptr<XamlBinaryFormatReader2> spVersion2Reader;
+        bool binaryXamlLoaded = false;
+        XamlTextReaderSettings textReaderSettings(false /* requireDefaultNamespace */, true /* shouldProcessUid */, false /*bForceUtf16*/);
+        VERIFY_SUCCEEDED(spXamlNodeStreamCacheManager->GetXamlReader(spSchemaContext, uri1, 0, nullptr, textReaderSettings, spXamlReader, spVersion2Reader, &binaryXamlLoaded));
+        VERIFY_IS_NOT_NULL(spXamlReader);
+
+        cacheNodeList(uri3);
+        VERIFY_IS_TRUE(hasNodeList(uri1));
+        VERIFY_IS_FALSE(hasNodeList(uri2));
+        VERIFY_IS_TRUE(hasNodeList(uri3));
+
+        auto statistics = spXamlNodeStreamCacheManager->GetStatistics();
+        VERIFY_ARE_EQUAL(statistics.hits, 1u);
+        VERIFY_ARE_EQUAL(statistics.evictions, 1u);
+        VERIFY_IS_TRUE(statistics.cachedBytes <= cbNodeList * 2);
+
+        // Flushing drops every node list along with its byte accounting.
+        spXamlNodeStreamCacheManager->Flush();
+        VERIFY_ARE_EQUAL(spXamlNodeStreamCacheManager->GetStatistics().cachedBytes, static_cast<size_t>(0));
+
+        spXamlNodeStreamCacheManager->ResetStatistics();
+        statistics = spXamlNodeStreamCacheManager->GetStatistics();
+        VERIFY_ARE_EQUAL(statistics.hits, 0u);
+        VERIFY_ARE_EQUAL(statistics.misses, 0u);
+        VERIFY_ARE_EQUAL(statistics.evictions, 0u);
+    }
+
+    std::shared_ptr<XamlOptimizedNodeList> XamlNodeStreamCacheManagerUnitTests::CreateGridNodeList(const std::shared_ptr<XamlSchemaContext>& spSchemaContext)
+    {
+        std::shared_ptr<XamlWriter> spNodeWriter;
+        std::shared_ptr<XamlType> spGridXamlType;
+        auto spNodeList = std::make_shared<XamlOptimizedNodeList>(spSchemaContext);
+
+        XamlTypeToken gridToken = XamlTypeToken::FromType(DirectUI::MetadataAPI::GetClassInfoByIndex(KnownTypeIndex::Grid));
+        VERIFY_SUCCEEDED(spSchemaContext->GetXamlType(gridToken, spGridXamlType));
+
+        VERIFY_SUCCEEDED(spNodeList->get_Writer(spNodeWriter));
+        VERIFY_SUCCEEDED(spNodeWriter->WriteObject(spGridXamlType, false));
+        VERIFY_SUCCEEDED(spNodeWriter->Close());
+
+        return spNodeList;
+    }
+
 } } } } }
 
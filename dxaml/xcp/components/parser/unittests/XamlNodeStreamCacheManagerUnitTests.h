@@ -10,6 +10,7 @@
 #include <WexTestClass.h>
 
 class XamlSchemaContext;
+class XamlOptimizedNodeList;
 struct IErrorService;
 class XamlNodeStreamCacheManager;
 class ParserErrorReporter;
@@ -39,8 +40,12 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
         BEGIN_TEST_METHOD(GetBinaryResourceForUnsupportedUri)
         END_TEST_METHOD()
 
+        BEGIN_TEST_METHOD(NodeListBudgetEvictsLeastRecentlyUsed)
+        END_TEST_METHOD()
+
     private:
         void GetBinaryResourceForSupportedUri(const xstring_ptr& uri, const xstring_ptr& physicalUri);
+        std::shared_ptr<XamlOptimizedNodeList> CreateGridNodeList(const std::shared_ptr<XamlSchemaContext>& spSchemaContext);
     };
 
 } } } } }
@@ -77,7 +77,9 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
         return xbfBufferClone;
     }
 
-    std::shared_ptr<XamlBinaryMetadataReader2> GetMetadataReader(_In_ xref_ptr<IPALMemory> xbfBuffer)
+    std::shared_ptr<XamlBinaryMetadataReader2> GetMetadataReader(
+        _In_ xref_ptr<IPALMemory> xbfBuffer,
+        _In_ ::Parser::XamlBufferType bufferType = ::Parser::XamlBufferType::Binary)
     {
         ParserUtilities parserUtils;
         uint32_t bufferOffset = 0;
@@ -114,7 +116,7 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
             schemaContext,
             spMetadataStream,
             spMetadataFileMemory,
-            ::Parser::XamlBufferType::Binary,
+            bufferType,
             fileVersion);
         return metadataReader;
     }
@@ -180,6 +182,47 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
 
     }
 
+    void Xbf2MetadataUnitTests::VerifyMemoryMappedTables()
+    {
+        auto xbfBuffer = GetXbfBuffer();
+        auto copiedMetadataReader = GetMetadataReader(xbfBuffer);
+        auto mappedMetadataReader = GetMetadataReader(xbfBuffer, ::Parser::XamlBufferType::MemoryMappedResource);
+        VERIFY_SUCCEEDED(copiedMetadataReader->LoadMetadata());
+        VERIFY_SUCCEEDED(mappedMetadataReader->LoadMetadata());
+
+        VERIFY_IS_FALSE(copiedMetadataReader->AreTablesMapped());
+        WEX::Logging::Log::Comment(WEX::Common::String().Format(L"Tables read in place: %d", mappedMetadataReader->AreTablesMapped()));
+
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetStringTableCount(), c_XbfStringTableCount);
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetAssemblyTableCount(), c_XbfAssemblyTableCount);
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetTypeNamespaceTableCount(), c_XbfTypeNamespaceTableCount);
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetTypeTableCount(), c_XbfTypeTableCount);
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetPropertyTableCount(), c_XbfPropertyTableCount);
+        VERIFY_ARE_EQUAL(mappedMetadataReader->GetXmlNamespaceTableCount(), c_XbfXmlNamespaceTableCount);
+
+        PersistedXamlNode2 entryIndex;
+
+        for (unsigned int index = 0; index < c_XbfStringTableCount; ++index)
+        {
+            xstring_ptr copiedString;
+            xstring_ptr mappedString;
+            entryIndex.m_uiObjectId = index;
+            VERIFY_SUCCEEDED(copiedMetadataReader->GetString(entryIndex, copiedString));
+            VERIFY_SUCCEEDED(mappedMetadataReader->GetString(entryIndex, mappedString));
+            VERIFY_ARE_EQUAL(copiedString.Compare(mappedString), 0);
+        }
+
+        for (unsigned int index = 0; index < c_XbfXmlNamespaceTableCount; ++index)
+        {
+            std::shared_ptr<XamlNamespace> copiedNamespace;
+            std::shared_ptr<XamlNamespace> mappedNamespace;
+            entryIndex.m_uiObjectId = index;
+            VERIFY_SUCCEEDED(copiedMetadataReader->GetXmlNamespace(entryIndex, copiedNamespace));
+            VERIFY_SUCCEEDED(mappedMetadataReader->GetXmlNamespace(entryIndex, mappedNamespace));
+            VERIFY_ARE_EQUAL(copiedNamespace->get_TargetNamespace().Compare(mappedNamespace->get_TargetNamespace()), 0);
+        }
+    }
+
     void VerifyTableOffsetFailures(xref_ptr<IPALMemory> xbfBuffer, const std::function<void()> &initialization, const std::function<void()> &cleanup)
     {
         // make table offset incorrect
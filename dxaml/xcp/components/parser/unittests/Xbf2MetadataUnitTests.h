@@ -46,6 +46,10 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
             TEST_METHOD_PROPERTY(L"Description", L"Validates XBF v2 Metadata Reader can load Xml Namespace Table entries.")
         END_TEST_METHOD()
 
+        BEGIN_TEST_METHOD(VerifyMemoryMappedTables)
+            TEST_METHOD_PROPERTY(L"Description", L"Validates XBF v2 Metadata Reader resolves the same entries when reading tables in place from a memory mapped buffer.")
+        END_TEST_METHOD()
+
         BEGIN_TEST_METHOD(VerifyTableLoadFailures)
             TEST_METHOD_PROPERTY(L"Description", L"Validates XBF v2 Metadata Reader fails on simple table load errors.")
         END_TEST_METHOD()
@@ -152,6 +152,7 @@ namespace Microsoft { namespace UI { namespace Xaml { namespace Tests { namespac
         VERIFY_ARE_EQUAL(GetResourceDictionarySerializationVersion(OSVersions::WIN10_RS5), CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4);
         VERIFY_ARE_EQUAL(GetResourceDictionarySerializationVersion(rs5plus1), CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4);
         VERIFY_ARE_EQUAL(GetResourceDictionarySerializationVersion(TargetOSVersion(99, 0, 0, 0)), CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v4);
+        VERIFY_ARE_EQUAL(GetResourceDictionarySerializationVersion(OSVersions::ResourceDictionary_v5_Minimum), CustomWriterRuntimeDataTypeIndex::ResourceDictionary_v5);
     }
 
     void XbfVersioningUnitTests::VerifyGetStyleSerializationVersion()
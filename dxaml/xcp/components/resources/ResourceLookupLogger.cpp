@@ -197,7 +197,9 @@ namespace Diagnostics
             "ResourceLookup_Stop",
             TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
             TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-            TraceLoggingValue(resourceKey.GetBuffer(), "ResourceKey"));
+            TraceLoggingValue(resourceKey.GetBuffer(), "ResourceKey"),
+            TraceLoggingValue(m_resolutionCacheStatistics.hits, "ResolutionCacheHits"),
+            TraceLoggingValue(m_resolutionCacheStatistics.misses, "ResolutionCacheMisses"));
 
         IFC_RETURN(StartNewLineWithIndentation());
         IFC_RETURN(m_messageBuilder->Append(StringCchPrintfWWrapper(
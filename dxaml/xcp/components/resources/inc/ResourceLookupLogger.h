@@ -41,6 +41,20 @@ namespace Diagnostics
         _Check_return_ HRESULT OnEnterImplicitStyle(CResourceDictionary* dictionary, const xstring_ptr_view& resourceKey, uint64_t etwEventIndex);
         _Check_return_ HRESULT OnLeaveImplicitStyle(CResourceDictionary* dictionary, const xstring_ptr_view& resourceKey, uint64_t etwEventIndex);
 
+        // Hit-rate counters for the ResourceResolutionCache. Unlike the trace, these are always kept, since the cache
+        // isn't consulted while a trace is being recorded.
+        struct ResolutionCacheStatistics
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+        };
+
+        void OnResolutionCacheHit() { ++m_resolutionCacheStatistics.hits; }
+        void OnResolutionCacheMiss() { ++m_resolutionCacheStatistics.misses; }
+
+        const ResolutionCacheStatistics& GetResolutionCacheStatistics() const { return m_resolutionCacheStatistics; }
+        void ResetResolutionCacheStatistics() { m_resolutionCacheStatistics = {}; }
+
     private:
         void IncrementIndentationLevel();
         void DecrementIndentationLevel();
@@ -54,6 +68,7 @@ namespace Diagnostics
         xstring_ptr m_traceMessage;
         std::uint32_t m_indentationLevel = 0;
         std::uint32_t m_etwIndentationLevel = 0;    // Etw logs more details with its own indentation
+        ResolutionCacheStatistics m_resolutionCacheStatistics;
 
 #ifdef TRACE_RESOURCELOOKUPS
         bool m_isLogging = true;
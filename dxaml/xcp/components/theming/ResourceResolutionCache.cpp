@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+
+#include <ResourceResolutionCache.h>
+#include <CDependencyObject.h>
+#include "Resources.h"
+
+void ResourceResolutionCache::EnsureCurrentGeneration()
+{
+    if (m_cacheGeneration != m_generation)
+    {
+        m_resourceCache.clear();
+        m_cacheGeneration = m_generation;
+    }
+}
+
+ResourceResolutionCache::LookupResult
+ResourceResolutionCache::TryGetCachedResult(
+    _In_ CResourceDictionary* dictionary,
+    _In_ const ResourceKey& resourceKey,
+    Theming::Theme theme,
+    _Outptr_result_maybenull_ CDependencyObject** resource,
+    _Out_opt_ xref_ptr<CResourceDictionary>* dictionaryReadFrom)
+{
+    *resource = nullptr;
+
+    EnsureCurrentGeneration();
+
+    auto iter = m_resourceCache.find(CacheKeyView{ dictionary, theme, resourceKey });
+
+    if (iter == m_resourceCache.end())
+    {
+        return LookupResult::NotCached;
+    }
+
+    const CacheValue& value = iter->second;
+
+    if (!value.found)
+    {
+        return LookupResult::NotFound;
+    }
+
+    CDependencyObject* cachedResource = value.resource.lock_noref();
+    CResourceDictionary* cachedDictionaryReadFrom = value.dictionaryReadFrom.lock_noref();
+
+    if (!cachedResource || (value.dictionaryReadFrom && !cachedDictionaryReadFrom))
+    {
+        m_resourceCache.erase(iter);
+        return LookupResult::NotCached;
+    }
+
+    *resource = cachedResource;
+
+    if (dictionaryReadFrom)
+    {
+        dictionaryReadFrom->reset(cachedDictionaryReadFrom);
+    }
+
+    return LookupResult::Found;
+}
+
+void
+ResourceResolutionCache::AddCachedResult(
+    _In_ CResourceDictionary* dictionary,
+    _In_ const ResourceKey& resourceKey,
+    Theming::Theme theme,
+    std::uint64_t generation,
+    _In_opt_ CDependencyObject* resource,
+    _In_opt_ CResourceDictionary* dictionaryReadFrom)
+{
+    if (generation != m_generation)
+    {
+        return;
+    }
+
+    if (std::find(m_undeferringKeys.begin(), m_undeferringKeys.end(), resourceKey) != m_undeferringKeys.end())
+    {
+        return;
+    }
+
+    EnsureCurrentGeneration();
+
+    if (m_resourceCache.size() >= c_maxEntries)
+    {
+        m_resourceCache.clear();
+    }
+
+    CacheValue value;
+    value.resource = xref::get_weakref(resource);
+    value.dictionaryReadFrom = xref::get_weakref(dictionaryReadFrom);
+    value.found = (resource != nullptr);
+
+    m_resourceCache.insert_or_assign(CacheKey{ dictionary, theme, resourceKey.ToStorage() }, std::move(value));
+}
+
+void ResourceResolutionCache::PushUndeferringKey(_In_ const ResourceKey& resourceKey)
+{
+    m_undeferringKeys.push_back(resourceKey);
+}
+
+void ResourceResolutionCache::PopUndeferringKey()
+{
+    ASSERT(!m_undeferringKeys.empty());
+    m_undeferringKeys.pop_back();
+}
@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include "Theme.h"
+#include "ResourceDictionaryKey.h"
+#include <weakref_ptr.h>
+#include <ankerl\unordered_dense.h>
+#include <vector>
+
+class CResourceDictionary;
+class CDependencyObject;
+
+// Caches the outcome of looking up a key in a dictionary and everything it contains - its MergedDictionaries and
+// its active theme dictionary. Resolving a {StaticResource} or {ThemeResource} does this for every dictionary on
+// the way up the tree, and with deeply nested MergedDictionaries most of those walks end without finding the key,
+// so both found and not-found results are cached.
+//
+// Entries are keyed by (dictionary, key, theme). Rather than tracking which entries a change affects, a change to
+// the contents or structure of a dictionary that some cached lookup went through bumps a generation counter, and
+// entries from an older generation are dropped the next time the cache is used. Dictionaries know whether a cached
+// lookup went through them because they are visited while IsRecordingLookup() is true.
+class ResourceResolutionCache
+{
+public:
+    enum class LookupResult : std::uint8_t
+    {
+        NotCached,
+        Found,
+        NotFound,
+    };
+
+    ResourceResolutionCache() = default;
+    ResourceResolutionCache(const ResourceResolutionCache&) = delete;
+    ResourceResolutionCache& operator=(const ResourceResolutionCache&) = delete;
+
+    ~ResourceResolutionCache() = default;
+
+    // This does not add-ref the returned value. A cached value that has since been released is reported as
+    // NotCached.
+    LookupResult TryGetCachedResult(
+        _In_ CResourceDictionary* dictionary,
+        _In_ const ResourceKey& resourceKey,
+        Theming::Theme theme,
+        _Outptr_result_maybenull_ CDependencyObject** resource,
+        _Out_opt_ xref_ptr<CResourceDictionary>* dictionaryReadFrom);
+
+    // Records the result of a lookup that started at the given generation. Nothing is recorded if the cache was
+    // invalidated in the meantime, since the result may already be stale. A null resource records a miss.
+    void AddCachedResult(
+        _In_ CResourceDictionary* dictionary,
+        _In_ const ResourceKey& resourceKey,
+        Theming::Theme theme,
+        std::uint64_t generation,
+        _In_opt_ CDependencyObject* resource,
+        _In_opt_ CResourceDictionary* dictionaryReadFrom);
+
+    void Invalidate()
+    {
+        ++m_generation;
+    }
+
+    std::uint64_t GetGeneration() const
+    {
+        return m_generation;
+    }
+
+    // Brackets a lookup whose result is going to be recorded. Lookups nest, since a dictionary looks up
+    // its MergedDictionaries and theme dictionaries the same way.
+    void BeginRecordedLookup()
+    {
+        ++m_recordedLookupDepth;
+    }
+
+    void EndRecordedLookup()
+    {
+        ASSERT(m_recordedLookupDepth > 0);
+        --m_recordedLookupDepth;
+    }
+
+    bool IsRecordingLookup() const
+    {
+        return m_recordedLookupDepth > 0;
+    }
+
+    // While a deferred resource is being loaded its key is hidden from reentrant lookups, to support e.g. a style
+    // BasedOn another style with the same key further up the tree. Lookups of that key see a transient state
+    // that isn't followed by an invalidation, so they are not cached.
+    void PushUndeferringKey(_In_ const ResourceKey& resourceKey);
+    void PopUndeferringKey();
+
+    std::size_t GetCount() const
+    {
+        return (m_cacheGeneration == m_generation) ? m_resourceCache.size() : 0;
+    }
+
+    // Once full, the cache starts over rather than tracking which entries are the least useful.
+    static constexpr std::size_t c_maxEntries = 4096;
+
+private:
+    struct CacheKey
+    {
+        CResourceDictionary* dictionary;
+        Theming::Theme theme;
+        ResourceKeyStorage resourceKey;
+    };
+
+    struct CacheKeyView
+    {
+        CResourceDictionary* dictionary;
+        Theming::Theme theme;
+        const ResourceKey& resourceKey;
+    };
+
+    struct CacheKey_transparent_hash
+    {
+        using is_transparent = void;
+        using is_avalanching = void;
+
+        template <typename T>
+        std::uint64_t operator()(const T& key) const
+        {
+            return ankerl::unordered_dense::hash<std::uint64_t>()(
+                key.resourceKey.hash() ^
+                reinterpret_cast<std::uintptr_t>(key.dictionary) ^
+                (static_cast<std::uint64_t>(key.theme) << 56));
+        }
+    };
+
+    struct CacheKey_transparent_equal
+    {
+        using is_transparent = void;
+
+        template <typename T, typename U>
+        bool operator()(const T& lhs, const U& rhs) const
+        {
+            return lhs.dictionary == rhs.dictionary &&
+                   lhs.theme == rhs.theme &&
+                   lhs.resourceKey == rhs.resourceKey;
+        }
+    };
+
+    struct CacheValue
+    {
+        // Dictionaries don't outlive their entries unnoticed - one being destroyed invalidates the cache - but the
+        // resource and the dictionary it was read from can be released without any dictionary changing.
+        xref::weakref_ptr<CDependencyObject> resource;
+        xref::weakref_ptr<CResourceDictionary> dictionaryReadFrom;
+        bool found;
+    };
+
+    void EnsureCurrentGeneration();
+
+    ankerl::unordered_dense::map<CacheKey, CacheValue, CacheKey_transparent_hash, CacheKey_transparent_equal> m_resourceCache;
+
+    // Keys are not copied, since they are popped before the lookup that pushed them returns.
+    std::vector<ResourceKey> m_undeferringKeys;
+
+    std::uint64_t m_generation = 0;
+    std::uint64_t m_cacheGeneration = 0;
+    std::uint32_t m_recordedLookupDepth = 0;
+};
@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include "ResourceResolutionCacheUnitTests.h"
+
+#include <XamlLogging.h>
+
+#include <ResourceResolutionCache.h>
+#include <CDependencyObject.h>
+#include <ResourceDictionaryKey.h>
+#include "Theme.h"
+
+using namespace WEX::Common;
+using namespace Theming;
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace Controls { namespace Theming {
+
+    using LookupResult = ResourceResolutionCache::LookupResult;
+
+    void ResourceResolutionCacheUnitTests::DoesCacheFoundAndNotFoundResults()
+    {
+        ResourceResolutionCache cache;
+
+        xref_ptr<CDependencyObject> resource;
+        resource.attach(new CDependencyObject());
+
+        auto targetDictionary = reinterpret_cast<CResourceDictionary*>(1234);
+        DECLARE_CONST_XSTRING_PTR_STORAGE(foundKey, L"FoundKey");
+        DECLARE_CONST_XSTRING_PTR_STORAGE(missingKey, L"MissingKey");
+        xstring_ptr foundKeyStr(foundKey);
+        xstring_ptr missingKeyStr(missingKey);
+
+        CDependencyObject* cachedResource = nullptr;
+
+        // Nothing has been looked up yet.
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(foundKeyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::NotCached);
+        VERIFY_IS_NULL(cachedResource);
+
+        cache.AddCachedResult(targetDictionary, ResourceKey(foundKeyStr, false), Theme::Light, cache.GetGeneration(), resource.get(), nullptr);
+        cache.AddCachedResult(targetDictionary, ResourceKey(missingKeyStr, false), Theme::Light, cache.GetGeneration(), nullptr, nullptr);
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(foundKeyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::Found);
+        VERIFY_ARE_EQUAL(cachedResource, resource.get());
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(missingKeyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::NotFound);
+        VERIFY_IS_NULL(cachedResource);
+
+        // Implicit and explicit keys with the same name are different keys.
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(foundKeyStr, true), Theme::Light, &cachedResource, nullptr) == LookupResult::NotCached);
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesCacheResultPerDictionaryAndTheme()
+    {
+        ResourceResolutionCache cache;
+
+        xref_ptr<CDependencyObject> resource1;
+        resource1.attach(new CDependencyObject());
+
+        xref_ptr<CDependencyObject> resource2;
+        resource2.attach(new CDependencyObject());
+
+        auto targetDictionary1 = reinterpret_cast<CResourceDictionary*>(1234);
+        auto targetDictionary2 = reinterpret_cast<CResourceDictionary*>(5678);
+
+        DECLARE_CONST_XSTRING_PTR_STORAGE(key, L"ResourceKey");
+        xstring_ptr keyStr(key);
+
+        cache.AddCachedResult(targetDictionary1, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), resource1.get(), nullptr);
+        cache.AddCachedResult(targetDictionary2, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), resource2.get(), nullptr);
+        cache.AddCachedResult(targetDictionary1, ResourceKey(keyStr, false), Theme::Dark, cache.GetGeneration(), nullptr, nullptr);
+
+        CDependencyObject* cachedResource = nullptr;
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary1, ResourceKey(keyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::Found);
+        VERIFY_ARE_EQUAL(cachedResource, resource1.get());
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary2, ResourceKey(keyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::Found);
+        VERIFY_ARE_EQUAL(cachedResource, resource2.get());
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary1, ResourceKey(keyStr, false), Theme::Dark, &cachedResource, nullptr) == LookupResult::NotFound);
+
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary1, ResourceKey(keyStr, false), Theme::Light | Theme::HighContrastBlack, &cachedResource, nullptr) == LookupResult::NotCached);
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesClearCacheOnInvalidate()
+    {
+        ResourceResolutionCache cache;
+
+        auto targetDictionary = reinterpret_cast<CResourceDictionary*>(1234);
+        DECLARE_CONST_XSTRING_PTR_STORAGE(key, L"ResourceKey");
+        xstring_ptr keyStr(key);
+
+        cache.AddCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), nullptr, nullptr);
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(1));
+
+        cache.Invalidate();
+
+        // Invalidating doesn't touch the entries, but none of them can be returned any more.
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(0));
+
+        CDependencyObject* cachedResource = nullptr;
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::NotCached);
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesNotCacheResultFromOlderGeneration()
+    {
+        ResourceResolutionCache cache;
+
+        auto targetDictionary = reinterpret_cast<CResourceDictionary*>(1234);
+        DECLARE_CONST_XSTRING_PTR_STORAGE(key, L"ResourceKey");
+        xstring_ptr keyStr(key);
+
+        // A dictionary changed while the lookup was in progress, so its result may be stale.
+        auto generation = cache.GetGeneration();
+        cache.Invalidate();
+        cache.AddCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, generation, nullptr, nullptr);
+
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(0));
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesNotCacheUndeferringKey()
+    {
+        ResourceResolutionCache cache;
+
+        auto targetDictionary = reinterpret_cast<CResourceDictionary*>(1234);
+        DECLARE_CONST_XSTRING_PTR_STORAGE(key, L"ResourceKey");
+        xstring_ptr keyStr(key);
+
+        cache.PushUndeferringKey(ResourceKey(keyStr, false));
+        cache.AddCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), nullptr, nullptr);
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(0));
+
+        cache.PopUndeferringKey();
+        cache.AddCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), nullptr, nullptr);
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(1));
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesNotReturnReleasedResource()
+    {
+        ResourceResolutionCache cache;
+
+        auto targetDictionary = reinterpret_cast<CResourceDictionary*>(1234);
+        DECLARE_CONST_XSTRING_PTR_STORAGE(key, L"ResourceKey");
+        xstring_ptr keyStr(key);
+
+        {
+            xref_ptr<CDependencyObject> resource;
+            resource.attach(new CDependencyObject());
+
+            cache.AddCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, cache.GetGeneration(), resource.get(), nullptr);
+        }
+
+        CDependencyObject* cachedResource = nullptr;
+        VERIFY_IS_TRUE(cache.TryGetCachedResult(targetDictionary, ResourceKey(keyStr, false), Theme::Light, &cachedResource, nullptr) == LookupResult::NotCached);
+        VERIFY_IS_NULL(cachedResource);
+        VERIFY_ARE_EQUAL(cache.GetCount(), static_cast<size_t>(0));
+    }
+
+    void ResourceResolutionCacheUnitTests::DoesTrackNestedRecordedLookups()
+    {
+        ResourceResolutionCache cache;
+
+        VERIFY_IS_FALSE(cache.IsRecordingLookup());
+
+        // A dictionary's lookup nests the lookups of its merged and theme dictionaries.
+        cache.BeginRecordedLookup();
+        cache.BeginRecordedLookup();
+        VERIFY_IS_TRUE(cache.IsRecordingLookup());
+
+        cache.EndRecordedLookup();
+        VERIFY_IS_TRUE(cache.IsRecordingLookup());
+
+        cache.EndRecordedLookup();
+        VERIFY_IS_FALSE(cache.IsRecordingLookup());
+    }
+
+} } } } } } // namespace ::Windows::UI::Xaml::Tests::Controls::Theming
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <WexTestClass.h>
+
+namespace Windows { namespace UI { namespace Xaml { namespace Tests { namespace Controls { namespace Theming {
+
+    class ResourceResolutionCacheUnitTests : public WEX::TestClass<ResourceResolutionCacheUnitTests>
+    {
+    public:
+        BEGIN_TEST_CLASS(ResourceResolutionCacheUnitTests)
+            TEST_CLASS_PROPERTY(L"Classification", L"Integration")
+            TEST_CLASS_PROPERTY(L"TestPass:IncludeOnlyOn", L"Desktop")
+        END_TEST_CLASS()
+
+        TEST_METHOD(DoesCacheFoundAndNotFoundResults)
+
+        TEST_METHOD(DoesCacheResultPerDictionaryAndTheme)
+
+        TEST_METHOD(DoesClearCacheOnInvalidate)
+
+        TEST_METHOD(DoesNotCacheResultFromOlderGeneration)
+
+        TEST_METHOD(DoesNotCacheUndeferringKey)
+
+        TEST_METHOD(DoesNotReturnReleasedResource)
+
+        TEST_METHOD(DoesTrackNestedRecordedLookups)
+
+    }; // class ResourceResolutionCacheUnitTests
+
+} } } } } } // namespace ::Windows::UI::Xaml::Tests::Controls::Theming
@@ -112,3 +112,4 @@ _Check_return_ HRESULT CResourceDictionary::GetLocalOverrideNoRef(
 }
 
 void CResourceDictionary::InvalidateNotFoundCache(bool) {}
+void CResourceDictionary::InvalidateResolutionCache() {}
@@ -24,6 +24,8 @@ XamlNodeStreamCacheManager::NodeStreamCacheEntry::SetNodeList(
 {
     IFCEXPECT_ASSERT_RETURN(!m_spNodeList);
     m_spNodeList = spXamlOptimizedNodeList;
+    m_cbNodeList = m_spNodeList->GetEstimatedSizeInBytes();
+    m_fCompacted = false;
     return S_OK;
 }
 
@@ -45,6 +47,33 @@ XamlNodeStreamCacheManager::NodeStreamCacheEntry::HasNodeList() const
     return !!m_spNodeList;
 }
 
+size_t
+XamlNodeStreamCacheManager::NodeStreamCacheEntry::ReleaseNodeList()
+{
+    // Readers handed out earlier hold their own reference to the node list,
+    // so releasing it here doesn't affect parses that are in progress.
+    const size_t cbReleased = m_cbNodeList;
+    m_spNodeList.reset();
+    m_cbNodeList = 0;
+    m_fCompacted = false;
+    return cbReleased;
+}
+
+size_t
+XamlNodeStreamCacheManager::NodeStreamCacheEntry::CompactNodeList()
+{
+    if (!m_spNodeList || m_fCompacted)
+    {
+        return 0;
+    }
+
+    const size_t cbBefore = m_cbNodeList;
+    m_spNodeList->ShrinkToFit();
+    m_cbNodeList = m_spNodeList->GetEstimatedSizeInBytes();
+    m_fCompacted = true;
+    return (cbBefore > m_cbNodeList) ? cbBefore - m_cbNodeList : 0;
+}
+
 UINT32
 XamlNodeStreamCacheManager::NodeStreamCacheEntry::GetAccessCount() const
 {
@@ -79,6 +108,7 @@ XamlNodeStreamCacheManager::Create(
 void XamlNodeStreamCacheManager::Flush()
 {
     m_UriToNodelistMap.clear();
+    m_cbCachedNodeLists = 0;
 
     m_UriToXbfResourceMap.clear();
 }
@@ -102,6 +132,72 @@ XamlNodeStreamCacheManager::ResetCachedXbfV2Readers()
     return S_OK;
 }
 
+void XamlNodeStreamCacheManager::SetNodeListBudget(size_t cbBudget)
+{
+    m_cbNodeListBudget = cbBudget;
+    EnforceNodeListBudget(nullptr);
+}
+
+XamlNodeStreamCacheManager::Statistics
+XamlNodeStreamCacheManager::GetStatistics() const
+{
+    Statistics statistics = m_statistics;
+    statistics.cachedBytes = m_cbCachedNodeLists;
+    return statistics;
+}
+
+void XamlNodeStreamCacheManager::ResetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+void XamlNodeStreamCacheManager::OnNodeListCached(
+    _In_ const std::shared_ptr<NodeStreamCacheEntry>& spNodeStreamCacheEntry)
+{
+    spNodeStreamCacheEntry->SetLastAccess(++m_accessSequence);
+    m_cbCachedNodeLists += spNodeStreamCacheEntry->GetNodeListSizeInBytes();
+    EnforceNodeListBudget(spNodeStreamCacheEntry.get());
+}
+
+// Evicts in least recently used order. The map typically holds a few dozen
+// pages at most, so a linear scan for the oldest entry is cheaper than
+// maintaining a separate recency list alongside the case-insensitive map.
+void XamlNodeStreamCacheManager::EnforceNodeListBudget(
+    _In_opt_ const NodeStreamCacheEntry* pExcludedEntry)
+{
+    if (m_cbNodeListBudget == 0)
+    {
+        return;
+    }
+
+    while (m_cbCachedNodeLists > m_cbNodeListBudget)
+    {
+        NodeStreamCacheEntry* pOldestEntry = nullptr;
+
+        for (const auto& kvp : m_UriToNodelistMap)
+        {
+            NodeStreamCacheEntry* pEntry = kvp.second.get();
+            if (pEntry != pExcludedEntry &&
+                pEntry->HasNodeList() &&
+                (!pOldestEntry || pEntry->GetLastAccess() < pOldestEntry->GetLastAccess()))
+            {
+                pOldestEntry = pEntry;
+            }
+        }
+
+        if (!pOldestEntry)
+        {
+            // Only the excluded entry is left; a single page larger than the
+            // budget is still cached so that it isn't re-parsed on every load.
+            break;
+        }
+
+        const size_t cbReleased = pOldestEntry->ReleaseNodeList();
+        m_cbCachedNodeLists -= std::min(cbReleased, m_cbCachedNodeLists);
+        m_statistics.evictions++;
+    }
+}
+
 // Checks whether we currently have a cached nodelist for the Uri.
 // This is a different question from whether we have a NodeStreamCacheEntry.
 // It is possible that we have a NodeStreamCacheEntry for tracking purposes,
@@ -266,6 +362,7 @@ XamlNodeStreamCacheManager::GetXamlBinaryReader(
             if (spNodeStreamCacheEntry)
             {
                 IFC_RETURN(spNodeStreamCacheEntry->SetNodeList(spNodeList));
+                OnNodeListCached(spNodeStreamCacheEntry);
             }
         }
     }
@@ -314,6 +411,7 @@ XamlNodeStreamCacheManager::GetXamlTextReader(
         IFC_RETURN(spNodeListWriter->Close());
         IFC_RETURN(spNodeList->get_Reader(spXamlReader));
         IFC_RETURN(spNodeStreamCacheEntry->SetNodeList(spNodeList));
+        OnNodeListCached(spNodeStreamCacheEntry);
     }
 
     return S_OK;
@@ -376,9 +474,23 @@ XamlNodeStreamCacheManager::GetXamlReader(
         if (spNodeStreamCacheEntry->HasNodeList())
         {
             IFC_RETURN(spNodeStreamCacheEntry->GetXamlReader(spXamlReader));
+            spNodeStreamCacheEntry->SetLastAccess(++m_accessSequence);
+            m_statistics.hits++;
+
+            // Pages that keep getting reloaded are going to stay in the cache, so
+            // trim the slack their node lists accumulated while being written.
+            if (!spNodeStreamCacheEntry->IsCompacted() &&
+                spNodeStreamCacheEntry->GetAccessCount() >= c_compactionAccessCount)
+            {
+                const size_t cbSaved = spNodeStreamCacheEntry->CompactNodeList();
+                m_cbCachedNodeLists -= std::min(cbSaved, m_cbCachedNodeLists);
+                m_statistics.compactions++;
+            }
         }
         else
         {
+            m_statistics.misses++;
+
             // try the xbf
             IFC_RETURN(GetXamlBinaryReader(spXamlSchemaContext, strUniqueName, spNodeStreamCacheEntry, spXamlReader, spVersion2Reader));
             if (spXamlReader || spVersion2Reader)
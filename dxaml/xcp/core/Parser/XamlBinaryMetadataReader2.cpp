@@ -28,6 +28,45 @@ XamlBinaryMetadataReader2::LoadMetadata()
     return S_OK;
 }
 
+template <typename TPersisted, typename TResolved>
+_Check_return_ HRESULT
+XamlBinaryMetadataReader2::LoadTableRecords(_Inout_ MetadataTable<TPersisted, TResolved>& table)
+{
+    // Persisted records are serialized as raw copies of their structs, so a memory mapped buffer
+    // can be viewed in place as long as the records are suitably aligned.
+    if (m_bufferType == Parser::XamlBufferType::MemoryMappedResource)
+    {
+        XUINT64 uCountPos = 0;
+        IFC_RETURN(m_spMetadataStream->GetPosition(&uCountPos));
+
+        XamlBinaryFormatSerializationHelper::VectorData vectorData;
+        IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeItemFromMetadataStream(&vectorData, m_version, m_spMetadataStream));
+
+        XUINT64 uPos = 0;
+        IFC_RETURN(m_spMetadataStream->GetPosition(&uPos));
+
+        const XUINT64 cbRecords = static_cast<XUINT64>(vectorData.uiCount) * sizeof(TPersisted);
+        IFCCHECK_RETURN(uPos + cbRecords <= m_spMetadataMemory->GetSize());
+
+        const BYTE* pRecords = static_cast<const BYTE*>(m_spMetadataMemory->GetAddress()) + uPos;
+        if (reinterpret_cast<uintptr_t>(pRecords) % alignof(TPersisted) == 0)
+        {
+            table.SetMappedRecords(reinterpret_cast<const TPersisted*>(pRecords), vectorData.uiCount);
+            IFC_RETURN(m_spMetadataStream->Seek(uPos + cbRecords, PALSeekOrigin::SeekOriginStart, nullptr));
+            return S_OK;
+        }
+
+        // Misaligned records fall back to a copy.
+        IFC_RETURN(m_spMetadataStream->Seek(uCountPos, PALSeekOrigin::SeekOriginStart, nullptr));
+    }
+
+    std::vector<TPersisted> records;
+    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(records, m_version, m_spMetadataStream));
+    table.SetRecords(std::move(records));
+
+    return S_OK;
+}
+
 _Check_return_ HRESULT
 XamlBinaryMetadataReader2::LoadHeader()
 {
@@ -115,9 +154,7 @@ XamlBinaryMetadataReader2::LoadAssemblyList()
         IGNOREHR(LogDeserializationError(c_strReferenceTableDescription));
     });
 
-    std::vector < PersistedXamlAssembly > vecAssemblyList;
-    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(vecAssemblyList, m_version, m_spMetadataStream));
-    m_vecMasterAssemblyList.reserve(vecAssemblyList.size());
+    IFC_RETURN(LoadTableRecords(m_vecMasterAssemblyList));
     deserializationGuard.release();
 
     auto readGuard = wil::scope_exit([this]()
@@ -125,8 +162,9 @@ XamlBinaryMetadataReader2::LoadAssemblyList()
         IGNOREHR(LogError(AG_E_PARSER2_XBF_METADATA_ASSEMBLY_LIST, xstring_ptr::NullString(), xstring_ptr::NullString()));
     });
 
-    for (const auto& persistedAssembly : vecAssemblyList)
+    for (size_t index = 0; index < m_vecMasterAssemblyList.size(); ++index)
     {
+        const auto& persistedAssembly = m_vecMasterAssemblyList.GetRecord(index);
         std::shared_ptr<XamlTypeInfoProvider> spTypeInfoProvider;
         std::shared_ptr<XamlAssembly> spAssembly;
         XamlAssemblyToken assemblyToken;
@@ -139,7 +177,7 @@ XamlBinaryMetadataReader2::LoadAssemblyList()
         IFC_RETURN(m_spXamlSchemaContext->GetXamlAssembly(assemblyToken, spAssemblyName, spAssembly));
 
         IFCCHECK_RETURN(spAssembly);
-        m_vecMasterAssemblyList.push_back(spAssembly);
+        m_vecMasterAssemblyList.SetResolved(index, std::move(spAssembly));
     }
     readGuard.release();
 
@@ -150,7 +188,7 @@ _Check_return_ HRESULT
 XamlBinaryMetadataReader2::LoadTypeNamespace(_In_ uint32_t index)
 {
     xstring_ptr spNamespaceName;
-    auto& persistedTypeNamespace = m_vecMasterTypeNamespaceList[index].first;
+    const auto& persistedTypeNamespace = m_vecMasterTypeNamespaceList.GetRecord(index);
 
     auto readGuard = wil::scope_exit([this, &spNamespaceName]()
     {
@@ -166,7 +204,7 @@ XamlBinaryMetadataReader2::LoadTypeNamespace(_In_ uint32_t index)
 
     IFCCHECK_RETURN(spTypeNamespace);
 
-    m_vecMasterTypeNamespaceList[index].second = spTypeNamespace;
+    m_vecMasterTypeNamespaceList.SetResolved(index, std::move(spTypeNamespace));
     readGuard.release();
 
     return S_OK;
@@ -192,16 +230,7 @@ XamlBinaryMetadataReader2::LoadTypeNamespaceList()
         IGNOREHR(LogDeserializationError(c_strTypeNamespaceTableDescription));
     });
 
-    std::vector < PersistedXamlTypeNamespace > vecTypeNamespaceList;
-    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(vecTypeNamespaceList, m_version, m_spMetadataStream));
-    m_vecMasterTypeNamespaceList.reserve(vecTypeNamespaceList.size());
-
-    std::transform(
-        vecTypeNamespaceList.begin(), vecTypeNamespaceList.end(), std::back_inserter(m_vecMasterTypeNamespaceList),
-        [](PersistedXamlTypeNamespace &element)
-        {
-            return std::make_pair(element, std::shared_ptr<XamlTypeNamespace>());
-        });
+    IFC_RETURN(LoadTableRecords(m_vecMasterTypeNamespaceList));
 
     deserializationGuard.release();
 
@@ -215,7 +244,7 @@ XamlBinaryMetadataReader2::LoadType(_In_ uint32_t index)
     std::shared_ptr<XamlTypeNamespace> spTypeNamespace;
     std::shared_ptr<XamlType> spType;
 
-    auto& xamlType = m_vecMasterTypeList[index].first;
+    const auto& xamlType = m_vecMasterTypeList.GetRecord(index);
     auto readGuard = wil::scope_exit([this, &spTypeNamespace, &spTypeName]()
     {
         xstring_ptr spTypeNamespaceName;
@@ -285,7 +314,7 @@ XamlBinaryMetadataReader2::LoadType(_In_ uint32_t index)
     }
 
     IFCCHECK_RETURN(spType);
-    m_vecMasterTypeList[index].second = std::move(spType);
+    m_vecMasterTypeList.SetResolved(index, std::move(spType));
     readGuard.release();
 
     return S_OK;
@@ -311,16 +340,7 @@ XamlBinaryMetadataReader2::LoadTypeList()
         IGNOREHR(LogDeserializationError(c_strTypeTableDescription));
     });
 
-    std::vector< PersistedXamlType > vecMasterTypeList;
-    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(vecMasterTypeList, m_version, m_spMetadataStream));
-    m_vecMasterTypeList.reserve(vecMasterTypeList.size());
-
-    std::transform(
-        vecMasterTypeList.begin(), vecMasterTypeList.end(), std::back_inserter(m_vecMasterTypeList),
-        [](PersistedXamlType &element)
-    {
-        return std::make_pair(element, std::shared_ptr<XamlType>());
-    });
+    IFC_RETURN(LoadTableRecords(m_vecMasterTypeList));
 
     deserializationGuard.release();
 
@@ -334,7 +354,7 @@ XamlBinaryMetadataReader2::LoadProperty(_In_ uint32_t index)
     std::shared_ptr<XamlType> spType;
     std::shared_ptr<XamlProperty> spProperty;
 
-    auto& xamlProperty = m_vecMasterPropertyList[index].first;
+    const auto& xamlProperty = m_vecMasterPropertyList.GetRecord(index);
     auto readGuard = wil::scope_exit([this, &spType, &spPropertyName]()
     {
         xstring_ptr spTypeName;
@@ -417,7 +437,7 @@ XamlBinaryMetadataReader2::LoadProperty(_In_ uint32_t index)
             IFCFAILFAST(E_FAIL);
         }
     }
-    m_vecMasterPropertyList[index].second = spProperty;
+    m_vecMasterPropertyList.SetResolved(index, std::move(spProperty));
     readGuard.release();
 
     return S_OK;
@@ -441,16 +461,7 @@ XamlBinaryMetadataReader2::LoadPropertyList()
         IGNOREHR(LogDeserializationError(xstring_ptr(c_strPropertyTableDescriptionStorage)));
     });
 
-    std::vector < PersistedXamlProperty > vecMasterPropertyList;
-    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(vecMasterPropertyList, m_version, m_spMetadataStream));
-    m_vecMasterPropertyList.reserve(vecMasterPropertyList.size());
-
-    std::transform(
-        vecMasterPropertyList.begin(), vecMasterPropertyList.end(), std::back_inserter(m_vecMasterPropertyList),
-        [](PersistedXamlProperty &element)
-    {
-        return std::make_pair(element, std::shared_ptr<XamlProperty>());
-    });
+    IFC_RETURN(LoadTableRecords(m_vecMasterPropertyList));
 
     deserializationGuard.release();
 
@@ -461,7 +472,7 @@ _Check_return_ HRESULT
 XamlBinaryMetadataReader2::LoadXmlNamespace(_In_ uint32_t index)
 {
     xstring_ptr spNamespaceUri;
-    auto& xamlNamespace = m_vecMasterXmlNamespaceList[index].first;
+    const auto& xamlNamespace = m_vecMasterXmlNamespaceList.GetRecord(index);
     auto readGuard = wil::scope_exit([this, &spNamespaceUri]()
     {
         IGNOREHR(LogError(AG_E_PARSER2_XBF_METADATA_XML_NAMESPACE_LIST, spNamespaceUri, xstring_ptr::NullString()));
@@ -479,7 +490,7 @@ XamlBinaryMetadataReader2::LoadXmlNamespace(_In_ uint32_t index)
     }
 
     IFCCHECK_RETURN(spXamlNamespace);
-    m_vecMasterXmlNamespaceList[index].second = spXamlNamespace;
+    m_vecMasterXmlNamespaceList.SetResolved(index, std::move(spXamlNamespace));
 
     readGuard.release();
 
@@ -507,16 +518,7 @@ XamlBinaryMetadataReader2::LoadXmlNamespaceList()
         IGNOREHR(LogDeserializationError(c_strXmlNamespaceTableDescription));
     });
 
-    std::vector<PersistedXamlXmlNamespace> vecXmlNamespaceList;
-    IFC_RETURN(XamlBinaryFormatSerializationHelper::DeserializeVectorFromMetadataStream(vecXmlNamespaceList, m_version, m_spMetadataStream));
-    m_vecMasterXmlNamespaceList.reserve(vecXmlNamespaceList.size());
-
-    std::transform(
-        vecXmlNamespaceList.begin(), vecXmlNamespaceList.end(), std::back_inserter(m_vecMasterXmlNamespaceList),
-        [](PersistedXamlXmlNamespace &element)
-    {
-        return std::make_pair(element, std::shared_ptr<XamlNamespace>());
-    });
+    IFC_RETURN(LoadTableRecords(m_vecMasterXmlNamespaceList));
 
     deserializationGuard.release();
 
@@ -575,18 +577,18 @@ _Check_return_ HRESULT XamlBinaryMetadataReader2::GetString(_In_ uint32_t index,
 _Check_return_ HRESULT XamlBinaryMetadataReader2::GetAssembly(_In_ uint32_t index, _Out_ std::shared_ptr<XamlAssembly>& result) const
 {
     IFCCHECK_RETURN(index < m_vecMasterAssemblyList.size());
-    result = m_vecMasterAssemblyList[index];
+    result = m_vecMasterAssemblyList.GetResolved(index);
     return S_OK;
 }
 
 _Check_return_ HRESULT XamlBinaryMetadataReader2::GetTypeNamespace(_In_ uint32_t index, _Out_ std::shared_ptr<XamlTypeNamespace>& result)
 {
     IFCCHECK_RETURN(index < m_vecMasterTypeNamespaceList.size());
-    result = m_vecMasterTypeNamespaceList[index].second;
+    result = m_vecMasterTypeNamespaceList.GetResolved(index);
     if (!result)
     {
         IFC_RETURN(LoadTypeNamespace(index));
-        result = m_vecMasterTypeNamespaceList[index].second;
+        result = m_vecMasterTypeNamespaceList.GetResolved(index);
     }
     return S_OK;
 }
@@ -594,11 +596,11 @@ _Check_return_ HRESULT XamlBinaryMetadataReader2::GetTypeNamespace(_In_ uint32_t
 _Check_return_ HRESULT XamlBinaryMetadataReader2::GetType(_In_ uint32_t index, _Out_ std::shared_ptr<XamlType>& result)
 {
     IFCCHECK_RETURN(index < m_vecMasterTypeList.size());
-    result = m_vecMasterTypeList[index].second;
+    result = m_vecMasterTypeList.GetResolved(index);
     if (!result)
     {
         IFC_RETURN(LoadType(index));
-        result = m_vecMasterTypeList[index].second;
+        result = m_vecMasterTypeList.GetResolved(index);
     }
     return S_OK;
 }
@@ -606,11 +608,11 @@ _Check_return_ HRESULT XamlBinaryMetadataReader2::GetType(_In_ uint32_t index, _
 _Check_return_ HRESULT XamlBinaryMetadataReader2::GetProperty(_In_ uint32_t index, _Out_ std::shared_ptr<XamlProperty>& result)
 {
     IFCCHECK_RETURN(index < m_vecMasterPropertyList.size());
-    result = m_vecMasterPropertyList[index].second;
+    result = m_vecMasterPropertyList.GetResolved(index);
     if (!result)
     {
         IFC_RETURN(LoadProperty(index));
-        result = m_vecMasterPropertyList[index].second;
+        result = m_vecMasterPropertyList.GetResolved(index);
     }
     return S_OK;
 }
@@ -618,11 +620,11 @@ _Check_return_ HRESULT XamlBinaryMetadataReader2::GetProperty(_In_ uint32_t inde
 _Check_return_ HRESULT XamlBinaryMetadataReader2::GetXmlNamespace(_In_ uint32_t index, _Out_ std::shared_ptr<XamlNamespace>& result)
 {
     IFCCHECK_RETURN(index < m_vecMasterXmlNamespaceList.size());
-    result = m_vecMasterXmlNamespaceList[index].second;
+    result = m_vecMasterXmlNamespaceList.GetResolved(index);
     if (!result)
     {
         IFC_RETURN(LoadXmlNamespace(index));
-        result = m_vecMasterXmlNamespaceList[index].second;
+        result = m_vecMasterXmlNamespaceList.GetResolved(index);
     }
     return S_OK;
 }
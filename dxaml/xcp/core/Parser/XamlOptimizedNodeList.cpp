@@ -609,6 +609,50 @@ void XamlOptimizedNodeList::Close()
     m_fReadMode = true;
 }
 
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Estimate the memory held by the XamlOptimizedNodeList. Values are
+//      counted at their object size and strings at their character count;
+//      unknown namespaces are shared with the schema context and are not
+//      counted.
+//
+//------------------------------------------------------------------------
+size_t XamlOptimizedNodeList::GetEstimatedSizeInBytes() const
+{
+    size_t cbSize = sizeof(*this);
+
+    cbSize += m_bytes.capacity() * sizeof(XBYTE);
+    cbSize += m_values.capacity() * sizeof(std::shared_ptr<XamlQualifiedObject>);
+    cbSize += m_values.size() * sizeof(XamlQualifiedObject);
+    cbSize += m_unknownNamespaces.capacity() * sizeof(std::shared_ptr<XamlNamespace>);
+    cbSize += m_strings.capacity() * sizeof(xstring_ptr);
+
+    for (const auto& str : m_strings)
+    {
+        cbSize += str.GetCount() * sizeof(WCHAR);
+    }
+
+    return cbSize;
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Release the growth slack accumulated while the XamlOptimizedNodeList
+//      was being written. Only valid once the list is in read mode.
+//
+//------------------------------------------------------------------------
+void XamlOptimizedNodeList::ShrinkToFit()
+{
+    ASSERT(m_fReadMode);
+
+    m_bytes.shrink_to_fit();
+    m_values.shrink_to_fit();
+    m_strings.shrink_to_fit();
+    m_unknownNamespaces.shrink_to_fit();
+}
+
 
 //------------------------------------------------------------------------
 //
@@ -29,6 +29,7 @@
 #include <DesignMode.h>
 #include "CColor.h"
 #include "ThemeWalkResourceCache.h"
+#include "ResourceResolutionCache.h"
 #include "XamlTelemetry.h"
 
 // Imports from DXAML to support NullKeyedResource
@@ -42,6 +43,18 @@
 using namespace Theming;
 using namespace Resources;
 
+namespace
+{
+    // The theme EnsureActiveThemeDictionary picks a theme dictionary for, which is what a LocalOnly lookup
+    // depends on besides the contents of the dictionaries.
+    Theme GetResolutionCacheTheme(_In_ CCoreServices* core)
+    {
+        FrameworkTheming* theming = core->GetFrameworkTheming();
+        const Theme baseTheme = core->IsThemeRequestedForSubTree() ? core->GetRequestedThemeForSubTree() : theming->GetBaseTheme();
+        return baseTheme | theming->GetHighContrastTheme();
+    }
+}
+
 CResourceDictionary::CResourceDictionary(_In_ CCoreServices* pCore)
     : CDOCollection(pCore)
     , m_nImplicitStylesCount(0)
@@ -59,6 +72,7 @@ CResourceDictionary::CResourceDictionary(_In_ CCoreServices* pCore)
     , m_isHighContrast(false)
     , m_useAppResourcesForThemeRef(false)
     , m_isGlobal(false)
+    , m_isReachableFromResolutionCache(false)
 #if DBG
     , m_processingBulkUndeferral(false)
 #endif
@@ -87,6 +101,9 @@ CResourceDictionary::~CResourceDictionary()
 
     m_pActiveThemeDictionary = NULL;
     ReleaseInterface(m_pThemeDictionaries);
+
+    // Entries are keyed by dictionary address, which can be reused once this one is gone.
+    InvalidateResolutionCache();
 }
 
 XUINT32 CResourceDictionary::GetCount() const
@@ -134,6 +151,7 @@ CResourceDictionary::SetValue(_In_ const SetValueParams& args)
                 {
                     m_pMergedDictionaries->SetResourceOwner(m_pResourceOwner);
                 }
+                InvalidateResolutionCache();
                 break;
             }
         case KnownPropertyIndex::ResourceDictionary_ThemeDictionaries:
@@ -142,6 +160,7 @@ CResourceDictionary::SetValue(_In_ const SetValueParams& args)
                 {
                     m_pThemeDictionaries->SetResourceOwner(m_pResourceOwner);
                 }
+                InvalidateResolutionCache();
                 break;
             }
         }
@@ -333,6 +352,7 @@ CResourceDictionary::RemoveKey(
     CDependencyObject* pValue = nullptr;
 
     GetContext()->GetThemeWalkResourceCache()->RemoveThemeResourceCacheEntry(key.GetKey());
+    InvalidateResolutionCache();
 
     // This method is called from Remove/RemoveAt and by now all the remaining keys should
     // have been faulted in and the deferred resource dictionary released.
@@ -412,6 +432,65 @@ CResourceDictionary::GetKeyNoRefImpl(
         key.ShouldFilter() &&
         !m_pResourceLookupLoggerNoRef->IsLogging();
 
+    // The resolution cache remembers the outcome of the whole lookup, found or not, keyed by the theme it was
+    // resolved for. It is used on the same edges as the key-not-found cache, so only the outermost dictionary
+    // of a lookup records an entry.
+    ResourceResolutionCache* const coreResolutionCache = GetContext()->GetResourceResolutionCache();
+    ResourceResolutionCache* resolutionCache =
+        (useKeysNotFoundCache && GetContext()->GetFrameworkTheming())
+            ? coreResolutionCache
+            : nullptr;
+    Theme resolutionCacheTheme = Theme::None;
+    std::uint64_t resolutionCacheGeneration = 0;
+    xref_ptr<CResourceDictionary> resolutionCacheReadFrom;
+
+    if (resolutionCache)
+    {
+        resolutionCacheTheme = GetResolutionCacheTheme(GetContext());
+        resolutionCacheGeneration = resolutionCache->GetGeneration();
+
+        CDependencyObject* cachedValue = nullptr;
+
+        switch (resolutionCache->TryGetCachedResult(this, key, resolutionCacheTheme, &cachedValue, dictionaryReadFrom))
+        {
+            case ResourceResolutionCache::LookupResult::Found:
+                m_pResourceLookupLoggerNoRef->OnResolutionCacheHit();
+                *keyNoRef = cachedValue;
+                return S_OK;
+
+            case ResourceResolutionCache::LookupResult::NotFound:
+                m_pResourceLookupLoggerNoRef->OnResolutionCacheHit();
+                return S_OK;
+
+            case ResourceResolutionCache::LookupResult::NotCached:
+                m_pResourceLookupLoggerNoRef->OnResolutionCacheMiss();
+                break;
+        }
+
+        // The cache needs to know where the value came from even if the caller doesn't.
+        if (!dictionaryReadFrom)
+        {
+            dictionaryReadFrom = &resolutionCacheReadFrom;
+        }
+
+        resolutionCache->BeginRecordedLookup();
+    }
+
+    auto endRecordedLookup = wil::scope_exit([resolutionCache]
+    {
+        if (resolutionCache)
+        {
+            resolutionCache->EndRecordedLookup();
+        }
+    });
+
+    // Every dictionary visited by a lookup that is going to be cached can change its outcome, so only changes
+    // to those dictionaries need to invalidate the cache.
+    if (coreResolutionCache && coreResolutionCache->IsRecordingLookup())
+    {
+        m_isReachableFromResolutionCache = true;
+    }
+
     if (useKeysNotFoundCache)
     {
         if (m_keysNotFoundCache &&
@@ -488,6 +567,11 @@ CResourceDictionary::GetKeyNoRefImpl(
             dictionaryReadFrom));
     }
 
+    if (resolutionCache && !undeferring)
+    {
+        resolutionCache->AddCachedResult(this, key, resolutionCacheTheme, resolutionCacheGeneration, value, dictionaryReadFrom->get());
+    }
+
     if (!value &&
         useKeysNotFoundCache &&
         !undeferring)
@@ -1124,6 +1208,7 @@ CResourceDictionary::Clear()
     xhr = CCollection::Clear();
     m_resourceMap.clear();
     m_keyByIndex.clear();
+    InvalidateResolutionCache();
     IFC(InvalidateImplicitStyles(NULL));
     m_pDeferredResources.reset();
 
@@ -1409,6 +1494,8 @@ CResourceDictionary::OnThemeDictionariesChanged()
     }
     m_activeTheme = Theming::Theme::None;
 
+    InvalidateResolutionCache();
+
     RRETURN(S_OK);
 }
 
@@ -1816,6 +1903,8 @@ CResourceDictionary::DeferKeysAsXaml(
 
     IFC_RETURN(m_pRuntimeDeferredKeys->RecordXaml(spServiceProviderContext, spNodeList, spContext, fIsResourceDictionaryWithKeyProperty));
 
+    InvalidateResolutionCache();
+
     return S_OK;
 }
 
@@ -1830,6 +1919,8 @@ CResourceDictionary::SetCustomWriterRuntimeData(
 
     IFC_RETURN(m_pDeferredResources->SetCustomWriterRuntimeData(std::static_pointer_cast<ResourceDictionaryCustomRuntimeData>(data), std::move(context)));
 
+    InvalidateResolutionCache();
+
     m_nImplicitStylesCount += m_pDeferredResources->GetInitialImplicitStyleKeyCount();
 
     // We need to load deferred resources with an x:Name or x:ConnectionId to ensure that they can
@@ -1904,12 +1995,23 @@ CResourceDictionary::TryLoadDeferredResource(
     // the key is removed on stack unwind so this temporary no-ref use is safe.
     m_undeferringResources.push_back(key);
 
+    ResourceResolutionCache* resolutionCache = GetContext()->GetResourceResolutionCache();
+    if (resolutionCache)
+    {
+        resolutionCache->PushUndeferringKey(key);
+    }
+
 #if DBG || defined(_PREFAST_)
-    auto guard = wil::scope_exit([this, &key, undeferringSize = m_undeferringResources.size()]
+    auto guard = wil::scope_exit([this, resolutionCache, &key, undeferringSize = m_undeferringResources.size()]
 #else
-    auto guard = wil::scope_exit([this]
+    auto guard = wil::scope_exit([this, resolutionCache]
 #endif
     {
+        if (resolutionCache)
+        {
+            resolutionCache->PopUndeferringKey();
+        }
+
         // m_undeferringResources is only used in this function and any reentrant calls should
         // leave it the same as when they started. This means the size should always be the same
         // as when we pushed, and that the back is the same key we pushed, so we can simply pop
@@ -2230,8 +2332,25 @@ CResourceDictionary* GetParentDictionaryHelper(_In_ CResourceDictionary* current
     return nullptr;
 }
 
+void CResourceDictionary::InvalidateResolutionCache()
+{
+    // Dictionaries that no cached lookup went through, like ones still being constructed or parsed, can't make a
+    // cached result stale. Skipping them keeps loading new dictionaries from flushing the cache for the whole core.
+    if (!m_isReachableFromResolutionCache)
+    {
+        return;
+    }
+
+    if (ResourceResolutionCache* cache = GetContext()->GetResourceResolutionCache())
+    {
+        cache->Invalidate();
+    }
+}
+
 void CResourceDictionary::InvalidateNotFoundCache(bool propagate)
 {
+    InvalidateResolutionCache();
+
     if (propagate)
     {
         // Traverse dictionary sub-tree iteratively as it has less overhead.
@@ -2259,6 +2378,8 @@ void CResourceDictionary::InvalidateNotFoundCache(bool propagate)
 
 void CResourceDictionary::InvalidateNotFoundCache(bool propagate, const ResourceKey& key)
 {
+    InvalidateResolutionCache();
+
     if (propagate)
     {
         // Traverse dictionary sub-tree iteratively as it has less overhead.
@@ -13,6 +13,7 @@
 #include <OptionalChangeState.h>
 #include "Transform3D.h"
 #include "HitTestParams.h"
+#include "HitTestGrid.h"
 #include <DependencyObjectDCompRegistry.h>
 #include "ICollectionChangeCallback.h"
 #include "OcclusivityTester.h"
@@ -13052,7 +13053,7 @@ _Check_return_ HRESULT CUIElement::GenerateChildOuterBounds(
     _Out_ XRECTF_RB* pBounds
     )
 {
-    const auto pCollection = static_cast<const CUIElementCollection*>(GetChildren());
+    const auto pCollection = GetChildren();
 
     EmptyRectF(pBounds);
 
@@ -13063,6 +13064,22 @@ _Check_return_ HRESULT CUIElement::GenerateChildOuterBounds(
 
         GetChildrenInRenderOrder(&ppUIElements, &childCount);
 
+        // Panels with many children keep a grid of the children's outer bounds, so that hit testing doesn't have
+        // to visit every child (see BoundsTestChildrenImpl). These are the bounds the hit testing walk culls
+        // children with, so the grid is rebuilt whenever they are. If this fails part way, the grid stays invalid
+        // until the next time.
+        HitTestGrid* hitTestGrid = nullptr;
+
+        if (childCount >= HitTestGrid::c_minItemCount)
+        {
+            hitTestGrid = &pCollection->EnsureHitTestGrid();
+            hitTestGrid->BeginBuild(childCount);
+        }
+        else if (pCollection->GetHitTestGrid() != nullptr)
+        {
+            pCollection->DestroyHitTestGrid();
+        }
+
         for (XUINT32 i = 0; i < childCount; ++i)
         {
             XRECTF_RB childBounds = { };
@@ -13079,9 +13096,33 @@ _Check_return_ HRESULT CUIElement::GenerateChildOuterBounds(
                     IFC_RETURN(ppUIElements[i]->GetOuterBounds(hitTestParams, &childBounds));
 
                     UnionRectF(pBounds, &childBounds);
+
+                    if (hitTestGrid != nullptr)
+                    {
+                        // The walk doesn't cull elements with depth by their outer bounds.
+                        if (pElement->HasDepthLegacy() || pElement->Has3DDepthOnSelfOrSubtree())
+                        {
+                            hitTestGrid->AddAlwaysTested(i, pElement);
+                        }
+                        else
+                        {
+                            hitTestGrid->Add(i, pElement, childBounds);
+                        }
+                    }
+                }
+                else if (hitTestGrid != nullptr)
+                {
+                    // Popups hit test their child wherever it is, and elements hidden for a layout transition
+                    // don't have up to date bounds.
+                    hitTestGrid->AddAlwaysTested(i, pElement);
                 }
             }
         }
+
+        if (hitTestGrid != nullptr)
+        {
+            hitTestGrid->EndBuild();
+        }
     }
 
     return S_OK;
@@ -14037,17 +14078,16 @@ _Check_return_ HRESULT CUIElement::BoundsTestChildrenImpl(
 
     GetChildrenInRenderOrder(&ppUIElements, &childCount);
 
-    // Test bounds in reverse render order (front to back).
-    for (XUINT32 i = childCount; i > 0 && flags_enum::is_set(childHitResult, BoundsWalkHitResult::Continue); --i)
+    auto boundsTestChild = [&](_In_opt_ CUIElement* pChild) -> HRESULT
     {
         // Workaround for a crash in a scenario where items are removed while ListView reordering is in progress.
         // If element leaves the tree while it is being dragged, pointer capture loss event is fired which will trigger bounds walk.
         // If pointer was over the element leaving the tree it will be tested and since it was replaced with null
         // in children collection to prevent reentrancy (CDOCollection::Neat), the pointer can be null and this case needs to be guarded.
         // Bounds check can be skipped since it is called via CCollection::Destroy().
-        if (ppUIElements[i - 1])
+        if (pChild)
         {
-            IFC_RETURN(ppUIElements[i - 1]->BoundsTestInternal(target, pCallback, hitTestParams, canHitDisabledElements, canHitInvisibleElements, &childHitResult));
+            IFC_RETURN(pChild->BoundsTestInternal(target, pCallback, hitTestParams, canHitDisabledElements, canHitInvisibleElements, &childHitResult));
 
             // If any child wanted to include its parent chain, copy the flag.
             if (flags_enum::is_set(childHitResult, BoundsWalkHitResult::IncludeParents))
@@ -14055,6 +14095,36 @@ _Check_return_ HRESULT CUIElement::BoundsTestChildrenImpl(
                 hitResult = flags_enum::set(hitResult, BoundsWalkHitResult::IncludeParents);
             }
         }
+
+        return S_OK;
+    };
+
+    // Large panels look up the children under the target in the grid built along with their child bounds. The grid
+    // only knows the children's outer bounds, so it can't be used when the walk doesn't cull children by them.
+    const HitTestGrid* hitTestGrid = m_pChildren ? m_pChildren->GetHitTestGrid() : nullptr;
+    std::vector<XUINT32> candidates;
+
+    if (hitTestGrid != nullptr
+        && !GetContext()->InvisibleHitTestMode()
+        && !canHitInvisibleElements
+        && !(hitTestParams != nullptr && hitTestParams->hasTransform3DInSubtree)
+        && !AreChildBoundsDirty()
+        && hitTestGrid->GetCandidates(GetHitTypeBounds(target), ppUIElements, childCount, candidates))
+    {
+        // The candidates are in descending order, so this is still front to back. The children left out would have
+        // been culled by their outer bounds and returned Continue.
+        for (auto it = candidates.begin(); it != candidates.end() && flags_enum::is_set(childHitResult, BoundsWalkHitResult::Continue); ++it)
+        {
+            IFC_RETURN(boundsTestChild(ppUIElements[*it]));
+        }
+    }
+    else
+    {
+        // Test bounds in reverse render order (front to back).
+        for (XUINT32 i = childCount; i > 0 && flags_enum::is_set(childHitResult, BoundsWalkHitResult::Continue); --i)
+        {
+            IFC_RETURN(boundsTestChild(ppUIElements[i - 1]));
+        }
     }
 
     // If the child element wanted the bounds walk to stop, remove the continue flag
@@ -14632,6 +14702,38 @@ bool DoesRectIntersectHitType(_In_ const XRECTF_RB& rect, _In_ const HitTestPoly
     return target.IntersectsRect(rect);
 }
 
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Returns the bounds of the point.
+//
+//------------------------------------------------------------------------
+template <>
+XRECTF_RB GetHitTypeBounds(_In_ const XPOINTF& target)
+{
+    return { target.x, target.y, target.x, target.y };
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Returns the bounds of the polygon, with some tolerance for the
+//      rounding in HitTestPolygon::IntersectsRect.
+//
+//------------------------------------------------------------------------
+template <>
+XRECTF_RB GetHitTypeBounds(_In_ const HitTestPolygon& target)
+{
+    XRECTF_RB bounds = target.GetPolygonBounds();
+
+    bounds.left -= 1.0f;
+    bounds.top -= 1.0f;
+    bounds.right += 1.0f;
+    bounds.bottom += 1.0f;
+
+    return bounds;
+}
+
 //------------------------------------------------------------------------
 //
 //  Synopsis:
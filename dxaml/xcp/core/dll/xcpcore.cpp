@@ -34,6 +34,7 @@
 #include <FrameworkTheming.h>
 #include <SystemThemingInterop.h>
 #include <ThemeWalkResourceCache.h>
+#include <ResourceResolutionCache.h>
 #include <GraphicsUtility.h>
 #include <DXamlServices.h>
 #include <AutoReentrantReferenceLock.h>
@@ -1241,6 +1242,7 @@ CCoreServices::Create(_Out_ CCoreServices **ppCore)
         false /* doNotifyThemeChange */));
 
     pCore->m_themeWalkResourceCache.reset(new ThemeWalkResourceCache());
+    pCore->m_resourceResolutionCache.reset(new ResourceResolutionCache());
 
     // Create the queue manager for deferring certain types of media event processing
     IFC( CMediaQueueManager::Create(&pCore->m_pmqm) );
@@ -31,6 +31,7 @@
 #include <weakref_count.h>
 #include <weakref_ptr.h>
 #include <vector_map.h>
+#include <SparseValueTable.h>
 #include <forward_list>
 #include <stack_allocator.h>
 #include <wil\result.h>
@@ -883,7 +884,6 @@ public:
     CDependencyObject* MapPropertyAndGroupOffsetToDO(_In_ UINT offset, _In_ UINT groupOffset);
     CValue* MapPropertyAndGroupOffsetToCValueNoRef(_In_ UINT offset, _In_ UINT groupOffset);
 
-    typedef containers::vector_map<KnownPropertyIndex, EffectiveValue> SparseValueTable;
     typedef SparseValueTable::value_type SparseValueEntry;
     const std::unique_ptr<SparseValueTable>& GetValueTable() const
     {
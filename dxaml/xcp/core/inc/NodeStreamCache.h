@@ -25,8 +25,30 @@ class XamlNodeStreamCacheManager
     friend class Microsoft::UI::Xaml::Tests::Parser::XamlNodeStreamCacheManagerUnitTests;
 
 public:
+    // Default upper bound on the memory held by cached node lists. Zero keeps every
+    // node list until the next Flush(), as the cache always did; hosts opt in to
+    // eviction with SetNodeListBudget. Once a budget is exceeded, the least recently
+    // used node lists are released, to be rebuilt from the XBF or text source the
+    // next time their Uri is loaded.
+    static constexpr size_t c_defaultNodeListBudgetInBytes = 0;
+
+    // Number of cache hits after which a node list's storage is trimmed with
+    // ShrinkToFit, dropping the growth slack left over from writing it. The node
+    // list keeps its format; this is the only treatment hot entries get.
+    static constexpr UINT32 c_compactionAccessCount = 2;
+
+    struct Statistics
+    {
+        UINT32 hits = 0;
+        UINT32 misses = 0;
+        UINT32 evictions = 0;
+        UINT32 compactions = 0;
+        size_t cachedBytes = 0;
+    };
+
     XamlNodeStreamCacheManager(_In_ IParserCoreServices* pCore)
         : m_pCore(pCore)
+        , m_cbNodeListBudget(c_defaultNodeListBudgetInBytes)
     {
         // Memoization should ignore case to avoid creating duplicate entries for the same stream
     }
@@ -70,12 +92,23 @@ public:
     // to our cached readers holding onto stale type information).
     _Check_return_ HRESULT ResetCachedXbfV2Readers();
 
+    // Sets the upper bound on the memory held by cached node lists. A budget
+    // of zero disables eviction.
+    void SetNodeListBudget(size_t cbBudget);
+    size_t GetNodeListBudget() const { return m_cbNodeListBudget; }
+
+    Statistics GetStatistics() const;
+    void ResetStatistics();
+
 private:
     class NodeStreamCacheEntry
     {
     public:
         NodeStreamCacheEntry()
             : m_uiAccessCount(0)
+            , m_cbNodeList(0)
+            , m_lastAccess(0)
+            , m_fCompacted(false)
         {}
 
         UINT32 GetAccessCount() const;
@@ -91,11 +124,36 @@ private:
 
         bool HasNodeList() const;
 
+        // Drops the cached node list, returning the number of bytes it was
+        // accounted for. The access count is kept so that a page which was
+        // frequently used before eviction is cached again when it is reloaded.
+        size_t ReleaseNodeList();
+
+        // Trims the node list's storage, returning the number of bytes saved.
+        size_t CompactNodeList();
+        bool IsCompacted() const { return m_fCompacted; }
+
+        size_t GetNodeListSizeInBytes() const { return m_cbNodeList; }
+
+        UINT64 GetLastAccess() const { return m_lastAccess; }
+        void SetLastAccess(UINT64 lastAccess) { m_lastAccess = lastAccess; }
+
     private:
         std::shared_ptr<XamlOptimizedNodeList> m_spNodeList;
         UINT32 m_uiAccessCount;
+        size_t m_cbNodeList;
+        UINT64 m_lastAccess;
+        bool m_fCompacted;
     };
 
+    // Accounts for a node list that was just stored in spNodeStreamCacheEntry and
+    // evicts other node lists if the budget is exceeded.
+    void OnNodeListCached(_In_ const std::shared_ptr<NodeStreamCacheEntry>& spNodeStreamCacheEntry);
+
+    // Releases least recently used node lists, other than the one held by
+    // pExcludedEntry, until the cached bytes fit within the budget.
+    void EnforceNodeListBudget(_In_opt_ const NodeStreamCacheEntry* pExcludedEntry);
+
     _Check_return_ HRESULT GetXamlBinaryReader(
         _In_ std::shared_ptr<XamlSchemaContext>& spXamlSchemaContext,
         _In_ const xstring_ptr& strUniqueName,
@@ -119,10 +177,18 @@ private:
     std::unordered_map<xstring_ptr, xref_ptr<IPALResource>> m_UriToXbfResourceMap;
     std::unordered_map<xstring_ptr, std::shared_ptr<NodeStreamCacheEntry>, xstrCaseInsensitiveHasher, xstrCaseInsensitiveEqual> m_UriToNodelistMap;
 
-    // This ensures that memory mapped XBF strings remain valid as long as
-    // this manager. We need to hold both the XBFv2 reader (which owns the
-    // xstring_ptr_storage wrappers) and the IPALResource that owns the underlying
-    // buffers.
+    // Byte accounting and LRU ordering for the node lists in m_UriToNodelistMap.
+    // m_accessSequence is a logical clock stamped on an entry whenever its node
+    // list is stored or read.
+    size_t m_cbNodeListBudget;
+    size_t m_cbCachedNodeLists = 0;
+    UINT64 m_accessSequence = 0;
+    Statistics m_statistics;
+
+    // This ensures that memory mapped XBF strings and metadata tables remain valid
+    // as long as this manager. We need to hold both the XBFv2 reader (which owns the
+    // xstring_ptr_storage wrappers and table views) and the IPALResource that owns
+    // the underlying buffers.
     containers::vector_map<const void*, std::shared_ptr<XamlBinaryFormatReader2>> m_XBFv2ReaderCache;
     std::vector<std::shared_ptr<XamlBinaryFormatReader2>> m_staleXBFv2Readers;
     std::vector<xref_ptr<IPALResource>> m_XbfResourceStorage;
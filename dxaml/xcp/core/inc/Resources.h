@@ -367,6 +367,10 @@ public:
     void InvalidateNotFoundCache(bool propagate);
     void InvalidateNotFoundCache(bool propagate, const ResourceKey& key);
 
+    // Drops the cached results of all lookups, in every dictionary, if this dictionary was visited by a cached
+    // lookup. Changes that can only make more keys found go through InvalidateNotFoundCache, which does this too.
+    void InvalidateResolutionCache();
+
     _Check_return_
     HRESULT DeferKeysAsXaml(
         _In_ const bool fIsDictionaryWithKeyProperty,
@@ -514,6 +518,7 @@ private:
     unsigned int m_isHighContrast              : 1;
     unsigned int m_useAppResourcesForThemeRef  : 1;
     unsigned int m_isGlobal                    : 1;
+    unsigned int m_isReachableFromResolutionCache : 1; // A lookup recorded in the ResourceResolutionCache went through this dictionary
 
     // m_pActiveThemeDictionary's theme
     Theming::Theme m_activeTheme               : 5;
@@ -128,6 +128,11 @@ bool DoesRectIntersectHitType(
     _In_ const HitType& target
     );
 
+template <typename HitType>
+XRECTF_RB GetHitTypeBounds(
+    _In_ const HitType& target
+    );
+
 template <typename HitType>
 _Check_return_ HRESULT ClipHitTypeToRect(
     _Inout_ HitType& target,
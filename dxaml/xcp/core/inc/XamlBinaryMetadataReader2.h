@@ -42,6 +42,46 @@ public:
     }
 
 private:
+    // A metadata table of fixed size persisted records, along with the runtime objects lazily
+    // resolved from them. For memory mapped XBF buffers the records are read in place from the
+    // mapping instead of being copied, so every reader of the same file shares the same pages.
+    template <typename TPersisted, typename TResolved>
+    class MetadataTable
+    {
+    public:
+        size_t size() const { return m_resolved.size(); }
+
+        const TPersisted& GetRecord(_In_ size_t index) const { return m_pRecords[index]; }
+
+        const std::shared_ptr<TResolved>& GetResolved(_In_ size_t index) const { return m_resolved[index]; }
+        void SetResolved(_In_ size_t index, std::shared_ptr<TResolved> spResolved) { m_resolved[index] = std::move(spResolved); }
+
+        // True when the records are views into the XBF buffer rather than copies.
+        bool IsMapped() const { return m_pRecords != nullptr && m_pRecords != m_recordStorage.data(); }
+
+        void SetMappedRecords(_In_reads_(count) const TPersisted* pRecords, _In_ uint32_t count)
+        {
+            m_recordStorage.clear();
+            m_pRecords = pRecords;
+            m_resolved.resize(count);
+        }
+
+        void SetRecords(_In_ std::vector<TPersisted>&& records)
+        {
+            m_recordStorage = std::move(records);
+            m_pRecords = m_recordStorage.data();
+            m_resolved.resize(m_recordStorage.size());
+        }
+
+    private:
+        const TPersisted* m_pRecords = nullptr;
+        std::vector<TPersisted> m_recordStorage;  // Only used when the records could not be read in place.
+        std::vector<std::shared_ptr<TResolved>> m_resolved;
+    };
+
+    template <typename TPersisted, typename TResolved>
+    _Check_return_ HRESULT LoadTableRecords(_Inout_ MetadataTable<TPersisted, TResolved>& table);
+
     _Check_return_ HRESULT LoadHeader();
     _Check_return_ HRESULT LoadAssemblyList();
     _Check_return_ HRESULT LoadStringTable();
@@ -88,6 +128,18 @@ public:
 
     xstring_ptr GetXbfHash() const;
 
+    // True when the string, type, property and namespace tables are all views into a memory mapped
+    // XBF buffer, i.e. loading this reader did not copy any of them.
+    bool AreTablesMapped() const
+    {
+        return m_vecStringStorageList &&
+            m_vecMasterAssemblyList.IsMapped() &&
+            m_vecMasterTypeNamespaceList.IsMapped() &&
+            m_vecMasterTypeList.IsMapped() &&
+            m_vecMasterPropertyList.IsMapped() &&
+            m_vecMasterXmlNamespaceList.IsMapped();
+    }
+
     const std::shared_ptr<std::vector<xstring_ptr_storage>>& GetStringStorage() const
     {
         return m_vecStringStorageList;
@@ -111,11 +163,11 @@ private:
     // xstring_ptr instances for copies of non-mapped buffers.
     std::shared_ptr<std::vector<xstring_ptr>> m_vecStringList;
 
-    std::vector < std::shared_ptr<XamlAssembly> > m_vecMasterAssemblyList;
-    std::vector < std::pair < PersistedXamlTypeNamespace, std::shared_ptr<XamlTypeNamespace> >>  m_vecMasterTypeNamespaceList;
-    std::vector < std::pair < PersistedXamlType, std::shared_ptr<XamlType> > > m_vecMasterTypeList;
-    std::vector < std::pair < PersistedXamlProperty, std::shared_ptr<XamlProperty> > > m_vecMasterPropertyList;
-    std::vector < std::pair < PersistedXamlXmlNamespace, std::shared_ptr<XamlNamespace> > > m_vecMasterXmlNamespaceList;
+    MetadataTable<PersistedXamlAssembly, XamlAssembly> m_vecMasterAssemblyList;
+    MetadataTable<PersistedXamlTypeNamespace, XamlTypeNamespace> m_vecMasterTypeNamespaceList;
+    MetadataTable<PersistedXamlType, XamlType> m_vecMasterTypeList;
+    MetadataTable<PersistedXamlProperty, XamlProperty> m_vecMasterPropertyList;
+    MetadataTable<PersistedXamlXmlNamespace, XamlNamespace> m_vecMasterXmlNamespaceList;
 
     xref_ptr<IPALStream> m_spMetadataStream;
     xref_ptr<IPALMemory> m_spMetadataMemory;
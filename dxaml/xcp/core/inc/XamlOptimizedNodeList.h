@@ -143,6 +143,12 @@ public:
     void ReserveBasedOn(const std::shared_ptr<XamlOptimizedNodeList>& spOther);
     void Close();
 
+    // Approximate memory held by the node list, including the shared values and strings.
+    size_t GetEstimatedSizeInBytes() const;
+
+    // Releases unused capacity once the node list has been closed for writing.
+    void ShrinkToFit();
+
 protected:
     void AddNodeType(XamlNodeType nodeType);
     void AddFlags(XamlOptimizedNodeList::NodeListFlags flags);
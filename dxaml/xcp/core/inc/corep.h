@@ -150,6 +150,7 @@ class ImageSurfaceWrapper;
 class XamlSchemaContext;
 class FrameworkTheming;
 class ThemeWalkResourceCache;
+class ResourceResolutionCache;
 class CTransformGroup;
 class WindowsPresentTarget;
 class CXamlCompositionBrush;
@@ -1425,6 +1426,11 @@ public:
         return m_themeWalkResourceCache.get();
     }
 
+    ResourceResolutionCache* GetResourceResolutionCache()
+    {
+        return m_resourceResolutionCache.get();
+    }
+
     Theming::Theme GetRequestedThemeForSubTree() const
     {
         return m_requestedThemeForSubTree;
@@ -2210,6 +2216,8 @@ public:
                                 m_spTheming;
     std::unique_ptr<ThemeWalkResourceCache>
                                 m_themeWalkResourceCache;
+    std::unique_ptr<ResourceResolutionCache>
+                                m_resourceResolutionCache;
 
     // Corresponds to FrameworkElement.RequestedTheme. Such a framework element
     // is the root of a theme subtree, and is used for theme mixing, where a
@@ -1235,7 +1235,7 @@ HRESULT
 BindingExpression::ConnectToEffectiveSource()
 {
     HRESULT hr = S_OK;
-    PropertyPathParser *pPropertyPathParser = NULL;     // Owned by the binding
+    std::shared_ptr<CompiledPropertyPath> spCompiledPath;
 
     // By this point we should have calculated the effective source
     ASSERT(m_effectiveSourceType != xaml_data::EffectiveSourceType_None);
@@ -1247,12 +1247,12 @@ BindingExpression::ConnectToEffectiveSource()
         ctl::ComPtr<PropertyPathListener> spListener;
 
         IFC(m_tpBinding->get_Mode(&bindingMode));
-        IFC(m_tpBinding->GetPropertyPathParser(&pPropertyPathParser));
+        IFC(m_tpBinding->GetCompiledPropertyPath(&spCompiledPath));
 
         fListenToChanges = bindingMode == xaml_data::BindingMode_OneWay || bindingMode == xaml_data::BindingMode_TwoWay;
 
         // Create and initialize the listener before setting into m_tpListener, so we don't have a race with ReferenceTrackerWalk.
-        IFC(ctl::make<PropertyPathListener>(this, pPropertyPathParser, fListenToChanges, m_effectiveSourceType == xaml_data::EffectiveSourceType_Target, &spListener));
+        IFC(ctl::make<PropertyPathListener>(this, spCompiledPath, fListenToChanges, m_effectiveSourceType == xaml_data::EffectiveSourceType_Target, &spListener));
         SetPtrValue(m_tpListener, spListener);
     }
 
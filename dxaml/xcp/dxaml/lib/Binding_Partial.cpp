@@ -10,7 +10,7 @@
 #include "precomp.h"
 #include "Binding.g.h"
 #include "PropertyPath.g.h"
-#include "PropertyPathParser.h"
+#include "CompiledPropertyPath.h"
 
 using namespace DirectUI;
 using namespace DirectUISynonyms;
@@ -238,10 +238,9 @@ Binding::UpdatePropertyPathParser()
     IFC_RETURN(GetPathString(strPath.GetAddressOf()));
     LPCWSTR szNewPath = strPath.GetRawBuffer(nullptr);
 
-    // Create a new parser and move it in (PropertyPathParser only supports parsing once)
-    PropertyPathParser newParser;
-    IFC_RETURN(newParser.SetSource(szNewPath, nullptr));
-    m_propertyPathParser = std::move(newParser);
+    std::shared_ptr<CompiledPropertyPath> spCompiledPath;
+    IFC_RETURN(CompiledPropertyPath::GetOrCreate(szNewPath, nullptr, &spCompiledPath));
+    m_spCompiledPath = std::move(spCompiledPath);
 
     return S_OK;
 }
@@ -250,13 +249,13 @@ _Check_return_
 HRESULT 
 Binding::EnsurePropertyPathParser(_In_opt_ DirectUI::XamlServiceProviderContext* context)
 {
-    if (!m_propertyPathParser.HasParsedPath())
+    if (!m_spCompiledPath)
     {
         wrl_wrappers::HString strPath;
         IFC_RETURN(GetPathString(strPath.GetAddressOf()));
         LPCWSTR szPath = strPath.GetRawBuffer(nullptr);
 
-        IFC_RETURN(m_propertyPathParser.SetSource(szPath, context));
+        IFC_RETURN(CompiledPropertyPath::GetOrCreate(szPath, context, &m_spCompiledPath));
     }
 
     return S_OK;
@@ -265,10 +264,10 @@ Binding::EnsurePropertyPathParser(_In_opt_ DirectUI::XamlServiceProviderContext*
 
 _Check_return_ 
 HRESULT 
-Binding::GetPropertyPathParser(_Outptr_ PropertyPathParser **ppPropertyPath)
+Binding::GetCompiledPropertyPath(_Out_ std::shared_ptr<CompiledPropertyPath> *pspCompiledPath)
 {
     IFC_RETURN(EnsurePropertyPathParser(/* context */ nullptr));
-    *ppPropertyPath = &m_propertyPathParser;
+    *pspCompiledPath = m_spCompiledPath;
 
     return S_OK;
 }
@@ -10,7 +10,7 @@
 #pragma once
 
 #include "Binding.g.h"
-#include "PropertyPathParser.h"
+#include "CompiledPropertyPath.h"
 
 namespace DirectUI
 {
@@ -56,8 +56,8 @@ namespace DirectUI
         IFACEMETHOD(put_TargetNullValue)(_In_ IInspectable* value) override;
         IFACEMETHOD(put_UpdateSourceTrigger)(_In_ xaml_data::UpdateSourceTrigger value) override;
 
-        // Internal method to get to the property path object
-        _Check_return_ HRESULT GetPropertyPathParser(_Outptr_ PropertyPathParser **ppPropertyPath);
+        // Internal method to get to the property path object, shared with the other Bindings with the same path
+        _Check_return_ HRESULT GetCompiledPropertyPath(_Out_ std::shared_ptr<CompiledPropertyPath> *pspCompiledPath);
 
         _Check_return_ HRESULT EnsurePropertyPathParser(_In_opt_ XamlServiceProviderContext* context);
         _Check_return_ HRESULT UpdatePropertyPathParser();
@@ -87,7 +87,7 @@ namespace DirectUI
         BOOLEAN m_fIsFrozen : 1;
         BOOLEAN __padding : 1;
 
-        PropertyPathParser m_propertyPathParser;
+        std::shared_ptr<CompiledPropertyPath> m_spCompiledPath;
 
         friend class BindingExpression;
     };
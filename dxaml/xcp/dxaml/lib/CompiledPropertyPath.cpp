@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "precomp.h"
+#include "CompiledPropertyPath.h"
+#include <atomic>
+#include <string_view>
+#include <unordered_map>
+
+using namespace DirectUI;
+
+namespace
+{
+    // Paths built from data, e.g. with indexers, could otherwise grow the cache without ever being shared.
+    constexpr size_t c_maxCachedPaths = 1024;
+
+    constexpr size_t c_maxResolutionsPerStep = 8;
+
+    // Keyed by views of the strings owned by the values.
+    typedef std::unordered_map<std::wstring_view, std::shared_ptr<CompiledPropertyPath>> CompiledPropertyPathMap;
+
+    // Each thread compiles and caches its own paths, so that resolving a Binding never takes a lock. Bindings and their
+    // targets belong to one thread, and few apps run more than one UI thread, so little is compiled twice.
+    struct ThreadCache
+    {
+        std::unique_ptr<CompiledPropertyPathMap> m_pCompiledPaths;
+
+        // The generation the paths were compiled in.
+        XUINT32 m_generation = 0;
+    };
+
+    thread_local ThreadCache tls_cache;
+    thread_local CompiledPropertyPath::Statistics tls_statistics;
+
+    // Incremented when the cache is reset, which can happen on any thread, so that every thread drops its paths and
+    // the resolutions stored before then are ignored.
+    std::atomic<XUINT32> s_generation = 0;
+
+    XUINT32 GetGeneration()
+    {
+        return s_generation.load(std::memory_order_acquire);
+    }
+}
+
+bool
+PropertyPathStepResolutions::TryGet(
+    Lookup lookup,
+    _In_ const CClassInfo *pSourceType,
+    _Outptr_result_maybenull_ const CDependencyProperty **ppProperty) const
+{
+    *ppProperty = nullptr;
+
+    // Only the thread that compiled the path uses its resolutions.
+    if (::GetCurrentThreadId() != m_threadId)
+    {
+        return false;
+    }
+
+    ++tls_statistics.propertyLookups;
+
+    const XUINT32 generation = GetGeneration();
+
+    for (const Entry& entry : m_entries)
+    {
+        if (entry.m_pSourceType == pSourceType && entry.m_lookup == lookup && entry.m_generation == generation)
+        {
+            ++tls_statistics.propertyHits;
+            *ppProperty = entry.m_pProperty;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+PropertyPathStepResolutions::Store(
+    Lookup lookup,
+    _In_ const CClassInfo *pSourceType,
+    _In_opt_ const CDependencyProperty *pProperty)
+{
+    if (::GetCurrentThreadId() != m_threadId)
+    {
+        return;
+    }
+
+    const XUINT32 generation = GetGeneration();
+    const Entry newEntry = { pSourceType, pProperty, generation, lookup };
+
+    // Entries from before a reset can be reused.
+    for (Entry& entry : m_entries)
+    {
+        if (entry.m_generation != generation || (entry.m_pSourceType == pSourceType && entry.m_lookup == lookup))
+        {
+            entry = newEntry;
+            return;
+        }
+    }
+
+    if (m_entries.size() < c_maxResolutionsPerStep)
+    {
+        m_entries.push_back(newEntry);
+    }
+}
+
+_Check_return_
+HRESULT
+CompiledPropertyPath::GetOrCreate(
+    _In_opt_z_ const WCHAR *szPath,
+    _In_opt_ XamlServiceProviderContext *context,
+    _Out_ std::shared_ptr<CompiledPropertyPath> *pspCompiledPath)
+{
+    const std::wstring_view path = szPath ? std::wstring_view(szPath) : std::wstring_view();
+
+    // (Type.Property) steps are resolved with the namespaces of the context, and hold the resolved property, so
+    // they're only good for the Binding that was parsed with them.
+    const bool isShareable = (path.find(L'(') == std::wstring_view::npos);
+
+    pspCompiledPath->reset();
+
+    const XUINT32 generation = GetGeneration();
+    if (tls_cache.m_generation != generation)
+    {
+        tls_cache.m_pCompiledPaths.reset();
+        tls_cache.m_generation = generation;
+    }
+
+    if (isShareable)
+    {
+        ++tls_statistics.pathLookups;
+
+        if (tls_cache.m_pCompiledPaths)
+        {
+            auto itCompiledPath = tls_cache.m_pCompiledPaths->find(path);
+
+            if (itCompiledPath != tls_cache.m_pCompiledPaths->end())
+            {
+                ++tls_statistics.pathHits;
+                *pspCompiledPath = itCompiledPath->second;
+                return S_OK;
+            }
+        }
+    }
+
+    auto spCompiledPath = std::make_shared<CompiledPropertyPath>();
+    IFC_RETURN(spCompiledPath->Parse(szPath, context));
+
+    if (isShareable)
+    {
+        if (!tls_cache.m_pCompiledPaths)
+        {
+            tls_cache.m_pCompiledPaths = std::make_unique<CompiledPropertyPathMap>();
+        }
+
+        if (tls_cache.m_pCompiledPaths->size() < c_maxCachedPaths)
+        {
+            const std::wstring_view key(spCompiledPath->m_path);
+            tls_cache.m_pCompiledPaths->emplace(key, spCompiledPath);
+        }
+    }
+
+    *pspCompiledPath = std::move(spCompiledPath);
+
+    return S_OK;
+}
+
+_Check_return_
+HRESULT
+CompiledPropertyPath::Parse(
+    _In_opt_z_ const WCHAR *szPath,
+    _In_opt_ XamlServiceProviderContext *context)
+{
+    if (szPath)
+    {
+        m_path = szPath;
+    }
+
+    IFC_RETURN(m_parser.SetSource(szPath, context));
+
+    // Sized once, so the steps can hold on to their element.
+    m_stepResolutions.resize(m_parser.size());
+
+    for (PropertyPathStepResolutions& stepResolutions : m_stepResolutions)
+    {
+        stepResolutions.m_threadId = ::GetCurrentThreadId();
+    }
+
+    return S_OK;
+}
+
+void
+CompiledPropertyPath::ResetCache()
+{
+    // The other threads drop their paths the next time they look one up.
+    ++s_generation;
+    tls_cache.m_pCompiledPaths.reset();
+}
+
+const CompiledPropertyPath::Statistics&
+CompiledPropertyPath::GetStatistics()
+{
+    return tls_statistics;
+}
+
+std::shared_ptr<PropertyPathStepResolutions>
+CompiledPropertyPath::GetStepResolutions(
+    _In_ const std::shared_ptr<CompiledPropertyPath>& spCompiledPath,
+    size_t stepIndex)
+{
+    ASSERT(stepIndex < spCompiledPath->m_stepResolutions.size());
+
+    // Shares the ownership of the path.
+    return std::shared_ptr<PropertyPathStepResolutions>(spCompiledPath, &spCompiledPath->m_stepResolutions[stepIndex]);
+}
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+//  Abstract:
+//      Defines the parsed property paths shared by the Bindings that use
+//      the same path, and the properties their steps resolve to.
+
+#pragma once
+
+#include "PropertyPathParser.h"
+#include <memory>
+#include <string>
+
+class CClassInfo;
+class CDependencyProperty;
+class XamlServiceProviderContext;
+
+namespace DirectUI
+{
+    // The properties a property access step resolved its name to, for each type of source it was connected to. Shared
+    // by the steps created from the same compiled path, on the thread that compiled it.
+    class PropertyPathStepResolutions
+    {
+    public:
+        enum class Lookup : XUINT8
+        {
+            // MetadataAPI::TryGetDependencyPropertyByName, for DependencyObject sources.
+            DependencyProperty,
+
+            // PropertyInfoPropertyAccess::ResolveProperty, for sources with bindable metadata.
+            BindableProperty,
+        };
+
+        // Returns false if the lookup wasn't cached for the source type. A cached lookup can have found no property.
+        // Lookups from another thread than the one that compiled the path are never cached.
+        bool TryGet(
+            Lookup lookup,
+            _In_ const CClassInfo *pSourceType,
+            _Outptr_result_maybenull_ const CDependencyProperty **ppProperty) const;
+
+        void Store(
+            Lookup lookup,
+            _In_ const CClassInfo *pSourceType,
+            _In_opt_ const CDependencyProperty *pProperty);
+
+    private:
+        friend class CompiledPropertyPath;
+
+        struct Entry
+        {
+            const CClassInfo *m_pSourceType;
+            const CDependencyProperty *m_pProperty;
+            XUINT32 m_generation;
+            Lookup m_lookup;
+        };
+
+        // Few steps see more than a couple of source types, so this is searched linearly.
+        std::vector<Entry> m_entries;
+
+        DWORD m_threadId = 0;
+    };
+
+    // A property path parsed once and shared by every Binding with the same path, with the resolutions of each of its
+    // steps. Only paths that parse the same way in any context are shared, i.e. paths without (Type.Property) steps.
+    //
+    // Each thread has a cache of its own, so neither the cache nor the resolutions need a lock. The cache holds
+    // metadata, so it's cleared along with the runtime type caches.
+    class CompiledPropertyPath
+    {
+    public:
+        struct Statistics
+        {
+            // Paths looked up in the cache, and found there.
+            uint64_t pathLookups = 0;
+            uint64_t pathHits = 0;
+
+            // Property lookups by the steps, and those answered from the step resolutions.
+            uint64_t propertyLookups = 0;
+            uint64_t propertyHits = 0;
+        };
+
+        CompiledPropertyPath() = default;
+        CompiledPropertyPath(const CompiledPropertyPath&) = delete;
+        CompiledPropertyPath& operator=(const CompiledPropertyPath&) = delete;
+
+        // Returns the shared compiled path for the string, parsing it if it isn't cached. Paths that depend on the
+        // context get a compiled path of their own.
+        static _Check_return_ HRESULT GetOrCreate(
+            _In_opt_z_ const WCHAR *szPath,
+            _In_opt_ XamlServiceProviderContext *context,
+            _Out_ std::shared_ptr<CompiledPropertyPath> *pspCompiledPath);
+
+        // Discards the cached paths of every thread, and the resolutions of the paths still in use.
+        static void ResetCache();
+
+        // The lookups made on the calling thread.
+        static const Statistics& GetStatistics();
+
+        // The parser is immutable once compiled, and only used to create steps.
+        PropertyPathParser* GetParser() { return &m_parser; }
+
+        // Returns the resolutions of the step created from the descriptor at the given index, kept alive by the path.
+        static std::shared_ptr<PropertyPathStepResolutions> GetStepResolutions(
+            _In_ const std::shared_ptr<CompiledPropertyPath>& spCompiledPath,
+            size_t stepIndex);
+
+    private:
+        _Check_return_ HRESULT Parse(
+            _In_opt_z_ const WCHAR *szPath,
+            _In_opt_ XamlServiceProviderContext *context);
+
+        std::wstring m_path;
+        PropertyPathParser m_parser;
+        std::vector<PropertyPathStepResolutions> m_stepResolutions;
+    };
+}
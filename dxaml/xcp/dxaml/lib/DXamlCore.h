@@ -191,6 +191,7 @@ namespace DirectUI
 
         PeerTable& GetPeers() override { return m_Peers; }
         ReferenceTrackerTable& GetReferenceTrackers() override { return m_ReferenceTrackers; }
+        PendingUnpegTable& GetPendingUnpegs() override { return m_PendingUnpegs; }
         void AddToReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* pItem) override;
         void RemoveFromReferenceTrackingList(_In_ xaml_hosting::IReferenceTrackerInternal* pItem) override;
         _Check_return_ HRESULT ShutdownAllPeers() override;
@@ -773,6 +774,7 @@ namespace DirectUI
 
         PeerTable m_Peers;
         ReferenceTrackerTable m_ReferenceTrackers;
+        PendingUnpegTable m_PendingUnpegs;
 
         // map of IWeakReference of IFrameworkElements. IFrameworkElement key is used as handle and should never be deref'ed.
         containers::vector_map<HANDLE, ctl::WeakRefPtr> m_LayoutUpdatedEventSources;
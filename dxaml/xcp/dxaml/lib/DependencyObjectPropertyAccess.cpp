@@ -44,42 +44,6 @@ DependencyObjectPropertyAccess::Initialize(
 #endif
 }
 
-_Check_return_
-HRESULT
-DependencyObjectPropertyAccess::CreateInstance(
-    _In_ IPropertyAccessHost *pOwner,
-    _In_ IInspectable *pInspSource,
-    _In_ const CClassInfo *pSourceType,
-    _In_ bool fListenToChanges,
-    _Outptr_ PropertyAccess **ppPropertyAccess)
-{
-    HRESULT hr = S_OK;
-    ctl::ComPtr<DependencyObject> spSource;
-    const CDependencyProperty* pProperty = nullptr;
-
-    // By default there's no property access
-    *ppPropertyAccess = NULL;
-
-    // First resolve the property
-    IFC(GetSource(pInspSource, spSource.ReleaseAndGetAddressOf()));
-    if (spSource != NULL)
-    {
-        IFC(ResolvePropertyName(spSource.Get(), pSourceType, pOwner->GetPropertyName(), &pProperty));
-    }
-
-    // If we didn't find the property then we're done
-    if (!pProperty)
-    {
-        goto Cleanup;
-    }
-
-    IFC(CreateInstance(pOwner, pInspSource, pSourceType, pProperty, fListenToChanges, ppPropertyAccess));
-
-Cleanup:
-
-    RRETURN(hr);
-}
-
 _Check_return_
 HRESULT
 DependencyObjectPropertyAccess::CreateInstance(
@@ -368,24 +332,3 @@ Cleanup:
 
     RRETURN(hr);
 }
-
-_Check_return_ HRESULT
-DependencyObjectPropertyAccess::ResolvePropertyName(
-    _In_ DependencyObject *pSource,
-    _In_ const CClassInfo* pSourceType,
-    _In_z_ WCHAR *szPropertyName,
-    _Outptr_ const CDependencyProperty** ppDP)
-{
-    HRESULT hr = S_OK;
-
-    IFC(MetadataAPI::TryGetDependencyPropertyByName(
-        pSourceType,
-        XSTRING_PTR_EPHEMERAL2(
-            szPropertyName,
-            xstrlen(szPropertyName)),
-        ppDP));
-
-Cleanup:
-    RRETURN(hr);
-}
-
@@ -83,13 +83,6 @@ public:
 
 public:
     
-    static _Check_return_ HRESULT CreateInstance(
-        _In_ IPropertyAccessHost *pOwner, 
-        _In_ IInspectable *pSource, 
-        _In_ const CClassInfo* pSourceType,
-        _In_ bool fListenToChanges,
-        _Outptr_ PropertyAccess **ppPropertyAccess);
-
     static _Check_return_ HRESULT CreateInstance(
         _In_ IPropertyAccessHost *pOwner, 
         _In_ IInspectable *pSource, 
@@ -126,12 +119,6 @@ private:
     // This method is safe to be called from the destructor path
     _Check_return_ HRESULT SafeGetSource(_Outptr_ DependencyObject **ppSource);
 
-    static _Check_return_ HRESULT ResolvePropertyName(
-        _In_ DependencyObject *pSource, 
-        _In_ const CClassInfo *pSourceType,
-        _In_z_ WCHAR *szPropertyName, 
-        _Outptr_ const CDependencyProperty** ppDP);
-
     _Check_return_ HRESULT PropertyAccessPathStepDPChanged(_In_ const CDependencyProperty* pDP);
 
 
@@ -19,6 +19,7 @@
 #include "XamlOptionalChanges.g.h"
 #include <Storyboard.h>
 #include "DefaultStyles.h"
+#include "CompiledPropertyPath.h"
 #include <FocusMgr.h>
 #include <DragDropInternal.h>
 #include "InternalDebugInteropModel.h"
@@ -708,6 +709,7 @@ IFACEMETHODIMP DxamlCoreTestHooks::GetGripperData(_In_ IInspectable* textControl
 IFACEMETHODIMP DxamlCoreTestHooks::ResetMetadata()
 {
     DXamlCore::GetCurrent()->GetDefaultStyles()->GetStyleCache()->Clear();
+    CompiledPropertyPath::ResetCache();
     MetadataAPI::Reset();
     IFC_RETURN(DXamlCore::GetCurrent()->GetHandle()->RefreshXamlSchemaContext());
 
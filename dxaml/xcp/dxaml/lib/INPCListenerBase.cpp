@@ -12,12 +12,365 @@ using namespace DirectUISynonyms;
 using namespace xaml_data;
 using namespace xaml_markup;
 
+thread_local std::unordered_map<IUnknown*, INPCDispatcher*> INPCDispatcher::tls_dispatchers;
+thread_local INPCDispatcher::Statistics INPCDispatcher::tls_statistics;
+
+INPCDispatcher::INPCDispatcher()
+    : m_pSourceIdentityNoRef(nullptr)
+    , m_threadId(::GetCurrentThreadId())
+    , m_listenerCount(0)
+    , m_dispatchDepth(0)
+    , m_hasRemovedListeners(false)
+{ }
+
+INPCDispatcher::~INPCDispatcher()
+{
+    ASSERT(m_listenerCount == 0 && m_dispatchDepth == 0);
+    ASSERT(m_pSourceIdentityNoRef == nullptr);
+}
+
+_Check_return_
+HRESULT
+INPCDispatcher::AddListener(
+    _In_ xaml_data::INotifyPropertyChanged *pSource,
+    _In_ INPCListenerBase *pListener)
+{
+    ASSERT(pListener->m_pDispatcher == nullptr);
+
+    const wchar_t* pszPropertyName = pListener->GetPropertyName();
+    IFCEXPECT_RETURN(pszPropertyName != nullptr);
+
+    ctl::ComPtr<IUnknown> spIdentity;
+    IFC_RETURN(pSource->QueryInterface(IID_PPV_ARGS(&spIdentity)));
+
+    INPCDispatcher* pDispatcher = nullptr;
+
+    auto itDispatcher = tls_dispatchers.find(spIdentity.Get());
+    if (itDispatcher != tls_dispatchers.end())
+    {
+        // A source that's gone may have been replaced by a new one at the same address.
+        if (itDispatcher->second->m_wrSource.AsOrNull<IInspectable>())
+        {
+            pDispatcher = itDispatcher->second;
+        }
+        else
+        {
+            itDispatcher->second->Unregister();
+        }
+    }
+
+    if (pDispatcher == nullptr)
+    {
+        INPCDispatcher* pNewDispatcher = new INPCDispatcher();
+        auto deleteGuard = wil::scope_exit([pNewDispatcher]
+        {
+            delete pNewDispatcher;
+        });
+
+        IFC_RETURN(pNewDispatcher->Attach(pSource));
+        IGNOREHR(ctl::AsWeakOrNull(pSource, &pNewDispatcher->m_wrSource));
+
+        if (pNewDispatcher->m_wrSource)
+        {
+            tls_dispatchers.emplace(spIdentity.Get(), pNewDispatcher);
+            pNewDispatcher->m_pSourceIdentityNoRef = spIdentity.Get();
+        }
+
+        deleteGuard.release();
+        pDispatcher = pNewDispatcher;
+    }
+
+    pDispatcher->Add(pListener, pszPropertyName);
+
+    return S_OK;
+}
+
+void
+INPCDispatcher::RemoveListener(
+    _In_ INPCListenerBase *pListener,
+    _In_opt_ IInspectable *pSource)
+{
+    if (pListener->m_pDispatcher)
+    {
+        pListener->m_pDispatcher->Remove(pListener, pSource);
+    }
+}
+
+_Check_return_
+HRESULT
+INPCDispatcher::Attach(_In_ xaml_data::INotifyPropertyChanged *pSource)
+{
+    IFC_RETURN(m_epPropertyChangedHandler.AttachEventHandler(pSource,
+        [this](IInspectable*, xaml_data::IPropertyChangedEventArgs *pArgs)
+        {
+            return OnPropertyChanged(pArgs);
+        }));
+
+    return S_OK;
+}
+
+void
+INPCDispatcher::Add(_In_ INPCListenerBase *pListener, _In_z_ const wchar_t *pszPropertyName)
+{
+    auto itPropertyListeners = m_listenersByName.find(std::wstring_view(pszPropertyName));
+
+    if (itPropertyListeners == m_listenersByName.end())
+    {
+        auto spPropertyListeners = std::make_unique<PropertyListeners>();
+        spPropertyListeners->m_propertyName = pszPropertyName;
+
+        const std::wstring_view name(spPropertyListeners->m_propertyName);
+        auto lock = m_listenersByNameLock.lock_exclusive();
+        itPropertyListeners = m_listenersByName.emplace(name, std::move(spPropertyListeners)).first;
+    }
+
+    PropertyListeners* pPropertyListeners = itPropertyListeners->second.get();
+    pPropertyListeners->m_listeners.push_back(pListener);
+    m_listeners.push_back(pListener);
+    ++m_listenerCount;
+
+    pListener->m_pDispatcher = this;
+    pListener->m_pPropertyListeners = pPropertyListeners;
+    pListener->m_subscriptionIndex = m_listeners.size() - 1;
+}
+
+void
+INPCDispatcher::Remove(_In_ INPCListenerBase *pListener, _In_opt_ IInspectable *pSource)
+{
+    std::vector<INPCListenerBase*>& listeners = pListener->m_pPropertyListeners->m_listeners;
+    auto itListener = std::find(listeners.begin(), listeners.end(), pListener);
+    ASSERT(itListener != listeners.end());
+
+    // The subscription order is only compacted once enough listeners are gone, so that removing all of them doesn't
+    // shift the rest each time.
+    ASSERT(m_listeners[pListener->m_subscriptionIndex] == pListener);
+    m_listeners[pListener->m_subscriptionIndex] = nullptr;
+
+    // Listeners notified during a dispatch can remove any other, so leave the lists as they are until it completes.
+    if (m_dispatchDepth > 0)
+    {
+        *itListener = nullptr;
+        m_hasRemovedListeners = true;
+    }
+    else
+    {
+        listeners.erase(itListener);
+
+        if (listeners.empty())
+        {
+            auto lock = m_listenersByNameLock.lock_exclusive();
+            m_listenersByName.erase(std::wstring_view(pListener->m_pPropertyListeners->m_propertyName));
+        }
+    }
+
+    pListener->m_pDispatcher = nullptr;
+    pListener->m_pPropertyListeners = nullptr;
+    --m_listenerCount;
+
+    if (m_dispatchDepth == 0 && m_listeners.size() > 2 * m_listenerCount)
+    {
+        CompactSubscriptions();
+    }
+
+    if (m_listenerCount == 0)
+    {
+        ctl::ComPtr<IInspectable> spSource(pSource);
+        if (!spSource)
+        {
+            spSource = m_wrSource.AsOrNull<IInspectable>();
+        }
+
+        // Without the source, all we can do is neuter the handler, which the destructor does.
+        if (spSource)
+        {
+            IGNOREHR(m_epPropertyChangedHandler.DetachEventHandler(spSource.Get()));
+        }
+
+        Unregister();
+        DeleteIfUnused();
+    }
+}
+
+//------------------------------------------------------------------------
+//
+//  Synopsis:
+//      Notifies the listeners of the property that changed, or all of
+//      them if the property name is empty.
+//
+//------------------------------------------------------------------------
+_Check_return_
+HRESULT
+INPCDispatcher::OnPropertyChanged(_In_ xaml_data::IPropertyChangedEventArgs *pArgs)
+{
+    wrl_wrappers::HString strProperty;
+    IFC_RETURN(pArgs->get_PropertyName(strProperty.GetAddressOf()));
+
+    // Sources can raise PropertyChanged from any thread, but bindings can't update their target from another one.
+    // Only changes that some listener wants fail there, as they did when each listener compared the name itself.
+    if (::GetCurrentThreadId() != m_threadId)
+    {
+        auto lock = m_listenersByNameLock.lock_shared();
+        bool hasListeners = !m_listenersByName.empty();
+
+        if (hasListeners && strProperty.Get() != nullptr)
+        {
+            UINT32 length = 0;
+            const wchar_t* buffer = strProperty.GetRawBuffer(&length);
+            hasListeners = m_listenersByName.find(std::wstring_view(buffer, length)) != m_listenersByName.end();
+        }
+
+        return hasListeners ? RPC_E_WRONG_THREAD : S_OK;
+    }
+
+    ++tls_statistics.eventsRaised;
+
+    // Listeners added during the dispatch aren't notified, and removed ones are skipped, as with separate handlers.
+    // This dispatcher stays alive until the dispatch completes, even if the last listener is removed.
+    ++m_dispatchDepth;
+    auto dispatchGuard = wil::scope_exit([this]
+    {
+        if (--m_dispatchDepth == 0)
+        {
+            Compact();
+            DeleteIfUnused();
+        }
+    });
+
+    if (strProperty.Get() != nullptr)
+    {
+        UINT32 length = 0;
+        const wchar_t* buffer = strProperty.GetRawBuffer(&length);
+
+        auto itPropertyListeners = m_listenersByName.find(std::wstring_view(buffer, length));
+        if (itPropertyListeners != m_listenersByName.end())
+        {
+            std::vector<INPCListenerBase*>& listeners = itPropertyListeners->second->m_listeners;
+            IFC_RETURN(NotifyListeners(listeners, listeners.size()));
+        }
+    }
+    else
+    {
+        // If the property name is NULL, which means empty, then every listener wants the change, in the order they
+        // subscribed.
+        IFC_RETURN(NotifyListeners(m_listeners, m_listeners.size()));
+    }
+
+    return S_OK;
+}
+
+// Notifies the first count listeners, and returns the first failure once all of them have been notified, so that a
+// listener that fails doesn't leave the ones after it out of date.
+_Check_return_
+HRESULT
+INPCDispatcher::NotifyListeners(_In_ const std::vector<INPCListenerBase*>& listeners, size_t count)
+{
+    HRESULT hrFirstFailure = S_OK;
+
+    // Index into the list, as listeners added during the dispatch can grow it.
+    for (size_t i = 0; i < count; ++i)
+    {
+        INPCListenerBase* pListener = listeners[i];
+
+        if (pListener)
+        {
+            ++tls_statistics.listenersNotified;
+
+            const HRESULT hr = pListener->OnPropertyChangedCallback();
+            if (FAILED(hr) && SUCCEEDED(hrFirstFailure))
+            {
+                hrFirstFailure = hr;
+            }
+        }
+    }
+
+    return hrFirstFailure;
+}
+
+// Drops the listeners removed from the subscription order, and renumbers the others.
+void
+INPCDispatcher::CompactSubscriptions()
+{
+    size_t count = 0;
+
+    for (INPCListenerBase* pListener : m_listeners)
+    {
+        if (pListener)
+        {
+            pListener->m_subscriptionIndex = count;
+            m_listeners[count++] = pListener;
+        }
+    }
+
+    m_listeners.resize(count);
+}
+
+// Drops the listeners removed during a dispatch, and the properties left without listeners.
+void
+INPCDispatcher::Compact()
+{
+    if (!m_hasRemovedListeners)
+    {
+        return;
+    }
+
+    CompactSubscriptions();
+
+    for (auto itPropertyListeners = m_listenersByName.begin(); itPropertyListeners != m_listenersByName.end();)
+    {
+        std::vector<INPCListenerBase*>& listeners = itPropertyListeners->second->m_listeners;
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), nullptr), listeners.end());
+
+        if (listeners.empty())
+        {
+            auto lock = m_listenersByNameLock.lock_exclusive();
+            itPropertyListeners = m_listenersByName.erase(itPropertyListeners);
+        }
+        else
+        {
+            ++itPropertyListeners;
+        }
+    }
+
+    m_hasRemovedListeners = false;
+}
+
+// Stops sharing this dispatcher, so new listeners of its source get a new one.
+void
+INPCDispatcher::Unregister()
+{
+    if (m_pSourceIdentityNoRef)
+    {
+        auto itDispatcher = tls_dispatchers.find(m_pSourceIdentityNoRef);
+        if (itDispatcher != tls_dispatchers.end() && itDispatcher->second == this)
+        {
+            tls_dispatchers.erase(itDispatcher);
+        }
+
+        m_pSourceIdentityNoRef = nullptr;
+    }
+}
+
+void
+INPCDispatcher::DeleteIfUnused()
+{
+    if (m_listenerCount == 0 && m_dispatchDepth == 0)
+    {
+        delete this;
+    }
+}
+
 INPCListenerBase::INPCListenerBase()
-    : m_propertyNameLength(0)
+    : m_pDispatcher(nullptr)
+    , m_pPropertyListeners(nullptr)
+    , m_subscriptionIndex(0)
 { }
 
 INPCListenerBase::~INPCListenerBase()
-{ }
+{
+    // Derived classes disconnect while they can still provide the source, but make sure no dispatcher is left
+    // pointing at this listener.
+    INPCDispatcher::RemoveListener(this, nullptr);
+}
 
 _Check_return_
 HRESULT
@@ -25,7 +378,7 @@ INPCListenerBase::AddPropertyChangedHandler(_In_ IInspectable *pSource)
 {
     HRESULT hr = S_OK;
 
-    IFCEXPECT(!m_epPropertyChangedHandler);
+    IFCEXPECT(!m_pDispatcher);
 
     IFC(UpdatePropertyChangedHandler(NULL, pSource));
 
@@ -43,22 +396,15 @@ INPCListenerBase::UpdatePropertyChangedHandler(_In_opt_ IInspectable *pOldSource
 
     const wchar_t* buffer = this->GetPropertyName();
     IFCEXPECT(buffer != nullptr);
-    m_propertyNameLength = wcslen(buffer);
 
-    if (pOldSource)
-    {
-        IFC(DisconnectPropertyChangedHandler(pOldSource));
-    }
+    // A listener listens to one source at a time.
+    INPCDispatcher::RemoveListener(this, pOldSource);
 
     if (pNewSource)
     {
         if ((spINPC = ctl::query_interface_cast<xaml_data::INotifyPropertyChanged>(pNewSource)))
         {
-            IFC(m_epPropertyChangedHandler.AttachEventHandler(spINPC.Get(),
-                [this](IInspectable*, xaml_data::IPropertyChangedEventArgs *pArgs)
-                {
-                    return OnPropertyChangedCallback(pArgs);
-                }));
+            IFC(INPCDispatcher::AddListener(spINPC.Get(), this));
         }
     }
 
@@ -71,69 +417,37 @@ _Check_return_
 HRESULT
 INPCListenerBase::DisconnectPropertyChangedHandler(_In_ IInspectable *pSource)
 {
-    HRESULT hr = S_OK;
+    INPCDispatcher::RemoveListener(this, pSource);
 
-    if (m_epPropertyChangedHandler)
-    {
-        IFC(m_epPropertyChangedHandler.DetachEventHandler(pSource));
-    }
-
-Cleanup:
-
-    RRETURN(hr);
+    RRETURN(S_OK);
 }
 
+// Called by the dispatcher when the property this listener listens to changes.
 _Check_return_
 HRESULT
-INPCListenerBase::OnPropertyChangedCallback(_In_ xaml_data::IPropertyChangedEventArgs *pArgs)
+INPCListenerBase::OnPropertyChangedCallback()
 {
-    HRESULT hr = S_OK;
-    BOOLEAN propertyChanged = FALSE;
-    wrl_wrappers::HString strProperty;
-
-    IFC(pArgs->get_PropertyName(strProperty.GetAddressOf()));
-
-    // If it is not then we need to compare the string vs. the string in the listener to see if the
-    // change affects the listener
-    if (strProperty.Get() != NULL)
-    {
-        UINT32 length = 0;
-        const wchar_t* buffer = this->GetPropertyName();
-        const wchar_t* current = strProperty.GetRawBuffer(&length);
-        propertyChanged = (length == m_propertyNameLength) && (wcsncmp(current, buffer, length) == 0);
-    }
-    else
-    {
-        // If the property name is NULL, which means empty, then we want the change
-        propertyChanged = TRUE;
-    }
+#ifdef TRACE_BINDINGS
+    TraceLoggingProviderWrite(
+        XamlTelemetry, "Binding - INPCListenerBase::OnPropertyChangedCallback",
+        TraceLoggingUInt64(reinterpret_cast<uint64_t>(this), "Listener Pointer"),
+        TraceLoggingWideString(this->GetPropertyName(), "PropertyName"),
+        TraceLoggingBoolean(true, "IsStart"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
 
-    // Notify the class if the property we're listening to changed
-    if (propertyChanged)
+    auto endEvent = wil::scope_exit([this]
     {
-#ifdef TRACE_BINDINGS
         TraceLoggingProviderWrite(
             XamlTelemetry, "Binding - INPCListenerBase::OnPropertyChangedCallback",
             TraceLoggingUInt64(reinterpret_cast<uint64_t>(this), "Listener Pointer"),
-            TraceLoggingWideString(this->GetPropertyName(), "PropertyName"),
-            TraceLoggingBoolean(true, "IsStart"),
+            TraceLoggingBoolean(false, "IsStart"),
             TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
-
-        auto endEvent = wil::scope_exit([this]
-        {
-            TraceLoggingProviderWrite(
-                XamlTelemetry, "Binding - INPCListenerBase::OnPropertyChangedCallback",
-                TraceLoggingUInt64(reinterpret_cast<uint64_t>(this), "Listener Pointer"),
-                TraceLoggingBoolean(false, "IsStart"),
-                TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
-        });
+    });
 #endif
 
-        IFC(OnPropertyChanged());
-    }
+    IFC_RETURN(OnPropertyChanged());
 
-Cleanup:
-    RRETURN(hr);
+    return S_OK;
 }
 
 
@@ -7,8 +7,95 @@
 
 #pragma once
 
+#include <string_view>
+
 namespace DirectUI
 {
+    class INPCListenerBase;
+
+    // Listens to the PropertyChanged event of a source on behalf of all the listeners of that source on the thread,
+    // and notifies only the listeners of the property that changed, so a change costs one delegate invocation and one
+    // hash lookup however many bindings share the source.
+    //
+    // Dispatchers are shared by source identity. The registry doesn't keep sources alive, so sources that don't support
+    // weak references, which could be replaced by a new object at the same address, get a dispatcher of their own.
+    class INPCDispatcher
+    {
+    public:
+        struct Statistics
+        {
+            // PropertyChanged events received from the sources.
+            uint64_t eventsRaised = 0;
+
+            // Listeners notified of those events.
+            uint64_t listenersNotified = 0;
+        };
+
+        static _Check_return_ HRESULT AddListener(
+            _In_ xaml_data::INotifyPropertyChanged *pSource,
+            _In_ INPCListenerBase *pListener);
+
+        // Removes the listener from its dispatcher, which detaches from the source once it has no listener left. The
+        // source is resolved from a weak reference if it isn't given, and left alone if it's gone.
+        static void RemoveListener(
+            _In_ INPCListenerBase *pListener,
+            _In_opt_ IInspectable *pSource);
+
+        // The events dispatched on the calling thread.
+        static const Statistics& GetStatistics() { return tls_statistics; }
+
+    private:
+        friend class INPCListenerBase;
+
+        struct PropertyListeners
+        {
+            std::wstring m_propertyName;
+
+            // In the order they were added. Listeners removed during a dispatch are set to null, and compacted
+            // once the dispatch completes.
+            std::vector<INPCListenerBase*> m_listeners;
+        };
+
+        INPCDispatcher();
+        ~INPCDispatcher();
+
+        _Check_return_ HRESULT Attach(_In_ xaml_data::INotifyPropertyChanged *pSource);
+        void Add(_In_ INPCListenerBase *pListener, _In_z_ const wchar_t *pszPropertyName);
+        void Remove(_In_ INPCListenerBase *pListener, _In_opt_ IInspectable *pSource);
+
+        _Check_return_ HRESULT OnPropertyChanged(_In_ xaml_data::IPropertyChangedEventArgs *pArgs);
+        _Check_return_ HRESULT NotifyListeners(_In_ const std::vector<INPCListenerBase*>& listeners, size_t count);
+
+        void CompactSubscriptions();
+        void Compact();
+        void Unregister();
+        void DeleteIfUnused();
+
+    private:
+
+        ctl::EventPtr<PropertyChangedEventCallback> m_epPropertyChangedHandler;
+        ctl::WeakRefPtr m_wrSource;
+
+        // The key of this dispatcher in the registry, or null if it isn't shared.
+        IUnknown *m_pSourceIdentityNoRef;
+        DWORD m_threadId;
+
+        // Every listener, in the order they were added, for changes to all properties. Removed listeners are set to
+        // null, and compacted once a dispatch completes or once they make up half of the list.
+        std::vector<INPCListenerBase*> m_listeners;
+
+        // The same listeners indexed by property name, keyed by views of the names owned by the values. Only this
+        // thread changes the names, under the lock, so that events raised on other threads can look them up.
+        std::unordered_map<std::wstring_view, std::unique_ptr<PropertyListeners>> m_listenersByName;
+        wil::srwlock m_listenersByNameLock;
+        size_t m_listenerCount;
+        UINT32 m_dispatchDepth;
+        bool m_hasRemovedListeners;
+
+        static thread_local std::unordered_map<IUnknown*, INPCDispatcher*> tls_dispatchers;
+        static thread_local Statistics tls_statistics;
+    };
+
     class INPCListenerBase
     {
     protected:
@@ -25,12 +112,17 @@ namespace DirectUI
 
     private:
 
-        _Check_return_ HRESULT OnPropertyChangedCallback(_In_ xaml_data::IPropertyChangedEventArgs *pArgs);
+        _Check_return_ HRESULT OnPropertyChangedCallback();
 
-    private:    
+    private:
 
-        ctl::EventPtr<PropertyChangedEventCallback> m_epPropertyChangedHandler;
-        UINT32 m_propertyNameLength;
+        friend class INPCDispatcher;
+
+        // The dispatcher of the source this listener is attached to, its listeners for the same property, and the
+        // position of this listener in its subscription order.
+        INPCDispatcher* m_pDispatcher;
+        INPCDispatcher::PropertyListeners* m_pPropertyListeners;
+        size_t m_subscriptionIndex;
     };
         
 
@@ -257,6 +257,38 @@ _Check_return_ HRESULT ItemsStackPanel::GetAverageContainerSize(_Out_ float* ave
     return S_OK;
 }
 
+_Check_return_ HRESULT ItemsStackPanel::OnLayoutElementsChanged(
+    _In_ wfc::CollectionChange action,
+    _In_ xaml_controls::ElementType elementType,
+    _In_ INT layoutIndex) /*override*/
+{
+    ctl::ComPtr<xaml_controls::ILayoutStrategy> stackingLayoutStrategy;
+
+    IFC_RETURN(GetLayoutStrategy(&stackingLayoutStrategy));
+
+    StackingLayoutStrategy* stacking = stackingLayoutStrategy.Cast<StackingLayoutStrategy>();
+
+    switch (action)
+    {
+    case wfc::CollectionChange_ItemInserted:
+        stacking->OnElementInserted(elementType, layoutIndex);
+        break;
+
+    case wfc::CollectionChange_ItemRemoved:
+        stacking->OnElementRemoved(elementType, layoutIndex);
+        break;
+
+    case wfc::CollectionChange_Reset:
+        stacking->OnElementsReset();
+        break;
+
+    default:
+        break;
+    }
+
+    return S_OK;
+}
+
 // Logical Orientation override
 _Check_return_ HRESULT ItemsStackPanel::get_LogicalOrientation(
     _Out_ xaml_controls::Orientation* pValue) 
@@ -42,6 +42,12 @@ namespace DirectUI
         _Check_return_ HRESULT GetAverageHeaderSize(_Out_ float* averageHeaderSize) override;
         _Check_return_ HRESULT GetAverageContainerSize(_Out_ float* averageContainerSize) override;
 
+        // Keeps the layout strategy's measured extents in step with the collection.
+        _Check_return_ HRESULT OnLayoutElementsChanged(
+            _In_ wfc::CollectionChange action,
+            _In_ xaml_controls::ElementType elementType,
+            _In_ INT layoutIndex) override;
+
     public:
         // implementation of IOrientedPanel
         _Check_return_ IFACEMETHOD(get_LogicalOrientation)(_Out_ xaml_controls::Orientation* pValue) override;
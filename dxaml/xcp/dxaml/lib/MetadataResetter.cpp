@@ -3,10 +3,13 @@
 
 #include "precomp.h"
 #include <MetadataResetter.h>
+#include "CompiledPropertyPath.h"
 
 using namespace DirectUI;
 
 MetadataResetter::~MetadataResetter()
 {
+    // The compiled property paths hold on to the properties they resolved.
+    CompiledPropertyPath::ResetCache();
     MetadataAPI::Reset();
 }
@@ -1323,6 +1323,7 @@ Cleanup:
 _Check_return_ HRESULT ModernCollectionBasePanel::OnItemAdded(_In_ INT nIndex)
 {
     HRESULT hr = S_OK;
+    const bool isIndexOutOfRange = m_cacheManager.GetTotalItemCount() < nIndex;
 
 #ifdef MCBP_DEBUG
     WCHAR szTrace[256];
@@ -1334,7 +1335,7 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnItemAdded(_In_ INT nIndex)
     // 5/7/2015. VoiceRecorder app actually gives us the wrong indices when raising events. We do not want to RI
     // a change that will break them, but are working with them to fix their code. A very scoped change to understand
     // their scenario and regress to the old reset code path.
-    if (m_cacheManager.GetTotalItemCount() < nIndex)
+    if (isIndexOutOfRange)
     {
 #ifdef MCBP_DEBUG
         WCHAR szTrace[256];
@@ -1379,6 +1380,12 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnItemAdded(_In_ INT nIndex)
             }
         }
 
+        // with a wrong index we can't tell where the item went, the layout strategy will start over
+        if (!isIndexOutOfRange)
+        {
+            IFC(OnLayoutElementsChanged(wfc::CollectionChange_ItemInserted, xaml_controls::ElementType_ItemContainer, nIndex));
+        }
+
         IFC(BeginTrackingOnCollectionChange(false /* isGroupChange */, nIndex, wfc::CollectionChange_ItemInserted));
 
         // while indexes are still correct, let the pinned containers know
@@ -1457,6 +1464,8 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnItemRemoved(INT nIndex, bool
         auto strongCache = m_cacheManager.CacheStrongRefs(&hr); // Releases when it goes out of scope at the end of method
         IFC(hr);
 
+        IFC(OnLayoutElementsChanged(wfc::CollectionChange_ItemRemoved, xaml_controls::ElementType_ItemContainer, nIndex));
+
         IFC(BeginTrackingOnCollectionChange(false /* isGroupChange */, nIndex, wfc::CollectionChange_ItemRemoved));
 
         // get the container from the pinned collection
@@ -1674,6 +1683,13 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnGroupAdded(_In_ INT nIndex)
         auto strongCache = m_cacheManager.CacheStrongRefs(&hr);
         IFC(hr);
 
+        // When empty groups are hidden, a group only gets a layout index once it has items, which we
+        // are not told about, so the layout strategy catches up on the next measure instead.
+        if (!m_cacheManager.GetHidesIfEmpty())
+        {
+            IFC(OnLayoutElementsChanged(wfc::CollectionChange_ItemInserted, xaml_controls::ElementType_GroupHeader, nIndex));
+        }
+
         IFC(BeginTrackingOnCollectionChange(true /* isGroupChange */, nIndex, wfc::CollectionChange_ItemInserted));
 
         // while indexes are still correct, let the pinned containers know
@@ -1755,6 +1771,11 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnGroupRemoved(_In_ INT nIndex
         auto strongCache = m_cacheManager.CacheStrongRefs(&hr); // Releases when it goes out of scope at the end of method
         IFC(hr);
 
+        if (!m_cacheManager.GetHidesIfEmpty())
+        {
+            IFC(OnLayoutElementsChanged(wfc::CollectionChange_ItemRemoved, xaml_controls::ElementType_GroupHeader, nIndex));
+        }
+
         IFC(BeginTrackingOnCollectionChange(true /* isGroupChange */, nIndex, wfc::CollectionChange_ItemRemoved));
 
         // get the container from the pinned collection
@@ -2066,6 +2087,8 @@ _Check_return_ HRESULT ModernCollectionBasePanel::OnCollectionReset()
         TraceGuardFailure(L"ResetDuringLayout");
     }
 
+    IFC(OnLayoutElementsChanged(wfc::CollectionChange_Reset, xaml_controls::ElementType_ItemContainer, -1 /* layoutIndex */));
+
     // logic during refresh:
     // 1. store items from pinnedcontainers and first visible container
     // 2. iterate over them and ask for new indices
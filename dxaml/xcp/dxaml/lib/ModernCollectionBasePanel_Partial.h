@@ -268,6 +268,18 @@ namespace DirectUI
         // Our implementation does not do anything here, just for the inheritors.
         virtual _Check_return_ HRESULT OnCollectionChangeProcessed() { return S_OK; }
 
+        // called as items and group headers are inserted or removed, with their layout index,
+        // and on resets. Lets inheritors keep per-element layout state in step with the collection.
+        // Our implementation does not do anything here, just for the inheritors.
+        virtual _Check_return_ HRESULT OnLayoutElementsChanged(
+            _In_ wfc::CollectionChange action,
+            _In_ xaml_controls::ElementType elementType,
+            _In_ INT layoutIndex)
+        {
+            UNREFERENCED_PARAMETER(action); UNREFERENCED_PARAMETER(elementType); UNREFERENCED_PARAMETER(layoutIndex);
+            return S_OK;
+        }
+
         //
         // Special items overrides
         //
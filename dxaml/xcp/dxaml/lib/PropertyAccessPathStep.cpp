@@ -402,7 +402,13 @@ PropertyAccessPathStep::ConnectPropertyAccessForObject(
             }
             else
             {
-                IFC(DependencyObjectPropertyAccess::CreateInstance(this, spSourceForDP.Get(), pSourceType, fListenToChanges, &spResult));
+                const CDependencyProperty* pDP = nullptr;
+
+                IFC(ResolveDependencyProperty(pSourceType, &pDP));
+                if (pDP)
+                {
+                    IFC(DependencyObjectPropertyAccess::CreateInstance(this, spSourceForDP.Get(), pSourceType, pDP, fListenToChanges, &spResult));
+                }
             }
         }
     }
@@ -418,7 +424,13 @@ PropertyAccessPathStep::ConnectPropertyAccessForObject(
             }
             else
             {
-                IFC(DependencyObjectPropertyAccess::CreateInstance(this, spSourceForDP.Get(), pSourceType, fListenToChanges, &spResult));
+                const CDependencyProperty* pDP = nullptr;
+
+                IFC(ResolveDependencyProperty(pSourceType, &pDP));
+                if (pDP)
+                {
+                    IFC(DependencyObjectPropertyAccess::CreateInstance(this, spSourceForDP.Get(), pSourceType, pDP, fListenToChanges, &spResult));
+                }
             }
         }
     }
@@ -427,8 +439,14 @@ PropertyAccessPathStep::ConnectPropertyAccessForObject(
     // keep looking
     if (!spResult && !m_pDP)
     {
+        const CDependencyProperty* pProperty = nullptr;
+
         // First try to acquire a property access through application metadata
-        IFC(PropertyInfoPropertyAccess::CreateInstance(this, spInsp.Get(), pSourceType, fListenToChanges, &spResult));
+        IFC(ResolveBindableProperty(pSourceType, &pProperty));
+        if (pProperty)
+        {
+            IFC(PropertyInfoPropertyAccess::CreateInstance(this, spInsp.Get(), pSourceType, pProperty, fListenToChanges, &spResult));
+        }
 
         // If the metadata doesn't contain information about this property then try
         // the object itself for metadata
@@ -480,6 +498,51 @@ Cleanup:
     RRETURN(hr);
 }
 
+_Check_return_
+HRESULT
+PropertyAccessPathStep::ResolveDependencyProperty(
+    _In_ const CClassInfo *pSourceType,
+    _Outptr_result_maybenull_ const CDependencyProperty **ppDP)
+{
+    if (m_spResolutions && m_spResolutions->TryGet(PropertyPathStepResolutions::Lookup::DependencyProperty, pSourceType, ppDP))
+    {
+        return S_OK;
+    }
+
+    IFC_RETURN(MetadataAPI::TryGetDependencyPropertyByName(
+        pSourceType,
+        XSTRING_PTR_EPHEMERAL2(m_szProperty, xstrlen(m_szProperty)),
+        ppDP));
+
+    if (m_spResolutions)
+    {
+        m_spResolutions->Store(PropertyPathStepResolutions::Lookup::DependencyProperty, pSourceType, *ppDP);
+    }
+
+    return S_OK;
+}
+
+_Check_return_
+HRESULT
+PropertyAccessPathStep::ResolveBindableProperty(
+    _In_ const CClassInfo *pSourceType,
+    _Outptr_result_maybenull_ const CDependencyProperty **ppProperty)
+{
+    if (m_spResolutions && m_spResolutions->TryGet(PropertyPathStepResolutions::Lookup::BindableProperty, pSourceType, ppProperty))
+    {
+        return S_OK;
+    }
+
+    IFC_RETURN(PropertyInfoPropertyAccess::ResolveProperty(pSourceType, m_szProperty, ppProperty));
+
+    if (m_spResolutions)
+    {
+        m_spResolutions->Store(PropertyPathStepResolutions::Lookup::BindableProperty, pSourceType, *ppProperty);
+    }
+
+    return S_OK;
+}
+
 void PropertyAccessPathStep::TraceConnectionError(_In_ IInspectable *pSource)
 {
     HRESULT hr = S_OK;
@@ -629,10 +692,7 @@ PropertyAccessPathStep::InlineDOConnect(
         IFC_RETURN(ResolveDependencyObject(pSource, &spSource));
         if (spSource)
         {
-            IFC_RETURN(MetadataAPI::TryGetDependencyPropertyByName(
-                pSourceType,
-                XSTRING_PTR_EPHEMERAL2(m_szProperty, xstrlen(m_szProperty)),
-                &pDP));
+            IFC_RETURN(ResolveDependencyProperty(pSourceType, &pDP));
         }
     }
 
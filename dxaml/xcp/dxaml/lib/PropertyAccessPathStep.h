@@ -11,6 +11,7 @@
 #include "XamlTelemetry.h"
 #include "DependencyObjectPropertyAccess.h"
 #include "PerfOptIn.h"
+#include "CompiledPropertyPath.h"
 
 namespace DirectUI
 {
@@ -83,6 +84,9 @@ public:
 
     using PropertyPathStep::Initialize;
 
+    void SetResolutions(_In_ const std::shared_ptr<PropertyPathStepResolutions>& spResolutions)
+    { m_spResolutions = spResolutions; }
+
     ~PropertyAccessPathStep() override;
 
 public:
@@ -131,6 +135,15 @@ private:
     void TraceGetterError();
     void TraceConnectionError(_In_ IInspectable *pSource);
 
+    // Resolves m_szProperty on the source type, through the resolutions of the compiled path if there are any.
+    _Check_return_ HRESULT ResolveDependencyProperty(
+        _In_ const CClassInfo *pSourceType,
+        _Outptr_result_maybenull_ const CDependencyProperty **ppDP);
+
+    _Check_return_ HRESULT ResolveBindableProperty(
+        _In_ const CClassInfo *pSourceType,
+        _Outptr_result_maybenull_ const CDependencyProperty **ppProperty);
+
     // Returns true when this step is using the inline DO fast path
     // (no heap-allocated DependencyObjectPropertyAccess).
     bool IsUsingInlineDOAccess() const
@@ -166,6 +179,9 @@ protected:
     const CDependencyProperty* m_pDP;
     TrackerPtr<PropertyAccess> m_tpPropertyAccess;
 
+    // Shared with the steps created from the same compiled path, if any.
+    std::shared_ptr<PropertyPathStepResolutions> m_spResolutions;
+
     // Inline DependencyObject accessor state (only used when IsInlineDOAccessEnabled() is true).
     // When active, we access the DP directly instead of
     // allocating a separate heap DependencyObjectPropertyAccess object.
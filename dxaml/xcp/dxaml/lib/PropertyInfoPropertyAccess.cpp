@@ -177,36 +177,39 @@ PropertyInfoPropertyAccess::GetPropertyName()
     return m_pOwner->GetPropertyName();
 }
 
+_Check_return_ HRESULT PropertyInfoPropertyAccess::ResolveProperty(
+    _In_ const CClassInfo* pSourceType,
+    _In_z_ const WCHAR* pszPropertyName,
+    _Outptr_result_maybenull_ const CDependencyProperty** ppProperty)
+{
+    *ppProperty = nullptr;
+
+    // We only care about types that are in the metadata because they are explicitly bindable
+    // this will remove things like DPs as we need those to be resolved in a specialized form.
+    if (!pSourceType->IsBindable())
+    {
+        return S_OK;
+    }
+
+    IFC_RETURN(MetadataAPI::TryGetPropertyByName(pSourceType, XSTRING_PTR_EPHEMERAL2(pszPropertyName, xstrlen(pszPropertyName)), ppProperty));
+
+    return S_OK;
+}
+
 _Check_return_ HRESULT PropertyInfoPropertyAccess::CreateInstance(
     _In_ IPropertyAccessHost* pOwner,
     _In_ IInspectable* pSource,
     _In_ const CClassInfo* pSourceType,
+    _In_ const CDependencyProperty* pProperty,
     _In_ bool fListenToChanges,
     _Outptr_ PropertyAccess** ppPropertyAccess)
 {
     HRESULT hr = S_OK;
     ctl::ComPtr<PropertyInfoPropertyAccess> spResult;
-    const CDependencyProperty* pProperty = nullptr;
-    const WCHAR* pszPropertyName = pOwner->GetPropertyName();
 
     IFCPTR(pSource);
 
-    *ppPropertyAccess = nullptr; // By default no property is generated
-
-    // We only care about types that are in the metadata because they are explicitly bindable
-    // this will remove things like DPs as we need those to be resolved in a specialized form.
-    if (!pSourceType->IsBindable())
-    {
-        goto Cleanup;
-    }
-
-    // Now try to resolve the property by name.
-    IFC(MetadataAPI::TryGetPropertyByName(pSourceType, XSTRING_PTR_EPHEMERAL2(pszPropertyName, xstrlen(pszPropertyName)), &pProperty));
-    if (pProperty == nullptr)
-    {
-        // We failed to find the property, bail out.
-        goto Cleanup;
-    }
+    *ppPropertyAccess = nullptr;
 
     // Create a property access object.
     IFC(ctl::make(pOwner, pSource, pSourceType, pProperty->AsOrNull<CCustomProperty>(), &spResult));
@@ -55,10 +55,17 @@ namespace DirectUI
 
     public:
 
+        // Resolves the property by name on a type with bindable metadata, or returns null.
+        static _Check_return_ HRESULT ResolveProperty(
+            _In_ const CClassInfo *pSourceType,
+            _In_z_ const WCHAR *pszPropertyName,
+            _Outptr_result_maybenull_ const CDependencyProperty **ppProperty);
+
         static _Check_return_ HRESULT CreateInstance(
             _In_ IPropertyAccessHost *pOwner,
             _In_ IInspectable *pSource, 
             _In_ const CClassInfo *pSourceType,
+            _In_ const CDependencyProperty *pProperty,
             _In_ bool fListenToChanges,
             _Outptr_ PropertyAccess **ppPropertyAccess);
 
@@ -4,6 +4,7 @@
 #include "precomp.h"
 #include "PropertyPath.h"
 #include "PropertyPathParser.h"
+#include "CompiledPropertyPath.h"
 #include "PropertyPathStep.h"
 
 using namespace DirectUI;
@@ -40,7 +41,7 @@ PropertyPathListener::Initialize(
 
     for (auto& descriptor : *pPropertyPathParser)
     {
-        IFC(descriptor.CreateStep(this, fListenToChanges, spStep.ReleaseAndGetAddressOf()));
+        IFC(descriptor.CreateStep(this, fListenToChanges, nullptr, spStep.ReleaseAndGetAddressOf()));
         AppendStep(spStep.Get());
     }
 
@@ -49,6 +50,32 @@ Cleanup:
     RRETURN(hr);
 }
 
+_Check_return_
+HRESULT
+PropertyPathListener::Initialize(
+    _In_ IPropertyPathListenerHost *pOwner,
+    _In_ const std::shared_ptr<CompiledPropertyPath>& spCompiledPath,
+    _In_ bool fListenToChanges,
+    _In_ bool fUseWeakReferenceForSource)
+{
+    ctl::ComPtr<PropertyPathStep> spStep;
+    size_t stepIndex = 0;
+
+    m_pOwner = pOwner;
+
+    for (auto& descriptor : *spCompiledPath->GetParser())
+    {
+        IFC_RETURN(descriptor.CreateStep(
+            this,
+            fListenToChanges,
+            CompiledPropertyPath::GetStepResolutions(spCompiledPath, stepIndex++),
+            spStep.ReleaseAndGetAddressOf()));
+        AppendStep(spStep.Get());
+    }
+
+    return S_OK;
+}
+
 _Check_return_ 
 HRESULT 
 PropertyPathListener::SetSource(_In_ IInspectable *pSource)
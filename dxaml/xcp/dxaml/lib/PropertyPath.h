@@ -9,6 +9,7 @@ class CClassInfo;
 namespace DirectUI
 {
 class BindingExpression;
+class CompiledPropertyPath;
 class PropertyPathListener;
 class PropertyPathParser;
 struct IPropertyPathListenerHost;
@@ -33,6 +34,13 @@ public:
         _In_ PropertyPathParser *pPropertyPathParser, 
         _In_ bool fListenToChanges, 
         _In_ bool fUseWeakReferenceForSource);
+
+    // Creates steps that share the properties they resolve with the other listeners of the compiled path.
+    _Check_return_ HRESULT Initialize(
+        _In_ IPropertyPathListenerHost *pOwner,
+        _In_ const std::shared_ptr<CompiledPropertyPath>& spCompiledPath,
+        _In_ bool fListenToChanges,
+        _In_ bool fUseWeakReferenceForSource);
     using ctl::WeakReferenceSource::Initialize;
     
     _Check_return_ HRESULT SetSource(_In_ IInspectable *pSource);
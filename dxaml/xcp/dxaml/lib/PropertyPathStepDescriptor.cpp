@@ -194,6 +194,7 @@ HRESULT
 PropertyPathStepDescriptor::CreateStep(
     _In_ PropertyPathListener* pListener,
     bool fListenToChanges,
+    _In_ const std::shared_ptr<PropertyPathStepResolutions>& spResolutions,
     _Outptr_ PropertyPathStep** ppStep) const
 {
     HRESULT hr = S_OK;
@@ -220,6 +221,7 @@ PropertyPathStepDescriptor::CreateStep(
         IFC(ctl::make<PropertyAccessPathStep>(pListener, szTempCopy, fListenToChanges, &spStep));
 
         szTempCopy = nullptr; // Transferred to the step
+        spStep->SetResolutions(spResolutions);
         *ppStep = spStep.Detach();
         break;
     }
@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <memory>
+
 namespace DirectUI
 {
     class PropertyPathListener;
     class PropertyPathStep;
     class PropertyPathStepDescriptor;
+    class PropertyPathStepResolutions;
 
     // Heap storage block for when we have more than 2 descriptors.
     struct HeapDescriptorStorage
@@ -60,9 +63,11 @@ namespace DirectUI
         PropertyPathStepDescriptorKind GetKind() const noexcept { return m_kind; }
         HeapDescriptorStorage* GetHeapStorage() const noexcept { return m_pHeapStorage; }
 
+        // Property access steps cache the properties they resolve in the given resolutions, if any.
         _Check_return_ HRESULT CreateStep(
             _In_ PropertyPathListener* pListener,
             bool fListenToChanges,
+            _In_ const std::shared_ptr<PropertyPathStepResolutions>& spResolutions,
             _Outptr_ PropertyPathStep** ppStep) const;
 
     private:
@@ -4,11 +4,25 @@
 #include "precomp.h"
 #include "StackingLayoutStrategy.g.h"
 #include "ModernCollectionBasePanel.g.h"
+#include "XamlTraceLogging.h"
 
 using namespace DirectUI;
 using namespace DirectUISynonyms;
 using namespace xaml_controls;
 
+StackingLayoutStrategy::~StackingLayoutStrategy()
+{
+    // Trace telemetry for how far our extent estimations were from the measured sizes
+    TraceLoggingWrite(
+        g_hTraceProvider,
+        "StackingLayoutEstimationLifetimeStats",
+        TraceLoggingValue(_layoutStrategyImpl.GetEstimatedElementCount(), "EstimatedElementCount"),
+        TraceLoggingValue(_layoutStrategyImpl.GetTotalEstimationError(), "TotalEstimationError"),
+        TraceLoggingLevel(WINEVENT_LEVEL_LOG_ALWAYS),
+        TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY));
+}
+
 _Check_return_ HRESULT StackingLayoutStrategy::Initialize()
 {
     _layoutStrategyImpl.Initialize();
@@ -12,6 +12,7 @@ namespace DirectUI
     {
     protected:
         StackingLayoutStrategy() = default;
+        ~StackingLayoutStrategy() override;
         _Check_return_ HRESULT Initialize() override;
 
     public:
@@ -174,6 +175,11 @@ namespace DirectUI
         float GetAverageHeaderSize() const { return _layoutStrategyImpl.GetAverageHeaderSize(); }
         float GetAverageContainerSize() const { return _layoutStrategyImpl.GetAverageContainerSize(); }
 
+        // Keeps the measured element extents in step with collection changes.
+        void OnElementInserted(_In_ xaml_controls::ElementType elementType, _In_ INT index) { _layoutStrategyImpl.OnElementInserted(elementType, index); }
+        void OnElementRemoved(_In_ xaml_controls::ElementType elementType, _In_ INT index) { _layoutStrategyImpl.OnElementRemoved(elementType, index); }
+        void OnElementsReset() { _layoutStrategyImpl.OnElementsReset(); }
+
     private:
         // This is where the actual implementation of the layout strategy exists,
         Components::Moco::StackingLayoutStrategyImpl _layoutStrategyImpl;
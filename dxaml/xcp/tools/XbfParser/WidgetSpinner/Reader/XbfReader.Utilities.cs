@@ -220,6 +220,7 @@ namespace Microsoft.Xaml.WidgetSpinner.Reader
                 case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v2:
                 case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v3:
                 case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v4:
+                case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v5:
                     {
                         data = ResourceDictionaryCustomRuntimeData.CreateAndDeserializeRuntimeData(this, typeIndex);
                     }
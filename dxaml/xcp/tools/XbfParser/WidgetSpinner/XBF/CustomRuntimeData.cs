@@ -23,6 +23,7 @@ namespace Microsoft.Xaml.WidgetSpinner.XBF
         ResourceDictionary_v3 = 10,
         Style_v3 = 11,
         ResourceDictionary_v4 = 12,
+        ResourceDictionary_v5 = 13,
 
         // Legacy values derived from StableXbfTypeIndex
         DeferredElement_v1 = StableXbfTypeIndex.DeferredElement,                        // 745
@@ -142,32 +142,24 @@ namespace Microsoft.Xaml.WidgetSpinner.XBF
                         return new ResourceDictionaryCustomRuntimeData(typeIndex, explicitKeyResources, implicitKeyResources, resourcesWithXNames, conditionallyDeclaredObjects);
                     }
                 case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v4:
+                case CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v5:
                     {
                         // v4 uses a unified map keyed by ResourceKeyStorage (string key + uint64 hashAndIsKeyType)
-                        // instead of separate explicit/implicit maps. We split back into the two lists by checking
-                        // the isKeyType flag (LSB of hashAndIsKeyType).
+                        // instead of separate explicit/implicit maps.
                         var explicitKeyResources = new List<Tuple<string, StreamOffsetToken>>();
                         var implicitKeyResources = new List<Tuple<string, StreamOffsetToken>>();
 
-                        var resourcesMapCount = reader.Read7BitEncodedInt();
-                        for (var i = 0; i < resourcesMapCount; i++)
+                        if (typeIndex == CustomWriterRuntimeDataTypeIndex.ResourceDictionary_v5)
                         {
-                            var key = reader.ReadSharedString();
-                            var hashAndIsKeyType = reader.ReadUInt64();
-                            var token = reader.ReadStreamOffsetToken();
-
-                            bool isKeyType = (hashAndIsKeyType & 1) != 0;
-                            var entry = new Tuple<string, StreamOffsetToken>(key, token);
-                            if (isKeyType)
-                            {
-                                implicitKeyResources.Add(entry);
-                            }
-                            else
-                            {
-                                explicitKeyResources.Add(entry);
-                            }
+                            // v5 stores the same entries as a minimal perfect hash table: the per-bucket seeds,
+                            // then the entries in slot order. Any resources that couldn't be placed in the
+                            // table follow in a v4-style map.
+                            reader.ReadVector((r) => r.Read7BitEncodedInt(), true);
+                            ReadUnifiedResources(reader, explicitKeyResources, implicitKeyResources);
                         }
 
+                        ReadUnifiedResources(reader, explicitKeyResources, implicitKeyResources);
+
                         var resourcesWithXNames = reader.ReadVector((r) => r.ReadSharedString(), true);
 
                         // Read conditional resources map (ResourceKeyStorage -> vector<StreamOffsetToken>).
@@ -205,5 +197,32 @@ namespace Microsoft.Xaml.WidgetSpinner.XBF
             }
 
         }
+
+        // Reads a vector of (ResourceKeyStorage, StreamOffsetToken) entries, as used by the unified resource map
+        // since ResourceDictionary_v4, and splits them by the isKeyType flag (LSB of hashAndIsKeyType).
+        private static void ReadUnifiedResources(
+            XbfReader reader,
+            List<Tuple<string, StreamOffsetToken>> explicitKeyResources,
+            List<Tuple<string, StreamOffsetToken>> implicitKeyResources)
+        {
+            var count = reader.Read7BitEncodedInt();
+            for (var i = 0; i < count; i++)
+            {
+                var key = reader.ReadSharedString();
+                var hashAndIsKeyType = reader.ReadUInt64();
+                var token = reader.ReadStreamOffsetToken();
+
+                bool isKeyType = (hashAndIsKeyType & 1) != 0;
+                var entry = new Tuple<string, StreamOffsetToken>(key, token);
+                if (isKeyType)
+                {
+                    implicitKeyResources.Add(entry);
+                }
+                else
+                {
+                    explicitKeyResources.Add(entry);
+                }
+            }
+        }
     }
 }
\ No newline at end of file